@@ -2334,8 +2334,22 @@ decided relatively late.  */
   BFD_RELOC_GPREL16,
   BFD_RELOC_GPREL32,
 
-/* Reloc types used for i960/b.out (although I'm going to use it for ELF) */
-  BFD_RELOC_I960_CALLJ, 
+/* Reloc types used for i960/b.out (although I'm going to use it for ELF)  */
+  BFD_RELOC_I960_CALLJ,
+
+/* i960 ELF: the 32-bit displacement of a callx which the linker may
+shorten to a call.  */
+  BFD_RELOC_I960_CALLX,
+
+/* i960 ELF: subtract the symbol value from the 32-bit field.  Used
+together with a BFD_RELOC_32 at the same address for a difference of
+two symbols which linker relaxation may change.  */
+  BFD_RELOC_I960_SUB,
+
+/* i960 ELF: marks an alignment directive in a code section, so that
+linker relaxation keeps the code after it aligned.  */
+  BFD_RELOC_I960_ALIGN,
+
 /* SPARC ELF relocations.  There is probably some overlap with other
 relocation types already defined.  */
   BFD_RELOC_NONE,
@@ -89,10 +89,19 @@ static reloc_howto_type elf_howto_table[]=
   HOWTO (R_960_IP24, 0, 2, 24, true, 0, complain_overflow_signed,
 	 elf32_i960_relocate, "R_960_IP24 ", true,
 	 0x00ffffff, 0x00ffffff, false),
-  EMPTY_HOWTO (4),
-  EMPTY_HOWTO (5),
-  EMPTY_HOWTO (6),
-  EMPTY_HOWTO (7)
+  HOWTO (R_960_SUB, 0, -2, 32, false, 0, complain_overflow_dont,
+	 elf32_i960_relocate, "R_960_SUB", true,
+	 0xffffffff, 0xffffffff, false),
+  HOWTO (R_960_OPTCALL, 0, 2, 24, true, 0, complain_overflow_signed,
+	 elf32_i960_relocate, "R_960_OPTCALL", true,
+	 0x00ffffff, 0x00ffffff, false),
+  HOWTO (R_960_OPTCALLX, 0, 2, 32, false, 0, complain_overflow_bitfield,
+	 elf32_i960_relocate, "R_960_OPTCALLX", true,
+	 0xffffffff, 0xffffffff, false),
+  EMPTY_HOWTO (7),
+  HOWTO (R_960_ALIGN, 0, 3, 0, false, 0, complain_overflow_dont,
+	 elf32_i960_relocate, "R_960_ALIGN", false,
+	 0, 0, false)
 };
 
 static enum elf_i960_reloc_type
@@ -104,6 +113,12 @@ elf32_i960_bfd_to_reloc_type (bfd_reloc_code_real_type code)
       return R_960_NONE;
     case BFD_RELOC_I960_CALLJ:
       return R_960_OPTCALL;
+    case BFD_RELOC_I960_CALLX:
+      return R_960_OPTCALLX;
+    case BFD_RELOC_I960_SUB:
+      return R_960_SUB;
+    case BFD_RELOC_I960_ALIGN:
+      return R_960_ALIGN;
     case BFD_RELOC_32:
     case BFD_RELOC_CTOR:
       return R_960_32;
@@ -162,6 +177,668 @@ elf32_i960_reloc_name_lookup (bfd *abfd ATTRIBUTE_UNUSED,
   return NULL;
 }
 
+/* Return the addend stored in the field at WHERE described by HOWTO.  */
+
+static bfd_vma
+elf32_i960_extract_rel_addend (bfd *abfd,
+			       bfd_byte *where,
+			       reloc_howto_type *howto)
+{
+  bfd_vma val;
+
+  val = bfd_get_32 (abfd, where) & howto->dst_mask;
+  if (howto->pc_relative)
+    {
+      bfd_vma sign;
+
+      sign = howto->dst_mask & ~(howto->dst_mask >> 1);
+      val = (val ^ sign) - sign;
+    }
+  return val;
+}
+
+/* Store ADDEND into the field at WHERE described by HOWTO.  */
+
+static void
+elf32_i960_insert_rel_addend (bfd *abfd,
+			      bfd_byte *where,
+			      reloc_howto_type *howto,
+			      bfd_vma addend)
+{
+  bfd_vma insn;
+
+  insn = bfd_get_32 (abfd, where) & ~howto->dst_mask;
+  insn |= addend & howto->dst_mask;
+  bfd_put_32 (abfd, insn, where);
+}
+
+/* Relocate an i960 ELF section.  The i960 uses REL relocs, so the
+   addend lives in the section contents.  R_960_IP24 and R_960_OPTCALL
+   displacements are relative to the start of the input section rather
+   than to the reloc itself (pcrel_offset is false), so a relocatable
+   link must rebase them when the input section moves within its output
+   section.  */
+
+static int
+elf32_i960_relocate_section (bfd *output_bfd,
+			     struct bfd_link_info *info,
+			     bfd *input_bfd,
+			     asection *input_section,
+			     bfd_byte *contents,
+			     Elf_Internal_Rela *relocs,
+			     Elf_Internal_Sym *local_syms,
+			     asection **local_sections)
+{
+  Elf_Internal_Shdr *symtab_hdr;
+  struct elf_link_hash_entry **sym_hashes;
+  Elf_Internal_Rela *rel, *relend;
+  const char *name;
+
+  symtab_hdr = &elf_tdata (input_bfd)->symtab_hdr;
+  sym_hashes = elf_sym_hashes (input_bfd);
+
+  rel = relocs;
+  relend = relocs + input_section->reloc_count;
+  for (; rel < relend; rel++)
+    {
+      unsigned int r_type;
+      reloc_howto_type *howto;
+      unsigned long r_symndx;
+      Elf_Internal_Sym *sym;
+      asection *sec;
+      struct elf_link_hash_entry *h;
+      bfd_vma relocation;
+      bfd_reloc_status_type r;
+
+      r_symndx = ELF32_R_SYM (rel->r_info);
+      r_type = ELF32_R_TYPE (rel->r_info);
+
+      if (r_type >= R_960_max
+	  || elf_howto_table[r_type].name == NULL)
+	{
+	  /* xgettext:c-format */
+	  _bfd_error_handler (_("%pB: unsupported relocation type %#x"),
+			      input_bfd, r_type);
+	  bfd_set_error (bfd_error_bad_value);
+	  return false;
+	}
+
+      if (r_type == R_960_NONE || r_type == R_960_ALIGN)
+	continue;
+
+      howto = elf_howto_table + r_type;
+      h = NULL;
+      sym = NULL;
+      sec = NULL;
+      if (r_symndx < symtab_hdr->sh_info)
+	{
+	  sym = local_syms + r_symndx;
+	  sec = local_sections[r_symndx];
+	  relocation = (sec->output_section->vma
+			+ sec->output_offset
+			+ sym->st_value);
+	  if (ELF_ST_TYPE (sym->st_info) == STT_SECTION
+	      && ((sec->flags & SEC_MERGE) != 0
+		  || (bfd_link_relocatable (info)
+		      && sec->output_offset != 0)))
+	    {
+	      bfd_vma addend;
+	      bfd_byte *where = contents + rel->r_offset;
+
+	      addend = elf32_i960_extract_rel_addend (input_bfd, where, howto);
+
+	      if (bfd_link_relocatable (info))
+		addend += sec->output_offset;
+	      else
+		{
+		  asection *msec = sec;
+		  addend = _bfd_elf_rel_local_sym (output_bfd, sym, &msec,
+						   addend);
+		  addend -= relocation;
+		  addend += msec->output_section->vma + msec->output_offset;
+		}
+	      elf32_i960_insert_rel_addend (input_bfd, where, howto, addend);
+	    }
+	}
+      else
+	{
+	  bool unresolved_reloc, warned, ignored;
+
+	  RELOC_FOR_GLOBAL_SYMBOL (info, input_bfd, input_section, rel,
+				   r_symndx, symtab_hdr, sym_hashes,
+				   h, sec, relocation,
+				   unresolved_reloc, warned, ignored);
+	}
+
+      if (sec != NULL && discarded_section (sec))
+	RELOC_AGAINST_DISCARDED_SECTION (info, input_bfd, input_section,
+					 rel, 1, relend, howto, 0, contents);
+
+      if (bfd_link_relocatable (info))
+	{
+	  /* The reloc itself moves with the input section; keep the
+	     section-relative displacement pointing at the same place.  */
+	  if (howto->pc_relative
+	      && !howto->pcrel_offset
+	      && input_section->output_offset != 0)
+	    {
+	      bfd_vma addend;
+	      bfd_byte *where = contents + rel->r_offset;
+
+	      addend = elf32_i960_extract_rel_addend (input_bfd, where, howto);
+	      addend -= input_section->output_offset;
+	      elf32_i960_insert_rel_addend (input_bfd, where, howto, addend);
+	    }
+	  continue;
+	}
+
+      if (h != NULL)
+	name = h->root.root.string;
+      else
+	{
+	  name = (bfd_elf_string_from_elf_section
+		  (input_bfd, symtab_hdr->sh_link, sym->st_name));
+	  if (name == NULL || *name == '\0')
+	    name = bfd_section_name (sec);
+	}
+
+      r = _bfd_final_link_relocate (howto, input_bfd, input_section,
+				    contents, rel->r_offset,
+				    relocation, (bfd_vma) 0);
+
+      if (r != bfd_reloc_ok)
+	{
+	  const char * msg = (const char *) 0;
+
+	  switch (r)
+	    {
+	    case bfd_reloc_overflow:
+	      (*info->callbacks->reloc_overflow)
+		(info, (h ? &h->root : NULL), name, howto->name,
+		 (bfd_vma) 0, input_bfd, input_section, rel->r_offset);
+	      break;
+
+	    case bfd_reloc_undefined:
+	      (*info->callbacks->undefined_symbol)
+		(info, name, input_bfd, input_section, rel->r_offset, true);
+	      break;
+
+	    case bfd_reloc_outofrange:
+	      msg = _("internal error: out of range error");
+	      goto common_error;
+
+	    case bfd_reloc_notsupported:
+	      msg = _("internal error: unsupported relocation error");
+	      goto common_error;
+
+	    case bfd_reloc_dangerous:
+	      msg = _("internal error: dangerous error");
+	      goto common_error;
+
+	    default:
+	      msg = _("internal error: unknown error");
+	      /* fall through */
+
+	    common_error:
+	      (*info->callbacks->warning) (info, msg, name, input_bfd,
+					   input_section, rel->r_offset);
+	      break;
+	    }
+	}
+    }
+
+  return true;
+}
+
+/* Opcodes used when relaxing callx.  */
+#define I960_CALLX_MASK		0xff003c00
+#define I960_CALLX_ABS		0x86003000	/* callx disp32 (MEMB, mode 1100).  */
+#define I960_CALL		0x09000000	/* call disp24 (CTRL).  */
+
+/* Alignment padding between input sections can grow as earlier
+   sections shrink, so leave some headroom when the target of a
+   relaxed call lies outside the section being relaxed.  */
+#define I960_RELAX_SLACK	0x1000
+
+/* Return TRUE if HOWTO describes a displacement relative to the start
+   of the section holding the reloc, i.e. R_960_IP24 or R_960_OPTCALL.  */
+
+static bool
+elf32_i960_section_relative_p (reloc_howto_type *howto)
+{
+  return howto->pc_relative && !howto->pcrel_offset;
+}
+
+/* Adjust the in-place addends of relocs in section O of ABFD after
+   COUNT bytes at ADDR have been deleted from SEC.  Everything in SEC
+   after ADDR and before TOADDR moves down by COUNT.  Relocs against the
+   section symbol of SEC whose target lies in that range move with the
+   code, and section-relative displacements in SEC itself must account
+   for their own reloc moving.  R_OFFSETs are updated here as well when
+   O is SEC.  */
+
+static bool
+elf32_i960_adjust_addends (bfd *abfd, asection *o, asection *sec,
+			   unsigned int sec_shndx, bfd_vma addr,
+			   bfd_vma toaddr, int count)
+{
+  Elf_Internal_Shdr *symtab_hdr;
+  Elf_Internal_Sym *isymbuf;
+  Elf_Internal_Rela *internal_relocs;
+  Elf_Internal_Rela *irel, *irelend;
+  bfd_byte *contents;
+
+  symtab_hdr = &elf_tdata (abfd)->symtab_hdr;
+  isymbuf = (Elf_Internal_Sym *) symtab_hdr->contents;
+
+  internal_relocs = _bfd_elf_link_read_relocs (abfd, o, NULL, NULL, true);
+  if (internal_relocs == NULL)
+    return false;
+
+  contents = elf_section_data (o)->this_hdr.contents;
+  irelend = internal_relocs + o->reloc_count;
+  for (irel = internal_relocs; irel < irelend; irel++)
+    {
+      unsigned int r_type = ELF32_R_TYPE (irel->r_info);
+      unsigned long r_symndx = ELF32_R_SYM (irel->r_info);
+      reloc_howto_type *howto;
+      bfd_vma old_offset, target, addend;
+      bool target_moves = false;
+
+      if (r_type >= R_960_max
+	  || r_type == R_960_NONE
+	  || elf_howto_table[r_type].name == NULL)
+	continue;
+      howto = elf_howto_table + r_type;
+      old_offset = irel->r_offset;
+
+      if (o == sec && old_offset > addr && old_offset < toaddr)
+	irel->r_offset -= count;
+
+      /* The field of an R_960_SUB does not hold the offset of its
+	 symbol, and an R_960_ALIGN has no field.  */
+      if (howto->negate || r_type == R_960_ALIGN)
+	continue;
+
+      if (r_symndx < symtab_hdr->sh_info
+	  && isymbuf != NULL
+	  && ELF_ST_TYPE (isymbuf[r_symndx].st_info) == STT_SECTION
+	  && isymbuf[r_symndx].st_shndx == sec_shndx)
+	target_moves = true;
+
+      if (!target_moves
+	  && !(o == sec
+	       && elf32_i960_section_relative_p (howto)
+	       && old_offset > addr
+	       && old_offset < toaddr))
+	continue;
+
+      if (contents == NULL)
+	{
+	  if (!bfd_malloc_and_get_section (abfd, o, &contents))
+	    return false;
+	  elf_section_data (o)->this_hdr.contents = contents;
+	}
+
+      addend = elf32_i960_extract_rel_addend (abfd, contents + irel->r_offset,
+					      howto);
+      if (elf32_i960_section_relative_p (howto))
+	{
+	  /* The field holds target - r_offset.  */
+	  target = addend + old_offset;
+	  if (target_moves && target > addr && target < toaddr)
+	    target -= count;
+	  addend = target - irel->r_offset;
+	}
+      else if (target_moves
+	       && addend + isymbuf[r_symndx].st_value > addr
+	       && addend + isymbuf[r_symndx].st_value < toaddr)
+	addend -= count;
+
+      elf32_i960_insert_rel_addend (abfd, contents + irel->r_offset, howto,
+				    addend);
+    }
+
+  elf_section_data (o)->relocs = internal_relocs;
+  return true;
+}
+
+/* Delete some bytes from a section while relaxing.
+
+   gas emits an R_960_ALIGN reloc at each alignment directive in a
+   code section assembled with --link-relax.  The reloc does not say
+   how much alignment was asked for, so the code after it keeps its
+   offset modulo the alignment of the whole section.  Unless COUNT is
+   a multiple of that, the deletion stops at the first R_960_ALIGN
+   after ADDR: the bytes up to it move down, and COUNT bytes of zero
+   padding are inserted just before it.  */
+
+static bool
+elf32_i960_relax_delete_bytes (bfd *abfd, asection *sec, bfd_vma addr,
+			       int count)
+{
+  Elf_Internal_Shdr *symtab_hdr;
+  unsigned int sec_shndx;
+  bfd_byte *contents;
+  asection *o;
+  Elf_Internal_Sym *isym;
+  Elf_Internal_Sym *isymend;
+  Elf_Internal_Rela *irel, *irelend;
+  Elf_Internal_Rela *irelalign;
+  bfd_vma toaddr;
+  struct elf_link_hash_entry **sym_hashes;
+  struct elf_link_hash_entry **end_hashes;
+  unsigned int symcount;
+
+  sec_shndx = _bfd_elf_section_from_bfd_section (abfd, sec);
+
+  contents = elf_section_data (sec)->this_hdr.contents;
+
+  /* Find the alignment reloc, if any, where the deletion stops.  */
+  irelalign = NULL;
+  toaddr = sec->size;
+  if ((count & ((1 << sec->alignment_power) - 1)) != 0)
+    {
+      irel = elf_section_data (sec)->relocs;
+      irelend = irel + sec->reloc_count;
+      for (; irel < irelend; irel++)
+	if (ELF32_R_TYPE (irel->r_info) == R_960_ALIGN
+	    && irel->r_offset > addr
+	    && irel->r_offset < toaddr)
+	  {
+	    irelalign = irel;
+	    toaddr = irel->r_offset;
+	  }
+    }
+
+  /* Actually delete the bytes.  */
+  memmove (contents + addr, contents + addr + count,
+	   (size_t) (toaddr - addr - count));
+  if (irelalign == NULL)
+    {
+      sec->size -= count;
+      /* Anything at the old end of the section moves too.  */
+      toaddr++;
+    }
+  else
+    memset (contents + toaddr - count, 0, count);
+
+  /* Adjust the relocs and the addends that depend on the deleted
+     range, both in this section and in any section referring to it
+     through its section symbol.  */
+  for (o = abfd->sections; o != NULL; o = o->next)
+    {
+      if ((o->flags & SEC_RELOC) == 0
+	  || o->reloc_count == 0
+	  || discarded_section (o))
+	continue;
+
+      if (!elf32_i960_adjust_addends (abfd, o, sec, sec_shndx, addr, toaddr,
+				      count))
+	return false;
+    }
+
+  /* Adjust the local symbols defined in this section.  */
+  symtab_hdr = &elf_tdata (abfd)->symtab_hdr;
+  isym = (Elf_Internal_Sym *) symtab_hdr->contents;
+  isymend = isym + symtab_hdr->sh_info;
+  for (; isym < isymend; isym++)
+    {
+      if (isym->st_shndx != sec_shndx)
+	continue;
+
+      if (isym->st_value > addr
+	  && isym->st_value < toaddr)
+	isym->st_value -= count;
+      else if (isym->st_value <= addr
+	       && isym->st_value + isym->st_size > addr
+	       && isym->st_value + isym->st_size < toaddr)
+	isym->st_size -= count;
+    }
+
+  /* Now adjust the global symbols defined in this section.  */
+  symcount = (symtab_hdr->sh_size / sizeof (Elf32_External_Sym)
+	      - symtab_hdr->sh_info);
+  sym_hashes = elf_sym_hashes (abfd);
+  end_hashes = sym_hashes + symcount;
+  for (; sym_hashes < end_hashes; sym_hashes++)
+    {
+      struct elf_link_hash_entry *sym_hash = *sym_hashes;
+
+      if ((sym_hash->root.type != bfd_link_hash_defined
+	   && sym_hash->root.type != bfd_link_hash_defweak)
+	  || sym_hash->root.u.def.section != sec)
+	continue;
+
+      if (sym_hash->root.u.def.value > addr
+	  && sym_hash->root.u.def.value < toaddr)
+	sym_hash->root.u.def.value -= count;
+      else if (sym_hash->root.u.def.value <= addr
+	       && sym_hash->root.u.def.value + sym_hash->size > addr
+	       && sym_hash->root.u.def.value + sym_hash->size < toaddr)
+	sym_hash->size -= count;
+    }
+
+  return true;
+}
+
+/* This function handles relaxing for the i960.
+
+   gas emits R_960_OPTCALLX against the 32-bit displacement of a
+   "callx sym" when assembling with --link-relax, and in that mode keeps
+   a reloc for every branch and every difference of code labels so that
+   code may move underneath it.  When the target is within reach of a
+   24-bit displacement we rewrite
+
+     callx disp32	->	call disp24	4 bytes
+
+   saving four bytes and the absolute address fetch.  A cobr has no
+   reloc, so gas only uses R_960_OPTCALLX where shortening the callx
+   cannot change the distance a cobr branches.  Each pass can only
+   shrink the section or move code towards the next R_960_ALIGN, so we
+   keep asking for another pass until nothing changes.
+
+   ELF objects carry no leafproc or sysproc marking, so calls are never
+   turned into bal or calls here.  */
+
+static bool
+elf32_i960_relax_section (bfd *abfd, asection *sec,
+			  struct bfd_link_info *link_info, bool *again)
+{
+  Elf_Internal_Shdr *symtab_hdr;
+  Elf_Internal_Rela *internal_relocs;
+  Elf_Internal_Rela *irel, *irelend;
+  bfd_byte *contents = NULL;
+  Elf_Internal_Sym *isymbuf = NULL;
+
+  /* Assume nothing changes.  */
+  *again = false;
+
+  /* We don't have to do anything for a relocatable link, if
+     this section does not have relocs, or if this is not a
+     code section.  */
+  if (bfd_link_relocatable (link_info)
+      || (sec->flags & SEC_RELOC) == 0
+      || sec->reloc_count == 0
+      || (sec->flags & SEC_CODE) == 0)
+    return true;
+
+  symtab_hdr = &elf_tdata (abfd)->symtab_hdr;
+
+  /* Get a copy of the native relocations.  */
+  internal_relocs = (_bfd_elf_link_read_relocs
+		     (abfd, sec, NULL, (Elf_Internal_Rela *) NULL,
+		      link_info->keep_memory));
+  if (internal_relocs == NULL)
+    goto error_return;
+
+  /* Walk through the relocs looking for relaxing opportunities.  */
+  irelend = internal_relocs + sec->reloc_count;
+  for (irel = internal_relocs; irel < irelend; irel++)
+    {
+      bfd_vma symval, pc, addend;
+      bfd_signed_vma disp, limit;
+      asection *sym_sec;
+      bfd_vma insn;
+
+      if (ELF32_R_TYPE (irel->r_info) != R_960_OPTCALLX)
+	continue;
+
+      if (irel->r_offset < 4 || irel->r_offset + 4 > sec->size)
+	continue;
+
+      /* Get the section contents if we haven't done so already.  */
+      if (contents == NULL)
+	{
+	  /* Get cached copy if it exists.  */
+	  if (elf_section_data (sec)->this_hdr.contents != NULL)
+	    contents = elf_section_data (sec)->this_hdr.contents;
+	  else
+	    {
+	      /* Go get them off disk.  */
+	      if (!bfd_malloc_and_get_section (abfd, sec, &contents))
+		goto error_return;
+	    }
+	}
+
+      /* Only the absolute displacement form can be shortened.  */
+      insn = bfd_get_32 (abfd, contents + irel->r_offset - 4);
+      if ((insn & I960_CALLX_MASK) != I960_CALLX_ABS)
+	continue;
+
+      /* Read this BFD's local symbols if we haven't done so already.  */
+      if (isymbuf == NULL && symtab_hdr->sh_info != 0)
+	{
+	  isymbuf = (Elf_Internal_Sym *) symtab_hdr->contents;
+	  if (isymbuf == NULL)
+	    isymbuf = bfd_elf_get_elf_syms (abfd, symtab_hdr,
+					    symtab_hdr->sh_info, 0,
+					    NULL, NULL, NULL);
+	  if (isymbuf == NULL)
+	    goto error_return;
+	}
+
+      /* Get the value of the symbol referred to by the reloc.  */
+      if (ELF32_R_SYM (irel->r_info) < symtab_hdr->sh_info)
+	{
+	  /* A local symbol.  */
+	  Elf_Internal_Sym *isym;
+
+	  isym = isymbuf + ELF32_R_SYM (irel->r_info);
+	  sym_sec = bfd_section_from_elf_index (abfd, isym->st_shndx);
+	  if (sym_sec == NULL || discarded_section (sym_sec))
+	    continue;
+	  symval = (isym->st_value
+		    + sym_sec->output_section->vma
+		    + sym_sec->output_offset);
+	}
+      else
+	{
+	  unsigned long indx;
+	  struct elf_link_hash_entry *h;
+
+	  /* An external symbol.  */
+	  indx = ELF32_R_SYM (irel->r_info) - symtab_hdr->sh_info;
+	  h = elf_sym_hashes (abfd)[indx];
+	  BFD_ASSERT (h != NULL);
+	  while (h->root.type == bfd_link_hash_indirect
+		 || h->root.type == bfd_link_hash_warning)
+	    h = (struct elf_link_hash_entry *) h->root.u.i.link;
+
+	  if (h->root.type != bfd_link_hash_defined
+	      && h->root.type != bfd_link_hash_defweak)
+	    /* This appears to be a reference to an undefined
+	       symbol.  Just ignore it--it will be caught by the
+	       regular reloc processing.  */
+	    continue;
+
+	  sym_sec = h->root.u.def.section;
+	  if (sym_sec->output_section == NULL)
+	    continue;
+	  symval = (h->root.u.def.value
+		    + sym_sec->output_section->vma
+		    + sym_sec->output_offset);
+	}
+
+      addend = bfd_get_32 (abfd, contents + irel->r_offset);
+      symval += addend;
+
+      pc = (sec->output_section->vma + sec->output_offset
+	    + irel->r_offset - 4);
+      disp = symval - pc;
+
+      limit = 0x800000;
+      if (sym_sec != sec)
+	limit -= I960_RELAX_SLACK;
+      else if (sec->alignment_power > 2)
+	/* Padding inserted before an R_960_ALIGN can push the target
+	   away again, by at most four bytes per callx shortened.  */
+	limit -= 4 * sec->reloc_count;
+      if ((disp & 3) != 0 || disp < -limit || disp >= limit)
+	continue;
+
+      /* The call's in-place field is relative to the start of the
+	 section, like every R_960_IP24.  */
+      addend -= irel->r_offset - 4;
+      if ((bfd_signed_vma) addend < -0x800000
+	  || (bfd_signed_vma) addend >= 0x800000)
+	continue;
+
+      /* Note that we've changed the relocs, section contents, etc.  */
+      elf_section_data (sec)->relocs = internal_relocs;
+      elf_section_data (sec)->this_hdr.contents = contents;
+      symtab_hdr->contents = (unsigned char *) isymbuf;
+
+      bfd_put_32 (abfd, I960_CALL | (addend & 0x00ffffff),
+		  contents + irel->r_offset - 4);
+
+      /* Fix the relocation's type and delete the old displacement.  */
+      irel->r_info = ELF32_R_INFO (ELF32_R_SYM (irel->r_info), R_960_IP24);
+      irel->r_offset -= 4;
+
+      if (!elf32_i960_relax_delete_bytes (abfd, sec, irel->r_offset + 4, 4))
+	goto error_return;
+
+      /* That will change things, so, we should relax again.  */
+      *again = true;
+    }
+
+  if (isymbuf != NULL
+      && symtab_hdr->contents != (unsigned char *) isymbuf)
+    {
+      if (! link_info->keep_memory)
+	free (isymbuf);
+      else
+	symtab_hdr->contents = (unsigned char *) isymbuf;
+    }
+
+  if (contents != NULL
+      && elf_section_data (sec)->this_hdr.contents != contents)
+    {
+      if (! link_info->keep_memory)
+	free (contents);
+      else
+	{
+	  /* Cache the section contents for elf_link_input_bfd.  */
+	  elf_section_data (sec)->this_hdr.contents = contents;
+	}
+    }
+
+  if (elf_section_data (sec)->relocs != internal_relocs)
+    free (internal_relocs);
+
+  return true;
+
+ error_return:
+  if (symtab_hdr->contents != (unsigned char *) isymbuf)
+    free (isymbuf);
+  if (elf_section_data (sec)->this_hdr.contents != contents)
+    free (contents);
+  if (elf_section_data (sec)->relocs != internal_relocs)
+    free (internal_relocs);
+  return false;
+}
+
 #define TARGET_LITTLE_SYM	i960_elf32_vec
 #define TARGET_LITTLE_NAME	"elf32-i960"
 #define ELF_ARCH		bfd_arch_i960
@@ -176,6 +853,8 @@ elf32_i960_reloc_name_lookup (bfd *abfd ATTRIBUTE_UNUSED,
 #define bfd_elf32_bfd_reloc_name_lookup     elf32_i960_reloc_name_lookup
 #define elf_info_to_howto		            elf32_i960_info_to_howto
 #define elf_info_to_howto_rel		        elf32_i960_info_to_howto_rel
+#define elf_backend_relocate_section	    elf32_i960_relocate_section
+#define bfd_elf32_bfd_relax_section	    elf32_i960_relax_section
 
 /*
 #define elf_backend_want_got_plt 1
@@ -183,7 +862,6 @@ elf32_i960_reloc_name_lookup (bfd *abfd ATTRIBUTE_UNUSED,
 #define elf_backend_can_gc_sections 1
 #define elf_backend_rela_normal 1
 #define elf_backend_can_refcount 1
-#define elf_backend_relocate_section
 #define elf_backend_gc_mark_hook
 #define elf_backend_gc_sweep_hook
 #define elf_backend_check_relocs
@@ -1097,6 +1097,9 @@ static const char *const bfd_reloc_code_real_names[] = { "@@uninitialized@@",
   "BFD_RELOC_GPREL16",
   "BFD_RELOC_GPREL32",
   "BFD_RELOC_I960_CALLJ",
+  "BFD_RELOC_I960_CALLX",
+  "BFD_RELOC_I960_SUB",
+  "BFD_RELOC_I960_ALIGN",
   "BFD_RELOC_NONE",
   "BFD_RELOC_SPARC_WDISP22",
   "BFD_RELOC_SPARC22",
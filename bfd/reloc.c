@@ -1769,6 +1769,27 @@ displacements off that register.  These relocation types are
 handled specially, because the value the register will have is
 decided relatively late.
 
+ENUM
+  BFD_RELOC_I960_CALLJ
+ENUMDOC
+  Reloc types used for i960/b.out (although I'm going to use it for ELF)
+ENUM
+  BFD_RELOC_I960_CALLX
+ENUMDOC
+  i960 ELF: the 32-bit displacement of a callx which the linker may
+shorten to a call.
+ENUM
+  BFD_RELOC_I960_SUB
+ENUMDOC
+  i960 ELF: subtract the symbol value from the 32-bit field.  Used
+together with a BFD_RELOC_32 at the same address for a difference of
+two symbols which linker relaxation may change.
+ENUM
+  BFD_RELOC_I960_ALIGN
+ENUMDOC
+  i960 ELF: marks an alignment directive in a code section, so that
+linker relaxation keeps the code after it aligned.
+
 ENUM
   BFD_RELOC_NONE
 ENUMX
@@ -72,6 +72,10 @@
 #include <sys/mman.h>
 #endif
 
+#ifdef HAVE_SYS_WAIT_H
+#include <sys/wait.h>
+#endif
+
 /* Internal headers for the ELF .stab-dump code - sorry.  */
 #define	BYTES_IN_WORD	32
 #include "aout/aout64.h"
@@ -111,6 +115,7 @@ static int disassemble_zeroes;		/* --disassemble-zeroes */
 static bool formats_info;		/* -i */
 static int wide_output;			/* -w */
 static int insn_width;			/* --insn-width */
+static int disassemble_threads = 1;	/* --threads */
 static bfd_vma start_address = (bfd_vma) -1; /* --start-address */
 static bfd_vma stop_address = (bfd_vma) -1;  /* --stop-address */
 static int dump_debugging;		/* --debugging */
@@ -359,6 +364,8 @@ usage (FILE *stream, int status)
       fprintf (stream, _("\
       --insn-width=WIDTH         Display WIDTH bytes on a single line for -d\n"));
       fprintf (stream, _("\
+      --threads=N                Disassemble large sections in N processes\n"));
+      fprintf (stream, _("\
       --adjust-vma=OFFSET        Add OFFSET to all displayed section addresses\n"));
       fprintf (stream, _("\
       --special-syms             Include special symbols in symbol dumps\n"));
@@ -424,6 +431,7 @@ enum option_values
     OPTION_NO_RECURSE_LIMIT,
     OPTION_INLINES,
     OPTION_SOURCE_COMMENT,
+    OPTION_THREADS,
 #ifdef ENABLE_LIBCTF
     OPTION_CTF,
     OPTION_CTF_PARENT,
@@ -490,6 +498,7 @@ static struct option long_options[]=
   {"stop-address", required_argument, NULL, OPTION_STOP_ADDRESS},
   {"syms", no_argument, NULL, 't'},
   {"target", required_argument, NULL, 'b'},
+  {"threads", required_argument, NULL, OPTION_THREADS},
   {"unicode", required_argument, NULL, 'U'},
   {"version", no_argument, NULL, 'V'},
   {"visualize-jumps", optional_argument, 0, OPTION_VISUALIZE_JUMPS},
@@ -3245,6 +3254,128 @@ disassemble_bytes (struct disassemble_info *inf,
   free (color_buffer);
 }
 
+/* Sections smaller than this are always disassembled serially.  */
+#define PARALLEL_DISASSEMBLY_MIN 0x10000
+
+#if defined (HAVE_FORK) && defined (HAVE_SYS_WAIT_H)
+
+/* Split the range [ADDR_OFFSET, STOP_OFFSET) of SECTION at function
+   symbols into up to DISASSEMBLE_THREADS chunks and disassemble each in
+   a forked child writing to its own temporary file.  In a child, set
+   *CHUNK_START and *CHUNK_STOP to the range it must print and return
+   true.  In the parent, copy the children's output to stdout in
+   address order once they have all finished and return false.  If
+   no useful split exists or a child cannot be started, return true
+   without changing the range, to disassemble serially.  */
+
+static bool
+fork_disassembly_workers (asection *section, struct disassemble_info *pinfo,
+			  bfd_vma addr_offset, bfd_vma stop_offset,
+			  bfd_vma *chunk_start, bfd_vma *chunk_stop)
+{
+  bfd_vma *bounds;
+  FILE **outs;
+  pid_t *pids;
+  int nchunks, i, j;
+  long x;
+
+  /* Chunk boundaries are the start addresses of function symbols in
+     this section, which the serial loop below also stops at.  */
+  bounds = xmalloc ((disassemble_threads + 1) * sizeof (*bounds));
+  bounds[0] = addr_offset;
+  nchunks = 1;
+  for (x = 0; x < sorted_symcount && nchunks < disassemble_threads; x++)
+    {
+      asymbol *s = sorted_syms[x];
+      bfd_vma off, want;
+
+      if (s->section != section
+	  || (s->flags & BSF_FUNCTION) == 0
+	  || !pinfo->symbol_is_valid (s, pinfo))
+	continue;
+
+      off = bfd_asymbol_value (s) - section->vma;
+      want = (addr_offset
+	      + (stop_offset - addr_offset) / disassemble_threads * nchunks);
+      if (off >= stop_offset)
+	break;
+      if (off > bounds[nchunks - 1] && off >= want)
+	bounds[nchunks++] = off;
+    }
+  bounds[nchunks] = stop_offset;
+
+  if (nchunks < 2)
+    {
+      free (bounds);
+      return true;
+    }
+
+  outs = xmalloc (nchunks * sizeof (*outs));
+  pids = xmalloc (nchunks * sizeof (*pids));
+
+  /* Anything still buffered would otherwise be written by every child.  */
+  fflush (stdout);
+
+  for (i = 0; i < nchunks; i++)
+    {
+      outs[i] = tmpfile ();
+      pids[i] = outs[i] != NULL ? fork () : -1;
+      if (pids[i] == 0)
+	{
+	  /* Child: print this chunk into the temporary file.  */
+	  if (dup2 (fileno (outs[i]), fileno (stdout)) < 0)
+	    _exit (1);
+	  *chunk_start = bounds[i];
+	  *chunk_stop = bounds[i + 1];
+	  free (bounds);
+	  return true;
+	}
+      if (pids[i] < 0)
+	{
+	  /* Give up on parallelism and let the caller do it all.  */
+	  for (j = 0; j < i; j++)
+	    {
+	      waitpid (pids[j], NULL, 0);
+	      fclose (outs[j]);
+	    }
+	  if (outs[i] != NULL)
+	    fclose (outs[i]);
+	  free (outs);
+	  free (pids);
+	  free (bounds);
+	  return true;
+	}
+    }
+
+  for (i = 0; i < nchunks; i++)
+    {
+      char buf[BUFSIZ];
+      size_t n;
+      int status;
+
+      if (waitpid (pids[i], &status, 0) < 0 || !WIFEXITED (status))
+	{
+	  non_fatal (_("disassembly of part of section %s failed"),
+		     sanitize_string (section->name));
+	  exit_status = 1;
+	}
+      else if (WEXITSTATUS (status) != 0)
+	exit_status = 1;
+
+      rewind (outs[i]);
+      while ((n = fread (buf, 1, sizeof buf, outs[i])) > 0)
+	fwrite (buf, 1, n, stdout);
+      fclose (outs[i]);
+    }
+
+  free (outs);
+  free (pids);
+  free (bounds);
+  return false;
+}
+
+#endif /* HAVE_FORK && HAVE_SYS_WAIT_H */
+
 static void
 disassemble_section (bfd *abfd, asection *section, void *inf)
 {
@@ -3264,6 +3395,9 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
   long rel_count;
   bfd_vma rel_offset;
   unsigned long addr_offset;
+  bfd_vma chunk_start = 0;
+  bfd_vma chunk_stop = (bfd_vma) -1;
+  bool worker = false;
   bool do_print;
   enum loop_control
   {
@@ -3388,6 +3522,23 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
       && bed->sign_extend_vma)
     sign_adjust = (bfd_vma) 1 << (bed->s->arch_size - 1);
 
+#if defined (HAVE_FORK) && defined (HAVE_SYS_WAIT_H)
+  /* Split large sections between worker processes.  Their output
+     depends on state carried from one symbol to the next when
+     printing source lines or a single symbol, so keep those serial.  */
+  if (disassemble_threads > 1
+      && paux->symbol == NULL
+      && !with_line_numbers
+      && !with_source_code
+      && stop_offset - addr_offset >= PARALLEL_DISASSEMBLY_MIN)
+    {
+      if (!fork_disassembly_workers (section, pinfo, addr_offset, stop_offset,
+				     &chunk_start, &chunk_stop))
+	goto done;
+      worker = chunk_stop != (bfd_vma) -1;
+    }
+#endif
+
   /* Disassemble a block of instructions up to the address associated with
      the symbol we have just found.  Then print the symbol and find the
      next symbol on.  Repeat until we have disassembled the entire section
@@ -3401,6 +3552,12 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
       asymbol *nextsym;
       bfd_vma nextstop_offset;
       bool insns;
+      bool in_chunk;
+
+      /* A worker only prints the symbols starting in its chunk.  */
+      if (addr_offset >= chunk_stop)
+	break;
+      in_chunk = addr_offset >= chunk_start;
 
       addr = section->vma + addr_offset;
       addr = ((addr & ((sign_adjust << 1) - 1)) ^ sign_adjust) - sign_adjust;
@@ -3502,7 +3659,7 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
 	    }
 	}
 
-      if (! prefix_addresses && do_print)
+      if (! prefix_addresses && do_print && in_chunk)
 	{
 	  pinfo->fprintf_func (pinfo->stream, "\n");
 	  objdump_print_addr_with_sym (abfd, section, sym, addr,
@@ -3563,7 +3720,14 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
       else
 	insns = false;
 
-      if (do_print)
+      if (!in_chunk)
+	{
+	  /* Skip the relocs that the serial loop would have consumed.  */
+	  while (rel_pp < rel_ppend
+		 && (*rel_pp)->address < rel_offset + nextstop_offset)
+	    ++rel_pp;
+	}
+      else if (do_print)
 	{
 	  /* Resolve symbol name.  */
 	  if (visualize_jumps && abfd && sym && sym->name)
@@ -3605,6 +3769,15 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
       sym = nextsym;
     }
 
+  if (worker)
+    {
+      fflush (stdout);
+      _exit (exit_status);
+    }
+
+#if defined (HAVE_FORK) && defined (HAVE_SYS_WAIT_H)
+ done:
+#endif
   free (data);
 
   if (rel_ppstart != NULL)
@@ -5461,6 +5634,11 @@ main (int argc, char **argv)
 	  if (insn_width <= 0)
 	    fatal (_("error: instruction width must be positive"));
 	  break;
+	case OPTION_THREADS:
+	  disassemble_threads = strtol (optarg, NULL, 0);
+	  if (disassemble_threads <= 0)
+	    fatal (_("error: thread count must be positive"));
+	  break;
 	case OPTION_INLINES:
 	  unwind_inlines = true;
 	  break;
@@ -0,0 +1,16 @@
+# A code section large enough for objdump --threads to split at
+# function symbols.
+
+	.macro	func name
+	.globl	\name
+	.type	\name, %function
+\name:
+	.fill	1024, 1, 0x90
+	.endm
+
+	.text
+	.irp	i, 0, 1, 2, 3, 4, 5, 6, 7
+	.irp	j, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9
+	func	f\i\j
+	.endr
+	.endr
@@ -0,0 +1,55 @@
+// i960.h -- ELF definitions specific to EM_960  -*- C++ -*-
+
+// Copyright (C) 2022 Free Software Foundation, Inc.
+
+// This file is part of elfcpp.
+   
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Library General Public License
+// as published by the Free Software Foundation; either version 2, or
+// (at your option) any later version.
+
+// In addition to the permissions in the GNU Library General Public
+// License, the Free Software Foundation gives you unlimited
+// permission to link the compiled version of this file into
+// combinations with other programs, and to distribute those
+// combinations without any restriction coming from the use of this
+// file.  (The Library Public License restrictions do apply in other
+// respects; for example, they cover modification of the file, and
+/// distribution when not linked into a combined executable.)
+
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Library General Public License for more details.
+
+// You should have received a copy of the GNU Library General Public
+// License along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston, MA
+// 02110-1301, USA.
+
+#ifndef ELFCPP_I960_H
+#define ELFCPP_I960_H
+
+namespace elfcpp
+{
+
+// The i960 only uses REL relocations; the addend is stored in the
+// section contents.  These numbers must match include/elf/i960.h.
+
+enum
+{
+  R_960_NONE = 0,           // No reloc.
+  R_960_12 = 1,             // Direct 12 bit (MEMA displacement).
+  R_960_32 = 2,             // Direct 32 bit.
+  R_960_IP24 = 3,           // PC relative 24 bit (CTRL displacement).
+  R_960_SUB = 4,            // Subtract symbol value.
+  R_960_OPTCALL = 5,        // Optimizable callj, as R_960_IP24.
+  R_960_OPTCALLX = 6,       // Optimizable callx, as R_960_32.
+  R_960_OPTCALLXA = 7,      // Optimizable callx with abase, as R_960_32.
+  R_960_ALIGN = 8,          // Alignment directive, for linker relaxation.
+};
+
+} // End namespace elfcpp.
+
+#endif // !defined(ELFCPP_I960_H)
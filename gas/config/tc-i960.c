@@ -237,155 +237,36 @@ struct regop
     int n;			/* Register number or literal value.  */
   };
 
-/* Number and assembler mnemonic for all registers that can appear in
-   operands.  */
-static const struct
-  {
-    const char *reg_name;
-    int reg_num;
-  }
-regnames[] =
-{
-  { "pfp", 0 },
-  { "sp", 1 },
-  { "rip", 2 },
-  { "r3", 3 },
-  { "r4", 4 },
-  { "r5", 5 },
-  { "r6", 6 },
-  { "r7", 7 },
-  { "r8", 8 },
-  { "r9", 9 },
-  { "r10", 10 },
-  { "r11", 11 },
-  { "r12", 12 },
-  { "r13", 13 },
-  { "r14", 14 },
-  { "r15", 15 },
-  { "g0", 16 },
-  { "g1", 17 },
-  { "g2", 18 },
-  { "g3", 19 },
-  { "g4", 20 },
-  { "g5", 21 },
-  { "g6", 22 },
-  { "g7", 23 },
-  { "g8", 24 },
-  { "g9", 25 },
-  { "g10", 26 },
-  { "g11", 27 },
-  { "g12", 28 },
-  { "g13", 29 },
-  { "g14", 30 },
-  { "fp", 31 },
-
-  /* Numbers for special-function registers are for assembler internal
-     use only: they are scaled back to range [0-31] for binary output.  */
-#define SF0	32
+/* Register numbers.  The i960 register names form a handful of small,
+   regular families, so they are decoded directly by reg_lookup rather
+   than looked up in a table:
 
-  { "sf0", 32 },
-  { "sf1", 33 },
-  { "sf2", 34 },
-  { "sf3", 35 },
-  { "sf4", 36 },
-  { "sf5", 37 },
-  { "sf6", 38 },
-  { "sf7", 39 },
-  { "sf8", 40 },
-  { "sf9", 41 },
-  { "sf10", 42 },
-  { "sf11", 43 },
-  { "sf12", 44 },
-  { "sf13", 45 },
-  { "sf14", 46 },
-  { "sf15", 47 },
-  { "sf16", 48 },
-  { "sf17", 49 },
-  { "sf18", 50 },
-  { "sf19", 51 },
-  { "sf20", 52 },
-  { "sf21", 53 },
-  { "sf22", 54 },
-  { "sf23", 55 },
-  { "sf24", 56 },
-  { "sf25", 57 },
-  { "sf26", 58 },
-  { "sf27", 59 },
-  { "sf28", 60 },
-  { "sf29", 61 },
-  { "sf30", 62 },
-  { "sf31", 63 },
-
-  /* Numbers for floating point registers are for assembler internal
-     use only: they are scaled back to [0-3] for binary output.  */
-#define FP0	64
+     pfp, sp, rip, r3-r15	0-15
+     g0-g14, fp		16-31
+     sf0-sf31		special-function registers
+     fp0-fp3		floating point registers  */
 
-  { "fp0", 64 },
-  { "fp1", 65 },
-  { "fp2", 66 },
-  { "fp3", 67 },
+/* Numbers for special-function registers are for assembler internal
+   use only: they are scaled back to range [0-31] for binary output.  */
+#define SF0	32
 
-  { NULL, 0 },				/* END OF LIST */
-};
+/* Numbers for floating point registers are for assembler internal
+   use only: they are scaled back to [0-3] for binary output.  */
+#define FP0	64
 
 #define	IS_RG_REG(n)	((0 <= (n)) && ((n) < SF0))
 #define	IS_SF_REG(n)	((SF0 <= (n)) && ((n) < FP0))
 #define	IS_FP_REG(n)	((n) >= FP0)
 
-/* Number and assembler mnemonic for all registers that can appear as
-   'abase' (indirect addressing) registers.  */
-static const struct
-{
-  const char *areg_name;
-  int areg_num;
-}
-aregs[] =
-{
-  { "(pfp)", 0 },
-  { "(sp)", 1 },
-  { "(rip)", 2 },
-  { "(r3)", 3 },
-  { "(r4)", 4 },
-  { "(r5)", 5 },
-  { "(r6)", 6 },
-  { "(r7)", 7 },
-  { "(r8)", 8 },
-  { "(r9)", 9 },
-  { "(r10)", 10 },
-  { "(r11)", 11 },
-  { "(r12)", 12 },
-  { "(r13)", 13 },
-  { "(r14)", 14 },
-  { "(r15)", 15 },
-  { "(g0)", 16 },
-  { "(g1)", 17 },
-  { "(g2)", 18 },
-  { "(g3)", 19 },
-  { "(g4)", 20 },
-  { "(g5)", 21 },
-  { "(g6)", 22 },
-  { "(g7)", 23 },
-  { "(g8)", 24 },
-  { "(g9)", 25 },
-  { "(g10)", 26 },
-  { "(g11)", 27 },
-  { "(g12)", 28 },
-  { "(g13)", 29 },
-  { "(g14)", 30 },
-  { "(fp)", 31 },
-
+/* Abase number of "(ip)".  For assembler internal use only: this number
+   never appears in binary output.  */
 #define IPREL	32
-  /* For assembler internal use only: this number never appears in binary
-     output.  */
-  { "(ip)", IPREL },
-
-  { NULL, 0 },				/* END OF LIST */
-};
 
-/* Hash tables.  */
-static struct hash_control *op_hash;	/* Opcode mnemonics.  */
-static struct hash_control *reg_hash;	/* Register name hash table.  */
-static struct hash_control *areg_hash;	/* Abase register hash table.  */
+/* Opcode mnemonics, sorted by name for binary search.  The table is
+   grouped by instruction format, so this index is sorted once in
+   md_begin; it excludes the table's terminating NULL entry.  */
+#define OP_COUNT (ARRAY_SIZE (i960_opcodes) - 1)
+static const struct i960_opcode *op_index[OP_COUNT];
 
 /* Architecture for which we are assembling.  */
 #define ARCH_ANY	0	/* Default: no architecture checking done.  */
@@ -454,34 +335,135 @@ static int br_cnt;
 static void ctrl_fmt (const char *, long, int);
 
 
-void
-md_begin (void)
+/* Parse the decimal register index in the LEN characters at P, which
+   must be a plain number no greater than MAX.  Return the index, or -1
+   if P is not such a number.  */
+
+static int
+reg_index (const char *p, size_t len, int max)
 {
-  int i;			/* Loop counter.  */
-  const struct i960_opcode *oP;	/* Pointer into opcode table.  */
-  const char *retval;		/* Value returned by hash functions.  */
+  int n;
+
+  if (len == 0 || len > 2 || (len == 2 && p[0] == '0'))
+    return -1;
+  if (!ISDIGIT (p[0]) || (len == 2 && !ISDIGIT (p[1])))
+    return -1;
+  n = p[0] - '0';
+  if (len == 2)
+    n = n * 10 + p[1] - '0';
+  return n <= max ? n : -1;
+}
+
+/* Return the internal number of the register whose name is the LEN
+   characters at NAME, or -1 if they do not name a register.  */
+
+static int
+reg_lookup (const char *name, size_t len)
+{
+  int n;
+
+  if (len < 2)
+    return -1;
+
+  switch (name[0])
+    {
+    case 'p':
+      if (len == 3 && name[1] == 'f' && name[2] == 'p')
+	return 0;
+      break;
+
+    case 's':
+      if (len == 2 && name[1] == 'p')
+	return 1;
+      if (name[1] == 'f' && (n = reg_index (name + 2, len - 2, 31)) >= 0)
+	return SF0 + n;
+      break;
+
+    case 'r':
+      if (len == 3 && name[1] == 'i' && name[2] == 'p')
+	return 2;
+      /* r0-r2 are only known by their aliases.  */
+      if ((n = reg_index (name + 1, len - 1, 15)) >= 3)
+	return n;
+      break;
+
+    case 'g':
+      /* g15 is only known as fp.  */
+      if ((n = reg_index (name + 1, len - 1, 14)) >= 0)
+	return 16 + n;
+      break;
+
+    case 'f':
+      if (name[1] != 'p')
+	break;
+      if (len == 2)
+	return 31;
+      if ((n = reg_index (name + 2, len - 2, 3)) >= 0)
+	return FP0 + n;
+      break;
+    }
+
+  return -1;
+}
 
-  op_hash = str_htab_create ();
-  reg_hash = str_htab_create ();
-  areg_hash = str_htab_create ();
+/* Return the abase number for the parenthesised register name NAME,
+   e.g. "(g0)", or -1 if NAME is not an abase specification.  */
 
-  /* For some reason, the base assembler uses an empty string for "no
-     error message", instead of a NULL pointer.  */
-  retval = 0;
+static int
+areg_lookup (const char *name)
+{
+  size_t len = strlen (name);
+  int n;
 
-  for (oP = i960_opcodes; oP->name && !retval; oP++)
-    retval = str_hash_insert (op_hash, oP->name, (void *) oP, 0);
+  if (len < 4 || name[0] != '(' || name[len - 1] != ')')
+    return -1;
+  if (len == 4 && name[1] == 'i' && name[2] == 'p')
+    return IPREL;
+  n = reg_lookup (name + 1, len - 2);
+  return IS_RG_REG (n) ? n : -1;
+}
 
-  for (i = 0; regnames[i].reg_name && !retval; i++)
-    retval = str_hash_insert (reg_hash, regnames[i].reg_name,
-			  (char *) &regnames[i].reg_num, 0);
+static int
+op_compare (const void *a, const void *b)
+{
+  const struct i960_opcode *const *opa = a;
+  const struct i960_opcode *const *opb = b;
 
-  for (i = 0; aregs[i].areg_name && !retval; i++)
-    retval = str_hash_insert (areg_hash, aregs[i].areg_name,
-			  (char *) &aregs[i].areg_num, 0);
+  return strcmp ((*opa)->name, (*opb)->name);
+}
 
-  if (retval)
-    as_fatal (_("Hashing returned \"%s\"."), retval);
+static int
+op_key_compare (const void *key, const void *b)
+{
+  const struct i960_opcode *const *opb = b;
+
+  return strcmp ((const char *) key, (*opb)->name);
+}
+
+/* Look up the opcode mnemonic NAME, returning NULL if it is unknown.  */
+
+static const struct i960_opcode *
+op_lookup (const char *name)
+{
+  const struct i960_opcode **oPP;
+
+  oPP = bsearch (name, op_index, OP_COUNT, sizeof (*op_index),
+		 op_key_compare);
+  return oPP != NULL ? *oPP : NULL;
+}
+
+void
+md_begin (void)
+{
+  size_t i;
+
+  for (i = 0; i < OP_COUNT; i++)
+    op_index[i] = &i960_opcodes[i];
+  qsort (op_index, OP_COUNT, sizeof (*op_index), op_compare);
+
+  for (i = 1; i < OP_COUNT; i++)
+    if (strcmp (op_index[i - 1]->name, op_index[i]->name) == 0)
+      as_fatal (_("duplicate opcode \"%s\"."), op_index[i]->name);
 }
 
 /* parse_expr:		parse an expression
@@ -522,7 +504,8 @@ parse_expr (const char *textP,		/* Text of expression to be parsed.  */
 	expP->X_op = O_illegal;
 
       symP = expP->X_add_symbol;
-      if (symP && (str_hash_find (reg_hash, S_GET_NAME (symP))))
+      if (symP && reg_lookup (S_GET_NAME (symP),
+			      strlen (S_GET_NAME (symP))) >= 0)
 	/* Register name in an expression.  */
 	/* FIXME: this isn't much of a check any more.  */
 	expP->X_op = O_illegal;
@@ -693,10 +676,7 @@ targ_has_sfr (int n)		/* Number (0-31) of sfr.  */
 static int
 get_regnum (char *regname)	/* Suspected register name.  */
 {
-  int *rP;
-
-  rP = (int *) str_hash_find (reg_hash, regname);
-  return (rP == NULL) ? -1 : *rP;
+  return reg_lookup (regname, strlen (regname));
 }
 
 /* syntax: Issue a syntax error.  */
@@ -886,7 +866,6 @@ parse_memop (memS *memP,	/* Where to put the results.  */
      (0,1,2,3,4 respectively).  */
   int scale;
   int mode;			/* MEMB mode bits.  */
-  int *intP;			/* Pointer to register number.  */
 
   /* The following table contains the default scale factors for each
      type of memory instruction.  It is accessed using (optype-MEM1)
@@ -974,11 +953,10 @@ parse_memop (memS *memP,	/* Where to put the results.  */
     {
       /* "(" is there -- does it start a legal abase spec?  If not, it
          could be part of a displacement expression.  */
-      intP = (int *) str_hash_find (areg_hash, p);
-      if (intP != NULL)
+      regnum = areg_lookup (p);
+      if (regnum >= 0)
 	{
 	  /* Got an abase here.  */
-	  regnum = *intP;
 	  *p = '\0';		/* Discard register spec.  */
 	  if (regnum == IPREL)
 	    /* We have to special-case ip-rel mode.  */
@@ -1643,7 +1621,7 @@ md_assemble (char *textP)
   /* Look up opcode mnemonic in table and check number of operands.
      Check that opcode is legal for the target architecture.  If all
      looks good, assemble instruction.  */
-  oP = (struct i960_opcode *) str_hash_find (op_hash, args[0]);
+  oP = (struct i960_opcode *) op_lookup (args[0]);
   if (!oP || !targ_has_iclass (oP->iclass))
     as_bad (_("invalid opcode, \"%s\"."), args[0]);
   else if (n_ops != oP->num_ops)
@@ -1884,8 +1862,8 @@ md_show_usage (FILE *stream)
   fprintf (stream, _("\n\
 			specify variant of 960 architecture\n\
 -b			add code to collect statistics about branches taken\n\
--link-relax		preserve individual alignment directives so linker\n\
-			can do relaxing (b.out format only)\n\
+-link-relax		keep branch relocations so the linker can shorten\n\
+			callx to call\n\
 -no-relax		don't alter compare-and-branch instructions for\n\
 			long displacements\n"));
 }
@@ -2368,6 +2346,138 @@ md_pcrel_from (fixS *fixP)
   return fixP->fx_where + fixP->fx_frag->fr_address;
 }
 
+#ifdef OBJ_ELF
+/* With --link-relax the linker deletes the second word of a callx,
+   moving everything after it up to the next R_960_ALIGN (or the end
+   of the section) down by four bytes.  A cobr has no ELF reloc, so
+   gas resolves it itself and records the range it spans; a callx
+   whose deletion would move one end of such a range but not the other
+   is emitted as a plain R_960_32.  The alignment directives that get
+   an R_960_ALIGN are recorded as empty ranges.  */
+
+struct i960_range
+{
+  segT seg;
+  addressT start;
+  addressT end;
+  /* The greatest END of this and the preceding ranges in SEG.  */
+  addressT max_end;
+};
+
+struct i960_range_list
+{
+  struct i960_range *ranges;
+  size_t count;
+  size_t alloc;
+  bool sorted;
+};
+
+static struct i960_range_list cobr_spans;
+static struct i960_range_list align_points;
+
+static void
+add_range (struct i960_range_list *list, segT seg,
+	   addressT start, addressT end)
+{
+  if (list->count == list->alloc)
+    {
+      list->alloc = list->alloc ? list->alloc * 2 : 64;
+      list->ranges = XRESIZEVEC (struct i960_range, list->ranges,
+				 list->alloc);
+    }
+  list->ranges[list->count].seg = seg;
+  list->ranges[list->count].start = start;
+  list->ranges[list->count].end = end;
+  list->count++;
+  list->sorted = false;
+}
+
+static int
+range_compare (const void *a, const void *b)
+{
+  const struct i960_range *ra = a;
+  const struct i960_range *rb = b;
+
+  if (ra->seg->index != rb->seg->index)
+    return ra->seg->index < rb->seg->index ? -1 : 1;
+  if (ra->start != rb->start)
+    return ra->start < rb->start ? -1 : 1;
+  return 0;
+}
+
+/* Return the index of the first range in LIST which is in SEG and
+   starts at or after ADDR, or which is in a later section.  */
+
+static size_t
+range_lower_bound (struct i960_range_list *list, segT seg, addressT addr)
+{
+  size_t lo = 0;
+  size_t hi;
+  size_t i;
+
+  if (!list->sorted)
+    {
+      qsort (list->ranges, list->count, sizeof (*list->ranges),
+	     range_compare);
+      for (i = 0; i < list->count; i++)
+	{
+	  list->ranges[i].max_end = list->ranges[i].end;
+	  if (i > 0
+	      && list->ranges[i - 1].seg == list->ranges[i].seg
+	      && list->ranges[i - 1].max_end > list->ranges[i].max_end)
+	    list->ranges[i].max_end = list->ranges[i - 1].max_end;
+	}
+      list->sorted = true;
+    }
+
+  hi = list->count;
+  while (lo < hi)
+    {
+      size_t mid = lo + (hi - lo) / 2;
+      const struct i960_range *r = &list->ranges[mid];
+
+      if (r->seg->index < seg->index
+	  || (r->seg == seg && r->start < addr))
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+  return lo;
+}
+
+/* Return TRUE if some cobr in SEG spans from before ADDR to ADDR or
+   beyond.  */
+
+static bool
+cobr_spans_p (segT seg, addressT addr)
+{
+  size_t i = range_lower_bound (&cobr_spans, seg, addr);
+
+  return (i > 0
+	  && cobr_spans.ranges[i - 1].seg == seg
+	  && cobr_spans.ranges[i - 1].max_end >= addr);
+}
+
+/* Return TRUE if the linker may shorten the callx whose displacement
+   is at WHERE in SEG.  */
+
+static bool
+i960_callx_relaxable_p (segT seg, addressT where)
+{
+  size_t i;
+
+  /* The displacement word itself is deleted, so WHERE + 4 is the
+     first address to move.  */
+  if (cobr_spans_p (seg, where + 4))
+    return false;
+
+  i = range_lower_bound (&align_points, seg, where + 1);
+  if (i < align_points.count && align_points.ranges[i].seg == seg)
+    return !cobr_spans_p (seg, align_points.ranges[i].start);
+  return true;
+}
+#endif /* OBJ_ELF */
+
 void
 md_apply_fix (fixS *fixP,
 	       valueT *valP,
@@ -2376,7 +2486,9 @@ md_apply_fix (fixS *fixP,
   long val = *valP;
   char *place = fixP->fx_where + fixP->fx_frag->fr_literal;
 
-  if (!fixP->fx_bit_fixP)
+  if (fixP->fx_r_type == BFD_RELOC_I960_ALIGN)
+    ;
+  else if (!fixP->fx_bit_fixP)
     {
       md_number_to_imm (place, val, fixP->fx_size);
     }
@@ -2393,9 +2505,25 @@ md_apply_fix (fixS *fixP,
       fixP->fx_addsy = NULL;
     }
   else
-    md_number_to_field (place, val, fixP->fx_bit_fixP);
+    {
+      md_number_to_field (place, val, fixP->fx_bit_fixP);
+#ifdef OBJ_ELF
+      if (linkrelax
+	  && (int) (size_t) fixP->fx_bit_fixP == 13
+	  && fixP->fx_addsy == NULL)
+	{
+	  addressT where = fixP->fx_frag->fr_address + fixP->fx_where;
 
-  if (fixP->fx_addsy == NULL)
+	  if (val < 0)
+	    add_range (&cobr_spans, seg, where + val, where);
+	  else
+	    add_range (&cobr_spans, seg, where, where + val);
+	}
+#endif
+    }
+
+  /* An R_960_ALIGN has no field, and is always emitted.  */
+  if (fixP->fx_addsy == NULL && fixP->fx_r_type != BFD_RELOC_I960_ALIGN)
     fixP->fx_done = 1;
 }
 
@@ -2563,7 +2691,20 @@ i960_handle_align (fragS *fragp ATTRIBUTE_UNUSED)
   if (!linkrelax)
     return;
 
-#ifndef OBJ_BOUT
+#ifdef OBJ_ELF
+  /* Instructions are all 4 bytes long, so smaller alignments are
+     kept anyway.  Nor does the padding at the end of a section need
+     keeping.  */
+  if ((fragp->fr_type != rs_align && fragp->fr_type != rs_align_code)
+      || fragp->fr_offset <= 2
+      || (bfd_section_flags (now_seg) & SEC_CODE) == 0
+      || (fragp->fr_next->fr_next == NULL && fragp->fr_next->fr_fix == 0))
+    return;
+
+  fix_new (fragp, fragp->fr_fix, 0, NULL, 0, 0, BFD_RELOC_I960_ALIGN);
+  add_range (&align_points, now_seg, fragp->fr_address + fragp->fr_fix,
+	     fragp->fr_address + fragp->fr_fix);
+#elif !defined (OBJ_BOUT)
   as_bad (_("option --link-relax is only supported in b.out format"));
   linkrelax = 0;
   return;
@@ -2601,16 +2742,48 @@ i960_validate_fix (fixS *fixP, segT this_segment_type ATTRIBUTE_UNUSED)
   return 1;
 }
 
+#ifdef OBJ_ELF
+int
+i960_force_relocation_sub (fixS *fixP, segT seg)
+{
+  return (linkrelax
+	  && (bfd_section_flags (seg) & SEC_CODE) != 0
+	  && fixP->fx_size == 4
+	  && !fixP->fx_pcrel
+	  && fixP->fx_bit_fixP == NULL
+	  && fixP->fx_subsy != NULL
+	  && S_GET_SEGMENT (fixP->fx_subsy) == seg);
+}
+#endif
+
 /* From cgen.c:  */
 
 static short
-tc_bfd_fix2rtype (fixS *fixP)
+tc_bfd_fix2rtype (fixS *fixP, segT seg ATTRIBUTE_UNUSED)
 {
+  if (fixP->fx_r_type == BFD_RELOC_I960_ALIGN)
+    return BFD_RELOC_I960_ALIGN;
+
   if (fixP->fx_pcrel == 0 && fixP->fx_size == 4)
-    return BFD_RELOC_32;
+    {
+      /* Let the linker know which displacements belong to a callx
+	 that it may shorten.  */
+      if (fixP->fx_bsr && linkrelax && fixP->fx_subsy == NULL
+#ifdef OBJ_ELF
+	  && i960_callx_relaxable_p (seg, (fixP->fx_frag->fr_address
+					   + fixP->fx_where))
+#endif
+	  )
+	return BFD_RELOC_I960_CALLX;
+      return BFD_RELOC_32;
+    }
 
   if (fixP->fx_pcrel != 0 && fixP->fx_size == 4)
-    return BFD_RELOC_24_PCREL;
+    {
+      if (fixP->fx_tcbit)
+	return BFD_RELOC_I960_CALLJ;
+      return BFD_RELOC_24_PCREL;
+    }
 
   abort ();
   return 0;
@@ -2621,15 +2794,15 @@ tc_bfd_fix2rtype (fixS *fixP)
 
    FIXME: To what extent can we get all relevant targets to use this?  */
 
-arelent *
-tc_gen_reloc (asection *section ATTRIBUTE_UNUSED, fixS *fixP)
+static arelent *
+gen_reloc (asection *section, fixS *fixP)
 {
   arelent * reloc;
 
   reloc = XNEW (arelent);
 
   /* HACK: Is this right?  */
-  fixP->fx_r_type = tc_bfd_fix2rtype (fixP);
+  fixP->fx_r_type = tc_bfd_fix2rtype (fixP, section);
 
   reloc->howto = bfd_reloc_type_lookup (stdoutput, fixP->fx_r_type);
   if (reloc->howto == NULL)
@@ -2638,6 +2811,7 @@ tc_gen_reloc (asection *section ATTRIBUTE_UNUSED, fixS *fixP)
 		    _("internal error: can't export reloc type %d (`%s')"),
 		    fixP->fx_r_type,
 		    bfd_get_reloc_code_name (fixP->fx_r_type));
+      free (reloc);
       return NULL;
     }
 
@@ -2651,6 +2825,39 @@ tc_gen_reloc (asection *section ATTRIBUTE_UNUSED, fixS *fixP)
   return reloc;
 }
 
+#ifdef OBJ_ELF
+arelent **
+tc_gen_reloc (asection *section, fixS *fixP)
+{
+  static arelent *relocs[MAX_RELOC_EXPANSION + 1];
+  arelent * reloc;
+
+  relocs[0] = gen_reloc (section, fixP);
+  relocs[1] = NULL;
+
+  /* The in-place field holds the constant part of A - B + C; R_960_32
+     adds A and R_960_SUB subtracts B.  */
+  if (relocs[0] != NULL && fixP->fx_subsy != NULL)
+    {
+      reloc = XNEW (arelent);
+      reloc->howto = bfd_reloc_type_lookup (stdoutput, BFD_RELOC_I960_SUB);
+      reloc->sym_ptr_ptr = XNEW (asymbol *);
+      *reloc->sym_ptr_ptr = symbol_get_bfdsym (fixP->fx_subsy);
+      reloc->address = relocs[0]->address;
+      reloc->addend = 0;
+      relocs[1] = reloc;
+    }
+
+  return relocs;
+}
+#else
+arelent *
+tc_gen_reloc (asection *section, fixS *fixP)
+{
+  return gen_reloc (section, fixP);
+}
+#endif
+
 /* end from cgen.c */
 
 const pseudo_typeS md_pseudo_table[] =
@@ -119,13 +119,6 @@ struct relocation_info
    visible symbols can be overridden.  */
 #define EXTERN_FORCE_RELOC 0
 
-/* Makes no sense to use the difference of 2 arbitrary symbols
-   as the target of a call instruction.  */
-#define TC_FORCE_RELOCATION_SUB_SAME(FIX, SEG)	\
-  (GENERIC_FORCE_RELOCATION_SUB_SAME (FIX, SEG)	\
-   || (FIX)->fx_tcbit				\
-   || TC_FORCE_RELOCATION (FIX))
-
 /* reloc_callj() may replace a 'call' with a 'calls' or a
    'bal', in which cases it modifies *fixP as appropriate.
    In the case of a 'calls', no further work is required.  */
@@ -135,9 +128,57 @@ extern int reloc_callj (struct fix *);
   (TC_FORCE_RELOCATION (FIX)			\
    || reloc_callj (FIX))
 
+#ifdef OBJ_ELF
+/* With --link-relax the linker may shorten callx instructions, so
+   branches and label differences in code are kept as relocs and
+   alignment directives get an R_960_ALIGN.  Everything else is still
+   fixed up normally.  */
+#define TC_LINKRELAX_FIXUP(SEG) 0
+
+/* Makes no sense to use the difference of 2 arbitrary symbols
+   as the target of a call instruction.  With --link-relax, a 32-bit
+   difference of two labels in a code section is emitted as an
+   R_960_32/R_960_SUB pair, since the linker may delete bytes between
+   them.  */
+extern int i960_force_relocation_sub (struct fix *, segT);
+#define TC_FORCE_RELOCATION_SUB_SAME(FIX, SEG)	\
+  (GENERIC_FORCE_RELOCATION_SUB_SAME (FIX, SEG)	\
+   || (FIX)->fx_tcbit				\
+   || TC_FORCE_RELOCATION (FIX)		\
+   || i960_force_relocation_sub (FIX, SEG))
+#define TC_VALIDATE_FIX_SUB(FIX, SEG) i960_force_relocation_sub (FIX, SEG)
+
+/* Likewise, don't fold such differences while parsing.  */
+#define md_allow_local_subtract(LEFT, RIGHT, SEG)	\
+  (!linkrelax || (bfd_section_flags (SEG) & SEC_CODE) == 0)
+
+/* A difference of two symbols needs a second reloc.  */
+#define RELOC_EXPANSION_POSSIBLE
+#define MAX_RELOC_EXPANSION 2
+
+/* With --link-relax, branches are kept as relocs too.  A cobr has no
+   reloc; gas resolves it and keeps the linker from moving its ends
+   apart (see tc_bfd_fix2rtype).  */
+#define TC_FORCE_RELOCATION_LOCAL(FIX)			\
+  (GENERIC_FORCE_RELOCATION_LOCAL (FIX)			\
+   || (linkrelax && (FIX)->fx_pcrel			\
+       && (FIX)->fx_bit_fixP != (bit_fixS *) 13)	\
+   || reloc_callj (FIX))
+
+/* R_960_ALIGN fixups are made after the rest, when frags are sized.  */
+#define GAS_SORT_RELOCS 1
+#else
+/* Makes no sense to use the difference of 2 arbitrary symbols
+   as the target of a call instruction.  */
+#define TC_FORCE_RELOCATION_SUB_SAME(FIX, SEG)	\
+  (GENERIC_FORCE_RELOCATION_SUB_SAME (FIX, SEG)	\
+   || (FIX)->fx_tcbit				\
+   || TC_FORCE_RELOCATION (FIX))
+
 #define TC_FORCE_RELOCATION_LOCAL(FIX)		\
   (GENERIC_FORCE_RELOCATION_LOCAL (FIX)		\
    || reloc_callj (FIX))
+#endif
 
 #ifdef OBJ_COFF
 
@@ -176,7 +217,9 @@ extern void i960_handle_align (struct frag *);
 extern const struct relax_type md_relax_table[];
 #define TC_GENERIC_RELAX_TABLE md_relax_table
 
+#ifndef OBJ_ELF
 #define LINKER_RELAXING_SHRINKS_ONLY
+#endif
 // i960-elf has an extra structure
 #define TC_FIX_TYPE struct { bit_fixS *bit_fixP; unsigned bsr : 1; }
 #define fx_bsr tc_fix_data.bsr
@@ -0,0 +1,12 @@
+# The Cx mnemonics in the i960 opcode table.
+
+.macro test insn args=""
+\insn\()_:
+	\insn \args
+.endm
+
+	.text
+	test eshro "g5, r9, r13"
+	test sdma "g5, r9, r13"
+	test udma
+	test sysctl "g5, r9, r13"
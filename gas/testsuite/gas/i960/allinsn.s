@@ -0,0 +1,299 @@
+# Every mnemonic in the i960 opcode table except the Cx ones, which
+# may not be mixed with the Kx, floating-point, decimal and MC ones.
+
+.macro test insn args=""
+\insn\()_:
+	\insn \args
+.endm
+
+	.text
+	test callj "target"
+	test b "target"
+	test call "target"
+	test ret
+	test bal "target"
+	test bno "target"
+	test bf "target"
+	test bru "target"
+	test bg "target"
+	test brg "target"
+	test be "target"
+	test bre "target"
+	test bge "target"
+	test brge "target"
+	test bl "target"
+	test brl "target"
+	test bne "target"
+	test brlg "target"
+	test ble "target"
+	test brle "target"
+	test bo "target"
+	test bt "target"
+	test bro "target"
+	test faultno
+	test faultf
+	test faultg
+	test faulte
+	test faultge
+	test faultl
+	test faultne
+	test faultle
+	test faulto
+	test faultt
+	test syscall
+	test testno "g5"
+	test testg "g5"
+	test teste "g5"
+	test testge "g5"
+	test testl "g5"
+	test testne "g5"
+	test testle "g5"
+	test testo "g5"
+	test bbc "5, r9, target"
+	test cmpobg "5, r9, target"
+	test cmpobe "5, r9, target"
+	test cmpobge "5, r9, target"
+	test cmpobl "5, r9, target"
+	test cmpobne "5, r9, target"
+	test cmpoble "5, r9, target"
+	test bbs "5, r9, target"
+	test cmpibno "5, r9, target"
+	test cmpibg "5, r9, target"
+	test cmpibe "5, r9, target"
+	test cmpibge "5, r9, target"
+	test cmpibl "5, r9, target"
+	test cmpibne "5, r9, target"
+	test cmpible "5, r9, target"
+	test cmpibo "5, r9, target"
+	test cmpojg "5, r9, target"
+	test cmpoje "5, r9, target"
+	test cmpojge "5, r9, target"
+	test cmpojl "5, r9, target"
+	test cmpojne "5, r9, target"
+	test cmpojle "5, r9, target"
+	test cmpijno "5, r9, target"
+	test cmpijg "5, r9, target"
+	test cmpije "5, r9, target"
+	test cmpijge "5, r9, target"
+	test cmpijl "5, r9, target"
+	test cmpijne "5, r9, target"
+	test cmpijle "5, r9, target"
+	test cmpijo "5, r9, target"
+	test ldob "0x10(r5), g5"
+	test stob "g5, 0x10(r5)"
+	test bx "0x10(r5)"
+	test balx "0x10(r5), g5"
+	test callx "0x10(r5)"
+	test ldos "0x10(r5), g5"
+	test stos "g5, 0x10(r5)"
+	test lda "0x10(r5), g5"
+	test ld "0x10(r5), g5"
+	test st "g5, 0x10(r5)"
+	test ldl "0x10(r5), r6"
+	test stl "r6, 0x10(r5)"
+	test ldt "0x10(r5), r8"
+	test stt "r8, 0x10(r5)"
+	test ldq "0x10(r5), r8"
+	test stq "r8, 0x10(r5)"
+	test ldib "0x10(r5), g5"
+	test stib "g5, 0x10(r5)"
+	test ldis "0x10(r5), g5"
+	test stis "g5, 0x10(r5)"
+	test notbit "g5, r9, r13"
+	test and "g5, r9, r13"
+	test andnot "g5, r9, r13"
+	test setbit "g5, r9, r13"
+	test notand "g5, r9, r13"
+	test xor "g5, r9, r13"
+	test or "g5, r9, r13"
+	test nor "g5, r9, r13"
+	test xnor "g5, r9, r13"
+	test not "g5, r9"
+	test ornot "g5, r9, r13"
+	test clrbit "g5, r9, r13"
+	test notor "g5, r9, r13"
+	test nand "g5, r9, r13"
+	test alterbit "g5, r9, r13"
+	test addo "g5, r9, r13"
+	test addi "g5, r9, r13"
+	test subo "g5, r9, r13"
+	test subi "g5, r9, r13"
+	test shro "g5, r9, r13"
+	test shrdi "g5, r9, r13"
+	test shri "g5, r9, r13"
+	test shlo "g5, r9, r13"
+	test rotate "g5, r9, r13"
+	test shli "g5, r9, r13"
+	test cmpo "g5, r9"
+	test cmpi "g5, r9"
+	test concmpo "g5, r9"
+	test concmpi "g5, r9"
+	test cmpinco "g5, r9, r13"
+	test cmpinci "g5, r9, r13"
+	test cmpdeco "g5, r9, r13"
+	test cmpdeci "g5, r9, r13"
+	test scanbyte "g5, r9"
+	test chkbit "g5, r9"
+	test addc "g5, r9, r13"
+	test subc "g5, r9, r13"
+	test mov "g5, r9"
+	test movl "r6, g2"
+	test movt "r4, g8"
+	test movq "r4, g8"
+	test atmod "g5, r9, r13"
+	test atadd "g5, r9, r13"
+	test spanbit "g5, r9"
+	test scanbit "g5, r9"
+	test modac "g5, r9, r13"
+	test modify "g5, r9, r13"
+	test extract "g5, r9, r13"
+	test modtc "g5, r9, r13"
+	test modpc "g5, r9, r13"
+	test calls "g5"
+	test mark
+	test fmark
+	test flushreg
+	test syncf
+	test emul "g5, r9, r10"
+	test ediv "g5, g2, r13"
+	test cvtadr "g5, g2"
+	test mulo "g5, r9, r13"
+	test remo "g5, r9, r13"
+	test divo "g5, r9, r13"
+	test muli "g5, r9, r13"
+	test remi "g5, r9, r13"
+	test modi "g5, r9, r13"
+	test divi "g5, r9, r13"
+	test cvtir "g5, fp1"
+	test cvtilr "g5, fp1"
+	test scalerl "g5, fp1, fp2"
+	test scaler "g5, fp1, fp2"
+	test atanr "fp0, fp1, fp2"
+	test logepr "fp0, fp1, fp2"
+	test logr "fp0, fp1, fp2"
+	test remr "fp0, fp1, fp2"
+	test cmpor "fp0, fp1"
+	test cmpr "fp0, fp1"
+	test sqrtr "fp0, fp1"
+	test expr "fp0, fp1"
+	test logbnr "fp0, fp1"
+	test roundr "fp0, fp1"
+	test sinr "fp0, fp1"
+	test cosr "fp0, fp1"
+	test tanr "fp0, fp1"
+	test classr "fp0"
+	test atanrl "fp0, fp1, fp2"
+	test logeprl "fp0, fp1, fp2"
+	test logrl "fp0, fp1, fp2"
+	test remrl "fp0, fp1, fp2"
+	test cmporl "fp0, fp1"
+	test cmprl "fp0, fp1"
+	test sqrtrl "fp0, fp1"
+	test exprl "fp0, fp1"
+	test logbnrl "fp0, fp1"
+	test roundrl "fp0, fp1"
+	test sinrl "fp0, fp1"
+	test cosrl "fp0, fp1"
+	test tanrl "fp0, fp1"
+	test classrl "fp0"
+	test cvtri "fp0, r9"
+	test cvtril "fp0, g2"
+	test cvtzri "fp0, r9"
+	test cvtzril "fp0, g2"
+	test movr "fp0, fp1"
+	test movrl "fp0, fp1"
+	test movre "fp0, fp1"
+	test cpysre "fp0, fp1, fp2"
+	test cpyrsre "fp0, fp1, fp2"
+	test divr "fp0, fp1, fp2"
+	test mulr "fp0, fp1, fp2"
+	test subr "fp0, fp1, fp2"
+	test addr "fp0, fp1, fp2"
+	test divrl "fp0, fp1, fp2"
+	test mulrl "fp0, fp1, fp2"
+	test subrl "fp0, fp1, fp2"
+	test addrl "fp0, fp1, fp2"
+	test brue "target"
+	test brug "target"
+	test bruge "target"
+	test brul "target"
+	test brule "target"
+	test brulg "target"
+	test daddc "g5, r9, r13"
+	test dsubc "g5, r9, r13"
+	test dmovt "g5, r9"
+	test synmov "g5, r9"
+	test synmovl "g5, r9"
+	test synmovq "g5, r9"
+	test synld "g5, r9"
+	test cmpstr "g5, r9, r13"
+	test movqstr "g5, r9, r13"
+	test movstr "g5, r9, r13"
+	test inspacc "g5, r9"
+	test ldphy "g5, r9"
+	test fill "g5, r9, r13"
+	test condrec "g5, r9"
+	test receive "g5, r9"
+	test send "g5, r9, r13"
+	test sendserv "g5"
+	test resumprcs "g5"
+	test schedprcs "g5"
+	test saveprcs
+	test condwait "g5"
+	test wait "g5"
+	test signal "g5"
+	test ldtime "r6"
+	test addono "g5, r9, r13"
+	test addog "g5, r9, r13"
+	test addoe "g5, r9, r13"
+	test addoge "g5, r9, r13"
+	test addol "g5, r9, r13"
+	test addone "g5, r9, r13"
+	test addole "g5, r9, r13"
+	test addoo "g5, r9, r13"
+	test addino "g5, r9, r13"
+	test addig "g5, r9, r13"
+	test addie "g5, r9, r13"
+	test addige "g5, r9, r13"
+	test addil "g5, r9, r13"
+	test addine "g5, r9, r13"
+	test addile "g5, r9, r13"
+	test addio "g5, r9, r13"
+	test bswap "g5, r9"
+	test cmpob "g5, r9"
+	test cmpib "g5, r9"
+	test cmpos "g5, r9"
+	test cmpis "g5, r9"
+	test selno "g5, r9, r13"
+	test selg "g5, r9, r13"
+	test sele "g5, r9, r13"
+	test selge "g5, r9, r13"
+	test sell "g5, r9, r13"
+	test selne "g5, r9, r13"
+	test selle "g5, r9, r13"
+	test selo "g5, r9, r13"
+	test subono "g5, r9, r13"
+	test subog "g5, r9, r13"
+	test suboe "g5, r9, r13"
+	test suboge "g5, r9, r13"
+	test subol "g5, r9, r13"
+	test subone "g5, r9, r13"
+	test subole "g5, r9, r13"
+	test suboo "g5, r9, r13"
+	test subino "g5, r9, r13"
+	test subig "g5, r9, r13"
+	test subie "g5, r9, r13"
+	test subige "g5, r9, r13"
+	test subil "g5, r9, r13"
+	test subine "g5, r9, r13"
+	test subile "g5, r9, r13"
+	test subio "g5, r9, r13"
+	test dcctl "g5, r9, r13"
+	test icctl "g5, r9, r13"
+	test intctl "g5, r9"
+	test intdis
+	test inten
+	test halt "g5"
+	test dcinva "0x10(r5)"
+target:
+	ret
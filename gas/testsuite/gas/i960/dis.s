@@ -0,0 +1,58 @@
+# Each i960 instruction format and the operand forms which the
+# disassembler treats specially.  Encodings which the assembler does not
+# produce are given as words.
+
+	.text
+ctrl:
+	b	cobr
+	ret
+	.word	0x12000012	# be.f: branch predicted not taken
+	.word	0x08000001	# Bit 0 set: invalid
+	.word	0x00000000	# No such opcode
+
+cobr:
+	testno	g5
+	cmpobg	5, r9, mema
+	cmpobg	g4, r9, mema
+	.word	0x32204021	# sf src2
+	.word	0x3a3a6022	# Literal src1, predicted not taken
+	.word	0x28000000	# No such opcode
+
+mema:
+	ld	0x10, g0
+	ld	0x10(r5), g0
+	st	g0, 0x10
+	st	g0, 0x10(r5)
+	callx	0x10
+	callx	0x10(r5)
+
+memb:
+	ld	(r5), g0
+	ld	8(ip), g0
+	ldob	(r5)[r6], g0
+	ld	(r5)[r6*4], g0
+	ld	0x12345, g0
+	ld	0x12345(r5), g0
+	ldob	0x12345[r6], g0
+	ld	0x12345[r6*2], g0
+	ldob	0x12345(r5)[r6], g0
+	ld	0x12345(r5)[r6*8], g0
+	st	g0, (r5)[r6*16]
+	callx	(r5)
+	.word	0x90815800	# Mode 6: invalid
+	.word	0x90815e86	# Scale 5: invalid
+	.word	0x81000000	# No such opcode
+
+reg:
+	and	g4, r9, r13
+	addo	5, 31, r4
+	mov	sf1, g0
+	.word	0x5c083604	# sf dst
+	ldtime	r6
+	mark
+	addr	fp0, 0f1.0, fp1
+	movr	0f0.0, fp2
+	addr	g4, r5, r6
+	.word	0x78082f85	# FP literal other than 0.0 and 1.0
+	.word	0x58000280	# No such opcode
+	.word	0x40000000	# No such format
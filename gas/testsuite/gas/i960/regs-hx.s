@@ -0,0 +1,5 @@
+# The special-function registers which only the Hx has.
+
+	.text
+	mov	sf3, g0
+	mov	sf4, g0
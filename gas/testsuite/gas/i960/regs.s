@@ -0,0 +1,75 @@
+# Every i960 register name, as a REG operand and as an abase.
+
+	.text
+	mov	pfp, g0
+	mov	sp, g0
+	mov	rip, g0
+	mov	r3, g0
+	mov	r4, g0
+	mov	r5, g0
+	mov	r6, g0
+	mov	r7, g0
+	mov	r8, g0
+	mov	r9, g0
+	mov	r10, g0
+	mov	r11, g0
+	mov	r12, g0
+	mov	r13, g0
+	mov	r14, g0
+	mov	r15, g0
+	mov	g0, g0
+	mov	g1, g0
+	mov	g2, g0
+	mov	g3, g0
+	mov	g4, g0
+	mov	g5, g0
+	mov	g6, g0
+	mov	g7, g0
+	mov	g8, g0
+	mov	g9, g0
+	mov	g10, g0
+	mov	g11, g0
+	mov	g12, g0
+	mov	g13, g0
+	mov	g14, g0
+	mov	fp, g0
+	mov	sf0, g0
+	mov	sf1, g0
+	mov	sf2, g0
+	movr	fp0, fp0
+	movr	fp1, fp0
+	movr	fp2, fp0
+	movr	fp3, fp0
+	ld	(pfp), g0
+	ld	(sp), g0
+	ld	(rip), g0
+	ld	(r3), g0
+	ld	(r4), g0
+	ld	(r5), g0
+	ld	(r6), g0
+	ld	(r7), g0
+	ld	(r8), g0
+	ld	(r9), g0
+	ld	(r10), g0
+	ld	(r11), g0
+	ld	(r12), g0
+	ld	(r13), g0
+	ld	(r14), g0
+	ld	(r15), g0
+	ld	(g0), g0
+	ld	(g1), g0
+	ld	(g2), g0
+	ld	(g3), g0
+	ld	(g4), g0
+	ld	(g5), g0
+	ld	(g6), g0
+	ld	(g7), g0
+	ld	(g8), g0
+	ld	(g9), g0
+	ld	(g10), g0
+	ld	(g11), g0
+	ld	(g12), g0
+	ld	(g13), g0
+	ld	(g14), g0
+	ld	(fp), g0
+	ld	4(ip), g0
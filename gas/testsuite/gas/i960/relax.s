@@ -0,0 +1,19 @@
+# The relocs which --link-relax keeps so that the linker can shorten
+# callx.
+
+	.text
+	.globl	start
+start:
+	callj	ext		# R_960_OPTCALL
+	callx	ext		# Shortenable: R_960_OPTCALLX
+	callx	near		# Likewise, even though it is local
+	ld	ext, g0		# Not a callx: R_960_32
+	call	near		# Branches stay relocs
+	b	near
+	.word	near - start	# R_960_32 and R_960_SUB
+	.align	4		# R_960_ALIGN
+near:
+	cmpobe	g0, g1, 1f	# A cobr is resolved here, so the callx
+	callx	ext		# inside it is not shortened
+1:
+	ret
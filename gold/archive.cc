@@ -30,6 +30,7 @@
 #include "filenames.h"
 
 #include "elfcpp.h"
+#include "debug.h"
 #include "options.h"
 #include "mapfile.h"
 #include "fileread.h"
@@ -38,6 +39,7 @@
 #include "object.h"
 #include "layout.h"
 #include "archive.h"
+#include "cache.h"
 #include "plugin.h"
 #include "incremental.h"
 
@@ -190,16 +192,24 @@ const char Archive::sym64name[7] = { '/', 'S', 'Y', 'M', '6', '4', '/' };
 
 Archive::Archive(const std::string& name, Input_file* input_file,
                  bool is_thin_archive, Dirsearch* dirpath, Task* task)
-  : Library_base(task), name_(name), input_file_(input_file), armap_(),
-    armap_names_(), extended_names_(), armap_checked_(), seen_offsets_(),
-    members_(), is_thin_archive_(is_thin_archive), included_member_(false),
-    nested_archives_(), dirpath_(dirpath), num_members_(0),
-    included_all_members_(false)
+  : Library_base(task), name_(name), input_file_(input_file), armap_(NULL),
+    armap_size_(0), armap_names_(NULL), armap_buckets_(NULL),
+    armap_bucket_count_(0), armap_chain_(NULL), armap_storage_(),
+    armap_names_storage_(), armap_index_storage_(), armap_cache_view_(NULL),
+    extended_names_(), armap_checked_(),
+    seen_offsets_(), members_(), is_thin_archive_(is_thin_archive),
+    included_member_(false), nested_archives_(), dirpath_(dirpath),
+    num_members_(0), included_all_members_(false)
 {
   this->no_export_ =
     parameters->options().check_excluded_libs(input_file->found_name());
 }
 
+Archive::~Archive()
+{
+  delete this->armap_cache_view_;
+}
+
 // Set up the archive: read the symbol map and the extended name
 // table.
 
@@ -218,14 +228,21 @@ Archive::setup()
 
   section_size_type armap_size = convert_to_section_size_type(header_size);
   off_t off = sarmag;
-  if (armap_name.empty())
-    {
-      this->read_armap<32>(sarmag + sizeof(Archive_header), armap_size);
-      off = sarmag + sizeof(Archive_header) + armap_size;
-    }
-  else if (armap_name == "/SYM64/")
+  if (armap_name.empty() || armap_name == "/SYM64/")
     {
-      this->read_armap<64>(sarmag + sizeof(Archive_header), armap_size);
+      int mapsize = armap_name.empty() ? 32 : 64;
+      std::string key;
+      std::string cache_file;
+      bool use_cache = this->armap_cache_key(mapsize, &key, &cache_file);
+      if (!use_cache || !this->read_armap_cache(key, cache_file))
+	{
+	  if (mapsize == 32)
+	    this->read_armap<32>(sarmag + sizeof(Archive_header), armap_size);
+	  else
+	    this->read_armap<64>(sarmag + sizeof(Archive_header), armap_size);
+	  if (use_cache)
+	    this->write_armap_cache(key, cache_file);
+	}
       off = sarmag + sizeof(Archive_header) + armap_size;
     }
   else if (!this->input_file_->options().whole_archive())
@@ -301,21 +318,22 @@ Archive::read_armap(off_t start, section_size_type size)
   const char* pnames = reinterpret_cast<const char*>(pword + nsyms);
   section_size_type names_size =
     reinterpret_cast<const char*>(p) + size - pnames;
-  this->armap_names_.assign(pnames, names_size);
+  this->armap_names_storage_.assign(pnames, names_size);
 
-  this->armap_.resize(nsyms);
+  this->armap_storage_.resize(nsyms);
 
   section_offset_type name_offset = 0;
   for (unsigned long i = 0; i < nsyms; ++i)
     {
-      this->armap_[i].name_offset = name_offset;
-      this->armap_[i].file_offset = convert_types<off_t, Entry_type>(
+      Armap_entry* pe = &this->armap_storage_[i];
+      pe->name_offset = name_offset;
+      pe->file_offset = convert_types<off_t, Entry_type>(
         elfcpp::Swap<mapsize, true>::readval(pword));
       name_offset += strlen(pnames + name_offset) + 1;
       ++pword;
-      if (this->armap_[i].file_offset != last_seen_offset)
+      if (pe->file_offset != last_seen_offset)
         {
-          last_seen_offset = this->armap_[i].file_offset;
+          last_seen_offset = pe->file_offset;
           ++this->num_members_;
         }
     }
@@ -324,11 +342,256 @@ Archive::read_armap(off_t start, section_size_type size)
     gold_error(_("%s: bad archive symbol table names"),
 	       this->name().c_str());
 
+  this->armap_ = nsyms == 0 ? NULL : &this->armap_storage_[0];
+  this->armap_size_ = nsyms;
+  this->armap_names_ = this->armap_names_storage_.data();
+
   // This array keeps track of which symbols are for archive elements
   // which we have already included in the link.
   this->armap_checked_.resize(nsyms);
 }
 
+// The archive index cache, enabled by --archive-index-cache, holds a
+// copy of the archive symbol map of each archive in a form which can
+// be mapped and used directly, plus a hash table over the symbol
+// names.  Each cache file is named by a hash of a key made from the
+// archive's real path, modification time and size, and holds the key
+// so that a hash collision is noticed.  The host's byte order and
+// Armap_entry layout are recorded in the header.
+
+// The header of an archive index cache file.  It is followed by the
+// archive map entries, the hash buckets, the hash chain, the key, and
+// the names.
+
+struct Archive_index_cache_header
+{
+  // ARCHIVE_INDEX_CACHE_MAGIC.
+  char magic[8];
+  // ARCHIVE_INDEX_CACHE_BYTE_ORDER in the host byte order.
+  uint32_t byte_order;
+  // The size of an off_t.
+  uint32_t off_t_size;
+  // The size of the key.
+  uint64_t key_size;
+  // The number of archive map entries.
+  uint64_t armap_size;
+  // The number of archive members.
+  uint64_t num_members;
+  // The size of the names, including a trailing null byte.
+  uint64_t names_size;
+  // The number of hash buckets.
+  uint64_t bucket_count;
+};
+
+static const char archive_index_cache_magic[8] =
+{
+  'G', 'O', 'L', 'D', 'A', 'R', 'X', '1'
+};
+
+static const uint32_t archive_index_cache_byte_order = 0x01020304;
+
+// Hash a name in the archive map, ignoring any version.
+
+static inline uint32_t
+armap_index_hash(const char* name)
+{
+  uint32_t h = 2166136261U;
+  for (const char* p = name; *p != '\0' && *p != '@'; ++p)
+    h = (h ^ static_cast<unsigned char>(*p)) * 16777619U;
+  return h;
+}
+
+// Get the key and file name of this archive in the archive index
+// cache.
+
+bool
+Archive::armap_cache_key(int mapsize, std::string* pkey,
+			 std::string* pcache_file)
+{
+#ifndef HAVE_MMAP
+  return false;
+#else
+  const char* cache_dir = parameters->options().archive_index_cache();
+  if (cache_dir == NULL || *cache_dir == '\0')
+    return false;
+
+  char* real_name = lrealpath(this->file().filename().c_str());
+  Timespec mtime = this->file().get_mtime();
+  char buf[100];
+  snprintf(buf, sizeof buf, "%lld.%d %lld %d",
+	   static_cast<long long>(mtime.seconds), mtime.nanoseconds,
+	   static_cast<long long>(this->file().filesize()), mapsize);
+  *pkey = std::string(real_name) + '\0' + buf;
+  free(real_name);
+
+  uint64_t h = 14695981039346656037ULL;
+  for (std::string::const_iterator p = pkey->begin(); p != pkey->end(); ++p)
+    h = (h ^ static_cast<unsigned char>(*p)) * 1099511628211ULL;
+  snprintf(buf, sizeof buf, "/%016llx.armap",
+	   static_cast<unsigned long long>(h));
+  *pcache_file = std::string(cache_dir) + buf;
+  return true;
+#endif
+}
+
+// Read the archive map from the archive index cache.
+
+bool
+Archive::read_armap_cache(const std::string& key,
+			  const std::string& cache_file)
+{
+  Cache_file_view* view = new Cache_file_view();
+  if (!view->map(cache_file)
+      || view->size() < sizeof(Archive_index_cache_header))
+    {
+      delete view;
+      return false;
+    }
+
+  // Check that the file is for this archive, and that all of its
+  // contents are in range.  The sizes are checked against the file
+  // size one at a time so that none of the arithmetic can overflow.
+  const unsigned char* base = view->data();
+  size_t file_size = view->size();
+  const Archive_index_cache_header* hdr =
+    reinterpret_cast<const Archive_index_cache_header*>(base);
+  size_t off = sizeof(Archive_index_cache_header);
+  size_t entries_off = off;
+  size_t buckets_off = 0;
+  size_t chain_off = 0;
+  size_t key_off = 0;
+  size_t names_off = 0;
+  bool ok = (memcmp(hdr->magic, archive_index_cache_magic,
+		    sizeof hdr->magic) == 0
+	     && hdr->byte_order == archive_index_cache_byte_order
+	     && hdr->off_t_size == sizeof(off_t)
+	     && hdr->key_size == key.size()
+	     && hdr->armap_size <= file_size / sizeof(Armap_entry)
+	     && hdr->bucket_count <= file_size / sizeof(uint32_t)
+	     && hdr->bucket_count > 0
+	     && (hdr->bucket_count & (hdr->bucket_count - 1)) == 0
+	     && hdr->names_size > 0
+	     && hdr->names_size <= file_size);
+  if (ok)
+    {
+      off += hdr->armap_size * sizeof(Armap_entry);
+      buckets_off = off;
+      off += hdr->bucket_count * sizeof(uint32_t);
+      chain_off = off;
+      off += hdr->armap_size * sizeof(uint32_t);
+      key_off = off;
+      off += hdr->key_size;
+      names_off = off;
+      off += hdr->names_size;
+      ok = (off == file_size
+	    && memcmp(base + key_off, key.data(), key.size()) == 0
+	    && base[file_size - 1] == '\0');
+    }
+
+  const Armap_entry* entries =
+    reinterpret_cast<const Armap_entry*>(base + entries_off);
+  const uint32_t* buckets =
+    reinterpret_cast<const uint32_t*>(base + buckets_off);
+  const uint32_t* chain = reinterpret_cast<const uint32_t*>(base + chain_off);
+  for (size_t i = 0; ok && i < hdr->armap_size; ++i)
+    ok = (entries[i].name_offset >= 0
+	  && static_cast<uint64_t>(entries[i].name_offset) < hdr->names_size
+	  && chain[i] <= hdr->armap_size);
+  for (size_t i = 0; ok && i < hdr->bucket_count; ++i)
+    ok = buckets[i] <= hdr->armap_size;
+
+  if (!ok)
+    {
+      gold_debug(DEBUG_FILES, "%s: ignoring stale archive index cache %s",
+		 this->name().c_str(), cache_file.c_str());
+      delete view;
+      return false;
+    }
+
+  gold_debug(DEBUG_FILES, "%s: using archive index cache %s",
+	     this->name().c_str(), cache_file.c_str());
+
+  this->armap_cache_view_ = view;
+  this->armap_ = hdr->armap_size == 0 ? NULL : entries;
+  this->armap_size_ = hdr->armap_size;
+  this->armap_names_ = reinterpret_cast<const char*>(base + names_off);
+  this->armap_buckets_ = buckets;
+  this->armap_bucket_count_ = hdr->bucket_count;
+  this->armap_chain_ = chain;
+  this->num_members_ = hdr->num_members;
+  this->armap_checked_.resize(this->armap_size_);
+  return true;
+}
+
+// Build the hash table over the archive map names.
+
+void
+Archive::build_armap_index()
+{
+  size_t bucket_count = 1;
+  while (bucket_count < this->armap_size_)
+    bucket_count <<= 1;
+
+  this->armap_index_storage_.assign(bucket_count + this->armap_size_, 0);
+  uint32_t* buckets = &this->armap_index_storage_[0];
+  uint32_t* chain = buckets + bucket_count;
+
+  // Insert in reverse order so that each chain is in archive map
+  // order.
+  for (size_t i = this->armap_size_; i > 0; --i)
+    {
+      const char* name = this->armap_names_ + this->armap_[i - 1].name_offset;
+      uint32_t* pb = &buckets[armap_index_hash(name) & (bucket_count - 1)];
+      chain[i - 1] = *pb;
+      *pb = static_cast<uint32_t>(i);
+    }
+
+  this->armap_buckets_ = buckets;
+  this->armap_bucket_count_ = bucket_count;
+  this->armap_chain_ = chain;
+}
+
+// Write the archive map to the archive index cache.  Any failure
+// just means that the cache will not be used next time.
+
+void
+Archive::write_armap_cache(const std::string& key,
+			   const std::string& cache_file)
+{
+  // Don't cache a symbol map which we could not read correctly.
+  size_t names_size = this->armap_names_storage_.size();
+  for (size_t i = 0; i < this->armap_size_; ++i)
+    if (static_cast<size_t>(this->armap_[i].name_offset) >= names_size)
+      return;
+
+  this->build_armap_index();
+
+  Archive_index_cache_header hdr;
+  memset(&hdr, 0, sizeof hdr);
+  memcpy(hdr.magic, archive_index_cache_magic, sizeof hdr.magic);
+  hdr.byte_order = archive_index_cache_byte_order;
+  hdr.off_t_size = sizeof(off_t);
+  hdr.key_size = key.size();
+  hdr.armap_size = this->armap_size_;
+  hdr.num_members = this->num_members_;
+  hdr.names_size = names_size + 1;
+  hdr.bucket_count = this->armap_bucket_count_;
+
+  std::vector<Cache_file_part> parts;
+  parts.push_back(Cache_file_part(&hdr, sizeof hdr));
+  parts.push_back(Cache_file_part(this->armap_,
+				  this->armap_size_ * sizeof(Armap_entry)));
+  parts.push_back(Cache_file_part(&this->armap_index_storage_[0],
+				  (this->armap_index_storage_.size()
+				   * sizeof(uint32_t))));
+  parts.push_back(Cache_file_part(key.data(), key.size()));
+  parts.push_back(Cache_file_part(this->armap_names_, names_size + 1));
+  if (!write_cache_file(parameters->options().archive_index_cache(),
+			cache_file, parts))
+    gold_debug(DEBUG_FILES, "%s: cannot write archive index cache %s: %s",
+	       this->name().c_str(), cache_file.c_str(), strerror(errno));
+}
+
 // Read the header of an archive member at OFF.  Fail if something
 // goes wrong.  Return the size of the member.  Set *PNAME to the name
 // of the member.
@@ -783,7 +1046,7 @@ Archive::add_symbols(Symbol_table* symtab, Layout* layout,
 
   input_objects->archive_start(this);
 
-  const size_t armap_size = this->armap_.size();
+  const size_t armap_size = this->armap_size_;
 
   // This is a quick optimization, since we usually see many symbols
   // in a row with the same offset.  last_seen_offset holds the last
@@ -816,7 +1079,7 @@ Archive::add_symbols(Symbol_table* symtab, Layout* layout,
 	      continue;
 	    }
 
-	  const char* sym_name = (this->armap_names_.data()
+	  const char* sym_name = (this->armap_names_
 				  + this->armap_[i].name_offset);
 
           Symbol* sym;
@@ -866,30 +1129,53 @@ Archive::defines_symbol(Symbol* sym) const
 {
   const char* symname = sym->name();
   size_t symname_len = strlen(symname);
-  size_t armap_size = this->armap_.size();
+
+  // If we have a hash table, only look at the entries with the same
+  // name.
+  if (this->armap_buckets_ != NULL)
+    {
+      size_t b = armap_index_hash(symname) & (this->armap_bucket_count_ - 1);
+      for (uint32_t j = this->armap_buckets_[b];
+	   j != 0;
+	   j = this->armap_chain_[j - 1])
+	if (this->armap_entry_defines(j - 1, sym, symname, symname_len))
+	  return true;
+      return false;
+    }
+
+  size_t armap_size = this->armap_size_;
   for (size_t i = 0; i < armap_size; ++i)
+    if (this->armap_entry_defines(i, sym, symname, symname_len))
+      return true;
+  return false;
+}
+
+// Return whether entry I in the archive map defines SYM.
+
+bool
+Archive::armap_entry_defines(size_t i, const Symbol* sym,
+			     const char* symname, size_t symname_len) const
+{
+  if (this->armap_checked_[i])
+    return false;
+  const char* archive_symname = (this->armap_names_
+				 + this->armap_[i].name_offset);
+  if (strncmp(archive_symname, symname, symname_len) != 0)
+    return false;
+  char c = archive_symname[symname_len];
+  if (c == '\0' && sym->version() == NULL)
+    return true;
+  if (c == '@')
     {
-      if (this->armap_checked_[i])
-	continue;
-      const char* archive_symname = (this->armap_names_.data()
-				     + this->armap_[i].name_offset);
-      if (strncmp(archive_symname, symname, symname_len) != 0)
-	continue;
-      char c = archive_symname[symname_len];
-      if (c == '\0' && sym->version() == NULL)
-	return true;
-      if (c == '@')
+      const char* ver = archive_symname + symname_len + 1;
+      if (*ver == '@')
 	{
-	  const char* ver = archive_symname + symname_len + 1;
-	  if (*ver == '@')
-	    {
-	      if (sym->version() == NULL)
-		return true;
-	      ++ver;
-	    }
-	  if (sym->version() != NULL && strcmp(sym->version(), ver) == 0)
+	  if (sym->version() == NULL)
 	    return true;
+	  ++ver;
 	}
+      if (sym->version() != NULL && strcmp(sym->version(), ver) == 0)
+	return true;
     }
   return false;
 }
@@ -1055,6 +1341,10 @@ Archive::include_member(Symbol_table* symtab, Layout* layout,
   {
     Read_symbols_data sd;
     obj->read_symbols(&sd);
+    // With an object cache, the names can be entered using the
+    // cached digests rather than being scanned by add_symbols.
+    if (Object_cache::enabled())
+      obj->intern_symbol_names(symtab, &sd);
     obj->layout(symtab, layout, &sd);
     obj->add_symbols(symtab, &sd, layout);
   }
@@ -1068,13 +1358,12 @@ Archive::include_member(Symbol_table* symtab, Layout* layout,
 void
 Archive::do_for_all_unused_symbols(Symbol_visitor_base* v) const
 {
-  for (std::vector<Armap_entry>::const_iterator p = this->armap_.begin();
-       p != this->armap_.end();
-       ++p)
+  for (size_t i = 0; i < this->armap_size_; ++i)
     {
+      const Armap_entry* p = &this->armap_[i];
       if (this->seen_offsets_.find(p->file_offset)
           == this->seen_offsets_.end())
-        v->visit(this->armap_names_.data() + p->name_offset);
+        v->visit(this->armap_names_ + p->name_offset);
     }
 }
 
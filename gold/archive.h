@@ -42,6 +42,7 @@ class Symbol_table;
 class Object;
 struct Read_symbols_data;
 class Input_file_lib;
+class Cache_file_view;
 class Incremental_archive_entry;
 
 // An entry in the archive map of offsets to members.
@@ -165,6 +166,8 @@ class Archive : public Library_base
   Archive(const std::string& name, Input_file* input_file,
           bool is_thin_archive, Dirsearch* dirpath, Task* task);
 
+  ~Archive();
+
   // The length of the magic string at the start of an archive.
   static const int sarmag = 8;
 
@@ -297,6 +300,34 @@ class Archive : public Library_base
   void
   read_armap(off_t start, section_size_type size);
 
+  // Set *PKEY to the key which identifies this archive, with an
+  // archive symbol map of MAPSIZE bits, in the archive index cache,
+  // and set *PCACHE_FILE to the name of the cache file.  Return false
+  // if the archive index cache is not in use.
+  bool
+  armap_cache_key(int mapsize, std::string* pkey, std::string* pcache_file);
+
+  // Try to read the archive symbol map from CACHE_FILE in the archive
+  // index cache.  Return false if it is not there or is out of date.
+  bool
+  read_armap_cache(const std::string& key, const std::string& cache_file);
+
+  // Write the archive symbol map to CACHE_FILE in the archive index
+  // cache.
+  void
+  write_armap_cache(const std::string& key, const std::string& cache_file);
+
+  // Build the hash table over the archive symbol map names.
+  void
+  build_armap_index();
+
+  // Return whether entry I in the archive symbol map is for a member
+  // which may be included and defines SYM, whose name is SYMNAME of
+  // length SYMNAME_LEN.
+  bool
+  armap_entry_defines(size_t i, const Symbol* sym, const char* symname,
+		      size_t symname_len) const;
+
   // Read an archive member header at OFF.  CACHE is whether to cache
   // the file view.  Return the size of the member, and set *PNAME to
   // the name.
@@ -384,10 +415,28 @@ class Archive : public Library_base
   std::string name_;
   // For reading the file.
   Input_file* input_file_;
-  // The archive map.
-  std::vector<Armap_entry> armap_;
+  // The archive map.  This points either into armap_storage_ or into
+  // a mapped archive index cache file.
+  const Armap_entry* armap_;
+  // The number of entries in the archive map.
+  size_t armap_size_;
   // The names in the archive map.
-  std::string armap_names_;
+  const char* armap_names_;
+  // A hash table over the names in the archive map, or NULL.  There
+  // are armap_bucket_count_ buckets, a power of two.  Each bucket
+  // holds one more than the index of its first archive map entry, or
+  // 0 if it is empty; armap_chain_ holds the following entries in the
+  // same way.
+  const uint32_t* armap_buckets_;
+  size_t armap_bucket_count_;
+  const uint32_t* armap_chain_;
+  // The archive map and names when read from the archive itself.
+  std::vector<Armap_entry> armap_storage_;
+  std::string armap_names_storage_;
+  // The hash table when built here: the buckets followed by the chain.
+  std::vector<uint32_t> armap_index_storage_;
+  // The mapped archive index cache file, if any.
+  Cache_file_view* armap_cache_view_;
   // The extended name table.
   std::string extended_names_;
   // Track which symbols in the archive map are for elements which are
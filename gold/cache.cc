@@ -0,0 +1,285 @@
+// cache.cc -- on-disk caches for gold
+
+// Copyright (C) 2022 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+#include "gold.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+
+#include "debug.h"
+#include "parameters.h"
+#include "options.h"
+#include "symtab.h"
+#include "cache.h"
+
+namespace gold
+{
+
+// Class Cache_file_view.
+
+Cache_file_view::~Cache_file_view()
+{
+  this->unmap();
+}
+
+// Map a cache file.
+
+bool
+Cache_file_view::map(const std::string& filename)
+{
+  gold_assert(this->data_ == NULL);
+#ifndef HAVE_MMAP
+  return false;
+#else
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat st;
+  if (::fstat(fd, &st) < 0 || st.st_size == 0)
+    {
+      ::close(fd);
+      return false;
+    }
+  void* p = ::mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (p == MAP_FAILED)
+    return false;
+  this->data_ = static_cast<const unsigned char*>(p);
+  this->size_ = st.st_size;
+  return true;
+#endif
+}
+
+// Unmap a cache file.
+
+void
+Cache_file_view::unmap()
+{
+#ifdef HAVE_MMAP
+  if (this->data_ != NULL)
+    ::munmap(const_cast<unsigned char*>(this->data_), this->size_);
+#endif
+  this->data_ = NULL;
+  this->size_ = 0;
+}
+
+// Write LEN bytes at P to descriptor FD.  Return false on error.
+
+static bool
+write_cache_bytes(int fd, const void* p, size_t len)
+{
+  const char* pc = static_cast<const char*>(p);
+  while (len > 0)
+    {
+      ssize_t bytes = ::write(fd, pc, len);
+      if (bytes < 0)
+	{
+	  if (errno == EINTR)
+	    continue;
+	  return false;
+	}
+      pc += bytes;
+      len -= bytes;
+    }
+  return true;
+}
+
+// Write a cache file.
+
+bool
+write_cache_file(const char* dir, const std::string& filename,
+		 const std::vector<Cache_file_part>& parts)
+{
+  ::mkdir(dir, 0777);
+
+  std::string tmpl = filename + ".XXXXXX";
+  std::vector<char> tmpname(tmpl.begin(), tmpl.end());
+  tmpname.push_back('\0');
+  int fd = ::mkstemp(&tmpname[0]);
+  if (fd < 0)
+    return false;
+  ::fchmod(fd, 0644);
+
+  bool ok = true;
+  for (std::vector<Cache_file_part>::const_iterator p = parts.begin();
+       ok && p != parts.end();
+       ++p)
+    ok = write_cache_bytes(fd, p->data, p->size);
+  if (::close(fd) < 0)
+    ok = false;
+  if (ok && ::rename(&tmpname[0], filename.c_str()) < 0)
+    ok = false;
+  if (!ok)
+    {
+      int e = errno;
+      ::unlink(&tmpname[0]);
+      errno = e;
+    }
+  return ok;
+}
+
+// The header of an object cache file.  It is followed by an array of
+// Symbol_name_digest, and then by the key.
+
+struct Object_cache_header
+{
+  // OBJECT_CACHE_MAGIC.
+  char magic[8];
+  // OBJECT_CACHE_BYTE_ORDER in the host byte order.
+  uint32_t byte_order;
+  // The size of a symbol name hash code.
+  uint32_t hash_size;
+  // The number of symbols.
+  uint64_t count;
+  // The size of the key.
+  uint64_t key_size;
+  // The fast hash of the digests, to catch a damaged file.
+  unsigned char checksum[16];
+};
+
+static const char object_cache_magic[8] =
+{
+  'G', 'O', 'L', 'D', 'O', 'B', 'C', '1'
+};
+
+static const uint32_t object_cache_byte_order = 0x01020304;
+
+// Class Object_cache.
+
+bool
+Object_cache::enabled()
+{
+  const char* dir = parameters->options().object_cache();
+  return dir != NULL && *dir != '\0';
+}
+
+// The key is a fast hash of the symbols and of the names, their
+// sizes, and the way in which the names are split.  The cache file is
+// named by a hash of the key.
+
+Object_cache::Object_cache(const unsigned char* syms, size_t syms_size,
+			   const char* sym_names, size_t sym_names_size,
+			   bool split_versions)
+  : key_(), filename_(), view_()
+{
+  unsigned char h[16];
+  char buf[200];
+
+  fast_hash_buffer(reinterpret_cast<const char*>(syms), syms_size, h);
+  for (size_t i = 0; i < sizeof h; ++i)
+    snprintf(buf + 2 * i, 3, "%02x", h[i]);
+  this->key_ = buf;
+
+  fast_hash_buffer(sym_names, sym_names_size, h);
+  for (size_t i = 0; i < sizeof h; ++i)
+    snprintf(buf + 2 * i, 3, "%02x", h[i]);
+  this->key_ += buf;
+
+  snprintf(buf, sizeof buf, " %llu %llu %d",
+	   static_cast<unsigned long long>(syms_size),
+	   static_cast<unsigned long long>(sym_names_size),
+	   split_versions ? 1 : 0);
+  this->key_ += buf;
+
+  fast_hash_buffer(this->key_.data(), this->key_.size(), h);
+
+  for (size_t i = 0; i < sizeof h; ++i)
+    snprintf(buf + 2 * i, 3, "%02x", h[i]);
+  this->filename_ = (std::string(parameters->options().object_cache())
+		     + '/' + buf + ".syms");
+}
+
+// Look up the digests.
+
+const Symbol_name_digest*
+Object_cache::find(size_t count)
+{
+  if (!this->view_.map(this->filename_))
+    return NULL;
+
+  const unsigned char* p = this->view_.data();
+  size_t size = this->view_.size();
+  const Object_cache_header* hdr =
+    reinterpret_cast<const Object_cache_header*>(p);
+  const size_t digests_size = count * sizeof(Symbol_name_digest);
+  unsigned char checksum[16];
+  if (size != (sizeof(Object_cache_header) + digests_size
+	       + this->key_.size())
+      || memcmp(hdr->magic, object_cache_magic, sizeof hdr->magic) != 0
+      || hdr->byte_order != object_cache_byte_order
+      || hdr->hash_size != sizeof(size_t)
+      || hdr->count != count
+      || hdr->key_size != this->key_.size()
+      || memcmp(p + sizeof(Object_cache_header) + digests_size,
+		this->key_.data(), this->key_.size()) != 0
+      || memcmp(fast_hash_buffer(reinterpret_cast<const char*>(hdr + 1),
+				 digests_size, checksum),
+		hdr->checksum, sizeof checksum) != 0)
+    {
+      gold_debug(DEBUG_FILES, "ignoring bad object cache file %s",
+		 this->filename_.c_str());
+      this->view_.unmap();
+      return NULL;
+    }
+
+  gold_debug(DEBUG_FILES, "using object cache file %s",
+	     this->filename_.c_str());
+  return reinterpret_cast<const Symbol_name_digest*>(hdr + 1);
+}
+
+// Save the digests.
+
+void
+Object_cache::save(const std::vector<Symbol_name_digest>& digests)
+{
+  Object_cache_header hdr;
+  memset(&hdr, 0, sizeof hdr);
+  memcpy(hdr.magic, object_cache_magic, sizeof hdr.magic);
+  hdr.byte_order = object_cache_byte_order;
+  hdr.hash_size = sizeof(size_t);
+  hdr.count = digests.size();
+  hdr.key_size = this->key_.size();
+
+  const char* data = NULL;
+  if (!digests.empty())
+    data = reinterpret_cast<const char*>(&digests[0]);
+  size_t data_size = digests.size() * sizeof(Symbol_name_digest);
+  fast_hash_buffer(data, data_size, hdr.checksum);
+
+  std::vector<Cache_file_part> parts;
+  parts.push_back(Cache_file_part(&hdr, sizeof hdr));
+  parts.push_back(Cache_file_part(data, data_size));
+  parts.push_back(Cache_file_part(this->key_.data(), this->key_.size()));
+  if (!write_cache_file(parameters->options().object_cache(),
+			this->filename_, parts))
+    gold_debug(DEBUG_FILES, "cannot write object cache file %s: %s",
+	       this->filename_.c_str(), strerror(errno));
+}
+
+} // End namespace gold.
@@ -0,0 +1,150 @@
+// cache.h -- on-disk caches for gold   -*- C++ -*-
+
+// Copyright (C) 2022 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+#ifndef GOLD_CACHE_H
+#define GOLD_CACHE_H
+
+#include <string>
+#include <vector>
+
+namespace gold
+{
+
+struct Symbol_name_digest;
+
+// The linker can keep information which is expensive to compute from
+// its inputs in cache directories, so that later links with the same
+// inputs can reuse it.  Cache files are only meant to be read on the
+// host which wrote them, so they are written in the host's byte
+// order, and are mapped and used in place.  A cache file is written
+// to a temporary name and then renamed, so that a link running at the
+// same time never sees a partial file.  Any failure to read or write
+// a cache file just means that the information is computed again.
+
+// A mapped cache file.
+
+class Cache_file_view
+{
+ public:
+  Cache_file_view()
+    : data_(NULL), size_(0)
+  { }
+
+  ~Cache_file_view();
+
+  // Map FILENAME.  Return false if it can not be mapped.
+  bool
+  map(const std::string& filename);
+
+  // Unmap the file.
+  void
+  unmap();
+
+  // The contents of the file.
+  const unsigned char*
+  data() const
+  { return this->data_; }
+
+  // The size of the file.
+  size_t
+  size() const
+  { return this->size_; }
+
+ private:
+  Cache_file_view(const Cache_file_view&);
+  Cache_file_view& operator=(const Cache_file_view&);
+
+  // The mapped contents, or NULL.
+  const unsigned char* data_;
+  // The size of the mapping.
+  size_t size_;
+};
+
+// A piece of a cache file to be written.
+
+struct Cache_file_part
+{
+  Cache_file_part(const void* d, size_t s)
+    : data(d), size(s)
+  { }
+
+  const void* data;
+  size_t size;
+};
+
+// Write the concatenation of PARTS to FILENAME in the cache
+// directory DIR, which is created if it does not exist.  Return false
+// on failure; ERRNO is set.
+extern bool
+write_cache_file(const char* dir, const std::string& filename,
+		 const std::vector<Cache_file_part>& parts);
+
+// The object cache, enabled by --object-cache, holds a digest of the
+// global symbol names of each relocatable object:  the length of each
+// name without its version, where the version starts, and the hash
+// code which the symbol table uses.  It is keyed by a fast hash of the
+// contents of the object's global symbols and symbol names, which are
+// all that the digests depend on, so an object which is rebuilt or
+// replaced in place never finds the digests of its old names.  The
+// fast hash reads the names in large blocks; on a hit the Read_symbols
+// task can enter them into the symbol table without scanning each one
+// for a version and hashing it.
+
+class Object_cache
+{
+ public:
+  // Return whether --object-cache is in use.
+  static bool
+  enabled();
+
+  // Prepare to look up the digests of an object whose global symbols
+  // are the SYMS_SIZE bytes at SYMS, and whose symbol names are the
+  // SYM_NAMES_SIZE bytes at SYM_NAMES.  SPLIT_VERSIONS is whether
+  // versions are split from the names.
+  Object_cache(const unsigned char* syms, size_t syms_size,
+	       const char* sym_names, size_t sym_names_size,
+	       bool split_versions);
+
+  // Return the cached digests of the COUNT symbols, or NULL if they
+  // are not in the cache.  The result is valid until this object is
+  // destroyed.
+  const Symbol_name_digest*
+  find(size_t count);
+
+  // Save DIGESTS in the cache.
+  void
+  save(const std::vector<Symbol_name_digest>& digests);
+
+ private:
+  Object_cache(const Object_cache&);
+  Object_cache& operator=(const Object_cache&);
+
+  // The full key, which is stored in the cache file.
+  std::string key_;
+  // The name of the cache file.
+  std::string filename_;
+  // The mapped cache file.
+  Cache_file_view view_;
+};
+
+} // End namespace gold.
+
+#endif // !defined(GOLD_CACHE_H)
@@ -22,6 +22,9 @@
 
 #include "gold.h"
 #include <zlib.h>
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
 #include "parameters.h"
 #include "options.h"
 #include "compressed_output.h"
@@ -29,6 +32,16 @@
 namespace gold
 {
 
+// The zlib compression level to use.
+
+static int
+zlib_compress_level()
+{
+  if (parameters->options().optimize() >= 1)
+    return 9;
+  return 1;
+}
+
 // Compress UNCOMPRESSED_DATA of size UNCOMPRESSED_SIZE.  Returns true
 // if it successfully compressed, false if it failed for any reason
 // (including not having zlib support in the library).  If it returns
@@ -48,11 +61,7 @@ zlib_compress(int header_size,
   *compressed_size = uncompressed_size + uncompressed_size / 1000 + 128;
   *compressed_data = new unsigned char[*compressed_size + header_size];
 
-  int compress_level;
-  if (parameters->options().optimize() >= 1)
-    compress_level = 9;
-  else
-    compress_level = 1;
+  int compress_level = zlib_compress_level();
 
   int rc = compress2(reinterpret_cast<Bytef*>(*compressed_data) + header_size,
                      compressed_size,
@@ -72,6 +81,116 @@ zlib_compress(int header_size,
     }
 }
 
+// Compress UNCOMPRESSED_DATA of size UNCOMPRESSED_SIZE as one piece
+// of a larger zlib stream, using raw deflate with no zlib header or
+// trailer.  DICTIONARY_SIZE bytes before UNCOMPRESSED_DATA are the end
+// of the previous piece, and are used to prime the compressor.  If
+// IS_LAST is false the data is ended with a sync flush, so that the
+// next piece can be appended at a byte boundary.  On success this
+// allocates *COMPRESSED_DATA using new and returns true.
+
+static bool
+zlib_compress_chunk(const unsigned char* uncompressed_data,
+		    unsigned long uncompressed_size,
+		    unsigned long dictionary_size,
+		    bool is_last,
+		    unsigned char** compressed_data,
+		    unsigned long* compressed_size)
+{
+  z_stream strm;
+  strm.zalloc = NULL;
+  strm.zfree = NULL;
+  strm.opaque = NULL;
+  if (deflateInit2(&strm, zlib_compress_level(), Z_DEFLATED, -MAX_WBITS,
+		   8, Z_DEFAULT_STRATEGY) != Z_OK)
+    return false;
+
+  if (dictionary_size > 0
+      && deflateSetDictionary(&strm,
+			      reinterpret_cast<const Bytef*>(uncompressed_data
+							     - dictionary_size),
+			      dictionary_size) != Z_OK)
+    {
+      deflateEnd(&strm);
+      return false;
+    }
+
+  // Leave room for the sync flush marker.
+  unsigned long buffer_size = deflateBound(&strm, uncompressed_size) + 16;
+  unsigned char* buffer = new unsigned char[buffer_size];
+
+  strm.next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(
+      uncompressed_data));
+  strm.avail_in = uncompressed_size;
+  strm.next_out = reinterpret_cast<Bytef*>(buffer);
+  strm.avail_out = buffer_size;
+  int rc = deflate(&strm, is_last ? Z_FINISH : Z_SYNC_FLUSH);
+  bool ok = (is_last
+	     ? rc == Z_STREAM_END
+	     : rc == Z_OK && strm.avail_in == 0 && strm.avail_out > 0);
+  unsigned long size = buffer_size - strm.avail_out;
+  deflateEnd(&strm);
+  if (!ok)
+    {
+      delete[] buffer;
+      return false;
+    }
+
+  *compressed_data = buffer;
+  *compressed_size = size;
+  return true;
+}
+
+#ifdef HAVE_ZSTD
+
+// Compress UNCOMPRESSED_DATA of size UNCOMPRESSED_SIZE into a single
+// zstd frame.  A compressed section may hold several frames one after
+// another.  On success this allocates *COMPRESSED_DATA using new and
+// returns true.
+
+static bool
+zstd_compress_chunk(const unsigned char* uncompressed_data,
+		    unsigned long uncompressed_size,
+		    unsigned char** compressed_data,
+		    unsigned long* compressed_size)
+{
+  int compress_level;
+  if (parameters->options().optimize() >= 1)
+    compress_level = ZSTD_CLEVEL_DEFAULT;
+  else
+    compress_level = 1;
+
+  size_t buffer_size = ZSTD_compressBound(uncompressed_size);
+  unsigned char* buffer = new unsigned char[buffer_size];
+  size_t rc = ZSTD_compress(buffer, buffer_size, uncompressed_data,
+			    uncompressed_size, compress_level);
+  if (ZSTD_isError(rc))
+    {
+      delete[] buffer;
+      return false;
+    }
+
+  *compressed_data = buffer;
+  *compressed_size = rc;
+  return true;
+}
+
+// Decompress the zstd frames in COMPRESSED_DATA into
+// UNCOMPRESSED_DATA, which must be filled exactly.
+
+static bool
+zstd_decompress(const unsigned char* compressed_data,
+		unsigned long compressed_size,
+		unsigned char* uncompressed_data,
+		unsigned long uncompressed_size)
+{
+  size_t rc = ZSTD_decompress(uncompressed_data, uncompressed_size,
+			      compressed_data, compressed_size);
+  return !ZSTD_isError(rc) && rc == uncompressed_size;
+}
+
+#endif // defined(HAVE_ZSTD)
+
 // Decompress COMPRESSED_DATA of size COMPRESSED_SIZE, into a buffer
 // UNCOMPRESSED_DATA of size UNCOMPRESSED_SIZE.  Returns TRUE if it
 // decompressed successfully, false if it failed.  The buffer, of
@@ -148,45 +267,39 @@ decompress_input_section(const unsigned char* compressed_data,
   if ((sh_flags & elfcpp::SHF_COMPRESSED) != 0)
     {
       unsigned int compression_header_size;
+      elfcpp::Elf_Word ch_type;
       if (size == 32)
 	{
 	  compression_header_size = elfcpp::Elf_sizes<32>::chdr_size;
 	  if (big_endian)
-	    {
-	      elfcpp::Chdr<32, true> chdr(compressed_data);
-	      if (chdr.get_ch_type() != elfcpp::ELFCOMPRESS_ZLIB)
-		return false;
-	    }
+	    ch_type = elfcpp::Chdr<32, true>(compressed_data).get_ch_type();
 	  else
-	    {
-	      elfcpp::Chdr<32, false> chdr(compressed_data);
-	      if (chdr.get_ch_type() != elfcpp::ELFCOMPRESS_ZLIB)
-		return false;
-	    }
+	    ch_type = elfcpp::Chdr<32, false>(compressed_data).get_ch_type();
 	}
       else if (size == 64)
 	{
 	  compression_header_size = elfcpp::Elf_sizes<64>::chdr_size;
 	  if (big_endian)
-	    {
-	      elfcpp::Chdr<64, true> chdr(compressed_data);
-	      if (chdr.get_ch_type() != elfcpp::ELFCOMPRESS_ZLIB)
-		return false;
-	    }
+	    ch_type = elfcpp::Chdr<64, true>(compressed_data).get_ch_type();
 	  else
-	    {
-	      elfcpp::Chdr<64, false> chdr(compressed_data);
-	      if (chdr.get_ch_type() != elfcpp::ELFCOMPRESS_ZLIB)
-		return false;
-	    }
+	    ch_type = elfcpp::Chdr<64, false>(compressed_data).get_ch_type();
 	}
       else
 	gold_unreachable();
 
-      return zlib_decompress(compressed_data + compression_header_size,
-			     compressed_size - compression_header_size,
-			     uncompressed_data,
-			     uncompressed_size);
+      if (ch_type == elfcpp::ELFCOMPRESS_ZLIB)
+	return zlib_decompress(compressed_data + compression_header_size,
+			       compressed_size - compression_header_size,
+			       uncompressed_data,
+			       uncompressed_size);
+#ifdef HAVE_ZSTD
+      if (ch_type == elfcpp::ELFCOMPRESS_ZSTD)
+	return zstd_decompress(compressed_data + compression_header_size,
+			       compressed_size - compression_header_size,
+			       uncompressed_data,
+			       uncompressed_size);
+#endif
+      return false;
     }
 
   const unsigned int zlib_header_size = 12;
@@ -211,17 +324,17 @@ decompress_input_section(const unsigned char* compressed_data,
 
 // Class Output_compressed_section.
 
-// Set the final data size of a compressed section.  This is where
-// we actually compress the section data.
+const section_size_type Output_compressed_section::chunk_size;
 
-void
-Output_compressed_section::set_final_data_size()
-{
-  off_t uncompressed_size = this->postprocessing_buffer_size();
+// Write the rest of the section contents into the postprocessing
+// buffer, choose the compression format, and divide the buffer into
+// chunks.
 
-  // (Try to) compress the data.
-  unsigned long compressed_size;
-  unsigned char* uncompressed_data = this->postprocessing_buffer();
+unsigned int
+Output_compressed_section::prepare_compression()
+{
+  gold_assert(!this->is_prepared_);
+  this->is_prepared_ = true;
 
   // At this point the contents of all regular input sections will
   // have been copied into the postprocessing buffer, and relocations
@@ -229,16 +342,178 @@ Output_compressed_section::set_final_data_size()
   // anything other than a regular input section.
   this->write_to_postprocessing_buffer();
 
+  const char* compress = this->options_->compress_debug_sections();
+  if (strcmp(compress, "zlib-gnu") == 0)
+    this->compression_ = COMPRESS_GNU_ZLIB;
+  else if (strcmp(compress, "zlib-gabi") == 0
+	   || strcmp(compress, "zlib") == 0)
+    this->compression_ = COMPRESS_GABI_ZLIB;
+  else if (strcmp(compress, "zstd") == 0)
+    this->compression_ = COMPRESS_GABI_ZSTD;
+  else
+    this->compression_ = COMPRESS_NONE;
+
+  if (this->compression_ == COMPRESS_NONE)
+    return 0;
+
+  section_size_type uncompressed_size = this->postprocessing_buffer_size();
+  section_size_type offset = 0;
+  do
+    {
+      Compressed_chunk chunk;
+      chunk.offset = offset;
+      chunk.size = std::min(chunk_size, uncompressed_size - offset);
+      chunk.data = NULL;
+      chunk.compressed_size = 0;
+      chunk.adler = 0;
+      this->chunks_.push_back(chunk);
+      offset += chunk.size;
+    }
+  while (offset < uncompressed_size);
+
+  return this->chunks_.size();
+}
+
+// Compress chunk I.  A section which fits in a single chunk is
+// compressed exactly as it always has been.
+
+void
+Output_compressed_section::compress_chunk(unsigned int i)
+{
+  gold_assert(i < this->chunks_.size());
+  Compressed_chunk* chunk = &this->chunks_[i];
+  const unsigned char* uncompressed_data =
+    this->postprocessing_buffer() + chunk->offset;
+  bool success = false;
+
+  switch (this->compression_)
+    {
+    case COMPRESS_GNU_ZLIB:
+    case COMPRESS_GABI_ZLIB:
+      if (this->chunks_.size() == 1)
+	success = zlib_compress(0, uncompressed_data, chunk->size,
+				&chunk->data, &chunk->compressed_size);
+      else
+	{
+	  unsigned long dictionary_size =
+	    std::min(chunk->offset, static_cast<section_size_type>(32768));
+	  success = zlib_compress_chunk(uncompressed_data, chunk->size,
+					dictionary_size,
+					i + 1 == this->chunks_.size(),
+					&chunk->data, &chunk->compressed_size);
+	  chunk->adler = adler32(adler32(0L, Z_NULL, 0),
+				 reinterpret_cast<const Bytef*>(
+				   uncompressed_data),
+				 chunk->size);
+	}
+      break;
+
+    case COMPRESS_GABI_ZSTD:
+#ifdef HAVE_ZSTD
+      success = zstd_compress_chunk(uncompressed_data, chunk->size,
+				    &chunk->data, &chunk->compressed_size);
+#endif
+      break;
+
+    default:
+      gold_unreachable();
+    }
+
+  if (!success)
+    chunk->data = NULL;
+}
+
+// Join the compressed chunks into this->data_, leaving room for a
+// header of HEADER_SIZE bytes.  This frees the chunks.  Returns false
+// if any chunk failed to compress.
+
+bool
+Output_compressed_section::join_chunks(section_size_type header_size,
+				       unsigned long* compressed_size)
+{
+  bool success = true;
+  unsigned long payload_size = 0;
+  for (std::vector<Compressed_chunk>::const_iterator p = this->chunks_.begin();
+       p != this->chunks_.end();
+       ++p)
+    {
+      if (p->data == NULL)
+	success = false;
+      payload_size += p->compressed_size;
+    }
+
+  // A zlib stream made of several raw deflate pieces needs its own
+  // header and adler32 trailer.
+  bool zlib_wrapper = (this->chunks_.size() > 1
+		       && this->compression_ != COMPRESS_GABI_ZSTD);
+
+  if (success)
+    {
+      *compressed_size = header_size + payload_size;
+      if (zlib_wrapper)
+	*compressed_size += 2 + 4;
+      this->data_ = new unsigned char[*compressed_size];
+
+      unsigned char* pov = this->data_ + header_size;
+      if (zlib_wrapper)
+	{
+	  // CMF: deflate with a 32K window.  FLG: the compression level
+	  // and a check value making the pair a multiple of 31.
+	  *pov++ = 0x78;
+	  *pov++ = zlib_compress_level() == 1 ? 0x01 : 0xda;
+	}
+
+      unsigned long adler = adler32(0L, Z_NULL, 0);
+      for (std::vector<Compressed_chunk>::const_iterator p =
+	     this->chunks_.begin();
+	   p != this->chunks_.end();
+	   ++p)
+	{
+	  memcpy(pov, p->data, p->compressed_size);
+	  pov += p->compressed_size;
+	  adler = adler32_combine(adler, p->adler, p->size);
+	}
+
+      if (zlib_wrapper)
+	{
+	  elfcpp::Swap_unaligned<32, true>::writeval(pov, adler);
+	  pov += 4;
+	}
+      gold_assert(pov == this->data_ + *compressed_size);
+    }
+
+  for (std::vector<Compressed_chunk>::iterator p = this->chunks_.begin();
+       p != this->chunks_.end();
+       ++p)
+    delete[] p->data;
+  this->chunks_.clear();
+
+  return success;
+}
+
+// Set the final data size of a compressed section.  This is where
+// we actually compress the section data, unless Compress_chunk_tasks
+// have already done so.
+
+void
+Output_compressed_section::set_final_data_size()
+{
+  off_t uncompressed_size = this->postprocessing_buffer_size();
+
+  if (!this->is_prepared_)
+    {
+      unsigned int count = this->prepare_compression();
+      for (unsigned int i = 0; i < count; ++i)
+	this->compress_chunk(i);
+    }
+
   bool success = false;
-  enum { none, gnu_zlib, gabi_zlib } compress;
+  unsigned long compressed_size;
   int compression_header_size = 12;
   const int size = parameters->target().get_size();
-  if (strcmp(this->options_->compress_debug_sections(), "zlib-gnu") == 0)
-    compress = gnu_zlib;
-  else if (strcmp(this->options_->compress_debug_sections(), "zlib-gabi") == 0
-	   || strcmp(this->options_->compress_debug_sections(), "zlib") == 0)
+  if (this->compression_ == COMPRESS_GABI_ZLIB
+      || this->compression_ == COMPRESS_GABI_ZSTD)
     {
-      compress = gabi_zlib;
       if (size == 32)
 	compression_header_size = elfcpp::Elf_sizes<32>::chdr_size;
       else if (size == 64)
@@ -246,34 +521,33 @@ Output_compressed_section::set_final_data_size()
       else
 	gold_unreachable();
     }
-  else
-    compress = none;
-  if (compress != none)
-    success = zlib_compress(compression_header_size, uncompressed_data,
-			    uncompressed_size, &this->data_,
-			    &compressed_size);
+  if (this->compression_ != COMPRESS_NONE)
+    success = this->join_chunks(compression_header_size, &compressed_size);
   if (success)
     {
       elfcpp::Elf_Xword flags = this->flags();
-      if (compress == gabi_zlib)
+      if (this->compression_ != COMPRESS_GNU_ZLIB)
 	{
 	  // Set the SHF_COMPRESSED bit.
 	  flags |= elfcpp::SHF_COMPRESSED;
 	  const bool is_big_endian = parameters->target().is_big_endian();
 	  uint64_t addralign = this->addralign();
+	  elfcpp::Elf_Word ch_type = (this->compression_ == COMPRESS_GABI_ZSTD
+				      ? elfcpp::ELFCOMPRESS_ZSTD
+				      : elfcpp::ELFCOMPRESS_ZLIB);
 	  if (size == 32)
 	    {
 	      if (is_big_endian)
 		{
 		  elfcpp::Chdr_write<32, true> chdr(this->data_);
-		  chdr.put_ch_type(elfcpp::ELFCOMPRESS_ZLIB);
+		  chdr.put_ch_type(ch_type);
 		  chdr.put_ch_size(uncompressed_size);
 		  chdr.put_ch_addralign(addralign);
 		}
 	      else
 		{
 		  elfcpp::Chdr_write<32, false> chdr(this->data_);
-		  chdr.put_ch_type(elfcpp::ELFCOMPRESS_ZLIB);
+		  chdr.put_ch_type(ch_type);
 		  chdr.put_ch_size(uncompressed_size);
 		  chdr.put_ch_addralign(addralign);
 		}
@@ -283,7 +557,7 @@ Output_compressed_section::set_final_data_size()
 	      if (is_big_endian)
 		{
 		  elfcpp::Chdr_write<64, true> chdr(this->data_);
-		  chdr.put_ch_type(elfcpp::ELFCOMPRESS_ZLIB);
+		  chdr.put_ch_type(ch_type);
 		  chdr.put_ch_size(uncompressed_size);
 		  chdr.put_ch_addralign(addralign);
 		  // Clear the reserved field.
@@ -292,7 +566,7 @@ Output_compressed_section::set_final_data_size()
 	      else
 		{
 		  elfcpp::Chdr_write<64, false> chdr(this->data_);
-		  chdr.put_ch_type(elfcpp::ELFCOMPRESS_ZLIB);
+		  chdr.put_ch_type(ch_type);
 		  chdr.put_ch_size(uncompressed_size);
 		  chdr.put_ch_addralign(addralign);
 		  // Clear the reserved field.
@@ -317,7 +591,10 @@ Output_compressed_section::set_final_data_size()
     }
   else
     {
-      gold_warning(_("not compressing section data: zlib error"));
+      if (this->compression_ == COMPRESS_GABI_ZSTD)
+	gold_warning(_("not compressing section data: zstd error"));
+      else
+	gold_warning(_("not compressing section data: zlib error"));
       gold_assert(this->data_ == NULL);
       this->set_data_size(uncompressed_size);
     }
@@ -339,4 +616,69 @@ Output_compressed_section::do_write(Output_file* of)
   of->write_output_view(offset, data_size, view);
 }
 
+// Class Compress_sections_task.
+
+// We can only compress once all the input sections have been written.
+
+Task_token*
+Compress_sections_task::is_runnable()
+{
+  if (this->input_sections_blocker_->is_blocked())
+    return this->input_sections_blocker_;
+  return NULL;
+}
+
+// We unlock BLOCKER when finished.  The chunk tasks each hold it as
+// well.
+
+void
+Compress_sections_task::locks(Task_locker* tl)
+{
+  tl->add(this, this->blocker_);
+}
+
+// Divide every compressed section into chunks, and queue a task to
+// compress each chunk.
+
+void
+Compress_sections_task::run(Workqueue* workqueue)
+{
+  std::vector<std::pair<Output_compressed_section*, unsigned int> > chunks;
+  for (std::vector<Output_compressed_section*>::const_iterator p =
+	 this->sections_->begin();
+       p != this->sections_->end();
+       ++p)
+    {
+      if (!(*p)->has_postprocessing_buffer())
+	continue;
+      unsigned int count = (*p)->prepare_compression();
+      for (unsigned int i = 0; i < count; ++i)
+	chunks.push_back(std::make_pair(*p, i));
+    }
+
+  // Add all the blockers before queuing any task, so that BLOCKER
+  // can not be released early.
+  this->blocker_->add_blockers(chunks.size());
+  for (size_t i = 0; i < chunks.size(); ++i)
+    workqueue->queue(new Compress_chunk_task(chunks[i].first,
+					     chunks[i].second,
+					     this->blocker_));
+}
+
+// Class Compress_chunk_task.
+
+void
+Compress_chunk_task::locks(Task_locker* tl)
+{
+  tl->add(this, this->blocker_);
+}
+
+std::string
+Compress_chunk_task::get_name() const
+{
+  char buf[32];
+  snprintf(buf, sizeof buf, " chunk %u", this->chunk_);
+  return std::string("Compress_chunk_task ") + this->os_->name() + buf;
+}
+
 } // End namespace gold.
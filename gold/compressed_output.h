@@ -29,8 +29,10 @@
 #define GOLD_COMPRESSED_OUTPUT_H
 
 #include <string>
+#include <vector>
 
 #include "output.h"
+#include "workqueue.h"
 
 namespace gold
 {
@@ -53,6 +55,13 @@ decompress_input_section(const unsigned char*, unsigned long, unsigned char*,
 // a regular Output_section which computes its contents into a buffer
 // and then postprocesses it.
 
+// Large sections are compressed in independent chunks of a fixed
+// size, which Compress_chunk_tasks can compress in parallel.  The
+// chunks are joined into a single stream: a zlib stream whose deflate
+// blocks end on a sync flush, or a series of zstd frames.  The chunk
+// size does not depend on the number of threads, so the output is
+// the same however the link is run.
+
 class Output_compressed_section : public Output_section
 {
  public:
@@ -60,9 +69,22 @@ class Output_compressed_section : public Output_section
 			    const char* name, elfcpp::Elf_Word flags,
 			    elfcpp::Elf_Xword type)
     : Output_section(name, flags, type),
-      options_(options)
+      options_(options), data_(NULL), compression_(COMPRESS_NONE),
+      chunks_(), is_prepared_(false)
   { this->set_requires_postprocessing(); }
 
+  // Copy everything other than the regular input sections into the
+  // postprocessing buffer, and divide it into chunks to compress.
+  // This must be called after the input sections are written and
+  // before any call to compress_chunk.  Returns the number of chunks.
+  unsigned int
+  prepare_compression();
+
+  // Compress chunk I.  This may run in parallel with other calls to
+  // compress_chunk for the same section.
+  void
+  compress_chunk(unsigned int i);
+
  protected:
   // Set the final data size.
   void
@@ -73,14 +95,125 @@ class Output_compressed_section : public Output_section
   do_write(Output_file*);
 
  private:
+  // The supported compression formats.
+  enum Compression
+  {
+    COMPRESS_NONE,
+    // A .zdebug section with a "ZLIB" header.
+    COMPRESS_GNU_ZLIB,
+    // A SHF_COMPRESSED section, ELFCOMPRESS_ZLIB.
+    COMPRESS_GABI_ZLIB,
+    // A SHF_COMPRESSED section, ELFCOMPRESS_ZSTD.
+    COMPRESS_GABI_ZSTD
+  };
+
+  // One piece of the uncompressed section contents.
+  struct Compressed_chunk
+  {
+    // The offset and size of the piece in the postprocessing buffer.
+    section_size_type offset;
+    section_size_type size;
+    // The compressed data, allocated with new[], or NULL if
+    // compression failed.
+    unsigned char* data;
+    // The size of DATA.
+    unsigned long compressed_size;
+    // The adler32 checksum of the uncompressed piece, used when
+    // joining zlib chunks.
+    unsigned long adler;
+  };
+
+  // The uncompressed size of each chunk other than the last.
+  static const section_size_type chunk_size = 1024 * 1024;
+
+  // Join the compressed chunks into DATA_ behind a header.  Returns
+  // false if any chunk failed to compress.
+  bool
+  join_chunks(section_size_type header_size, unsigned long* compressed_size);
+
   // The options--this includes the compression type.
   const General_options* options_;
   // The compressed data.
   unsigned char* data_;
+  // The compression format, set by prepare_compression.
+  Compression compression_;
+  // The chunks, set by prepare_compression.
+  std::vector<Compressed_chunk> chunks_;
+  // Whether prepare_compression has been called.
+  bool is_prepared_;
   // The new section name if we do compress.
   std::string new_section_name_;
 };
 
+// This task runs after all the input sections have been written, and
+// queues a Compress_chunk_task for each chunk of each compressed
+// output section.  It holds BLOCKER, which is released when all the
+// chunks have been compressed.
+
+class Compress_sections_task : public Task
+{
+ public:
+  Compress_sections_task(const std::vector<Output_compressed_section*>*
+			   sections,
+			 Task_token* input_sections_blocker,
+			 Task_token* blocker)
+    : sections_(sections), input_sections_blocker_(input_sections_blocker),
+      blocker_(blocker)
+  { }
+
+  // The standard Task methods.
+
+  Task_token*
+  is_runnable();
+
+  void
+  locks(Task_locker*);
+
+  void
+  run(Workqueue*);
+
+  std::string
+  get_name() const
+  { return "Compress_sections_task"; }
+
+ private:
+  const std::vector<Output_compressed_section*>* sections_;
+  Task_token* input_sections_blocker_;
+  Task_token* blocker_;
+};
+
+// This task compresses one chunk of a compressed output section.
+
+class Compress_chunk_task : public Task
+{
+ public:
+  Compress_chunk_task(Output_compressed_section* os, unsigned int chunk,
+		      Task_token* blocker)
+    : os_(os), chunk_(chunk), blocker_(blocker)
+  { }
+
+  // The standard Task methods.
+
+  Task_token*
+  is_runnable()
+  { return NULL; }
+
+  void
+  locks(Task_locker*);
+
+  void
+  run(Workqueue*)
+  { this->os_->compress_chunk(this->chunk_); }
+
+  std::string
+  get_name() const;
+
+ private:
+  Output_compressed_section* os_;
+  unsigned int chunk_;
+  Task_token* blocker_;
+};
+
 } // End namespace gold.
 
 #endif // !defined(GOLD_COMPRESSED_OUTPUT_H)
@@ -28,6 +28,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <cerrno>
+#include <unistd.h>
 
 #include <vector>
 #include <algorithm>
@@ -45,6 +46,7 @@
 #include "compressed_output.h"
 #include "stringpool.h"
 #include "dwarf_reader.h"
+#include "workqueue.h"
 
 static void
 usage(FILE* fd, int) ATTRIBUTE_NORETURN;
@@ -99,6 +101,21 @@ struct Unit_set
   { }
 };
 
+// A compilation unit or type unit found in a .debug_info.dwo or
+// .debug_types.dwo input section.
+
+struct Dwo_unit
+{
+  Dwo_unit(section_offset_type o, section_size_type l, uint64_t s)
+    : offset(o), length(l), signature(s)
+  { }
+
+  section_offset_type offset;
+  section_size_type length;
+  uint64_t signature;
+};
+typedef std::vector<Dwo_unit> Unit_list;
+
 // An input file.
 // This class may represent a .dwo file, a .dwp file
 // produced by an earlier run, or an executable file whose
@@ -108,9 +125,15 @@ class Dwo_file
 {
  public:
   Dwo_file(const char* name)
-    : name_(name), obj_(NULL), input_file_(NULL), is_compressed_(),
-      sect_offsets_(), str_offset_map_()
-  { }
+    : name_(name), obj_(NULL), input_file_(NULL), machine_(0), osabi_(0),
+      abiversion_(0), is_compressed_(), sect_offsets_(), debug_types_(),
+      debug_str_(0), debug_cu_index_(0), debug_tu_index_(0), strings_(),
+      str_contents_(NULL), str_contents_is_new_(false), info_units_(),
+      types_units_(), str_offset_map_()
+  {
+    for (unsigned int i = 0; i <= elfcpp::DW_SECT_MAX; i++)
+      this->debug_shndx_[i] = 0;
+  }
 
   ~Dwo_file();
 
@@ -119,9 +142,21 @@ class Dwo_file
   void
   read_executable(File_list* files);
 
-  // Read the input file and send its contents to OUTPUT_FILE.
+  // Read the input file, and find its strings and units.  This does
+  // not touch the output file, so it may run in parallel for several
+  // input files.
+  void
+  read();
+
+  // Send the contents found by read() to OUTPUT_FILE.  The input
+  // files must be added in order.
   void
-  read(Dwp_output_file* output_file);
+  add_to_output(Dwp_output_file* output_file);
+
+  // Return the filename.
+  const char*
+  name() const
+  { return this->name_; }
 
   // Verify a .dwp file given a list of .dwo files referenced by the
   // corresponding executable file.  Returns true if no problems
@@ -135,6 +170,19 @@ class Dwo_file
       Str_offset_map_entry;
   typedef std::vector<Str_offset_map_entry> Str_offset_map;
 
+  // A string in the input string table, with its hash code.
+  struct Dwo_string
+  {
+    Dwo_string(const char* s, size_t l, size_t h)
+      : str(s), len(l), hash(h)
+    { }
+
+    const char* str;
+    size_t len;
+    size_t hash;
+  };
+  typedef std::vector<Dwo_string> String_list;
+
   // A less-than comparison routine for Str_offset_map.
   struct Offset_compare
   {
@@ -198,9 +246,17 @@ class Dwo_file
   bool
   sized_verify_dwo_list(unsigned int, const File_list& files);
 
+  // Split the input string table section into strings.
+  void
+  read_strings();
+
+  // Find the units of a .debug_info.dwo or .debug_types.dwo section.
+  void
+  read_units(unsigned int shndx, bool is_debug_types, Unit_list* units);
+
   // Merge the input string table section into the output file.
   void
-  add_strings(Dwp_output_file*, unsigned int);
+  add_strings(Dwp_output_file*);
 
   // Copy a section from the input file to the output file.
   Section_bounds
@@ -221,10 +277,10 @@ class Dwo_file
   remap_str_offset(section_offset_type val);
 
   // Add a set of .debug_info.dwo or .debug_types.dwo and related sections
-  // to OUTPUT_FILE.
+  // to OUTPUT_FILE.  UNITS are the units found in the section.
   void
   add_unit_set(Dwp_output_file* output_file, unsigned int *debug_shndx,
-	       bool is_debug_types);
+	       bool is_debug_types, const Unit_list& units);
 
   // The filename.
   const char* name_;
@@ -232,10 +288,33 @@ class Dwo_file
   Relobj* obj_;
   // The Input_file object.
   Input_file* input_file_;
+  // ELF header values for the output file.
+  int machine_;
+  int osabi_;
+  int abiversion_;
   // Flags indicating which sections are compressed.
   std::vector<bool> is_compressed_;
   // Map input section index onto output section offset and size.
   std::vector<Section_bounds> sect_offsets_;
+  // The debug sections found by read(), indexed by DW_SECT.
+  unsigned int debug_shndx_[elfcpp::DW_SECT_MAX + 1];
+  // The .debug_types.dwo sections.
+  std::vector<unsigned int> debug_types_;
+  // The .debug_str.dwo section.
+  unsigned int debug_str_;
+  // The .debug_cu_index and .debug_tu_index sections of a .dwp file.
+  unsigned int debug_cu_index_;
+  unsigned int debug_tu_index_;
+  // The strings of the .debug_str.dwo section.
+  String_list strings_;
+  // The contents of the .debug_str.dwo section, which STRINGS_ point
+  // into, and whether we must delete them.
+  const unsigned char* str_contents_;
+  bool str_contents_is_new_;
+  // The units of the .debug_info.dwo section.
+  Unit_list info_units_;
+  // The units of each .debug_types.dwo section in DEBUG_TYPES_.
+  std::vector<Unit_list> types_units_;
   // Map input string offsets to output string offsets.
   Str_offset_map str_offset_map_;
 };
@@ -447,15 +526,16 @@ class Sized_relobj_dwo : public Sized_relobj<size, big_endian>
 class Dwp_output_file
 {
  public:
-  Dwp_output_file(const char* name)
+  Dwp_output_file(const char* name, bool spill_contributions)
     : name_(name), machine_(0), size_(0), big_endian_(false), osabi_(0),
       abiversion_(0), fd_(NULL), next_file_offset_(0), shnum_(1), sections_(),
       section_id_map_(), shoff_(0), shstrndx_(0), have_strings_(false),
       stringpool_(), shstrtab_(), cu_index_(), tu_index_(), last_type_sig_(0),
-      last_tu_slot_(0)
+      last_tu_slot_(0), spill_contributions_(spill_contributions)
   {
     this->section_id_map_.resize(elfcpp::DW_SECT_MAX + 1);
     this->stringpool_.set_no_zero_null();
+    this->stringpool_.set_no_optimize();
   }
 
   // Record the target info from an input file.
@@ -463,11 +543,14 @@ class Dwp_output_file
   record_target_info(const char* name, int machine, int size, bool big_endian,
 		     int osabi, int abiversion);
 
-  // Add a string to the debug strings section.
+  // Add a string to the debug strings section.  HASH is the
+  // Stringpool hash code of the string.
   section_offset_type
-  add_string(const char* str, size_t len);
+  add_string(const char* str, size_t len, size_t hash);
 
   // Add a section to the output file, and return the new section offset.
+  // The contents are written out or copied before this returns, so the
+  // caller keeps ownership of CONTENTS.
   section_offset_type
   add_contribution(elfcpp::DW_SECT section_id, const unsigned char* contents,
 		   section_size_type len, int align);
@@ -498,7 +581,11 @@ class Dwp_output_file
     const unsigned char* contents;
   };
 
-  // Sections in the output file.
+  // Sections in the output file.  We don't know where a section
+  // other than .debug_info.dwo goes until we have seen all of the
+  // input files.  We keep its contributions in memory, or with
+  // --threads write them to a temporary file as we get them, and
+  // copy them into place in finalize().
   struct Section
   {
     const char* name;
@@ -506,9 +593,10 @@ class Dwp_output_file
     section_size_type size;
     int align;
     std::vector<Contribution> contributions;
+    FILE* spill;
 
     Section(const char* n, int a)
-      : name(n), offset(0), size(0), align(a), contributions()
+      : name(n), offset(0), size(0), align(a), contributions(), spill(NULL)
     { }
   };
 
@@ -634,7 +722,7 @@ class Dwp_output_file
 
   // Write the contributions to an output section.
   void
-  write_contributions(const Section& sect);
+  write_contributions(Section& sect);
 
   // Write a CU or TU index section.
   template<bool big_endian>
@@ -677,6 +765,9 @@ class Dwp_output_file
   uint64_t last_type_sig_;
   // Cache of the slot index for the last type signature.
   unsigned int last_tu_slot_;
+  // TRUE if contributions are written to temporary files rather than
+  // kept in memory until finalize().
+  bool spill_contributions_;
 };
 
 // A specialization of Dwarf_info_reader, for reading dwo_names from
@@ -711,23 +802,23 @@ class Dwo_name_info_reader : public Dwarf_info_reader
   File_list* files_;
 };
 
-// A specialization of Dwarf_info_reader, for reading DWARF CUs and TUs
-// and adding them to the output file.
+// A specialization of Dwarf_info_reader, for finding the DWARF CUs
+// and TUs to add to the output file.
 
 class Unit_reader : public Dwarf_info_reader
 {
  public:
   Unit_reader(bool is_type_unit, Relobj* object, unsigned int shndx)
     : Dwarf_info_reader(is_type_unit, object, NULL, 0, shndx, 0, 0),
-      output_file_(NULL), sections_(NULL)
+      units_(NULL)
   { }
 
   ~Unit_reader()
   { }
 
-  // Read the CUs or TUs and add them to the output file.
+  // Read the CUs or TUs and add them to UNITS.
   void
-  add_units(Dwp_output_file*, unsigned int debug_abbrev, Section_bounds*);
+  read_units(unsigned int debug_abbrev, Unit_list* units);
 
  protected:
   // Visit a compilation unit.
@@ -740,8 +831,7 @@ class Unit_reader : public Dwarf_info_reader
 		  uint64_t signature, Dwarf_die*);
 
  private:
-  Dwp_output_file* output_file_;
-  Section_bounds* sections_;
+  Unit_list* units_;
 };
 
 // Return the name of a DWARF .dwo section.
@@ -828,6 +918,8 @@ Sized_relobj_dwo<size, big_endian>::do_section_contents(
 
 Dwo_file::~Dwo_file()
 {
+  if (this->str_contents_is_new_)
+    delete[] this->str_contents_;
   if (this->obj_ != NULL)
     delete this->obj_;
   if (this->input_file_ != NULL)
@@ -880,25 +972,21 @@ Dwo_file::read_executable(File_list* files)
     }
 }
 
-// Read the input file and send its contents to OUTPUT_FILE.
+// Read the input file.  For a .dwo file, we split the string table
+// into strings and find the units of the .debug_info.dwo and
+// .debug_types.dwo sections, so that add_to_output only has to copy
+// things.
 
 void
-Dwo_file::read(Dwp_output_file* output_file)
+Dwo_file::read()
 {
-  this->obj_ = this->make_object(output_file);
+  this->obj_ = this->make_object(NULL);
 
   unsigned int shnum = this->shnum();
   this->is_compressed_.resize(shnum);
   this->sect_offsets_.resize(shnum);
 
-  typedef std::vector<unsigned int> Types_list;
-  Types_list debug_types;
-  unsigned int debug_shndx[elfcpp::DW_SECT_MAX + 1];
-  for (unsigned int i = 0; i <= elfcpp::DW_SECT_MAX; i++)
-    debug_shndx[i] = 0;
-  unsigned int debug_str = 0;
-  unsigned int debug_cu_index = 0;
-  unsigned int debug_tu_index = 0;
+  unsigned int* debug_shndx = this->debug_shndx_;
 
   // Scan the section table and collect debug sections.
   // (Section index 0 is a dummy section; skip it.)
@@ -920,7 +1008,7 @@ Dwo_file::read(Dwp_output_file* output_file)
       if (strcmp(suffix, "info.dwo") == 0)
 	debug_shndx[elfcpp::DW_SECT_INFO] = i;
       else if (strcmp(suffix, "types.dwo") == 0)
-	debug_types.push_back(i);
+	this->debug_types_.push_back(i);
       else if (strcmp(suffix, "abbrev.dwo") == 0)
 	debug_shndx[elfcpp::DW_SECT_ABBREV] = i;
       else if (strcmp(suffix, "line.dwo") == 0)
@@ -928,7 +1016,7 @@ Dwo_file::read(Dwp_output_file* output_file)
       else if (strcmp(suffix, "loc.dwo") == 0)
 	debug_shndx[elfcpp::DW_SECT_LOC] = i;
       else if (strcmp(suffix, "str.dwo") == 0)
-	debug_str = i;
+	this->debug_str_ = i;
       else if (strcmp(suffix, "str_offsets.dwo") == 0)
 	debug_shndx[elfcpp::DW_SECT_STR_OFFSETS] = i;
       else if (strcmp(suffix, "macinfo.dwo") == 0)
@@ -936,45 +1024,73 @@ Dwo_file::read(Dwp_output_file* output_file)
       else if (strcmp(suffix, "macro.dwo") == 0)
 	debug_shndx[elfcpp::DW_SECT_MACRO] = i;
       else if (strcmp(suffix, "cu_index") == 0)
-	debug_cu_index = i;
+	this->debug_cu_index_ = i;
       else if (strcmp(suffix, "tu_index") == 0)
-	debug_tu_index = i;
+	this->debug_tu_index_ = i;
     }
 
+  this->read_strings();
+
+  // A .dwp file has index sections, which we read in add_to_output.
+  if (this->debug_cu_index_ > 0 || this->debug_tu_index_ > 0)
+    return;
+
+  if (debug_shndx[elfcpp::DW_SECT_INFO] > 0)
+    this->read_units(debug_shndx[elfcpp::DW_SECT_INFO], false,
+		     &this->info_units_);
+
+  this->types_units_.resize(this->debug_types_.size());
+  for (unsigned int i = 0; i < this->debug_types_.size(); ++i)
+    this->read_units(this->debug_types_[i], true, &this->types_units_[i]);
+}
+
+// Send the contents of the input file to OUTPUT_FILE.
+
+void
+Dwo_file::add_to_output(Dwp_output_file* output_file)
+{
+  output_file->record_target_info(this->name_, this->machine_,
+				  this->obj_->elfsize(),
+				  this->obj_->is_big_endian(),
+				  this->osabi_, this->abiversion_);
+
+  unsigned int* debug_shndx = this->debug_shndx_;
+
   // Merge the input string table into the output string table.
-  this->add_strings(output_file, debug_str);
+  this->add_strings(output_file);
 
   // If we found any .dwp index sections, read those and add the section
   // sets to the output file.
-  if (debug_cu_index > 0 || debug_tu_index > 0)
+  if (this->debug_cu_index_ > 0 || this->debug_tu_index_ > 0)
     {
-      if (debug_cu_index > 0)
-	this->read_unit_index(debug_cu_index, debug_shndx, output_file, false);
-      if (debug_tu_index > 0)
+      if (this->debug_cu_index_ > 0)
+	this->read_unit_index(this->debug_cu_index_, debug_shndx, output_file,
+			      false);
+      if (this->debug_tu_index_ > 0)
         {
-	  if (debug_types.size() > 1)
+	  if (this->debug_types_.size() > 1)
 	    gold_fatal(_("%s: .dwp file must have no more than one "
 			 ".debug_types.dwo section"), this->name_);
-          if (debug_types.size() == 1)
-            debug_shndx[elfcpp::DW_SECT_TYPES] = debug_types[0];
+          if (this->debug_types_.size() == 1)
+            debug_shndx[elfcpp::DW_SECT_TYPES] = this->debug_types_[0];
           else
             debug_shndx[elfcpp::DW_SECT_TYPES] = 0;
-	  this->read_unit_index(debug_tu_index, debug_shndx, output_file, true);
+	  this->read_unit_index(this->debug_tu_index_, debug_shndx,
+				output_file, true);
 	}
       return;
     }
 
   // If we found no index sections, this is a .dwo file.
   if (debug_shndx[elfcpp::DW_SECT_INFO] > 0)
-    this->add_unit_set(output_file, debug_shndx, false);
+    this->add_unit_set(output_file, debug_shndx, false, this->info_units_);
 
   debug_shndx[elfcpp::DW_SECT_INFO] = 0;
-  for (Types_list::const_iterator tp = debug_types.begin();
-       tp != debug_types.end();
-       ++tp)
+  for (unsigned int i = 0; i < this->debug_types_.size(); ++i)
     {
-      debug_shndx[elfcpp::DW_SECT_TYPES] = *tp;
-      this->add_unit_set(output_file, debug_shndx, true);
+      debug_shndx[elfcpp::DW_SECT_TYPES] = this->debug_types_[i];
+      this->add_unit_set(output_file, debug_shndx, true,
+			 this->types_units_[i]);
     }
 }
 
@@ -1104,6 +1220,9 @@ Dwo_file::sized_make_object(const unsigned char* p, Input_file* input_file,
   Sized_relobj_dwo<size, big_endian>* obj =
       new Sized_relobj_dwo<size, big_endian>(this->name_, input_file, ehdr);
   obj->setup();
+  this->machine_ = ehdr.get_e_machine();
+  this->osabi_ = ehdr.get_ei_osabi();
+  this->abiversion_ = ehdr.get_ei_abiversion();
   if (output_file != NULL)
     output_file->record_target_info(
 	this->name_, ehdr.get_e_machine(), size, big_endian,
@@ -1236,15 +1355,6 @@ Dwo_file::sized_read_unit_index(unsigned int shndx,
 	      info_contents + unit_set->sections[info_sect].offset;
 	  section_size_type unit_length = unit_set->sections[info_sect].size;
 
-	  // Dwp_output_file::add_contribution writes the .debug_info.dwo
-	  // section directly to the output file, so we only need to
-	  // duplicate contributions for .debug_types.dwo section.
-	  if (is_tu_index)
-	    {
-	      unsigned char *copy = new unsigned char[unit_length];
-	      memcpy(copy, unit_start, unit_length);
-	      unit_start = copy;
-	    }
 	  section_offset_type off =
 	      output_file->add_contribution(info_sect, unit_start,
 					    unit_length, 1);
@@ -1360,14 +1470,17 @@ Dwo_file::sized_verify_dwo_list(unsigned int shndx, const File_list& files)
   return nmissing == 0;
 }
 
-// Merge the input string table section into the output file.
+// Split the input string table section into strings, and compute
+// their hash codes.
 
 void
-Dwo_file::add_strings(Dwp_output_file* output_file, unsigned int debug_str)
+Dwo_file::read_strings()
 {
   section_size_type len;
-  bool is_new;
-  const unsigned char* pdata = this->section_contents(debug_str, &len, &is_new);
+  const unsigned char* pdata =
+      this->section_contents(this->debug_str_, &len,
+			     &this->str_contents_is_new_);
+  this->str_contents_ = pdata;
   const char* p = reinterpret_cast<const char*>(pdata);
   const char* pend = p + len;
 
@@ -1376,30 +1489,64 @@ Dwo_file::add_strings(Dwp_output_file* output_file, unsigned int debug_str)
     gold_fatal(_("%s: last entry in string section '%s' "
 		 "is not null terminated"),
 	       this->name_,
-	       this->section_name(debug_str).c_str());
+	       this->section_name(this->debug_str_).c_str());
 
-  // Count the number of strings in the section, and size the map.
+  // Count the number of strings in the section, and size the list.
   size_t count = 0;
   for (const char* pt = p; pt < pend; pt += strlen(pt) + 1)
     ++count;
-  this->str_offset_map_.reserve(count + 1);
+  this->strings_.reserve(count);
+
+  while (p < pend)
+    {
+      size_t len = strlen(p);
+      this->strings_.push_back(Dwo_string(p, len,
+					  Stringpool::hash_string(p, len)));
+      p += len + 1;
+    }
+}
+
+// Merge the input string table section into the output file.
+
+void
+Dwo_file::add_strings(Dwp_output_file* output_file)
+{
+  this->str_offset_map_.reserve(this->strings_.size() + 1);
 
   // Add the strings to the output string table, and record the new offsets
   // in the map.
   section_offset_type i = 0;
   section_offset_type new_offset;
-  while (p < pend)
+  for (String_list::const_iterator p = this->strings_.begin();
+       p != this->strings_.end();
+       ++p)
     {
-      size_t len = strlen(p);
-      new_offset = output_file->add_string(p, len);
+      new_offset = output_file->add_string(p->str, p->len, p->hash);
       this->str_offset_map_.push_back(std::make_pair(i, new_offset));
-      p += len + 1;
-      i += len + 1;
+      i += p->len + 1;
     }
   new_offset = 0;
   this->str_offset_map_.push_back(std::make_pair(i, new_offset));
-  if (is_new)
-    delete[] pdata;
+
+  // We don't need the strings any more.
+  String_list().swap(this->strings_);
+  if (this->str_contents_is_new_)
+    delete[] this->str_contents_;
+  this->str_contents_ = NULL;
+  this->str_contents_is_new_ = false;
+}
+
+// Find the units of a .debug_info.dwo or .debug_types.dwo section.
+
+void
+Dwo_file::read_units(unsigned int shndx, bool is_debug_types,
+		     Unit_list* units)
+{
+  if (this->debug_shndx_[elfcpp::DW_SECT_ABBREV] == 0)
+    gold_fatal(_("%s: no .debug_abbrev.dwo section found"), this->name_);
+
+  Unit_reader reader(is_debug_types, this->obj_, shndx);
+  reader.read_units(this->debug_shndx_[elfcpp::DW_SECT_ABBREV], units);
 }
 
 // Copy a section from the input file to the output file.
@@ -1418,8 +1565,8 @@ Dwo_file::copy_section(Dwp_output_file* output_file, unsigned int shndx,
 
   // Get the section contents. Upon return, if IS_NEW is true, the memory
   // has been allocated via new; if false, the memory is part of the mapped
-  // input file, and we will need to duplicate it so that it will persist
-  // after we close the input file.
+  // input file.  Either way, the output file writes the contents out
+  // before add_contribution returns, so we don't need to copy them.
   section_size_type len;
   bool is_new;
   const unsigned char* contents = this->section_contents(shndx, &len, &is_new);
@@ -1430,18 +1577,14 @@ Dwo_file::copy_section(Dwp_output_file* output_file, unsigned int shndx,
       if (is_new)
 	delete[] contents;
       contents = remapped;
-    }
-  else if (!is_new)
-    {
-      unsigned char* copy = new unsigned char[len];
-      memcpy(copy, contents, len);
-      contents = copy;
+      is_new = true;
     }
 
   // Add the contents of the input section to the output section.
-  // The output file takes ownership of the memory pointed to by CONTENTS.
   section_offset_type off = output_file->add_contribution(section_id, contents,
 							  len, 1);
+  if (is_new)
+    delete[] contents;
 
   // Store the output section bounds.
   Section_bounds bounds(off, len);
@@ -1512,7 +1655,7 @@ Dwo_file::remap_str_offset(section_offset_type val)
 
 void
 Dwo_file::add_unit_set(Dwp_output_file* output_file, unsigned int *debug_shndx,
-		       bool is_debug_types)
+		       bool is_debug_types, const Unit_list& units)
 {
   unsigned int shndx = (is_debug_types
 			? debug_shndx[elfcpp::DW_SECT_TYPES]
@@ -1532,13 +1675,41 @@ Dwo_file::add_unit_set(Dwp_output_file* output_file, unsigned int *debug_shndx,
 					 static_cast<elfcpp::DW_SECT>(i));
     }
 
-  // Parse the .debug_info or .debug_types section and add each compilation
-  // or type unit to the output file, along with the contributions to the
-  // related sections.
-  Unit_reader reader(is_debug_types, this->obj_, shndx);
-  reader.add_units(output_file, debug_shndx[elfcpp::DW_SECT_ABBREV], sections);
+  // Add each compilation or type unit to the output file, along with the
+  // contributions to the related sections.
+  section_size_type len;
+  bool is_new;
+  const unsigned char* contents = this->section_contents(shndx, &len, &is_new);
+  elfcpp::DW_SECT unit_sect = (is_debug_types
+			       ? elfcpp::DW_SECT_TYPES
+			       : elfcpp::DW_SECT_INFO);
+  for (Unit_list::const_iterator p = units.begin(); p != units.end(); ++p)
+    {
+      // Skip type units we have already seen.
+      if (is_debug_types && output_file->lookup_tu(p->signature))
+	continue;
+
+      Unit_set* unit_set = new Unit_set();
+      unit_set->signature = p->signature;
+      for (unsigned int i = elfcpp::DW_SECT_ABBREV;
+	   i <= elfcpp::DW_SECT_MAX;
+	   ++i)
+	unit_set->sections[i] = sections[i];
+
+      section_offset_type off =
+	  output_file->add_contribution(unit_sect, contents + p->offset,
+					p->length, 1);
+      unit_set->sections[unit_sect] = Section_bounds(off, p->length);
+      if (is_debug_types)
+	output_file->add_tu_set(unit_set);
+      else
+	output_file->add_cu_set(unit_set);
+    }
+  if (is_new)
+    delete[] contents;
 }
 
+
 // Class Dwp_output_file.
 
 // Record the target info from an input file.  On first call, we
@@ -1582,14 +1753,14 @@ Dwp_output_file::record_target_info(const char*, int machine,
 // Add a string to the debug strings section.
 
 section_offset_type
-Dwp_output_file::add_string(const char* str, size_t len)
+Dwp_output_file::add_string(const char* str, size_t len, size_t hash)
 {
   Stringpool::Key key;
-  this->stringpool_.add_with_length(str, len, true, &key);
+  this->stringpool_.add_with_hash(str, len, hash, true, &key);
   this->have_strings_ = true;
   // We aren't supposed to call get_offset() until after
   // calling set_string_offsets(), but the offsets will
-  // not change unless optimizing the string pool.
+  // not change because we don't optimize the string pool.
   return this->stringpool_.get_offset_from_key(key);
 }
 
@@ -1614,9 +1785,11 @@ Dwp_output_file::add_output_section(const char* section_name, int align)
 // Add a contribution to a section in the output file, and return the offset
 // of the contribution within the output section.  The .debug_info.dwo section
 // is expected to be the largest one, so we will write the contents of this
-// section directly to the output file as we receive contributions, allowing
-// us to free that memory as soon as possible. We will save the remaining
-// contributions until we finalize the layout of the output file.
+// section directly to the output file as we receive contributions.  We save
+// copies of the remaining contributions until we finalize the layout of the
+// output file.  With --threads, several input files are held in memory at
+// once, so we write the remaining contributions to a temporary file for each
+// section instead, and copy them into the output file in finalize().
 
 section_offset_type
 Dwp_output_file::add_contribution(elfcpp::DW_SECT section_id,
@@ -1668,22 +1841,46 @@ Dwp_output_file::add_contribution(elfcpp::DW_SECT section_id,
       section_offset = file_offset - section.offset;
       section.size = file_offset + len - section.offset;
 
-      ::fseek(this->fd_, file_offset, SEEK_SET);
+      if (::fseek(this->fd_, file_offset, SEEK_SET) != 0)
+	gold_fatal(_("%s: %s"), this->name_, strerror(errno));
       if (::fwrite(contents, 1, len, this->fd_) < len)
 	gold_fatal(_("%s: error writing section '%s'"), this->name_,
 		   section_name);
       this->next_file_offset_ = file_offset + len;
     }
-  else
+  else if (!this->spill_contributions_)
     {
-      // Collect the contributions and keep track of the total size.
+      // Collect a copy of the contribution and keep track of the
+      // total size.
       if (align > section.align)
 	section.align = align;
       section_offset = align_offset(section.size, align);
       section.size = section_offset + len;
-      Contribution contrib = { section_offset, len, contents };
+      unsigned char* copy = new unsigned char[len];
+      memcpy(copy, contents, len);
+      Contribution contrib = { section_offset, len, copy };
       section.contributions.push_back(contrib);
     }
+  else
+    {
+      // Spill the contribution and keep track of the total size.
+      if (align > section.align)
+	section.align = align;
+      section_offset = align_offset(section.size, align);
+      section.size = section_offset + len;
+      if (section.spill == NULL)
+	{
+	  section.spill = ::tmpfile();
+	  if (section.spill == NULL)
+	    gold_fatal(_("%s: cannot create temporary file: %s"),
+		       this->name_, strerror(errno));
+	}
+      if (::fseek(section.spill, section_offset, SEEK_SET) != 0)
+	gold_fatal(_("%s: temporary file: %s"), this->name_, strerror(errno));
+      if (::fwrite(contents, 1, len, section.spill) < len)
+	gold_fatal(_("%s: error writing section '%s' to temporary file"),
+		   this->name_, section_name);
+    }
 
   return section_offset;
 }
@@ -1927,19 +2124,47 @@ Dwp_output_file::finalize()
   this->fd_ = NULL;
 }
 
-// Write the contributions to an output section.
+// Write the contributions to an output section, from memory or by
+// copying them from the temporary file for the section.
 
 void
-Dwp_output_file::write_contributions(const Section& sect)
+Dwp_output_file::write_contributions(Section& sect)
 {
   for (unsigned int i = 0; i < sect.contributions.size(); ++i)
     {
       const Contribution& c = sect.contributions[i];
-      ::fseek(this->fd_, sect.offset + c.output_offset, SEEK_SET);
+      if (::fseek(this->fd_, sect.offset + c.output_offset, SEEK_SET) != 0)
+	gold_fatal(_("%s: %s"), this->name_, strerror(errno));
       if (::fwrite(c.contents, 1, c.size, this->fd_) < c.size)
 	gold_fatal(_("%s: error writing section '%s'"), this->name_, sect.name);
       delete[] c.contents;
     }
+  std::vector<Contribution>().swap(sect.contributions);
+
+  if (sect.spill == NULL)
+    return;
+
+  const section_size_type buf_size = 1024 * 1024;
+  unsigned char* buf = new unsigned char[buf_size];
+  if (::fseek(sect.spill, 0, SEEK_SET) != 0)
+    gold_fatal(_("%s: temporary file: %s"), this->name_, strerror(errno));
+  if (::fseek(this->fd_, sect.offset, SEEK_SET) != 0)
+    gold_fatal(_("%s: %s"), this->name_, strerror(errno));
+  section_size_type left = sect.size;
+  while (left > 0)
+    {
+      section_size_type len = std::min(left, buf_size);
+      if (::fread(buf, 1, len, sect.spill) < len)
+	gold_fatal(_("%s: error reading section '%s' from temporary file"),
+		   this->name_, sect.name);
+      if (::fwrite(buf, 1, len, this->fd_) < len)
+	gold_fatal(_("%s: error writing section '%s'"), this->name_, sect.name);
+      left -= len;
+    }
+  delete[] buf;
+
+  ::fclose(sect.spill);
+  sect.spill = NULL;
 }
 
 // Write a new section to the output file.
@@ -2220,15 +2445,12 @@ Dwo_name_info_reader::visit_compilation_unit(off_t, off_t, Dwarf_die* die)
 
 // Class Unit_reader.
 
-// Read the CUs or TUs and add them to the output file.
+// Read the CUs or TUs and add them to UNITS.
 
 void
-Unit_reader::add_units(Dwp_output_file* output_file,
-		       unsigned int debug_abbrev,
-		       Section_bounds* sections)
+Unit_reader::read_units(unsigned int debug_abbrev, Unit_list* units)
 {
-  this->output_file_ = output_file;
-  this->sections_ = sections;
+  this->units_ = units;
   this->set_abbrev_shndx(debug_abbrev);
   this->parse();
 }
@@ -2241,21 +2463,8 @@ Unit_reader::visit_compilation_unit(off_t, off_t cu_length, Dwarf_die* die)
   if (cu_length == 0)
     return;
 
-  Unit_set* unit_set = new Unit_set();
-  unit_set->signature = die->uint_attribute(elfcpp::DW_AT_GNU_dwo_id);
-  for (unsigned int i = elfcpp::DW_SECT_ABBREV; i <= elfcpp::DW_SECT_MAX; ++i)
-    unit_set->sections[i] = this->sections_[i];
-
-  // Dwp_output_file::add_contribution writes the .debug_info.dwo section
-  // directly to the output file, so we do not need to duplicate the
-  // section contents, and add_contribution does not need to free the memory.
-  section_offset_type off =
-      this->output_file_->add_contribution(elfcpp::DW_SECT_INFO,
-					   this->buffer_at_offset(0),
-					   cu_length, 1);
-  Section_bounds bounds(off, cu_length);
-  unit_set->sections[elfcpp::DW_SECT_INFO] = bounds;
-  this->output_file_->add_cu_set(unit_set);
+  uint64_t dwo_id = die->uint_attribute(elfcpp::DW_AT_GNU_dwo_id);
+  this->units_->push_back(Dwo_unit(this->cu_offset(), cu_length, dwo_id));
 }
 
 // Visit a type unit.
@@ -2266,22 +2475,176 @@ Unit_reader::visit_type_unit(off_t, off_t tu_length, off_t,
 {
   if (tu_length == 0)
     return;
-  if (this->output_file_->lookup_tu(signature))
-    return;
 
-  Unit_set* unit_set = new Unit_set();
-  unit_set->signature = signature;
-  for (unsigned int i = elfcpp::DW_SECT_ABBREV; i <= elfcpp::DW_SECT_MAX; ++i)
-    unit_set->sections[i] = this->sections_[i];
-
-  unsigned char* contents = new unsigned char[tu_length];
-  memcpy(contents, this->buffer_at_offset(0), tu_length);
-  section_offset_type off =
-      this->output_file_->add_contribution(elfcpp::DW_SECT_TYPES, contents,
-					   tu_length, 1);
-  Section_bounds bounds(off, tu_length);
-  unit_set->sections[elfcpp::DW_SECT_TYPES] = bounds;
-  this->output_file_->add_tu_set(unit_set);
+  this->units_->push_back(Dwo_unit(this->cu_offset(), tu_length, signature));
+}
+
+// Class Dwo_read_task.
+
+// This task reads an input file.  These tasks run in parallel, but
+// are held back by WINDOW_BLOCKER, if any, so that they run only a
+// limited number of files ahead of the Dwo_add_tasks, which must add
+// the files to the output file in order.
+
+class Dwo_read_task : public Task
+{
+ public:
+  Dwo_read_task(Dwo_file* dwo_file, Task_token* window_blocker,
+		Task_token* read_blocker)
+    : dwo_file_(dwo_file), window_blocker_(window_blocker),
+      read_blocker_(read_blocker)
+  { }
+
+  // The standard Task methods.
+
+  Task_token*
+  is_runnable()
+  {
+    if (this->window_blocker_ != NULL && this->window_blocker_->is_blocked())
+      return this->window_blocker_;
+    return NULL;
+  }
+
+  void
+  locks(Task_locker* tl)
+  { tl->add(this, this->read_blocker_); }
+
+  void
+  run(Workqueue*)
+  {
+    // We are the only task waiting for the window blocker.
+    delete this->window_blocker_;
+    this->dwo_file_->read();
+  }
+
+  std::string
+  get_name() const
+  { return std::string("Dwo_read_task ") + this->dwo_file_->name(); }
+
+ private:
+  Dwo_file* dwo_file_;
+  Task_token* window_blocker_;
+  Task_token* read_blocker_;
+};
+
+// Class Dwo_add_task.
+
+// This task adds an input file to the output file, once the file has
+// been read and the previous file has been added.
+
+class Dwo_add_task : public Task
+{
+ public:
+  Dwo_add_task(Dwo_file* dwo_file, Dwp_output_file* output_file,
+	       bool verbose, Task_token* read_blocker,
+	       Task_token* this_blocker, Task_token* next_blocker,
+	       Task_token* window_blocker)
+    : dwo_file_(dwo_file), output_file_(output_file), verbose_(verbose),
+      read_blocker_(read_blocker), this_blocker_(this_blocker),
+      next_blocker_(next_blocker), window_blocker_(window_blocker)
+  { }
+
+  // The standard Task methods.
+
+  Task_token*
+  is_runnable()
+  {
+    if (this->this_blocker_ != NULL && this->this_blocker_->is_blocked())
+      return this->this_blocker_;
+    if (this->read_blocker_->is_blocked())
+      return this->read_blocker_;
+    return NULL;
+  }
+
+  void
+  locks(Task_locker* tl)
+  {
+    tl->add(this, this->next_blocker_);
+    if (this->window_blocker_ != NULL)
+      tl->add(this, this->window_blocker_);
+  }
+
+  void
+  run(Workqueue*)
+  {
+    if (this->verbose_)
+      fprintf(stderr, "%s\n", this->dwo_file_->name());
+    this->dwo_file_->add_to_output(this->output_file_);
+    delete this->dwo_file_;
+    delete this->read_blocker_;
+    delete this->this_blocker_;
+  }
+
+  std::string
+  get_name() const
+  { return std::string("Dwo_add_task ") + this->dwo_file_->name(); }
+
+ private:
+  Dwo_file* dwo_file_;
+  Dwp_output_file* output_file_;
+  bool verbose_;
+  Task_token* read_blocker_;
+  Task_token* this_blocker_;
+  Task_token* next_blocker_;
+  Task_token* window_blocker_;
+};
+
+// Read the input files in parallel with THREAD_COUNT threads, and add
+// them to OUTPUT_FILE in order.
+
+static void
+process_files_in_parallel(const File_list& files,
+			  Dwp_output_file* output_file,
+			  int thread_count, bool verbose)
+{
+  const size_t nfiles = files.size();
+
+  // Let each thread have a couple of files read ahead of the file
+  // being added, but no more, so that we don't hold the contents of
+  // every input file at once.
+  const size_t window = 2 * thread_count;
+
+  // Create all of the blockers before queuing any task.  WINDOW_BLOCKERS[I]
+  // is released when file I has been added, and holds back the reading
+  // of file I + WINDOW.
+  std::vector<Task_token*> read_blockers(nfiles);
+  std::vector<Task_token*> add_blockers(nfiles + 1);
+  std::vector<Task_token*> window_blockers(nfiles, NULL);
+  add_blockers[0] = NULL;
+  for (size_t i = 0; i < nfiles; ++i)
+    {
+      read_blockers[i] = new Task_token(true);
+      read_blockers[i]->add_blocker();
+      add_blockers[i + 1] = new Task_token(true);
+      add_blockers[i + 1]->add_blocker();
+      if (i + window < nfiles)
+	{
+	  window_blockers[i] = new Task_token(true);
+	  window_blockers[i]->add_blocker();
+	}
+    }
+
+  Workqueue workqueue(parameters->options());
+  workqueue.set_thread_count(thread_count);
+
+  for (size_t i = 0; i < nfiles; ++i)
+    {
+      Dwo_file* dwo_file = new Dwo_file(files[i].dwo_name.c_str());
+      workqueue.queue(new Dwo_read_task(dwo_file,
+					(i >= window
+					 ? window_blockers[i - window]
+					 : NULL),
+					read_blockers[i]));
+      workqueue.queue(new Dwo_add_task(dwo_file, output_file, verbose,
+				       read_blockers[i], add_blockers[i],
+				       add_blockers[i + 1],
+				       window_blockers[i]));
+    }
+
+  workqueue.process(0);
+
+  // Nothing waits for the last file to be added.
+  delete add_blockers[nfiles];
 }
 
 }; // End namespace gold
@@ -2292,6 +2655,8 @@ using namespace gold;
 
 enum Dwp_options {
   VERIFY_ONLY = 0x101,
+  THREADS,
+  THREAD_COUNT
 };
 
 struct option dwp_options[] =
@@ -2299,6 +2664,8 @@ struct option dwp_options[] =
     { "exec", required_argument, NULL, 'e' },
     { "help", no_argument, NULL, 'h' },
     { "output", required_argument, NULL, 'o' },
+    { "threads", no_argument, NULL, THREADS },
+    { "thread-count", required_argument, NULL, THREAD_COUNT },
     { "verbose", no_argument, NULL, 'v' },
     { "verify-only", no_argument, NULL, VERIFY_ONLY },
     { "version", no_argument, NULL, 'V' },
@@ -2315,6 +2682,9 @@ usage(FILE* fd, int exit_status)
   fprintf(fd, _("  -e EXE, --exec EXE       Get list of dwo files from EXE"
 					   " (defaults output to EXE.dwp)\n"));
   fprintf(fd, _("  -o FILE, --output FILE   Set output dwp file name\n"));
+  fprintf(fd, _("  --threads                Read input files in"
+					   " multiple threads\n"));
+  fprintf(fd, _("  --thread-count COUNT     Number of threads to use\n"));
   fprintf(fd, _("  -v, --verbose            Verbose output\n"));
   fprintf(fd, _("  --verify-only            Verify output file against"
 					   " exec file\n"));
@@ -2378,6 +2748,8 @@ main(int argc, char** argv)
   const char* exe_filename = NULL;
   bool verbose = false;
   bool verify_only = false;
+  bool threads = false;
+  int thread_count = 0;
   int c;
   while ((c = getopt_long(argc, argv, "e:ho:vV", dwp_options, NULL)) != -1)
     {
@@ -2397,6 +2769,18 @@ main(int argc, char** argv)
 	  case VERIFY_ONLY:
 	    verify_only = true;
 	    break;
+	  case THREADS:
+	    threads = true;
+	    break;
+	  case THREAD_COUNT:
+	    {
+	      char* endptr;
+	      thread_count = strtol(optarg, &endptr, 0);
+	      if (*endptr != '\0' || thread_count <= 0)
+		gold_fatal(_("invalid thread count: %s"), optarg);
+	      threads = true;
+	    }
+	    break;
 	  case 'V':
 	    print_version();
 	  case '?':
@@ -2436,14 +2820,45 @@ main(int argc, char** argv)
       return ok ? EXIT_SUCCESS : EXIT_FAILURE;
     }
 
+#ifdef ENABLE_THREADS
+  if (threads)
+    {
+      options.enable_threads();
+      if (thread_count == 0)
+	{
+#ifdef _SC_NPROCESSORS_ONLN
+	  thread_count = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	  if (thread_count <= 0)
+	    thread_count = 1;
+	}
+    }
+#else
+  if (threads)
+    {
+      gold_warning(_("ignoring --threads: "
+		     "%s was compiled without thread support"),
+		   program_name);
+      threads = false;
+    }
+#endif
+
   // Process each file, adding its contents to the output file.
-  Dwp_output_file output_file(output_filename.c_str());
-  for (File_list::const_iterator f = files.begin(); f != files.end(); ++f)
+  Dwp_output_file output_file(output_filename.c_str(), threads);
+  if (threads)
+    process_files_in_parallel(files, &output_file, thread_count, verbose);
+  else
     {
-      if (verbose)
-	fprintf(stderr, "%s\n", f->dwo_name.c_str());
-      Dwo_file dwo_file(f->dwo_name.c_str());
-      dwo_file.read(&output_file);
+      for (File_list::const_iterator f = files.begin();
+	   f != files.end();
+	   ++f)
+	{
+	  if (verbose)
+	    fprintf(stderr, "%s\n", f->dwo_name.c_str());
+	  Dwo_file dwo_file(f->dwo_name.c_str());
+	  dwo_file.read();
+	  dwo_file.add_to_output(&output_file);
+	}
     }
   output_file.finalize();
 
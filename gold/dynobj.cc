@@ -753,6 +753,7 @@ Sized_dynobj<size, big_endian>::do_add_symbols(Symbol_table* symtab,
 			   : sd->versym->data()),
 			  sd->versym_size,
 			  &version_map,
+			  sd->interned_names,
 			  this->symbols_,
 			  &this->defined_count_);
 
@@ -775,12 +776,41 @@ Sized_dynobj<size, big_endian>::do_add_symbols(Symbol_table* symtab,
       delete sd->verneed;
       sd->verneed = NULL;
     }
+  if (sd->interned_names != NULL)
+    {
+      delete sd->interned_names;
+      sd->interned_names = NULL;
+    }
 
   // This is normally the last time we will read any data from this
   // file.
   this->clear_view_cache_marks();
 }
 
+// Enter the names of the dynamic symbols into the name pool of
+// SYMTAB.  The versions come from the version sections, and are
+// handled by do_add_symbols.
+
+template<int size, bool big_endian>
+void
+Sized_dynobj<size, big_endian>::do_intern_symbol_names(Symbol_table* symtab,
+						       Read_symbols_data* sd)
+{
+  if (sd->symbols == NULL || sd->interned_names != NULL)
+    return;
+
+  const int sym_size = This::sym_size;
+  const size_t symcount = sd->symbols_size / sym_size;
+  if (symcount * sym_size != sd->symbols_size)
+    return;
+
+  sd->interned_names = new Interned_symbol_names();
+  symtab->intern_symbol_names<size, big_endian>(
+      sd->symbols->data(), symcount,
+      reinterpret_cast<const char*>(sd->symbol_names->data()),
+      sd->symbol_names_size, false, NULL, NULL, sd->interned_names);
+}
+
 template<int size, bool big_endian>
 Archive::Should_include
 Sized_dynobj<size, big_endian>::do_should_include_member(Symbol_table*,
@@ -862,13 +892,17 @@ Dynobj::compute_bucket_count(const std::vector<uint32_t>& hashcodes,
   // Array used to determine the number of hash table buckets to use
   // based on the number of symbols there are.  If there are fewer
   // than 3 symbols we use 1 bucket, fewer than 17 symbols we use 3
-  // buckets, fewer than 37 we use 17 buckets, and so forth.  We never
-  // use more than 262147 buckets.  This is straight from the old GNU
-  // linker.
+  // buckets, fewer than 37 we use 17 buckets, and so forth.  This is
+  // straight from the old GNU linker, which never uses more than
+  // 262147 buckets.  With several hundred thousand symbols that makes
+  // the chains the dynamic linker has to walk grow without bound, so
+  // we carry on with the first prime above each power of two.  That
+  // does not change the table for any smaller symbol count.
   static const unsigned int buckets[] =
   {
     1, 3, 17, 37, 67, 97, 131, 197, 263, 521, 1031, 2053, 4099, 8209,
-    16411, 32771, 65537, 131101, 262147
+    16411, 32771, 65537, 131101, 262147, 524309, 1048583, 2097169,
+    4194319, 8388617, 16777259
   };
   const int buckets_count = sizeof buckets / sizeof buckets[0];
 
@@ -914,23 +948,78 @@ Dynobj::elf_hash(const char* name)
   return h;
 }
 
+// Compute the ELF and GNU hash codes of the names of DYNSYMS.  With
+// --hash-style=both this walks each name once for both hash codes,
+// rather than once for each hash table; with a large dynamic symbol
+// table the names are no longer in the cache by the second walk.
+
+void
+Dynobj::compute_hash_values(const std::vector<Symbol*>& dynsyms,
+			    std::vector<uint32_t>* elf_hashvals,
+			    std::vector<uint32_t>* gnu_hashvals)
+{
+  const unsigned int count = dynsyms.size();
+
+  if (elf_hashvals == NULL)
+    {
+      if (gnu_hashvals != NULL)
+	{
+	  // The symbols left out of the GNU hash table need no hash code.
+	  gnu_hashvals->resize(count);
+	  for (unsigned int i = 0; i < count; ++i)
+	    if (!Dynobj::is_unhashed_dynsym(dynsyms[i]))
+	      (*gnu_hashvals)[i] = Dynobj::gnu_hash(dynsyms[i]->name());
+	}
+      return;
+    }
+
+  elf_hashvals->resize(count);
+  if (gnu_hashvals == NULL)
+    {
+      for (unsigned int i = 0; i < count; ++i)
+	(*elf_hashvals)[i] = Dynobj::elf_hash(dynsyms[i]->name());
+      return;
+    }
+
+  // This is elf_hash and gnu_hash run side by side.
+  gnu_hashvals->resize(count);
+  for (unsigned int i = 0; i < count; ++i)
+    {
+      const unsigned char* nameu =
+	reinterpret_cast<const unsigned char*>(dynsyms[i]->name());
+      uint32_t eh = 0;
+      uint32_t gh = 5381;
+      unsigned char c;
+      while ((c = *nameu++) != '\0')
+	{
+	  eh = (eh << 4) + c;
+	  uint32_t g = eh & 0xf0000000;
+	  if (g != 0)
+	    {
+	      eh ^= g >> 24;
+	      eh ^= g;
+	    }
+	  gh = (gh << 5) + gh + c;
+	}
+      (*elf_hashvals)[i] = eh;
+      (*gnu_hashvals)[i] = gh;
+    }
+}
+
 // Create a standard ELF hash table, setting *PPHASH and *PHASHLEN.
-// DYNSYMS is a vector with all the global dynamic symbols.
-// LOCAL_DYNSYM_COUNT is the number of local symbols in the dynamic
-// symbol table.
+// DYNSYMS is a vector with all the global dynamic symbols, and
+// DYNSYM_HASHVALS is their ELF hash codes.  LOCAL_DYNSYM_COUNT is
+// the number of local symbols in the dynamic symbol table.
 
 void
 Dynobj::create_elf_hash_table(const std::vector<Symbol*>& dynsyms,
+			      const std::vector<uint32_t>& dynsym_hashvals,
 			      unsigned int local_dynsym_count,
 			      unsigned char** pphash,
 			      unsigned int* phashlen)
 {
   unsigned int dynsym_count = dynsyms.size();
-
-  // Get the hash values for all the symbols.
-  std::vector<uint32_t> dynsym_hashvals(dynsym_count);
-  for (unsigned int i = 0; i < dynsym_count; ++i)
-    dynsym_hashvals[i] = Dynobj::elf_hash(dynsyms[i]->name());
+  gold_assert(dynsym_hashvals.size() == dynsym_count);
 
   const unsigned int bucketcount =
     Dynobj::compute_bucket_count(dynsym_hashvals, false);
@@ -1052,21 +1141,35 @@ Dynobj::gnu_hash(const char* name)
   return h;
 }
 
+// Return whether SYM is left out of the GNU hash table.  Symbols
+// which are not defined here cannot be found through it.
+
+bool
+Dynobj::is_unhashed_dynsym(const Symbol* sym)
+{
+  return (!sym->needs_dynsym_value()
+	  && (sym->is_undefined()
+	      || sym->is_from_dynobj()
+	      || sym->is_forced_local()));
+}
+
 // Create a GNU hash table, setting *PPHASH and *PHASHLEN.  GNU hash
 // tables are an extension to ELF which are recognized by the GNU
 // dynamic linker.  They are referenced using dynamic tag DT_GNU_HASH.
 // TARGET is the target.  DYNSYMS is a vector with all the global
-// symbols which will be going into the dynamic symbol table.
-// LOCAL_DYNSYM_COUNT is the number of local symbols in the dynamic
-// symbol table.
+// symbols which will be going into the dynamic symbol table, and
+// ALL_HASHVALS is their GNU hash codes.  LOCAL_DYNSYM_COUNT is the
+// number of local symbols in the dynamic symbol table.
 
 void
 Dynobj::create_gnu_hash_table(const std::vector<Symbol*>& dynsyms,
+			      const std::vector<uint32_t>& all_hashvals,
 			      unsigned int local_dynsym_count,
 			      unsigned char** pphash,
 			      unsigned int* phashlen)
 {
   const unsigned int count = dynsyms.size();
+  gold_assert(all_hashvals.size() == count);
 
   // Sort the dynamic symbols into two vectors.  Symbols which we do
   // not want to put into the hash table we store into
@@ -1087,15 +1190,12 @@ Dynobj::create_gnu_hash_table(const std::vector<Symbol*>& dynsyms,
     {
       Symbol* sym = dynsyms[i];
 
-      if (!sym->needs_dynsym_value()
-	  && (sym->is_undefined()
-	      || sym->is_from_dynobj()
-	      || sym->is_forced_local()))
+      if (Dynobj::is_unhashed_dynsym(sym))
 	unhashed_dynsyms.push_back(sym);
       else
 	{
 	  hashed_dynsyms.push_back(sym);
-	  dynsym_hashvals.push_back(Dynobj::gnu_hash(sym->name()));
+	  dynsym_hashvals.push_back(all_hashvals[i]);
 	}
     }
 
@@ -1546,6 +1646,18 @@ Versions::record_version(const Symbol_table* symtab,
     }
 }
 
+// Record a reference to version VERSION of DYNOBJ.
+
+void
+Versions::record_need(Stringpool* dynpool, const Dynobj* dynobj,
+		      const char* version)
+{
+  gold_assert(!this->is_finalized_);
+  Stringpool::Key version_key;
+  version = dynpool->add(version, false, &version_key);
+  this->add_need(dynpool, dynobj->soname(), version, version_key);
+}
+
 // We've found a symbol SYM defined in version VERSION.
 
 void
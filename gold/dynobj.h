@@ -86,22 +86,33 @@ class Dynobj : public Object
   static uint32_t
   elf_hash(const char*);
 
+  // Compute the hash codes of the names of DYNSYMS, reading each
+  // name only once.  If ELF_HASHVALS is not NULL, set it to the ELF
+  // hash codes; if GNU_HASHVALS is not NULL, set it to the GNU hash
+  // codes.  Both are parallel to DYNSYMS.
+  static void
+  compute_hash_values(const std::vector<Symbol*>& dynsyms,
+		      std::vector<uint32_t>* elf_hashvals,
+		      std::vector<uint32_t>* gnu_hashvals);
+
   // Create a standard ELF hash table, setting *PPHASH and *PHASHLEN.
-  // DYNSYMS is the global dynamic symbols.  LOCAL_DYNSYM_COUNT is the
-  // number of local dynamic symbols, which is the index of the first
-  // dynamic gobal symbol.
+  // DYNSYMS is the global dynamic symbols, and DYNSYM_HASHVALS their
+  // ELF hash codes.  LOCAL_DYNSYM_COUNT is the number of local dynamic
+  // symbols, which is the index of the first dynamic gobal symbol.
   static void
   create_elf_hash_table(const std::vector<Symbol*>& dynsyms,
+			const std::vector<uint32_t>& dynsym_hashvals,
 			unsigned int local_dynsym_count,
 			unsigned char** pphash,
 			unsigned int* phashlen);
 
   // Create a GNU hash table, setting *PPHASH and *PHASHLEN.  DYNSYMS
-  // is the global dynamic symbols.  LOCAL_DYNSYM_COUNT is the number
-  // of local dynamic symbols, which is the index of the first dynamic
-  // gobal symbol.
+  // is the global dynamic symbols, and DYNSYM_HASHVALS their GNU hash
+  // codes.  LOCAL_DYNSYM_COUNT is the number of local dynamic symbols,
+  // which is the index of the first dynamic gobal symbol.
   static void
   create_gnu_hash_table(const std::vector<Symbol*>& dynsyms,
+			const std::vector<uint32_t>& dynsym_hashvals,
 			unsigned int local_dynsym_count,
 			unsigned char** pphash, unsigned int* phashlen);
 
@@ -126,6 +137,10 @@ class Dynobj : public Object
   static uint32_t
   gnu_hash(const char*);
 
+  // Return whether a dynamic symbol is left out of the GNU hash table.
+  static bool
+  is_unhashed_dynsym(const Symbol*);
+
   // Compute the number of hash buckets to use.
   static unsigned int
   compute_bucket_count(const std::vector<uint32_t>& hashcodes,
@@ -188,6 +203,10 @@ class Sized_dynobj : public Dynobj
   void
   do_layout(Symbol_table*, Layout*, Read_symbols_data*);
 
+  // Enter the global symbol names into the name pool.
+  void
+  do_intern_symbol_names(Symbol_table*, Read_symbols_data*);
+
   // Add the symbols to the symbol table.
   void
   do_add_symbols(Symbol_table*, Read_symbols_data*, Layout*);
@@ -569,6 +588,11 @@ class Versions
   void
   record_version(const Symbol_table* symtab, Stringpool*, const Symbol* sym);
 
+  // Record a reference to version VERSION of DYNOBJ which does not
+  // come from a symbol.
+  void
+  record_need(Stringpool*, const Dynobj* dynobj, const char* version);
+
   // Set the version indexes.  DYNSYM_INDEX is the index we should use
   // for the next dynamic symbol.  We add new dynamic symbols to SYMS
   // and return an updated DYNSYM_INDEX.
@@ -188,8 +188,7 @@ Eh_frame_hdr::do_sized_write(Output_file* of)
       this->get_fde_addresses<size, big_endian>(of, &this->fde_offsets_,
 						&fde_addresses);
 
-      std::sort(fde_addresses.begin(), fde_addresses.end(),
-		Fde_address_compare<size>());
+      this->sort_fde_addresses<size>(&fde_addresses);
 
       typename elfcpp::Elf_types<size>::Elf_Addr output_address;
       output_address = this->address();
@@ -323,6 +322,67 @@ Eh_frame_hdr::get_fde_addresses(Output_file* of,
   of->free_input_view(eh_frame_offset, eh_frame_size, eh_frame_contents);
 }
 
+// Sort FDE_ADDRESSES by PC.  The FDEs were recorded in the order in
+// which they appear in the .eh_frame section, which normally follows
+// the order of the input files, and so the order of the code.  The
+// list is therefore made up of long runs which are already sorted,
+// typically one for each input file, and merging the runs is much
+// faster than sorting the whole list.  When the code is in the same
+// order as the FDEs there is only one run, and nothing to do.
+
+template<int size>
+void
+Eh_frame_hdr::sort_fde_addresses(Fde_addresses<size>* fde_addresses)
+{
+  typedef typename Fde_addresses<size>::Fde_address Fde_address;
+
+  const size_t count = fde_addresses->end() - fde_addresses->begin();
+  if (count < 2)
+    return;
+  Fde_address* const base = &*fde_addresses->begin();
+  Fde_address_compare<size> compare;
+
+  // Find where each run starts.  The list ends with COUNT.
+  std::vector<size_t> runs;
+  runs.push_back(0);
+  for (size_t i = 1; i < count; ++i)
+    if (compare(base[i], base[i - 1]))
+      runs.push_back(i);
+  if (runs.size() == 1)
+    return;
+  runs.push_back(count);
+
+  // Merge pairs of adjacent runs back and forth between the list and
+  // a buffer until there is only one run.
+  std::vector<Fde_address> buffer(count);
+  Fde_address* from = base;
+  Fde_address* to = &buffer[0];
+  while (runs.size() > 2)
+    {
+      std::vector<size_t> merged_runs;
+      merged_runs.reserve(runs.size() / 2 + 2);
+      size_t i;
+      for (i = 0; i + 2 < runs.size(); i += 2)
+	{
+	  std::merge(from + runs[i], from + runs[i + 1],
+		     from + runs[i + 1], from + runs[i + 2],
+		     to + runs[i], compare);
+	  merged_runs.push_back(runs[i]);
+	}
+      if (i + 1 < runs.size())
+	{
+	  std::copy(from + runs[i], from + runs[i + 1], to + runs[i]);
+	  merged_runs.push_back(runs[i]);
+	}
+      merged_runs.push_back(count);
+      runs.swap(merged_runs);
+      std::swap(from, to);
+    }
+
+  if (from != base)
+    std::copy(from, from + count, base);
+}
+
 // Class Fde.
 
 // Write the FDE to OVIEW starting at OFFSET.  CIE_OFFSET is the
@@ -148,6 +148,11 @@ class Eh_frame_hdr : public Output_section_data
 		    const Fde_offsets* fde_offsets,
 		    Fde_addresses<size>* fde_addresses);
 
+  // Sort Fde_addresses by PC.
+  template<int size>
+  void
+  sort_fde_addresses(Fde_addresses<size>* fde_addresses);
+
   // The .eh_frame section.
   Output_section* eh_frame_section_;
   // The .eh_frame section data.
@@ -29,40 +29,248 @@
 namespace gold
 {
 
-// Garbage collection uses a worklist style algorithm to determine the 
-// transitive closure of all referenced sections.
-void 
-Garbage_collection::do_transitive_closure()
+// Garbage collection uses a worklist style algorithm to determine the
+// transitive closure of all referenced sections.  To make that fast,
+// the sections are given dense numbers, the references are copied
+// into arrays indexed by those numbers, and the sections which are
+// reached are recorded in a bitmap.  The bitmap is set with atomic
+// operations, so that several tasks can walk the graph at once.
+
+// Once a Gc_mark_task has this many sections on its work list, it
+// tries to hand half of them to a new task.
+
+static const size_t gc_mark_split_size = 256;
+
+// How many sections a Gc_mark_task processes between checks of the
+// size of its work list.
+
+static const unsigned int gc_mark_split_interval = 64;
+
+// The references from one section, while the graph is being built.
+
+struct Gc_reference_source
+{
+  // The number of the section.
+  unsigned int num;
+  // The number of sections it refers to.
+  unsigned int count;
+  // The index of the first of them in the graph.
+  size_t start;
+};
+
+// Set *PNUM to the number of section ID.
+
+bool
+Garbage_collection::section_number(const Section_id& id, unsigned int* pnum)
+{
+  if (id.first == NULL)
+    return false;
+  if (id.first != this->last_object_)
+    {
+      std::pair<Section_ranges::iterator, bool> ins =
+	this->section_ranges_.insert(std::make_pair(id.first,
+						    Section_range()));
+      if (ins.second)
+	{
+	  Section_range* r = &ins.first->second;
+	  r->base = this->section_count_;
+	  r->count = id.first->shnum();
+	  gold_assert(this->section_count_ + r->count >= this->section_count_);
+	  this->section_count_ += r->count;
+	}
+      this->last_object_ = id.first;
+      this->last_range_ = ins.first->second;
+    }
+  if (id.second >= this->last_range_.count)
+    return false;
+  *pnum = this->last_range_.base + id.second;
+  return true;
+}
+
+// Number the sections and build the reference graph.
+
+void
+Garbage_collection::prepare_mark(std::vector<unsigned int>* seeds)
+{
+  // The sections on the work list.
+  std::vector<unsigned int> work;
+  work.reserve(this->work_list_.size());
+  for (Worklist_type::const_iterator p = this->work_list_.begin();
+       p != this->work_list_.end();
+       ++p)
+    {
+      unsigned int num;
+      if (this->section_number(*p, &num))
+	work.push_back(num);
+    }
+  Worklist_type().swap(this->work_list_);
+
+  // The references.  Numbering the target sections may number more
+  // objects, so we can't size the arrays indexed by section number
+  // until we are done.
+  std::vector<Gc_reference_source> sources;
+  sources.reserve(this->section_reloc_map_.size());
+  for (Section_ref::const_iterator p = this->section_reloc_map_.begin();
+       p != this->section_reloc_map_.end();
+       ++p)
+    {
+      Gc_reference_source src;
+      if (!this->section_number(p->first, &src.num))
+	continue;
+      src.start = this->refs_.size();
+      for (Sections_reachable::const_iterator q = p->second.begin();
+	   q != p->second.end();
+	   ++q)
+	{
+	  unsigned int num;
+	  if (this->section_number(*q, &num))
+	    this->refs_.push_back(num);
+	}
+      src.count = this->refs_.size() - src.start;
+      if (src.count > 0)
+	sources.push_back(src);
+    }
+
+  this->ref_start_.resize(this->section_count_, 0);
+  this->ref_count_.resize(this->section_count_, 0);
+  for (std::vector<Gc_reference_source>::const_iterator p = sources.begin();
+       p != sources.end();
+       ++p)
+    {
+      this->ref_start_[p->num] = p->start;
+      this->ref_count_[p->num] = p->count;
+    }
+
+  this->marked_.resize((this->section_count_ + mark_word_bits - 1)
+		       / mark_word_bits, 0);
+  seeds->clear();
+  for (std::vector<unsigned int>::const_iterator p = work.begin();
+       p != work.end();
+       ++p)
+    if (this->set_marked(*p))
+      seeds->push_back(*p);
+}
+
+// Mark the sections reachable from *WORK.
+
+void
+Garbage_collection::mark_sections(Workqueue* workqueue, Task_token* blocker,
+				  std::vector<unsigned int>* work)
 {
-  while (!this->worklist().empty())
+  unsigned int steps = 0;
+  while (!work->empty())
     {
-      // Add elements from the work list to the referenced list
-      // one by one.
-      Section_id entry = this->worklist().back();
-      this->worklist().pop_back();
-      if (!this->referenced_list().insert(entry).second)
-        continue;
-      Garbage_collection::Section_ref::iterator find_it = 
-                this->section_reloc_map().find(entry);
-      if (find_it == this->section_reloc_map().end()) 
-          continue;
-      const Garbage_collection::Sections_reachable &v = find_it->second;
-      // Scan the vector of references for each work_list entry. 
-      for (Garbage_collection::Sections_reachable::const_iterator it_v =
-               v.begin();
-           it_v != v.end();
-           ++it_v)
-        {
-          // Do not add already processed sections to the work_list. 
-          if (this->referenced_list().find(*it_v)
-              == this->referenced_list().end())
-            {
-              this->worklist().push_back(*it_v);
-            }
-        }
+      unsigned int num = work->back();
+      work->pop_back();
+      size_t i = this->ref_start_[num];
+      size_t iend = i + this->ref_count_[num];
+      for (; i < iend; ++i)
+	if (this->set_marked(this->refs_[i]))
+	  work->push_back(this->refs_[i]);
+
+      // The sections at the bottom of the work list were found
+      // earliest, so they are likely to lead to the most work.  Give
+      // them to a new task if there is room for one.  The count of
+      // tasks is only a hint here, so it is read without a lock.
+      if (workqueue != NULL
+	  && ++steps % gc_mark_split_interval == 0
+	  && work->size() >= gc_mark_split_size
+	  && this->mark_tasks_ < this->max_mark_tasks_)
+	{
+	  size_t half = work->size() / 2;
+	  std::vector<unsigned int> split(work->begin(), work->begin() + half);
+	  work->erase(work->begin(), work->begin() + half);
+	  __sync_add_and_fetch(&this->mark_tasks_, 1);
+	  workqueue->add_blocker(blocker);
+	  workqueue->queue_soon(new Gc_mark_task(this, blocker, &split));
+	}
     }
+}
+
+// Free the reference graph.
+
+void
+Garbage_collection::finish_mark()
+{
+  std::vector<size_t>().swap(this->ref_start_);
+  std::vector<unsigned int>().swap(this->ref_count_);
+  std::vector<unsigned int>().swap(this->refs_);
   this->worklist_ready();
 }
 
+// Mark all the sections reachable from the work list in this thread.
+
+void
+Garbage_collection::do_transitive_closure()
+{
+  std::vector<unsigned int> work;
+  this->prepare_mark(&work);
+  this->mark_sections(NULL, NULL, &work);
+  this->finish_mark();
+}
+
+// Queue the tasks to mark all the sections reachable from the work
+// list.  The reference graph is built in this thread, and the sections
+// to start from are split among the first tasks.
+
+void
+Garbage_collection::queue_mark_tasks(Workqueue* workqueue, int max_tasks,
+				     Task_token* blocker)
+{
+  std::vector<unsigned int> seeds;
+  this->prepare_mark(&seeds);
+
+  if (seeds.empty())
+    {
+      this->finish_mark();
+      return;
+    }
+
+  size_t ntasks = (seeds.size() + gc_mark_split_size - 1) / gc_mark_split_size;
+  if (max_tasks < 1)
+    max_tasks = 1;
+  if (ntasks > static_cast<size_t>(max_tasks))
+    ntasks = max_tasks;
+  this->max_mark_tasks_ = max_tasks;
+  this->mark_tasks_ = ntasks;
+
+  // Add all the blockers before queuing any task, since a queued task
+  // may finish and release its blocker on another thread right away.
+  blocker->add_blockers(ntasks);
+  size_t start = 0;
+  for (size_t i = 0; i < ntasks; ++i)
+    {
+      size_t end = seeds.size() * (i + 1) / ntasks;
+      std::vector<unsigned int> work(seeds.begin() + start,
+				     seeds.begin() + end);
+      workqueue->queue(new Gc_mark_task(this, blocker, &work));
+      start = end;
+    }
+}
+
+// Run a Gc_mark_task.  The last task to finish frees the graph.
+
+void
+Garbage_collection::run_mark_task(Workqueue* workqueue, Task_token* blocker,
+				  std::vector<unsigned int>* work)
+{
+  this->mark_sections(workqueue, blocker, work);
+  if (__sync_sub_and_fetch(&this->mark_tasks_, 1) == 0)
+    this->finish_mark();
+}
+
+// Return whether section SHNDX of OBJ was not reached.
+
+bool
+Garbage_collection::is_section_garbage(Relobj* obj, unsigned int shndx) const
+{
+  Section_ranges::const_iterator p = this->section_ranges_.find(obj);
+  if (p == this->section_ranges_.end() || shndx >= p->second.count)
+    return true;
+  unsigned int num = p->second.base + shndx;
+  return (this->marked_[num / mark_word_bits]
+	  & (1UL << (num % mark_word_bits))) == 0;
+}
+
 } // End namespace gold.
 
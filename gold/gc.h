@@ -29,6 +29,7 @@
 #include "symtab.h"
 #include "object.h"
 #include "icf.h"
+#include "workqueue.h"
 
 namespace gold
 {
@@ -55,15 +56,13 @@ class Garbage_collection
   typedef std::map<std::string, Sections_reachable> Cident_section_map;
 
   Garbage_collection()
-  : is_worklist_ready_(false)
+  : is_worklist_ready_(false), section_ranges_(), section_count_(0),
+    last_object_(NULL), last_range_(), ref_start_(), ref_count_(), refs_(),
+    marked_(), mark_tasks_(0), max_mark_tasks_(0)
   { }
 
   // Accessor methods for the private members.
 
-  Sections_reachable&
-  referenced_list()
-  { return referenced_list_; }
-
   Section_ref&
   section_reloc_map()
   { return this->section_reloc_map_; }
@@ -80,13 +79,27 @@ class Garbage_collection
   worklist_ready()
   { this->is_worklist_ready_ = true; }
 
+  // Find all the sections reachable from the work list, in this
+  // thread.
   void
   do_transitive_closure();
 
+  // Find all the sections reachable from the work list using a set of
+  // tasks, at most MAX_TASKS of which run at once.  BLOCKER is
+  // unblocked when they are all done.  This does not add a blocker to
+  // BLOCKER if the tasks have nothing to do.
+  void
+  queue_mark_tasks(Workqueue* workqueue, int max_tasks, Task_token* blocker);
+
+  // Run a Gc_mark_task, which marks the sections reachable from the
+  // sections in *WORK.
+  void
+  run_mark_task(Workqueue* workqueue, Task_token* blocker,
+		std::vector<unsigned int>* work);
+
+  // Return whether section SHNDX of OBJ was not reached.
   bool
-  is_section_garbage(Relobj* obj, unsigned int shndx)
-  { return (this->referenced_list().find(Section_id(obj, shndx))
-            == this->referenced_list().end()); }
+  is_section_garbage(Relobj* obj, unsigned int shndx) const;
 
   Cident_section_map*
   cident_sections()
@@ -110,12 +123,116 @@ class Garbage_collection
   }
 
  private:
+  // For marking, the sections of each object are given consecutive
+  // numbers, starting at BASE.
+  struct Section_range
+  {
+    Section_range()
+      : base(0), count(0)
+    { }
+
+    unsigned int base;
+    unsigned int count;
+  };
+
+  typedef Unordered_map<const Relobj*, Section_range> Section_ranges;
+
+  // The number of bits in an element of the mark bitmap.
+  static const unsigned int mark_word_bits = sizeof(unsigned long) * 8;
+
+  // Set *PNUM to the number of section ID, numbering its object if
+  // needed.  Return false if ID is not a valid section.
+  bool
+  section_number(const Section_id& id, unsigned int* pnum);
+
+  // Number the sections, build the reference graph from the reloc
+  // map, and mark the sections on the work list.  Set *SEEDS to the
+  // numbers of the sections to start from.
+  void
+  prepare_mark(std::vector<unsigned int>* seeds);
+
+  // Mark section NUM.  Return true if it was not marked before.  This
+  // may be called from several threads at once.
+  bool
+  set_marked(unsigned int num)
+  {
+    unsigned long* p = &this->marked_[num / mark_word_bits];
+    unsigned long bit = 1UL << (num % mark_word_bits);
+    if ((*p & bit) != 0)
+      return false;
+    return (__sync_fetch_and_or(p, bit) & bit) == 0;
+  }
+
+  // Mark all the sections reachable from *WORK.  If WORKQUEUE is not
+  // NULL, hand part of the work to a new task when there is a lot of
+  // it.
+  void
+  mark_sections(Workqueue* workqueue, Task_token* blocker,
+		std::vector<unsigned int>* work);
+
+  // Free the reference graph once marking is done.
+  void
+  finish_mark();
 
   Worklist_type work_list_;
   bool is_worklist_ready_;
   Section_ref section_reloc_map_;
-  Sections_reachable referenced_list_;
   Cident_section_map cident_sections_;
+  // The section numbers of each object which is referenced.
+  Section_ranges section_ranges_;
+  // The number of sections which have been numbered.
+  unsigned int section_count_;
+  // A cache for section_number.
+  const Relobj* last_object_;
+  Section_range last_range_;
+  // The reference graph: the sections referenced by section N are
+  // REFS_[REF_START_[N]] up to REFS_[REF_START_[N] + REF_COUNT_[N]].
+  std::vector<size_t> ref_start_;
+  std::vector<unsigned int> ref_count_;
+  std::vector<unsigned int> refs_;
+  // A bit for each section, set when it is reached.
+  std::vector<unsigned long> marked_;
+  // The number of Gc_mark_tasks which have not finished.
+  int mark_tasks_;
+  // The number of Gc_mark_tasks to run at once.
+  int max_mark_tasks_;
+};
+
+// This task marks sections reachable from a list of sections, for
+// garbage collection.  A task with a lot of work to do may start
+// another task to take some of it.
+
+class Gc_mark_task : public Task
+{
+ public:
+  // The sections in *WORK are moved to the new task.
+  Gc_mark_task(Garbage_collection* gc, Task_token* blocker,
+	       std::vector<unsigned int>* work)
+    : gc_(gc), blocker_(blocker), work_()
+  { this->work_.swap(*work); }
+
+  // The standard Task methods.
+
+  Task_token*
+  is_runnable()
+  { return NULL; }
+
+  void
+  locks(Task_locker* tl)
+  { tl->add(this, this->blocker_); }
+
+  void
+  run(Workqueue* workqueue)
+  { this->gc_->run_mark_task(workqueue, this->blocker_, &this->work_); }
+
+  std::string
+  get_name() const
+  { return "Gc_mark_task"; }
+
+ private:
+  Garbage_collection* gc_;
+  Task_token* blocker_;
+  std::vector<unsigned int> work_;
 };
 
 // Data to pass between successive invocations of do_layout
@@ -321,7 +321,7 @@ void
 Gdb_index_info_reader::visit_compilation_unit(off_t cu_offset, off_t cu_length,
 					      Dwarf_die* root_die)
 {
-  ++Gdb_index_info_reader::dwarf_cu_count;
+  __sync_fetch_and_add(&Gdb_index_info_reader::dwarf_cu_count, 1);
   this->cu_index_ = this->gdb_index_->add_comp_unit(cu_offset, cu_length);
   this->visit_top_die(root_die);
 }
@@ -333,7 +333,7 @@ Gdb_index_info_reader::visit_type_unit(off_t tu_offset, off_t,
 				       off_t type_offset, uint64_t signature,
 				       Dwarf_die* root_die)
 {
-  ++Gdb_index_info_reader::dwarf_tu_count;
+  __sync_fetch_and_add(&Gdb_index_info_reader::dwarf_tu_count, 1);
   // Use a negative index to flag this as a TU instead of a CU.
   this->cu_index_ = -1 - this->gdb_index_->add_type_unit(tu_offset, type_offset,
 							 signature);
@@ -381,9 +381,11 @@ Gdb_index_info_reader::visit_top_die(Dwarf_die* die)
 		return;
 	      }
 	    if (die->tag() == elfcpp::DW_TAG_compile_unit)
-	      ++Gdb_index_info_reader::dwarf_cu_nopubnames_count;
+	      __sync_fetch_and_add(
+		  &Gdb_index_info_reader::dwarf_cu_nopubnames_count, 1);
 	    else
-	      ++Gdb_index_info_reader::dwarf_tu_nopubnames_count;
+	      __sync_fetch_and_add(
+		  &Gdb_index_info_reader::dwarf_tu_nopubnames_count, 1);
 	    this->visit_children(die, NULL);
 	  }
 	break;
@@ -991,6 +993,7 @@ Gdb_index::Gdb_index(Output_section* gdb_index_section)
     type_units_(),
     ranges_(),
     cu_vector_list_(),
+    cu_vector_names_(),
     cu_vector_offsets_(NULL),
     stringpool_(),
     tu_offset_(0),
@@ -999,7 +1002,8 @@ Gdb_index::Gdb_index(Output_section* gdb_index_section)
     cu_pool_offset_(0),
     stringpool_offset_(0),
     pubnames_object_(NULL),
-    stmt_list_offset_(-1)
+    stmt_list_offset_(-1),
+    deferred_objects_()
 {
   this->gdb_symtab_ = new Gdb_hashtab<Gdb_symbol>();
 }
@@ -1011,6 +1015,8 @@ Gdb_index::~Gdb_index()
   // Free the memory used by the CU vectors.
   for (unsigned int i = 0; i < this->cu_vector_list_.size(); ++i)
     delete this->cu_vector_list_[i];
+  delete this->pubnames_table_;
+  delete this->pubtypes_table_;
 }
 
 
@@ -1120,15 +1126,143 @@ Gdb_index::scan_debug_info(bool is_type_unit,
   dwinfo.parse();
 }
 
-// Add a symbol.
+// Whether to defer scanning the debug info until Gdb_index_scan_tasks
+// can read the objects in parallel.  As for merged string sections,
+// we don't bother when not using threads, and an incremental update
+// scans the debug info of objects as they are added.
+
+bool
+Gdb_index::should_defer_scan()
+{
+  return (parameters->options().threads()
+	  && !parameters->incremental());
+}
+
+// Record a .debug_info or .debug_types input section to be scanned by
+// a Gdb_index_scan_task.  The sections of an object are laid out
+// together, so we only need to check the last object.
 
 void
-Gdb_index::add_symbol(int cu_index, const char* sym_name, uint8_t flags)
+Gdb_index::add_deferred_scan(bool is_type_unit,
+			     Relobj* object,
+			     unsigned int shndx,
+			     unsigned int reloc_shndx,
+			     unsigned int reloc_type)
+{
+  if (this->deferred_objects_.empty()
+      || this->deferred_objects_.back().object != object)
+    this->deferred_objects_.push_back(Deferred_object(object));
+  this->deferred_objects_.back().sections.push_back(
+      Deferred_section(is_type_unit, shndx, reloc_shndx, reloc_type));
+}
+
+// Scan the deferred sections of the Nth object into a new index of
+// its own.  Nothing else touches that index or the object until the
+// index is merged, so this needs no locking beyond the object lock.
+
+void
+Gdb_index::scan_deferred_object(unsigned int n)
+{
+  Deferred_object* deferred = &this->deferred_objects_[n];
+  Relobj* object = deferred->object;
+
+  // The symbols read by Read_symbols are gone by now, so get them
+  // again.  We only get here for objects with debug info, for which
+  // we read all of the symbols.
+  const unsigned char* symbols = NULL;
+  section_size_type symbols_size = 0;
+  for (unsigned int shndx = 1; shndx < object->shnum(); ++shndx)
+    {
+      if (object->section_type(shndx) == elfcpp::SHT_SYMTAB)
+	{
+	  symbols = object->section_contents(shndx, &symbols_size, false);
+	  break;
+	}
+    }
+
+  Gdb_index* index = new Gdb_index(NULL);
+  for (std::vector<Deferred_section>::const_iterator p
+	 = deferred->sections.begin();
+       p != deferred->sections.end();
+       ++p)
+    index->scan_debug_info(p->is_type_unit, object, symbols, symbols_size,
+			   p->shndx, p->reloc_shndx, p->reloc_type);
+  deferred->index = index;
+}
+
+// Merge the indexes built by the Gdb_index_scan_tasks.  We do this in
+// input order, so that the CU indexes, the symbol table and the
+// constant pool are the same as when scanning during layout.
+
+void
+Gdb_index::add_deferred_scans()
+{
+  for (std::vector<Deferred_object>::iterator p
+	 = this->deferred_objects_.begin();
+       p != this->deferred_objects_.end();
+       ++p)
+    {
+      gold_assert(p->index != NULL);
+      this->merge_index(p->index);
+      delete p->index;
+    }
+  this->deferred_objects_.clear();
+}
+
+// Append the units, address ranges and symbols of INDEX to this
+// index, renumbering its CUs and TUs to follow ours.
+
+void
+Gdb_index::merge_index(const Gdb_index* index)
+{
+  int cu_base = this->comp_units_.size();
+  int tu_base = this->type_units_.size();
+
+  this->comp_units_.insert(this->comp_units_.end(),
+			   index->comp_units_.begin(),
+			   index->comp_units_.end());
+  this->type_units_.insert(this->type_units_.end(),
+			   index->type_units_.begin(),
+			   index->type_units_.end());
+
+  // The ranges now belong to this index.
+  for (unsigned int i = 0; i < index->ranges_.size(); ++i)
+    {
+      const Per_cu_range_list& range = index->ranges_[i];
+      int cu_index = static_cast<int>(range.cu_index);
+      cu_index = cu_index < 0 ? cu_index - tu_base : cu_index + cu_base;
+      this->ranges_.push_back(Per_cu_range_list(range.object, cu_index,
+						range.ranges));
+    }
+
+  // The CU vectors of INDEX are in the order its symbols were first
+  // seen, which is the order in which add_symbol would have added
+  // them to this index.  Each vector already holds one entry per
+  // consecutive CU, and no CU of INDEX matches the last entry of one
+  // of our vectors, so we can just append the entries.
+  for (unsigned int i = 0; i < index->cu_vector_list_.size(); ++i)
+    {
+      const Cu_vector* from = index->cu_vector_list_[i];
+      Cu_vector* cu_vec = this->find_or_add_symbol(index->cu_vector_names_[i]);
+      for (Cu_vector::const_iterator p = from->begin(); p != from->end(); ++p)
+	{
+	  int cu_index = p->first;
+	  cu_index = cu_index < 0 ? cu_index - tu_base : cu_index + cu_base;
+	  cu_vec->push_back(std::make_pair(cu_index, p->second));
+	}
+    }
+}
+
+// Return the CU vector for a symbol, adding the symbol to the symbol
+// table if it is new.
+
+Gdb_index::Cu_vector*
+Gdb_index::find_or_add_symbol(const char* sym_name)
 {
   unsigned int hash = mapped_index_string_hash(
       reinterpret_cast<const unsigned char*>(sym_name));
   Gdb_symbol* sym = new Gdb_symbol();
-  this->stringpool_.add(sym_name, true, &sym->name_key);
+  const char* name = this->stringpool_.add(sym_name, true, &sym->name_key);
   sym->hashval = hash;
   sym->cu_vector_index = 0;
 
@@ -1138,6 +1272,7 @@ Gdb_index::add_symbol(int cu_index, const char* sym_name, uint8_t flags)
       // New symbol -- allocate a new CU index vector.
       found->cu_vector_index = this->cu_vector_list_.size();
       this->cu_vector_list_.push_back(new Cu_vector());
+      this->cu_vector_names_.push_back(name);
     }
   else
     {
@@ -1146,10 +1281,19 @@ Gdb_index::add_symbol(int cu_index, const char* sym_name, uint8_t flags)
       delete sym;
     }
 
+  return this->cu_vector_list_[found->cu_vector_index];
+}
+
+// Add a symbol.
+
+void
+Gdb_index::add_symbol(int cu_index, const char* sym_name, uint8_t flags)
+{
+  Cu_vector* cu_vec = this->find_or_add_symbol(sym_name);
+
   // Add the CU index to the vector list for this symbol,
   // if it's not already on the list.  We only need to
   // check the last added entry.
-  Cu_vector* cu_vec = this->cu_vector_list_[found->cu_vector_index];
   if (cu_vec->size() == 0
       || cu_vec->back().first != cu_index
       || cu_vec->back().second != flags)
@@ -1182,6 +1326,9 @@ Gdb_index::set_pubnames_read(const Relobj* object, off_t offset)
 void
 Gdb_index::set_final_data_size()
 {
+  // Pick up the results of the Gdb_index_scan_tasks.
+  this->add_deferred_scans();
+
   // Finalize the string pool.
   this->stringpool_.set_string_offsets();
 
@@ -1356,4 +1503,43 @@ Gdb_index::print_stats()
     Gdb_index_info_reader::print_stats();
 }
 
+// Class Gdb_index_scan_task.
+
+// We need to lock the object to read its sections.
+
+Task_token*
+Gdb_index_scan_task::is_runnable()
+{
+  Relobj* object = this->gdb_index_->deferred_object(this->n_);
+  if (object->is_locked())
+    return object->token();
+  return NULL;
+}
+
+// Lock the object while we read from it, and unblock BLOCKER when
+// done.
+
+void
+Gdb_index_scan_task::locks(Task_locker* tl)
+{
+  Task_token* token = this->gdb_index_->deferred_object(this->n_)->token();
+  if (token != NULL)
+    tl->add(this, token);
+  tl->add(this, this->blocker_);
+}
+
+void
+Gdb_index_scan_task::run(Workqueue*)
+{
+  this->gdb_index_->scan_deferred_object(this->n_);
+  this->gdb_index_->deferred_object(this->n_)->release();
+}
+
+std::string
+Gdb_index_scan_task::get_name() const
+{
+  return ("Gdb_index_scan_task "
+	  + this->gdb_index_->deferred_object(this->n_)->name());
+}
+
 } // End namespace gold.
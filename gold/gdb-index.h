@@ -27,6 +27,7 @@
 #include "output.h"
 #include "mapfile.h"
 #include "stringpool.h"
+#include "workqueue.h"
 
 #ifndef GOLD_GDB_INDEX_H
 #define GOLD_GDB_INDEX_H
@@ -65,6 +66,37 @@ class Gdb_index : public Output_section_data
 		       unsigned int reloc_shndx,
 		       unsigned int reloc_type);
 
+  // Whether to defer scanning .debug_info and .debug_types input
+  // sections to Gdb_index_scan_tasks.
+  static bool
+  should_defer_scan();
+
+  // Record a .debug_info or .debug_types input section to be scanned
+  // later by a Gdb_index_scan_task.
+  void
+  add_deferred_scan(bool is_type_unit,
+		    Relobj* object,
+		    unsigned int shndx,
+		    unsigned int reloc_shndx,
+		    unsigned int reloc_type);
+
+  // Return the number of objects with deferred sections.
+  unsigned int
+  deferred_object_count() const
+  { return this->deferred_objects_.size(); }
+
+  // Return the Nth object with deferred sections.
+  Relobj*
+  deferred_object(unsigned int n) const
+  { return this->deferred_objects_[n].object; }
+
+  // Scan the deferred sections of the Nth object into a separate
+  // index, to be merged into this one by set_final_data_size.  This
+  // is called with the object locked, and may run in parallel for
+  // different objects.
+  void
+  scan_deferred_object(unsigned int n);
+
   // Add a compilation unit.
   int
   add_comp_unit(off_t cu_offset, off_t cu_length)
@@ -216,6 +248,46 @@ class Gdb_index : public Output_section_data
 
   typedef std::vector<std::pair<int, uint8_t> > Cu_vector;
 
+  // A .debug_info or .debug_types input section whose scan was
+  // deferred.
+  struct Deferred_section
+  {
+    Deferred_section(bool is_type, unsigned int sec, unsigned int reloc_sec,
+		     unsigned int rtype)
+      : is_type_unit(is_type), shndx(sec), reloc_shndx(reloc_sec),
+	reloc_type(rtype)
+    { }
+    bool is_type_unit;
+    unsigned int shndx;
+    unsigned int reloc_shndx;
+    unsigned int reloc_type;
+  };
+
+  // The deferred sections of one object, and the index built by
+  // scanning them.
+  struct Deferred_object
+  {
+    Deferred_object(Relobj* obj)
+      : object(obj), sections(), index(NULL)
+    { }
+    Relobj* object;
+    std::vector<Deferred_section> sections;
+    Gdb_index* index;
+  };
+
+  // Return the CU vector for the symbol SYM_NAME, adding the symbol
+  // if it is new.
+  Cu_vector*
+  find_or_add_symbol(const char* sym_name);
+
+  // Merge the indexes built by scan_deferred_object, in input order.
+  void
+  add_deferred_scans();
+
+  // Append the units, address ranges and symbols of INDEX.
+  void
+  merge_index(const Gdb_index* index);
+
   typedef Unordered_map<off_t, off_t> Pubname_offset_map;
   Pubname_offset_map cu_pubname_map_;
   Pubname_offset_map cu_pubtype_map_;
@@ -243,6 +315,8 @@ class Gdb_index : public Output_section_data
   Gdb_hashtab<Gdb_symbol>* gdb_symtab_;
   // The CU vector portion of the constant pool.
   std::vector<Cu_vector*> cu_vector_list_;
+  // The name of the symbol that owns each CU vector.
+  std::vector<const char*> cu_vector_names_;
   // An array to map from a CU vector index to an offset to the constant pool.
   off_t* cu_vector_offsets_;
   // The string portion of the constant pool.
@@ -257,6 +331,40 @@ class Gdb_index : public Output_section_data
   // last read pubnames and pubtypes sections.
   const Relobj* pubnames_object_;
   off_t stmt_list_offset_;
+  // The objects whose sections are scanned by Gdb_index_scan_tasks.
+  std::vector<Deferred_object> deferred_objects_;
+};
+
+// This task scans the .debug_info and .debug_types sections of one
+// object for the .gdb_index section, after layout and before the
+// section size is set.
+
+class Gdb_index_scan_task : public Task
+{
+ public:
+  Gdb_index_scan_task(Gdb_index* gdb_index, unsigned int n,
+		      Task_token* blocker)
+    : gdb_index_(gdb_index), n_(n), blocker_(blocker)
+  { }
+
+  // The standard Task methods.
+
+  Task_token*
+  is_runnable();
+
+  void
+  locks(Task_locker*);
+
+  void
+  run(Workqueue*);
+
+  std::string
+  get_name() const;
+
+ private:
+  Gdb_index* gdb_index_;
+  unsigned int n_;
+  Task_token* blocker_;
 };
 
 } // End namespace gold.
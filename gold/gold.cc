@@ -39,6 +39,9 @@
 #include "common.h"
 #include "object.h"
 #include "layout.h"
+#include "compressed_output.h"
+#include "merge.h"
+#include "gdb-index.h"
 #include "reloc.h"
 #include "defstd.h"
 #include "plugin.h"
@@ -102,6 +105,101 @@ do_gold_unreachable(const char* filename, int lineno, const char* function)
   gold_exit(GOLD_ERR);
 }
 
+// The hash used for --build-id=fast.  This is not a cryptographic
+// hash; it only needs to make accidental collisions unlikely, and to
+// run at close to memory bandwidth.  The input is consumed in 32 byte
+// stripes by four independent 64-bit lanes, in the style of xxHash, so
+// that the lanes can run in parallel on a superscalar or vector unit.
+// The lanes are then folded into a 128-bit result.  Input words are
+// read as little-endian, so the result does not depend on the host.
+
+static const uint64_t fast_hash_prime1 = 0x9e3779b185ebca87ULL;
+static const uint64_t fast_hash_prime2 = 0xc2b2ae3d27d4eb4fULL;
+static const uint64_t fast_hash_prime3 = 0x165667b19e3779f9ULL;
+static const uint64_t fast_hash_prime4 = 0x85ebca77c2b2ae63ULL;
+static const uint64_t fast_hash_prime5 = 0x27d4eb2f165667c5ULL;
+
+static inline uint64_t
+fast_hash_rotl(uint64_t v, int n)
+{
+  return (v << n) | (v >> (64 - n));
+}
+
+static inline uint64_t
+fast_hash_round(uint64_t acc, uint64_t input)
+{
+  acc += input * fast_hash_prime2;
+  acc = fast_hash_rotl(acc, 31);
+  return acc * fast_hash_prime1;
+}
+
+static inline uint64_t
+fast_hash_avalanche(uint64_t h)
+{
+  h ^= h >> 33;
+  h *= fast_hash_prime2;
+  h ^= h >> 29;
+  h *= fast_hash_prime3;
+  h ^= h >> 32;
+  return h;
+}
+
+// Compute the 128-bit hash of the LEN bytes at BUFFER, and store it
+// in the 16 bytes at RESBLOCK.
+
+void*
+fast_hash_buffer(const char* buffer, size_t len, void* resblock)
+{
+  typedef elfcpp::Swap_unaligned<64, false> Read64;
+
+  const unsigned char* p = reinterpret_cast<const unsigned char*>(buffer);
+  const unsigned char* const pend = p + len;
+
+  uint64_t v1 = fast_hash_prime1 + fast_hash_prime2;
+  uint64_t v2 = fast_hash_prime2;
+  uint64_t v3 = 0;
+  uint64_t v4 = -fast_hash_prime1;
+  while (pend - p >= 32)
+    {
+      v1 = fast_hash_round(v1, Read64::readval(p));
+      v2 = fast_hash_round(v2, Read64::readval(p + 8));
+      v3 = fast_hash_round(v3, Read64::readval(p + 16));
+      v4 = fast_hash_round(v4, Read64::readval(p + 24));
+      p += 32;
+    }
+
+  // Fold the lanes two different ways to get two halves.
+  uint64_t h1 = (fast_hash_rotl(v1, 1) + fast_hash_rotl(v2, 7)
+		 + fast_hash_rotl(v3, 12) + fast_hash_rotl(v4, 18));
+  uint64_t h2 = (fast_hash_rotl(v1, 18) ^ fast_hash_rotl(v2, 12)
+		 ^ fast_hash_rotl(v3, 7) ^ fast_hash_rotl(v4, 1));
+  h1 += static_cast<uint64_t>(len);
+  h2 += static_cast<uint64_t>(len) * fast_hash_prime5;
+
+  // Mix in any remaining bytes.
+  while (pend - p >= 8)
+    {
+      uint64_t k = fast_hash_round(0, Read64::readval(p));
+      h1 = fast_hash_rotl(h1 ^ k, 27) * fast_hash_prime1 + fast_hash_prime4;
+      h2 = fast_hash_rotl(h2 + k, 31) * fast_hash_prime2 + fast_hash_prime3;
+      p += 8;
+    }
+  while (p < pend)
+    {
+      h1 = fast_hash_rotl(h1 ^ (*p * fast_hash_prime5), 11) * fast_hash_prime1;
+      h2 = fast_hash_rotl(h2 + (*p * fast_hash_prime3), 17) * fast_hash_prime4;
+      ++p;
+    }
+
+  h1 = fast_hash_avalanche(h1 + h2);
+  h2 = fast_hash_avalanche(h2 + h1);
+
+  unsigned char* out = static_cast<unsigned char*>(resblock);
+  elfcpp::Swap_unaligned<64, false>::writeval(out, h1);
+  elfcpp::Swap_unaligned<64, false>::writeval(out + 8, h2);
+  return resblock;
+}
+
 // This class arranges to run the functions done in the middle of the
 // link.  It is just a closure.
 
@@ -134,6 +232,82 @@ Middle_runner::run(Workqueue* workqueue, const Task* task)
 		     this->layout_, workqueue, this->mapfile_);
 }
 
+static void
+queue_middle_after_icf_tasks(const General_options&, const Task*,
+			     const Input_objects*, Symbol_table*, Layout*,
+			     Workqueue*, Mapfile*);
+
+static void
+queue_middle_after_gc_tasks(const General_options&, const Task*,
+			    const Input_objects*, Symbol_table*, Layout*,
+			    Workqueue*, Mapfile*);
+
+// This class arranges to run the rest of the middle functions once
+// the sections reachable for garbage collection have been marked.
+
+class Middle_after_gc_runner : public Task_function_runner
+{
+ public:
+  Middle_after_gc_runner(const General_options& options,
+			 const Input_objects* input_objects,
+			 Symbol_table* symtab,
+			 Layout* layout, Mapfile* mapfile)
+    : options_(options), input_objects_(input_objects), symtab_(symtab),
+      layout_(layout), mapfile_(mapfile)
+  { }
+
+  void
+  run(Workqueue*, const Task*);
+
+ private:
+  const General_options& options_;
+  const Input_objects* input_objects_;
+  Symbol_table* symtab_;
+  Layout* layout_;
+  Mapfile* mapfile_;
+};
+
+void
+Middle_after_gc_runner::run(Workqueue* workqueue, const Task* task)
+{
+  queue_middle_after_gc_tasks(this->options_, task, this->input_objects_,
+			      this->symtab_, this->layout_, workqueue,
+			      this->mapfile_);
+}
+
+// This class arranges to run the rest of the middle functions once
+// identical code folding is done.
+
+class Middle_after_icf_runner : public Task_function_runner
+{
+ public:
+  Middle_after_icf_runner(const General_options& options,
+			  const Input_objects* input_objects,
+			  Symbol_table* symtab,
+			  Layout* layout, Mapfile* mapfile)
+    : options_(options), input_objects_(input_objects), symtab_(symtab),
+      layout_(layout), mapfile_(mapfile)
+  { }
+
+  void
+  run(Workqueue*, const Task*);
+
+ private:
+  const General_options& options_;
+  const Input_objects* input_objects_;
+  Symbol_table* symtab_;
+  Layout* layout_;
+  Mapfile* mapfile_;
+};
+
+void
+Middle_after_icf_runner::run(Workqueue* workqueue, const Task* task)
+{
+  queue_middle_after_icf_tasks(this->options_, task, this->input_objects_,
+			       this->symtab_, this->layout_, workqueue,
+			       this->mapfile_);
+}
+
 // This class arranges the tasks to process the relocs for garbage collection.
 
 class Gc_runner : public Task_function_runner
@@ -521,18 +695,80 @@ queue_middle_tasks(const General_options& options,
       // Symbols named with -u should not be considered garbage.
       symtab->gc_mark_undef_symbols(layout);
       gold_assert(symtab->gc() != NULL);
-      // Do a transitive closure on all references to determine the worklist.
+      // Do a transitive closure on all references to determine the
+      // worklist.  When using threads, this is done by a set of
+      // tasks, and we queue the rest of the middle tasks when they
+      // are done.
+      if (parameters->options().threads())
+	{
+	  int thread_count = options.thread_count_middle();
+	  if (thread_count == 0)
+	    thread_count = std::max(2,
+				    input_objects->number_of_input_objects());
+	  Task_token* gc_blocker = new Task_token(true);
+	  symtab->gc()->queue_mark_tasks(workqueue, thread_count, gc_blocker);
+	  workqueue->queue(new Task_function(
+			     new Middle_after_gc_runner(options, input_objects,
+							symtab, layout,
+							mapfile),
+			     gc_blocker,
+			     "Task_function Middle_after_gc_runner"));
+	  return;
+	}
       symtab->gc()->do_transitive_closure();
     }
 
+  queue_middle_after_gc_tasks(options, task, input_objects, symtab, layout,
+			      workqueue, mapfile);
+}
+
+// Queue up the middle tasks which run after garbage collection, if
+// any.
+
+static void
+queue_middle_after_gc_tasks(const General_options& options,
+			    const Task* task,
+			    const Input_objects* input_objects,
+			    Symbol_table* symtab,
+			    Layout* layout,
+			    Workqueue* workqueue,
+			    Mapfile* mapfile)
+{
   // If identical code folding (--icf) is chosen it makes sense to do it
   // only after garbage collection (--gc-sections) as we do not want to
-  // be folding sections that will be garbage.
+  // be folding sections that will be garbage.  ICF is done by a set of
+  // tasks, and we queue the rest of the middle tasks when they are
+  // done.
   if (parameters->options().icf_enabled())
     {
-      symtab->icf()->find_identical_sections(input_objects, symtab);
+      Task_token* icf_blocker = new Task_token(true);
+      icf_blocker->add_blocker();
+      symtab->icf()->find_identical_sections(input_objects, symtab, task,
+					     workqueue, icf_blocker);
+      workqueue->queue(new Task_function(
+			 new Middle_after_icf_runner(options, input_objects,
+						     symtab, layout, mapfile),
+			 icf_blocker,
+			 "Task_function Middle_after_icf_runner"));
+      return;
     }
 
+  queue_middle_after_icf_tasks(options, task, input_objects, symtab, layout,
+			       workqueue, mapfile);
+}
+
+// Queue up the rest of the middle set of tasks, after identical code
+// folding if any.
+
+static void
+queue_middle_after_icf_tasks(const General_options& options,
+			     const Task* task,
+			     const Input_objects* input_objects,
+			     Symbol_table* symtab,
+			     Layout* layout,
+			     Workqueue* workqueue,
+			     Mapfile* mapfile)
+{
   // Call Object::layout for the second time to determine the
   // output_sections for all referenced input sections.  When
   // --gc-sections or --icf is turned on, or when certain input
@@ -607,6 +843,9 @@ queue_middle_tasks(const General_options& options,
     (!input_objects->any_dynamic()
      && !parameters->options().output_is_position_independent());
   set_parameters_doing_static_link(doing_static_link);
+  if (!doing_static_link && parameters->target().dynamic_linker() == NULL)
+    gold_fatal(_("dynamic linking is not supported for this target; "
+		 "cannot use -shared, -pie or dynamic objects"));
   if (!doing_static_link && options.is_static())
     {
       // We print out just the first .so we see; there may be others.
@@ -705,17 +944,50 @@ queue_middle_tasks(const General_options& options,
 
   Task_token* this_blocker = NULL;
 
-  // Allocate common symbols.  We use a blocker to run this before the
-  // Scan_relocs tasks, because it writes to the symbol table just as
-  // they do.
-  if (parameters->options().define_common())
+  // Count the objects whose merged string sections have not been read
+  // yet.
+  std::vector<Relobj*> merge_objects;
+  for (Input_objects::Relobj_iterator p = input_objects->relobj_begin();
+       p != input_objects->relobj_end();
+       ++p)
+    if ((*p)->has_deferred_merge_sections())
+      merge_objects.push_back(*p);
+
+  // Count the objects whose debug info has not been scanned for the
+  // .gdb_index section yet.
+  Gdb_index* gdb_index = layout->gdb_index();
+  unsigned int gdb_index_objects = (gdb_index == NULL
+				    ? 0
+				    : gdb_index->deferred_object_count());
+
+  // Allocate common symbols, read the merged string sections, and
+  // scan the debug info.  We use a blocker to run these before the
+  // Scan_relocs tasks, because Allocate_commons_task writes to the
+  // symbol table just as they do.  All the blockers are added before
+  // any task is queued.
+  if (parameters->options().define_common()
+      || !merge_objects.empty()
+      || gdb_index_objects > 0)
     {
       this_blocker = new Task_token(true);
-      this_blocker->add_blocker();
-      workqueue->queue(new Allocate_commons_task(symtab, layout, mapfile,
-						 this_blocker));
+      if (parameters->options().define_common())
+	this_blocker->add_blocker();
+      this_blocker->add_blockers(merge_objects.size());
+      this_blocker->add_blockers(gdb_index_objects);
     }
 
+  if (parameters->options().define_common())
+    workqueue->queue(new Allocate_commons_task(symtab, layout, mapfile,
+					       this_blocker));
+
+  for (std::vector<Relobj*>::const_iterator p = merge_objects.begin();
+       p != merge_objects.end();
+       ++p)
+    workqueue->queue(new Merge_input_sections_task(*p, this_blocker));
+
+  for (unsigned int i = 0; i < gdb_index_objects; ++i)
+    workqueue->queue(new Gdb_index_scan_task(gdb_index, i, this_blocker));
+
   // If doing garbage collection, the relocations have already been read.
   // Otherwise, read and scan the relocations.
   if (parameters->options().gc_sections()
@@ -876,17 +1148,31 @@ queue_final_tasks(const General_options& options,
     }
   else
     {
+      // Compress the debug sections in parallel chunks once their
+      // input sections are complete.
+      Task_token* after_input_blocker = final_blocker;
+      if (!layout->compressed_sections()->empty())
+	{
+	  after_input_blocker = new Task_token(true);
+	  after_input_blocker->add_blocker();
+	  workqueue->queue(new Compress_sections_task(
+	      layout->compressed_sections(), final_blocker,
+	      after_input_blocker));
+	}
+
       Task_token* new_final_blocker = new Task_token(true);
       new_final_blocker->add_blocker();
       Task* t = new Write_after_input_sections_task(layout, of,
-						    final_blocker,
+						    after_input_blocker,
 						    new_final_blocker);
       workqueue->queue(t);
       final_blocker = new_final_blocker;
     }
 
-  // Create tasks for tree-style build ID computation, if necessary.
-  if (strcmp(options.build_id(), "tree") == 0)
+  // Create tasks for tree-style or fast build ID computation, if
+  // necessary.
+  if (strcmp(options.build_id(), "tree") == 0
+      || strcmp(options.build_id(), "fast") == 0)
     {
       // Queue a task to compute the build id.  This will be blocked by
       // FINAL_BLOCKER, and will in turn schedule the task to close
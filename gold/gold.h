@@ -303,6 +303,14 @@ string_hash(const Char_type* s)
   return h;
 }
 
+// Compute a fast non-cryptographic 128-bit hash of the LEN bytes at
+// BUFFER, and store it in the 16 bytes at RESBLOCK.  Return RESBLOCK.
+// This has the same interface as md5_buffer.  The result does not
+// depend on the host.
+
+extern void*
+fast_hash_buffer(const char* buffer, size_t len, void* resblock);
+
 // Return whether STRING contains a wildcard character.  This is used
 // to speed up matching.
 
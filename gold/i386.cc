@@ -1015,6 +1015,21 @@ Target_i386::rel_dyn_section(Layout* layout)
       layout->add_output_section_data(".rel.dyn", elfcpp::SHT_REL,
 				      elfcpp::SHF_ALLOC, this->rel_dyn_,
 				      ORDER_DYNAMIC_RELOCS, false);
+
+      // With -z pack-relative-relocs, RELATIVE relocs go into a
+      // SHT_RELR section when they can.
+      if (parameters->options().pack_relative_relocs()
+	  && parameters->options().output_is_position_independent()
+	  && !parameters->incremental())
+	{
+	  Output_data_relr<32, false>* relr =
+	    new Output_data_relr<32, false>();
+	  layout->add_output_section_data(".relr.dyn", elfcpp::SHT_RELR,
+					  elfcpp::SHF_ALLOC, relr,
+					  ORDER_DYNAMIC_RELOCS, false);
+	  this->rel_dyn_->set_relr(relr, elfcpp::R_386_RELATIVE);
+	  layout->set_relr_dyn(relr);
+	}
     }
   return this->rel_dyn_;
 }
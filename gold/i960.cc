@@ -0,0 +1,920 @@
+// i960.cc -- i960 target support for gold.
+
+// Copyright (C) 2022 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+#include "gold.h"
+
+#include <cstring>
+
+#include "elfcpp.h"
+#include "parameters.h"
+#include "reloc.h"
+#include "i960.h"
+#include "object.h"
+#include "symtab.h"
+#include "layout.h"
+#include "output.h"
+#include "target.h"
+#include "target-reloc.h"
+#include "target-select.h"
+#include "gc.h"
+#include "icf.h"
+
+namespace
+{
+
+using namespace gold;
+
+// The i960 is only supported for statically linked, embedded images:
+// there is no ABI for dynamic linking, so there is no GOT, no PLT and
+// no dynamic relocations, and the target has no dynamic linker.  All
+// relocations are SHT_REL and keep their addend in the section
+// contents.
+
+class Target_i960 : public Sized_target<32, false>
+{
+ public:
+  Target_i960()
+    : Sized_target<32, false>(&i960_info)
+  { }
+
+  // Process the relocations to determine unreferenced sections for
+  // garbage collection.
+  void
+  gc_process_relocs(Symbol_table* symtab,
+		    Layout* layout,
+		    Sized_relobj_file<32, false>* object,
+		    unsigned int data_shndx,
+		    unsigned int sh_type,
+		    const unsigned char* prelocs,
+		    size_t reloc_count,
+		    Output_section* output_section,
+		    bool needs_special_offset_handling,
+		    size_t local_symbol_count,
+		    const unsigned char* plocal_symbols);
+
+  // Scan the relocations to look for symbol adjustments.
+  void
+  scan_relocs(Symbol_table* symtab,
+	      Layout* layout,
+	      Sized_relobj_file<32, false>* object,
+	      unsigned int data_shndx,
+	      unsigned int sh_type,
+	      const unsigned char* prelocs,
+	      size_t reloc_count,
+	      Output_section* output_section,
+	      bool needs_special_offset_handling,
+	      size_t local_symbol_count,
+	      const unsigned char* plocal_symbols);
+
+  // Relocate a section.
+  void
+  relocate_section(const Relocate_info<32, false>*,
+		   unsigned int sh_type,
+		   const unsigned char* prelocs,
+		   size_t reloc_count,
+		   Output_section* output_section,
+		   bool needs_special_offset_handling,
+		   unsigned char* view,
+		   elfcpp::Elf_types<32>::Elf_Addr view_address,
+		   section_size_type view_size,
+		   const Reloc_symbol_changes*);
+
+  // Scan the relocs during a relocatable link.
+  void
+  scan_relocatable_relocs(Symbol_table* symtab,
+			  Layout* layout,
+			  Sized_relobj_file<32, false>* object,
+			  unsigned int data_shndx,
+			  unsigned int sh_type,
+			  const unsigned char* prelocs,
+			  size_t reloc_count,
+			  Output_section* output_section,
+			  bool needs_special_offset_handling,
+			  size_t local_symbol_count,
+			  const unsigned char* plocal_symbols,
+			  Relocatable_relocs*);
+
+  // Scan the relocs for --emit-relocs.
+  void
+  emit_relocs_scan(Symbol_table* symtab,
+		   Layout* layout,
+		   Sized_relobj_file<32, false>* object,
+		   unsigned int data_shndx,
+		   unsigned int sh_type,
+		   const unsigned char* prelocs,
+		   size_t reloc_count,
+		   Output_section* output_section,
+		   bool needs_special_offset_handling,
+		   size_t local_symbol_count,
+		   const unsigned char* plocal_syms,
+		   Relocatable_relocs* rr);
+
+  // Emit relocations for a section.
+  void
+  relocate_relocs(const Relocate_info<32, false>*,
+		  unsigned int sh_type,
+		  const unsigned char* prelocs,
+		  size_t reloc_count,
+		  Output_section* output_section,
+		  elfcpp::Elf_types<32>::Elf_Off offset_in_output_section,
+		  unsigned char* view,
+		  elfcpp::Elf_types<32>::Elf_Addr view_address,
+		  section_size_type view_size,
+		  unsigned char* reloc_view,
+		  section_size_type reloc_view_size);
+
+  // Adjust the in-place addend of a PC relative relocation in a
+  // relocatable link.
+  void
+  relocate_special_relocatable(const Relocate_info<32, false>* relinfo,
+			       unsigned int sh_type,
+			       const unsigned char* preloc_in,
+			       size_t relnum,
+			       Output_section* output_section,
+			       elfcpp::Elf_types<32>::Elf_Off
+                                 offset_in_output_section,
+			       unsigned char* view,
+			       elfcpp::Elf_types<32>::Elf_Addr view_address,
+			       section_size_type view_size,
+			       unsigned char* preloc_out);
+
+  // Return whether the relocation type is one of the PC relative
+  // CTRL format relocations, which store a 24-bit displacement that
+  // is relative to the start of the section containing the reloc.
+  static bool
+  is_ip24_reloc(unsigned int r_type)
+  {
+    return (r_type == elfcpp::R_960_IP24
+	    || r_type == elfcpp::R_960_OPTCALL);
+  }
+
+ private:
+  // The class which scans relocations.
+  struct Scan
+  {
+    inline void
+    local(Symbol_table* symtab, Layout* layout, Target_i960* target,
+	  Sized_relobj_file<32, false>* object,
+	  unsigned int data_shndx,
+	  Output_section* output_section,
+	  const elfcpp::Rel<32, false>& reloc, unsigned int r_type,
+	  const elfcpp::Sym<32, false>& lsym,
+	  bool is_discarded);
+
+    inline void
+    global(Symbol_table* symtab, Layout* layout, Target_i960* target,
+	   Sized_relobj_file<32, false>* object,
+	   unsigned int data_shndx,
+	   Output_section* output_section,
+	   const elfcpp::Rel<32, false>& reloc, unsigned int r_type,
+	   Symbol* gsym);
+
+    inline bool
+    local_reloc_may_be_function_pointer(Symbol_table*, Layout*,
+					Target_i960*,
+					Sized_relobj_file<32, false>*,
+					unsigned int,
+					Output_section*,
+					const elfcpp::Rel<32, false>&,
+					unsigned int r_type,
+					const elfcpp::Sym<32, false>&)
+    {
+      return (r_type == elfcpp::R_960_32
+	      || r_type == elfcpp::R_960_OPTCALLX);
+    }
+
+    inline bool
+    global_reloc_may_be_function_pointer(Symbol_table*, Layout*,
+					 Target_i960*,
+					 Sized_relobj_file<32, false>*,
+					 unsigned int,
+					 Output_section*,
+					 const elfcpp::Rel<32, false>&,
+					 unsigned int r_type,
+					 Symbol*)
+    {
+      return (r_type == elfcpp::R_960_32
+	      || r_type == elfcpp::R_960_OPTCALLX);
+    }
+
+    static void
+    unsupported_reloc_local(Sized_relobj_file<32, false>*, unsigned int r_type);
+
+    static void
+    unsupported_reloc_global(Sized_relobj_file<32, false>*, unsigned int r_type,
+			     Symbol*);
+
+    static void
+    unsupported_reloc_12(Sized_relobj_file<32, false>*);
+  };
+
+  // The class which implements relocation.
+  class Relocate
+  {
+   public:
+    // Do a relocation.  Return false if the caller should not issue
+    // any warnings about this relocation.
+    inline bool
+    relocate(const Relocate_info<32, false>*, unsigned int,
+	     Target_i960*, Output_section*, size_t, const unsigned char*,
+	     const Sized_symbol<32>*, const Symbol_value<32>*,
+	     unsigned char*, elfcpp::Elf_types<32>::Elf_Addr,
+	     section_size_type);
+  };
+
+  // A class for inquiring about properties of a relocation,
+  // used while scanning relocs during a relocatable link and
+  // garbage collection.
+  class Classify_reloc :
+      public gold::Default_classify_reloc<elfcpp::SHT_REL, 32, false>
+  {
+   public:
+    typedef Reloc_types<elfcpp::SHT_REL, 32, false>::Reloc Reltype;
+
+    // Return the explicit addend of the relocation (return 0 for SHT_REL).
+    static elfcpp::Elf_types<32>::Elf_Swxword
+    get_r_addend(const Reltype*)
+    { return 0; }
+
+    // Return the size of the addend of the relocation (only used for SHT_REL).
+    static unsigned int
+    get_size_for_reloc(unsigned int, Relobj*);
+  };
+
+  // The strategy to use for relocations in a relocatable link.  The
+  // 24-bit CTRL displacements cannot be adjusted by the generic code,
+  // both because they do not occupy a whole word and because their
+  // in-place addend depends on the offset of the reloc.
+  class Scan_relocatable_relocs :
+      public gold::Default_scan_relocatable_relocs<Classify_reloc>
+  {
+   public:
+    inline Relocatable_relocs::Reloc_strategy
+    local_non_section_strategy(unsigned int r_type, Relobj* object,
+			       unsigned int r_sym)
+    {
+      if (Target_i960::is_ip24_reloc(r_type))
+	return Relocatable_relocs::RELOC_SPECIAL;
+      return gold::Default_scan_relocatable_relocs<Classify_reloc>::
+	local_non_section_strategy(r_type, object, r_sym);
+    }
+
+    inline Relocatable_relocs::Reloc_strategy
+    local_section_strategy(unsigned int r_type, Relobj* object)
+    {
+      if (Target_i960::is_ip24_reloc(r_type))
+	return Relocatable_relocs::RELOC_SPECIAL;
+      return gold::Default_scan_relocatable_relocs<Classify_reloc>::
+	local_section_strategy(r_type, object);
+    }
+
+    inline Relocatable_relocs::Reloc_strategy
+    global_strategy(unsigned int r_type, Relobj*, unsigned int)
+    {
+      if (Target_i960::is_ip24_reloc(r_type))
+	return Relocatable_relocs::RELOC_SPECIAL;
+      return Relocatable_relocs::RELOC_COPY;
+    }
+  };
+
+  // Information about this specific target which we pass to the
+  // general Target structure.
+  static const Target::Target_info i960_info;
+};
+
+const Target::Target_info Target_i960::i960_info =
+{
+  32,			// size
+  false,		// is_big_endian
+  elfcpp::EM_960,	// machine_code
+  false,		// has_make_symbol
+  false,		// has_resolve
+  false,		// has_code_fill
+  false,		// is_default_stack_executable
+  false,		// can_icf_inline_merge_sections
+  '\0',			// wrap_char
+  NULL,			// dynamic_linker
+  0x0,			// default_text_segment_address
+  0x1000,		// abi_pagesize (overridable by -z max-page-size)
+  0x1000,		// common_pagesize (overridable by -z common-page-size)
+  false,                // isolate_execinstr
+  0,                    // rosegment_gap
+  elfcpp::SHN_UNDEF,	// small_common_shndx
+  elfcpp::SHN_UNDEF,	// large_common_shndx
+  0,			// small_common_section_flags
+  0,			// large_common_section_flags
+  NULL,			// attributes_section
+  NULL,			// attributes_vendor
+  "_start",		// entry_symbol_name
+  0,			// hash_entry_size
+  elfcpp::SHT_PROGBITS,	// unwind_section_type
+};
+
+// Relocation routines specific to the i960.
+
+class I960_relocate_functions : public Relocate_functions<32, false>
+{
+ public:
+  typedef elfcpp::Swap<32, false>::Valtype Valtype;
+
+  // Apply a 24-bit CTRL format displacement (R_960_IP24 and
+  // R_960_OPTCALL).  The assembler stores the displacement relative
+  // to the start of the section, rather than to the reloc itself, so
+  // SECTION_ADDRESS is the address of the start of the input section.
+  static inline Reloc_status
+  ip24(unsigned char* view,
+       const Sized_relobj_file<32, false>* object,
+       const Symbol_value<32>* psymval,
+       elfcpp::Elf_types<32>::Elf_Addr section_address)
+  {
+    Valtype* wv = reinterpret_cast<Valtype*>(view);
+    Valtype val = elfcpp::Swap<32, false>::readval(wv);
+    int32_t addend = Bits<24>::sign_extend32(val & 0x00ffffff);
+    Address reloc = psymval->value(object, addend) - section_address;
+    val = (val & ~0x00ffffff) | (reloc & 0x00ffffff);
+    elfcpp::Swap<32, false>::writeval(wv, val);
+    return (Bits<24>::has_overflow32(reloc)
+	    ? RELOC_OVERFLOW
+	    : RELOC_OK);
+  }
+
+  // Add DELTA to the 24-bit CTRL format displacement at VIEW.  This is
+  // used to rebase the in-place addend in a relocatable link.
+  static inline Reloc_status
+  adjust_ip24(unsigned char* view, int32_t delta)
+  {
+    Valtype* wv = reinterpret_cast<Valtype*>(view);
+    Valtype val = elfcpp::Swap<32, false>::readval(wv);
+    int32_t addend = Bits<24>::sign_extend32(val & 0x00ffffff);
+    Address reloc = addend + delta;
+    val = (val & ~0x00ffffff) | (reloc & 0x00ffffff);
+    elfcpp::Swap<32, false>::writeval(wv, val);
+    return (Bits<24>::has_overflow32(reloc)
+	    ? RELOC_OVERFLOW
+	    : RELOC_OK);
+  }
+
+  // Subtract the symbol value from the 32-bit word at VIEW
+  // (R_960_SUB).  The assembler pairs this with an R_960_32 at the
+  // same offset to express the difference of two symbols.
+  static inline void
+  sub32(unsigned char* view,
+	const Sized_relobj_file<32, false>* object,
+	const Symbol_value<32>* psymval)
+  {
+    Valtype* wv = reinterpret_cast<Valtype*>(view);
+    Valtype val = elfcpp::Swap<32, false>::readval(wv);
+    elfcpp::Swap<32, false>::writeval(wv, val - psymval->value(object, 0));
+  }
+};
+
+// Report an unsupported relocation against a local symbol.
+
+void
+Target_i960::Scan::unsupported_reloc_local(Sized_relobj_file<32, false>* object,
+					   unsigned int r_type)
+{
+  gold_error(_("%s: unsupported reloc %u against local symbol"),
+	     object->name().c_str(), r_type);
+}
+
+// Report an unsupported relocation against a global symbol.
+
+void
+Target_i960::Scan::unsupported_reloc_global(
+    Sized_relobj_file<32, false>* object,
+    unsigned int r_type,
+    Symbol* gsym)
+{
+  gold_error(_("%s: unsupported reloc %u against global symbol %s"),
+	     object->name().c_str(), r_type, gsym->demangled_name().c_str());
+}
+
+// Report an R_960_12 relocation.  Neither gas nor the BFD linker
+// supports this MEMA format displacement, so no tools produce it.
+
+void
+Target_i960::Scan::unsupported_reloc_12(Sized_relobj_file<32, false>* object)
+{
+  gold_error(_("%s: unsupported reloc R_960_12 (12-bit MEMA displacement)"),
+	     object->name().c_str());
+}
+
+// Scan a relocation for a local symbol.
+
+inline void
+Target_i960::Scan::local(Symbol_table*,
+			 Layout*,
+			 Target_i960*,
+			 Sized_relobj_file<32, false>* object,
+			 unsigned int,
+			 Output_section*,
+			 const elfcpp::Rel<32, false>&,
+			 unsigned int r_type,
+			 const elfcpp::Sym<32, false>&,
+			 bool is_discarded)
+{
+  if (is_discarded)
+    return;
+
+  switch (r_type)
+    {
+    case elfcpp::R_960_NONE:
+    case elfcpp::R_960_32:
+    case elfcpp::R_960_SUB:
+    case elfcpp::R_960_OPTCALLX:
+    case elfcpp::R_960_IP24:
+    case elfcpp::R_960_OPTCALL:
+    case elfcpp::R_960_ALIGN:
+      // Nothing to do; there are no dynamic relocations.
+      break;
+
+    case elfcpp::R_960_12:
+      unsupported_reloc_12(object);
+      break;
+
+    default:
+      unsupported_reloc_local(object, r_type);
+      break;
+    }
+}
+
+// Scan a relocation for a global symbol.
+
+inline void
+Target_i960::Scan::global(Symbol_table*,
+			  Layout*,
+			  Target_i960*,
+			  Sized_relobj_file<32, false>* object,
+			  unsigned int,
+			  Output_section*,
+			  const elfcpp::Rel<32, false>&,
+			  unsigned int r_type,
+			  Symbol* gsym)
+{
+  switch (r_type)
+    {
+    case elfcpp::R_960_NONE:
+    case elfcpp::R_960_32:
+    case elfcpp::R_960_SUB:
+    case elfcpp::R_960_OPTCALLX:
+    case elfcpp::R_960_IP24:
+    case elfcpp::R_960_OPTCALL:
+    case elfcpp::R_960_ALIGN:
+      // Nothing to do; there are no dynamic relocations, and a link
+      // with a dynamic object has already been rejected.
+      break;
+
+    case elfcpp::R_960_12:
+      unsupported_reloc_12(object);
+      break;
+
+    default:
+      unsupported_reloc_global(object, r_type, gsym);
+      break;
+    }
+}
+
+// Process relocations for gc.
+
+void
+Target_i960::gc_process_relocs(Symbol_table* symtab,
+			       Layout* layout,
+			       Sized_relobj_file<32, false>* object,
+			       unsigned int data_shndx,
+			       unsigned int,
+			       const unsigned char* prelocs,
+			       size_t reloc_count,
+			       Output_section* output_section,
+			       bool needs_special_offset_handling,
+			       size_t local_symbol_count,
+			       const unsigned char* plocal_symbols)
+{
+  gold::gc_process_relocs<32, false, Target_i960, Scan, Classify_reloc>(
+    symtab,
+    layout,
+    this,
+    object,
+    data_shndx,
+    prelocs,
+    reloc_count,
+    output_section,
+    needs_special_offset_handling,
+    local_symbol_count,
+    plocal_symbols);
+}
+
+// Scan relocations for a section.
+
+void
+Target_i960::scan_relocs(Symbol_table* symtab,
+			 Layout* layout,
+			 Sized_relobj_file<32, false>* object,
+			 unsigned int data_shndx,
+			 unsigned int sh_type,
+			 const unsigned char* prelocs,
+			 size_t reloc_count,
+			 Output_section* output_section,
+			 bool needs_special_offset_handling,
+			 size_t local_symbol_count,
+			 const unsigned char* plocal_symbols)
+{
+  if (sh_type == elfcpp::SHT_RELA)
+    {
+      gold_error(_("%s: unsupported RELA reloc section"),
+		 object->name().c_str());
+      return;
+    }
+
+  gold::scan_relocs<32, false, Target_i960, Scan, Classify_reloc>(
+    symtab,
+    layout,
+    this,
+    object,
+    data_shndx,
+    prelocs,
+    reloc_count,
+    output_section,
+    needs_special_offset_handling,
+    local_symbol_count,
+    plocal_symbols);
+}
+
+// Perform a relocation.
+
+inline bool
+Target_i960::Relocate::relocate(const Relocate_info<32, false>* relinfo,
+				unsigned int,
+				Target_i960*,
+				Output_section*,
+				size_t relnum,
+				const unsigned char* preloc,
+				const Sized_symbol<32>* gsym,
+				const Symbol_value<32>* psymval,
+				unsigned char* view,
+				elfcpp::Elf_types<32>::Elf_Addr address,
+				section_size_type)
+{
+  if (view == NULL)
+    return true;
+
+  const elfcpp::Rel<32, false> rel(preloc);
+  unsigned int r_type = elfcpp::elf_r_type<32>(rel.get_r_info());
+  const Sized_relobj_file<32, false>* object = relinfo->object;
+
+  I960_relocate_functions::Reloc_status reloc_status =
+    I960_relocate_functions::RELOC_OK;
+
+  switch (r_type)
+    {
+    case elfcpp::R_960_NONE:
+    case elfcpp::R_960_ALIGN:
+      // gold does not relax, so alignment is already right.
+      break;
+
+    case elfcpp::R_960_12:
+      // Already reported by Scan.
+      break;
+
+    case elfcpp::R_960_32:
+    case elfcpp::R_960_OPTCALLX:
+      // gold does not relax callx, so its displacement is a plain
+      // 32-bit address.
+      Relocate_functions<32, false>::rel32(view, object, psymval);
+      break;
+
+    case elfcpp::R_960_SUB:
+      I960_relocate_functions::sub32(view, object, psymval);
+      break;
+
+    case elfcpp::R_960_IP24:
+    case elfcpp::R_960_OPTCALL:
+      // The ELF object format has no way to mark a leafproc or a
+      // sysproc, so an optimizable callj is always a plain call.
+      reloc_status = I960_relocate_functions::ip24(view, object, psymval,
+						   address - rel.get_r_offset());
+      break;
+
+    default:
+      gold_error_at_location(relinfo, relnum, rel.get_r_offset(),
+			     _("unsupported reloc %u"),
+			     r_type);
+      break;
+    }
+
+  if (reloc_status == I960_relocate_functions::RELOC_OVERFLOW)
+    {
+      if (gsym == NULL)
+	gold_error_at_location(relinfo, relnum, rel.get_r_offset(),
+			       _("relocation overflow"));
+      else
+	gold_error_at_location(relinfo, relnum, rel.get_r_offset(),
+			       _("relocation overflow: reference to '%s'"),
+			       gsym->name());
+    }
+
+  return true;
+}
+
+// Relocate section data.
+
+void
+Target_i960::relocate_section(const Relocate_info<32, false>* relinfo,
+			      unsigned int sh_type,
+			      const unsigned char* prelocs,
+			      size_t reloc_count,
+			      Output_section* output_section,
+			      bool needs_special_offset_handling,
+			      unsigned char* view,
+			      elfcpp::Elf_types<32>::Elf_Addr address,
+			      section_size_type view_size,
+			      const Reloc_symbol_changes* reloc_symbol_changes)
+{
+  gold_assert(sh_type == elfcpp::SHT_REL);
+
+  gold::relocate_section<32, false, Target_i960, Relocate,
+			 gold::Default_comdat_behavior, Classify_reloc>(
+    relinfo,
+    this,
+    prelocs,
+    reloc_count,
+    output_section,
+    needs_special_offset_handling,
+    view,
+    address,
+    view_size,
+    reloc_symbol_changes);
+}
+
+// Return the size of a relocation while scanning during a relocatable
+// link.
+
+unsigned int
+Target_i960::Classify_reloc::get_size_for_reloc(
+    unsigned int r_type,
+    Relobj* object)
+{
+  switch (r_type)
+    {
+    case elfcpp::R_960_NONE:
+    case elfcpp::R_960_ALIGN:
+      return 0;
+
+    case elfcpp::R_960_32:
+    case elfcpp::R_960_SUB:
+    case elfcpp::R_960_OPTCALLX:
+    case elfcpp::R_960_IP24:
+    case elfcpp::R_960_OPTCALL:
+      return 4;
+
+    default:
+      object->error(_("unsupported reloc %u in object file"), r_type);
+      return 0;
+    }
+}
+
+// Scan the relocs during a relocatable link.
+
+void
+Target_i960::scan_relocatable_relocs(Symbol_table* symtab,
+				     Layout* layout,
+				     Sized_relobj_file<32, false>* object,
+				     unsigned int data_shndx,
+				     unsigned int sh_type,
+				     const unsigned char* prelocs,
+				     size_t reloc_count,
+				     Output_section* output_section,
+				     bool needs_special_offset_handling,
+				     size_t local_symbol_count,
+				     const unsigned char* plocal_symbols,
+				     Relocatable_relocs* rr)
+{
+  gold_assert(sh_type == elfcpp::SHT_REL);
+
+  gold::scan_relocatable_relocs<32, false, Scan_relocatable_relocs>(
+    symtab,
+    layout,
+    object,
+    data_shndx,
+    prelocs,
+    reloc_count,
+    output_section,
+    needs_special_offset_handling,
+    local_symbol_count,
+    plocal_symbols,
+    rr);
+}
+
+// Scan the relocs for --emit-relocs.
+
+void
+Target_i960::emit_relocs_scan(Symbol_table* symtab,
+			      Layout* layout,
+			      Sized_relobj_file<32, false>* object,
+			      unsigned int data_shndx,
+			      unsigned int sh_type,
+			      const unsigned char* prelocs,
+			      size_t reloc_count,
+			      Output_section* output_section,
+			      bool needs_special_offset_handling,
+			      size_t local_symbol_count,
+			      const unsigned char* plocal_syms,
+			      Relocatable_relocs* rr)
+{
+  typedef gold::Default_emit_relocs_strategy<Classify_reloc>
+      Emit_relocs_strategy;
+
+  gold_assert(sh_type == elfcpp::SHT_REL);
+
+  gold::scan_relocatable_relocs<32, false, Emit_relocs_strategy>(
+    symtab,
+    layout,
+    object,
+    data_shndx,
+    prelocs,
+    reloc_count,
+    output_section,
+    needs_special_offset_handling,
+    local_symbol_count,
+    plocal_syms,
+    rr);
+}
+
+// Emit relocations for a section.
+
+void
+Target_i960::relocate_relocs(
+    const Relocate_info<32, false>* relinfo,
+    unsigned int sh_type,
+    const unsigned char* prelocs,
+    size_t reloc_count,
+    Output_section* output_section,
+    elfcpp::Elf_types<32>::Elf_Off offset_in_output_section,
+    unsigned char* view,
+    elfcpp::Elf_types<32>::Elf_Addr view_address,
+    section_size_type view_size,
+    unsigned char* reloc_view,
+    section_size_type reloc_view_size)
+{
+  gold_assert(sh_type == elfcpp::SHT_REL);
+
+  gold::relocate_relocs<32, false, Classify_reloc>(
+    relinfo,
+    prelocs,
+    reloc_count,
+    output_section,
+    offset_in_output_section,
+    view,
+    view_address,
+    view_size,
+    reloc_view,
+    reloc_view_size);
+}
+
+// Perform target-specific processing in a relocatable link.  This is
+// only used for the 24-bit CTRL format relocations, whose in-place
+// addend is relative to the start of the section containing the
+// reloc.  When that section moves within its output section, the
+// addend has to move the other way.
+
+void
+Target_i960::relocate_special_relocatable(
+    const Relocate_info<32, false>* relinfo,
+    unsigned int sh_type,
+    const unsigned char* preloc_in,
+    size_t relnum,
+    Output_section* output_section,
+    elfcpp::Elf_types<32>::Elf_Off offset_in_output_section,
+    unsigned char* view,
+    elfcpp::Elf_types<32>::Elf_Addr view_address,
+    section_size_type,
+    unsigned char* preloc_out)
+{
+  gold_assert(sh_type == elfcpp::SHT_REL);
+
+  typedef Reloc_types<elfcpp::SHT_REL, 32, false>::Reloc Reltype;
+  typedef Reloc_types<elfcpp::SHT_REL, 32, false>::Reloc_write
+    Reltype_write;
+  typedef elfcpp::Elf_types<32>::Elf_Addr Address;
+  const Address invalid_address = static_cast<Address>(0) - 1;
+
+  Sized_relobj_file<32, false>* object = relinfo->object;
+  const unsigned int local_count = object->local_symbol_count();
+
+  Reltype reloc(preloc_in);
+  Reltype_write reloc_write(preloc_out);
+
+  elfcpp::Elf_types<32>::Elf_WXword r_info = reloc.get_r_info();
+  const unsigned int r_sym = elfcpp::elf_r_sym<32>(r_info);
+  const unsigned int r_type = elfcpp::elf_r_type<32>(r_info);
+  gold_assert(is_ip24_reloc(r_type));
+
+  // Get the new symbol index, and the amount by which the target
+  // moved relative to the start of its output section.  For a global
+  // symbol or a local non-section symbol, the symbol value accounts
+  // for any movement.
+  unsigned int new_symndx;
+  int32_t target_delta = 0;
+  if (r_sym >= local_count)
+    {
+      const Symbol* gsym = object->global_symbol(r_sym);
+      gold_assert(gsym != NULL);
+      if (gsym->is_forwarder())
+	gsym = relinfo->symtab->resolve_forwards(gsym);
+      gold_assert(gsym->has_symtab_index());
+      new_symndx = gsym->symtab_index();
+    }
+  else if (!object->local_symbol(r_sym)->is_section_symbol())
+    {
+      new_symndx = object->symtab_index(r_sym);
+      gold_assert(new_symndx != -1U);
+    }
+  else
+    {
+      bool is_ordinary;
+      unsigned int shndx = object->local_symbol_input_shndx(r_sym,
+							    &is_ordinary);
+      gold_assert(is_ordinary);
+      Output_section* os = object->output_section(shndx);
+      gold_assert(os != NULL);
+      gold_assert(os->needs_symtab_index());
+      new_symndx = os->symtab_index();
+      target_delta = object->local_symbol(r_sym)->value(object, 0);
+      if (!parameters->options().relocatable())
+	target_delta -= os->address();
+    }
+
+  // Get the new offset--the location in the output section where
+  // this relocation should be applied.
+  Address offset = reloc.get_r_offset();
+  Address new_offset;
+  if (offset_in_output_section != invalid_address)
+    new_offset = offset + offset_in_output_section;
+  else
+    {
+      section_offset_type sot_offset =
+	convert_types<section_offset_type, Address>(offset);
+      section_offset_type new_sot_offset =
+	output_section->output_offset(object, relinfo->data_shndx,
+				      sot_offset);
+      gold_assert(new_sot_offset != -1);
+      new_offset = new_sot_offset;
+    }
+  int32_t reloc_delta = new_offset - offset;
+
+  // In an object file, r_offset is an offset within the section.
+  // In an executable or dynamic object, generated by
+  // --emit-relocs, r_offset is an absolute address.
+  if (!parameters->options().relocatable())
+    {
+      new_offset += view_address;
+      if (offset_in_output_section != invalid_address)
+	new_offset -= offset_in_output_section;
+    }
+
+  reloc_write.put_r_offset(new_offset);
+  reloc_write.put_r_info(elfcpp::elf_r_info<32>(new_symndx, r_type));
+
+  if (I960_relocate_functions::adjust_ip24(view + offset,
+					   target_delta - reloc_delta)
+      != I960_relocate_functions::RELOC_OK)
+    gold_error_at_location(relinfo, relnum, reloc.get_r_offset(),
+			   _("relocation overflow"));
+}
+
+// The selector for i960 object files.
+
+class Target_selector_i960 : public Target_selector
+{
+public:
+  Target_selector_i960()
+    : Target_selector(elfcpp::EM_960, 32, false,
+		      "elf32-i960", "elf32_i960")
+  { }
+
+  virtual Target*
+  do_instantiate_target()
+  { return new Target_i960(); }
+};
+
+Target_selector_i960 target_selector_i960;
+
+} // End anonymous namespace.
@@ -180,15 +180,15 @@ namespace gold
 // ID_SECTION : Vector mapping a section index to a Section_id pair.
 // IS_SECN_OR_GROUP_UNIQUE : To check if a section or a group of identical
 //                            sections is already known to be unique.
-// SECTION_CONTENTS : Contains the section's text and relocs to sections
-//                    that cannot be folded.   SECTION_CONTENTS are NULL
-//                    implies that this function is being called for the
-//                    first time before the first iteration of icf.
+// SECTION_CKSUMS : The checksum of each section's contents: the raw
+//                  contents before the first iteration of icf, and
+//                  the section's text and relocs to sections that
+//                  cannot be folded after that.
 
 static void
 preprocess_for_unique_sections(const std::vector<Section_id>& id_section,
                                std::vector<bool>* is_secn_or_group_unique,
-                               std::vector<std::string>* section_contents)
+                               const std::vector<uint32_t>& section_cksums)
 {
   Unordered_map<uint32_t, unsigned int> uniq_map;
   std::pair<Unordered_map<uint32_t, unsigned int>::iterator, bool>
@@ -199,30 +199,7 @@ preprocess_for_unique_sections(const std::vector<Section_id>& id_section,
       if ((*is_secn_or_group_unique)[i])
         continue;
 
-      uint32_t cksum;
-      Section_id secn = id_section[i];
-      section_size_type plen;
-      if (section_contents == NULL)
-        {
-          // Lock the object so we can read from it.  This is only called
-          // single-threaded from queue_middle_tasks, so it is OK to lock.
-          // Unfortunately we have no way to pass in a Task token.
-          const Task* dummy_task = reinterpret_cast<const Task*>(-1);
-          Task_lock_obj<Object> tl(dummy_task, secn.first);
-          const unsigned char* contents;
-          contents = secn.first->section_contents(secn.second,
-                                                  &plen,
-                                                  false);
-          cksum = xcrc32(contents, plen, 0xffffffff);
-        }
-      else
-        {
-          const unsigned char* contents_array = reinterpret_cast
-            <const unsigned char*>((*section_contents)[i].c_str());
-          cksum = xcrc32(contents_array, (*section_contents)[i].length(),
-                         0xffffffff);
-        }
-      uniq_map_insert = uniq_map.insert(std::make_pair(cksum, i));
+      uniq_map_insert = uniq_map.insert(std::make_pair(section_cksums[i], i));
       if (uniq_map_insert.second)
         {
           (*is_secn_or_group_unique)[i] = true;
@@ -297,6 +274,10 @@ get_rel_addend(const unsigned char* reloc_addend_ptr,
 //                      this offset.
 // END_OFFSET         : Only consider the part of the section before this
 //                      offset.
+//
+// This is called by Icf_checksum_task for the sections of different
+// objects in parallel.  It must only read from the object of SECN;
+// Icf::prepare_section_relocs arranges this.
 
 static std::string
 get_section_contents(bool first_iteration,
@@ -323,7 +304,7 @@ get_section_contents(bool first_iteration,
   Icf::Reloc_info_list& reloc_info_list = 
     symtab->icf()->reloc_info_list();
 
-  Icf::Reloc_info_list::iterator it_reloc_info_list =
+  Icf::Reloc_info_list::const_iterator it_reloc_info_list =
     reloc_info_list.find(secn);
 
   buffer.clear();
@@ -333,19 +314,19 @@ get_section_contents(bool first_iteration,
 
   if (it_reloc_info_list != reloc_info_list.end())
     {
-      Icf::Sections_reachable_info &v =
+      const Icf::Sections_reachable_info &v =
         (it_reloc_info_list->second).section_info;
       // Stores the information of the symbol pointed to by the reloc.
       const Icf::Symbol_info &s = (it_reloc_info_list->second).symbol_info;
       // Stores the addend and the symbol value.
-      Icf::Addend_info &a = (it_reloc_info_list->second).addend_info;
+      const Icf::Addend_info &a = (it_reloc_info_list->second).addend_info;
       // Stores the offset of the reloc.
       const Icf::Offset_info &o = (it_reloc_info_list->second).offset_info;
       const Icf::Reloc_addend_size_info &reloc_addend_size_info =
         (it_reloc_info_list->second).reloc_addend_size_info;
-      Icf::Sections_reachable_info::iterator it_v = v.begin();
+      Icf::Sections_reachable_info::const_iterator it_v = v.begin();
       Icf::Symbol_info::const_iterator it_s = s.begin();
-      Icf::Addend_info::iterator it_a = a.begin();
+      Icf::Addend_info::const_iterator it_a = a.begin();
       Icf::Offset_info::const_iterator it_o = o.begin();
       Icf::Reloc_addend_size_info::const_iterator it_addend_size =
         reloc_addend_size_info.begin();
@@ -367,25 +348,6 @@ get_section_contents(bool first_iteration,
 	      gsym = NULL;
 	    }
 
-	  if (first_iteration
-	      && it_v->first != NULL)
-	    {
-	      Symbol_location loc;
-	      loc.object = it_v->first;
-	      loc.shndx = it_v->second;
-	      loc.offset = convert_types<off_t, long long>(it_a->first
-							   + it_a->second);
-	      // Look through function descriptors
-	      parameters->target().function_location(&loc);
-	      if (loc.shndx != it_v->second)
-		{
-		  it_v->second = loc.shndx;
-		  // Modify symvalue/addend to the code entry.
-		  it_a->first = loc.offset;
-		  it_a->second = 0;
-		}
-	    }
-
           // ADDEND_STR stores the symbol value and addend and offset,
           // each at most 16 hex digits long.  it_a points to a pair
           // where first is the symbol value and second is the
@@ -646,6 +608,38 @@ get_section_contents(bool first_iteration,
   return buffer;
 }
 
+// For targets that use function descriptors, make the relocs in
+// RELOC_INFO which refer to a function refer to its code instead.
+// This may read from the objects the relocs refer to.
+
+static void
+adjust_function_locations(Icf::Reloc_info* reloc_info)
+{
+  Icf::Sections_reachable_info::iterator it_v =
+    reloc_info->section_info.begin();
+  Icf::Addend_info::iterator it_a = reloc_info->addend_info.begin();
+  for (; it_v != reloc_info->section_info.end(); ++it_v, ++it_a)
+    {
+      if (it_v->first == NULL)
+	continue;
+
+      Symbol_location loc;
+      loc.object = it_v->first;
+      loc.shndx = it_v->second;
+      loc.offset = convert_types<off_t, long long>(it_a->first
+						   + it_a->second);
+      // Look through function descriptors
+      parameters->target().function_location(&loc);
+      if (loc.shndx != it_v->second)
+	{
+	  it_v->second = loc.shndx;
+	  // Modify symvalue/addend to the code entry.
+	  it_a->first = loc.offset;
+	  it_a->second = 0;
+	}
+    }
+}
+
 // This function computes a checksum on each section to detect and form
 // groups of identical sections.  The first iteration does this for all 
 // sections.
@@ -653,6 +647,12 @@ get_section_contents(bool first_iteration,
 // determine if larger groups of identical sections could be formed.  The
 // first section in each group is the kept section for that group.
 //
+// The part of each section's contents which does not change from
+// iteration to iteration, and its checksum, have already been computed
+// in parallel by Icf_checksum_task.  Here we only compute the relocs
+// to sections that could be folded, in order, so that a section sees
+// the sections folded earlier in the same iteration.
+//
 // CRC32 is the checksumming algorithm and can have collisions.  That is,
 // two sections with different contents can have the same checksum. Hence,
 // a multimap is used to maintain more than one group of checksum
@@ -661,89 +661,73 @@ get_section_contents(bool first_iteration,
 //
 // Parameters  :
 // ITERATION_NUM           : Invocation instance of this function.
-// NUM_TRACKED_RELOCS : Vector reference to store the number of relocs
-//                      to ICF sections.
+// NUM_TRACKED_RELOCS : Vector of the number of relocs to ICF sections.
 // KEPT_SECTION_ID    : Vector which maps folded sections to kept sections.
 // ID_SECTION         : Vector mapping a section to an unique integer.
 // IS_SECN_OR_GROUP_UNIQUE : To check if a section or a group of identical
 //                            sections is already known to be unique.
-// SECTION_CONTENTS   : Store the section's text and relocs to non-ICF
+// SECTION_CONTENTS   : The section's text and relocs to non-ICF
 //                      sections.
+// SECTION_CKSUMS     : The checksums of SECTION_CONTENTS.
 
 static bool
 match_sections(unsigned int iteration_num,
                Symbol_table* symtab,
-               std::vector<unsigned int>* num_tracked_relocs,
+               const std::vector<unsigned int>& num_tracked_relocs,
                std::vector<unsigned int>* kept_section_id,
                const std::vector<Section_id>& id_section,
 	       const std::vector<uint64_t>& section_addraligns,
                std::vector<bool>* is_secn_or_group_unique,
-               std::vector<std::string>* section_contents)
+               const std::vector<std::string>& section_contents,
+               const std::vector<uint32_t>& section_cksums)
 {
   Unordered_multimap<uint32_t, unsigned int> section_cksum;
   std::pair<Unordered_multimap<uint32_t, unsigned int>::iterator,
             Unordered_multimap<uint32_t, unsigned int>::iterator> key_range;
   bool converged = true;
 
-  if (iteration_num == 1)
-    preprocess_for_unique_sections(id_section,
-                                   is_secn_or_group_unique,
-                                   NULL);
-  else
+  if (iteration_num > 1)
     preprocess_for_unique_sections(id_section,
                                    is_secn_or_group_unique,
-                                   section_contents);
+                                   section_cksums);
 
-  std::vector<std::string> full_section_contents;
+  // The relocs to ICF sections of the kept section of each group.
+  std::vector<std::string> kept_reloc_contents(id_section.size());
 
   for (unsigned int i = 0; i < id_section.size(); i++)
     {
-      full_section_contents.push_back("");
       if ((*is_secn_or_group_unique)[i])
         continue;
 
-      Section_id secn = id_section[i];
-
-      // Lock the object so we can read from it.  This is only called
-      // single-threaded from queue_middle_tasks, so it is OK to lock.
-      // Unfortunately we have no way to pass in a Task token.
-      const Task* dummy_task = reinterpret_cast<const Task*>(-1);
-      Task_lock_obj<Object> tl(dummy_task, secn.first);
-
-      std::string this_secn_contents;
-      uint32_t cksum;
-      std::string* this_secn_cache = &((*section_contents)[i]);
-      if (iteration_num == 1)
-        {
-          unsigned int num_relocs = 0;
-          this_secn_contents = get_section_contents(true, this_secn_cache,
-						    secn, secn, &num_relocs,
-						    symtab, (*kept_section_id));
-          (*num_tracked_relocs)[i] = num_relocs;
-        }
-      else
+      if (iteration_num > 1 && (*kept_section_id)[i] != i)
         {
-          if ((*kept_section_id)[i] != i)
-            {
-              // This section is already folded into something.
-              continue;
-            }
-          this_secn_contents = get_section_contents(false, this_secn_cache,
-						    secn, secn, NULL,
-						    symtab, (*kept_section_id));
+          // This section is already folded into something.
+          continue;
         }
 
-      const unsigned char* this_secn_contents_array =
-            reinterpret_cast<const unsigned char*>(this_secn_contents.c_str());
-      cksum = xcrc32(this_secn_contents_array, this_secn_contents.length(),
-                     0xffffffff);
+      // Passing an empty FIXED_CACHE gets just the relocs to ICF
+      // sections; the rest of the contents is in SECTION_CONTENTS.
+      Section_id secn = id_section[i];
+      std::string no_fixed_contents;
+      std::string this_secn_relocs =
+        get_section_contents(false, &no_fixed_contents, secn, secn, NULL,
+                             symtab, (*kept_section_id));
+
+      // This is the checksum of the section contents followed by
+      // the relocs.
+      const unsigned char* this_secn_relocs_array =
+            reinterpret_cast<const unsigned char*>(this_secn_relocs.c_str());
+      uint32_t cksum = xcrc32(this_secn_relocs_array,
+                              this_secn_relocs.length(),
+                              section_cksums[i]);
+      const std::string& this_secn_contents = section_contents[i];
       size_t count = section_cksum.count(cksum);
 
       if (count == 0)
         {
           // Start a group with this cksum.
           section_cksum.insert(std::make_pair(cksum, i));
-          full_section_contents[i] = this_secn_contents;
+          kept_reloc_contents[i].swap(this_secn_relocs);
         }
       else
         {
@@ -753,12 +737,17 @@ match_sections(unsigned int iteration_num,
           for (it = key_range.first; it != key_range.second; ++it)
             {
               unsigned int kept_section = it->second;
-              if (full_section_contents[kept_section].length()
-                  != this_secn_contents.length())
+              if (section_contents[kept_section].length()
+                  != this_secn_contents.length()
+                  || kept_reloc_contents[kept_section].length()
+                  != this_secn_relocs.length())
                   continue;
-              if (memcmp(full_section_contents[kept_section].c_str(),
+              if (memcmp(section_contents[kept_section].c_str(),
                          this_secn_contents.c_str(),
-                         this_secn_contents.length()) != 0)
+                         this_secn_contents.length()) != 0
+                  || memcmp(kept_reloc_contents[kept_section].c_str(),
+                            this_secn_relocs.c_str(),
+                            this_secn_relocs.length()) != 0)
                   continue;
 
 	      // Check section alignment here.
@@ -775,8 +764,8 @@ match_sections(unsigned int iteration_num,
 		{
 		  (*kept_section_id)[kept_section] = i;
 		  it->second = i;
-		  full_section_contents[kept_section].swap(
-		      full_section_contents[i]);
+		  kept_reloc_contents[kept_section].swap(
+		      kept_reloc_contents[i]);
 		}
 
               converged = false;
@@ -786,12 +775,12 @@ match_sections(unsigned int iteration_num,
             {
               // Create a new group for this cksum.
               section_cksum.insert(std::make_pair(cksum, i));
-              full_section_contents[i] = this_secn_contents;
+              kept_reloc_contents[i].swap(this_secn_relocs);
             }
         }
       // If there are no relocs to foldable sections do not process
       // this section any further.
-      if (iteration_num == 1 && (*num_tracked_relocs)[i] == 0)
+      if (iteration_num == 1 && num_tracked_relocs[i] == 0)
         (*is_secn_or_group_unique)[i] = true;
     }
 
@@ -944,18 +933,17 @@ Icf::add_ehframe_links(Relobj* object, unsigned int ehframe_shndx,
 }
 
 // This is the main ICF function called in gold.cc.  This does the
-// initialization and calls match_sections repeatedly (thrice by default)
-// which computes the crc checksums and detects identical functions.
+// initialization and queues the tasks which compute the crc checksums
+// of the sections in parallel.  When they are done, Icf_match_task
+// calls match_sections repeatedly (thrice by default) which detects
+// identical functions.
 
 void
 Icf::find_identical_sections(const Input_objects* input_objects,
-                             Symbol_table* symtab)
+                             Symbol_table* symtab, const Task* task,
+                             Workqueue* workqueue, Task_token* next_blocker)
 {
   unsigned int section_num = 0;
-  std::vector<unsigned int> num_tracked_relocs;
-  std::vector<uint64_t> section_addraligns;
-  std::vector<bool> is_secn_or_group_unique;
-  std::vector<std::string> section_contents;
   const Target& target = parameters->target();
 
   // Decide which sections are possible candidates first.
@@ -964,12 +952,9 @@ Icf::find_identical_sections(const Input_objects* input_objects,
        p != input_objects->relobj_end();
        ++p)
     {
-      // Lock the object so we can read from it.  This is only called
-      // single-threaded from queue_middle_tasks, so it is OK to lock.
-      // Unfortunately we have no way to pass in a Task token.
-      const Task* dummy_task = reinterpret_cast<const Task*>(-1);
-      Task_lock_obj<Object> tl(dummy_task, *p);
+      Task_lock_obj<Object> tl(task, *p);
       std::vector<unsigned int> eh_frame_ind;
+      unsigned int first_section = section_num;
 
       for (unsigned int i = 0; i < (*p)->shnum(); ++i)
         {
@@ -1001,13 +986,16 @@ Icf::find_identical_sections(const Input_objects* input_objects,
           this->id_section_.push_back(Section_id(*p, i));
           this->section_id_[Section_id(*p, i)] = section_num;
           this->kept_section_id_.push_back(section_num);
-          num_tracked_relocs.push_back(0);
-	  section_addraligns.push_back((*p)->section_addralign(i));
-          is_secn_or_group_unique.push_back(false);
-          section_contents.push_back("");
+	  this->section_addraligns_.push_back((*p)->section_addralign(i));
           section_num++;
         }
 
+      if (section_num > first_section)
+	{
+	  this->candidate_objects_.push_back(*p);
+	  this->object_first_section_.push_back(first_section);
+	}
+
       for (std::vector<unsigned int>::iterator it_eh_ind = eh_frame_ind.begin();
 	   it_eh_ind != eh_frame_ind.end(); ++it_eh_ind)
 	{
@@ -1034,6 +1022,195 @@ Icf::find_identical_sections(const Input_objects* input_objects,
 	}
     }
 
+  this->object_first_section_.push_back(section_num);
+  this->num_tracked_relocs_.resize(section_num, 0);
+  this->is_secn_or_group_unique_.resize(section_num, false);
+  this->is_contents_ready_.resize(section_num, false);
+  this->section_contents_.resize(section_num);
+  this->section_cksums_.resize(section_num, 0);
+
+  // Start by computing the checksums of the raw section contents.
+  this->queue_checksum_tasks(workqueue, symtab, false, next_blocker);
+}
+
+// Queue an Icf_checksum_task for each object with candidate sections
+// which need a checksum, and an Icf_match_task to run when they are
+// done.
+
+void
+Icf::queue_checksum_tasks(Workqueue* workqueue, Symbol_table* symtab,
+                          bool fixed_contents, Task_token* final_blocker)
+{
+  std::vector<unsigned int> objects;
+  for (unsigned int i = 0; i < this->candidate_objects_.size(); ++i)
+    {
+      if (fixed_contents)
+	{
+	  // Skip objects whose sections are all unique or ready.
+	  unsigned int j;
+	  for (j = this->object_first_section_[i];
+	       j < this->object_first_section_[i + 1];
+	       ++j)
+	    if (!this->is_secn_or_group_unique_[j]
+		&& !this->is_contents_ready_[j])
+	      break;
+	  if (j == this->object_first_section_[i + 1])
+	    continue;
+	}
+      objects.push_back(i);
+    }
+
+  // Add all the blockers before queuing any task, since a queued task
+  // may finish and release its blocker on another thread right away.
+  Task_token* this_blocker = new Task_token(true);
+  this_blocker->add_blockers(objects.size());
+  for (unsigned int k = 0; k < objects.size(); ++k)
+    {
+      unsigned int i = objects[k];
+      workqueue->queue(new Icf_checksum_task(this, symtab, i,
+					     this->candidate_objects_[i],
+					     fixed_contents, this_blocker));
+    }
+  workqueue->queue(new Icf_match_task(this, symtab, fixed_contents,
+				      this_blocker, final_blocker));
+}
+
+// Compute the checksums of the candidate sections of an object.  The
+// object is locked by the calling Icf_checksum_task.
+
+void
+Icf::checksum_object_sections(unsigned int object_index, Symbol_table* symtab,
+                              bool fixed_contents)
+{
+  for (unsigned int i = this->object_first_section_[object_index];
+       i < this->object_first_section_[object_index + 1];
+       ++i)
+    {
+      Section_id secn = this->id_section_[i];
+      if (!fixed_contents)
+	{
+	  section_size_type plen;
+	  const unsigned char* contents;
+	  contents = secn.first->section_contents(secn.second, &plen, false);
+	  this->section_cksums_[i] = xcrc32(contents, plen, 0xffffffff);
+	  continue;
+	}
+
+      if (this->is_secn_or_group_unique_[i] || this->is_contents_ready_[i])
+	continue;
+
+      unsigned int num_relocs = 0;
+      get_section_contents(true, &this->section_contents_[i], secn, secn,
+			   &num_relocs, symtab, this->kept_section_id_);
+      this->num_tracked_relocs_[i] = num_relocs;
+      const unsigned char* contents_array = reinterpret_cast
+	<const unsigned char*>(this->section_contents_[i].c_str());
+      this->section_cksums_[i] = xcrc32(contents_array,
+					this->section_contents_[i].length(),
+					0xffffffff);
+    }
+}
+
+// Before computing the contents of the sections which may still be
+// folded, adjust their relocs for function descriptors.  Computing
+// the contents of a section normally only reads from its own object,
+// so the sections of different objects can be handled in parallel.
+// A section with a reloc to a merge section of another object, or
+// whose identity includes a region of another object, reads from that
+// object, so its contents are computed here instead.
+
+void
+Icf::prepare_section_relocs(const Task* task, Symbol_table* symtab)
+{
+  Unordered_set<Section_id, Section_id_hash> adjusted;
+  for (unsigned int i = 0; i < this->candidate_objects_.size(); ++i)
+    {
+      Relobj* object = this->candidate_objects_[i];
+      Task_lock_obj<Object> tl(task, object);
+
+      for (unsigned int j = this->object_first_section_[i];
+	   j < this->object_first_section_[i + 1];
+	   ++j)
+	{
+	  if (this->is_secn_or_group_unique_[j])
+	    continue;
+
+	  Section_id secn = this->id_section_[j];
+	  bool reads_other_object = false;
+
+	  Reloc_info_list::iterator it_rel = this->reloc_info_list_.find(secn);
+	  if (it_rel != this->reloc_info_list_.end())
+	    {
+	      if (adjusted.insert(secn).second)
+		adjust_function_locations(&it_rel->second);
+
+	      const Sections_reachable_info& v = it_rel->second.section_info;
+	      for (Sections_reachable_info::const_iterator p = v.begin();
+		   p != v.end() && !reads_other_object;
+		   ++p)
+		{
+		  if (p->first != NULL
+		      && p->first != object
+		      && ((p->first->section_flags(p->second)
+			   & elfcpp::SHF_MERGE) != 0))
+		    reads_other_object = true;
+		}
+	    }
+
+	  std::pair<Extra_identity_list::const_iterator,
+		    Extra_identity_list::const_iterator>
+	    extra_range = this->extra_identity_list_.equal_range(secn);
+	  for (Extra_identity_list::const_iterator p = extra_range.first;
+	       p != extra_range.second;
+	       ++p)
+	    {
+	      const Section_id& extra_secn(p->second.section);
+	      if (extra_secn.first != object)
+		reads_other_object = true;
+	      Reloc_info_list::iterator it_extra =
+		this->reloc_info_list_.find(extra_secn);
+	      if (it_extra != this->reloc_info_list_.end()
+		  && adjusted.insert(extra_secn).second)
+		adjust_function_locations(&it_extra->second);
+	    }
+
+	  if (reads_other_object)
+	    {
+	      unsigned int num_relocs = 0;
+	      get_section_contents(true, &this->section_contents_[j], secn,
+				   secn, &num_relocs, symtab,
+				   this->kept_section_id_);
+	      this->num_tracked_relocs_[j] = num_relocs;
+	      const unsigned char* contents_array = reinterpret_cast
+		<const unsigned char*>(this->section_contents_[j].c_str());
+	      this->section_cksums_[j] =
+		xcrc32(contents_array, this->section_contents_[j].length(),
+		       0xffffffff);
+	      this->is_contents_ready_[j] = true;
+	    }
+	}
+    }
+}
+
+// Do the serial work once the Icf_checksum_tasks for a step are done.
+// After the raw contents step, find the unique sections and queue the
+// tasks to compute the contents of the others.  After that, form the
+// groups of identical sections.
+
+void
+Icf::match_step(const Task* task, Workqueue* workqueue, Symbol_table* symtab,
+                bool fixed_contents, Task_token* final_blocker)
+{
+  if (!fixed_contents)
+    {
+      preprocess_for_unique_sections(this->id_section_,
+				     &this->is_secn_or_group_unique_,
+				     this->section_cksums_);
+      this->prepare_section_relocs(task, symtab);
+      this->queue_checksum_tasks(workqueue, symtab, true, final_blocker);
+      return;
+    }
+
   unsigned int num_iterations = 0;
 
   // Default number of iterations to run ICF is 3.
@@ -1047,9 +1224,12 @@ Icf::find_identical_sections(const Input_objects* input_objects,
     {
       num_iterations++;
       converged = match_sections(num_iterations, symtab,
-                                 &num_tracked_relocs, &this->kept_section_id_,
-                                 this->id_section_, section_addraligns,
-                                 &is_secn_or_group_unique, &section_contents);
+                                 this->num_tracked_relocs_,
+                                 &this->kept_section_id_,
+                                 this->id_section_, this->section_addraligns_,
+                                 &this->is_secn_or_group_unique_,
+                                 this->section_contents_,
+                                 this->section_cksums_);
     }
 
   if (parameters->options().print_icf_sections())
@@ -1088,6 +1268,16 @@ Icf::find_identical_sections(const Input_objects* input_objects,
 
     }
 
+  // Free the memory used while matching.
+  std::vector<Relobj*>().swap(this->candidate_objects_);
+  std::vector<unsigned int>().swap(this->object_first_section_);
+  std::vector<unsigned int>().swap(this->num_tracked_relocs_);
+  std::vector<uint64_t>().swap(this->section_addraligns_);
+  std::vector<bool>().swap(this->is_secn_or_group_unique_);
+  std::vector<bool>().swap(this->is_contents_ready_);
+  std::vector<std::string>().swap(this->section_contents_);
+  std::vector<uint32_t>().swap(this->section_cksums_);
+
   this->icf_ready();
 }
 
@@ -1136,4 +1326,76 @@ Icf::get_folded_section(Relobj* dup_obj, unsigned int dup_shndx)
   return folded_section;
 }
 
+// Icf_checksum_task methods.
+
+// We need to wait for the object to be unlocked.
+
+Task_token*
+Icf_checksum_task::is_runnable()
+{
+  if (this->object_->is_locked())
+    return this->object_->token();
+  return NULL;
+}
+
+// Lock the object while we read from it, and unblock NEXT_BLOCKER
+// when done.
+
+void
+Icf_checksum_task::locks(Task_locker* tl)
+{
+  Task_token* token = this->object_->token();
+  if (token != NULL)
+    tl->add(this, token);
+  tl->add(this, this->next_blocker_);
+}
+
+void
+Icf_checksum_task::run(Workqueue*)
+{
+  this->icf_->checksum_object_sections(this->object_index_, this->symtab_,
+				       this->fixed_contents_);
+  this->object_->release();
+}
+
+std::string
+Icf_checksum_task::get_name() const
+{
+  return "Icf_checksum_task " + this->object_->name();
+}
+
+// Icf_match_task methods.
+
+Icf_match_task::~Icf_match_task()
+{
+  delete this->this_blocker_;
+}
+
+// We can run once all the Icf_checksum_tasks are done.
+
+Task_token*
+Icf_match_task::is_runnable()
+{
+  if (this->this_blocker_->is_blocked())
+    return this->this_blocker_;
+  return NULL;
+}
+
+// The last step unblocks FINAL_BLOCKER.  Earlier steps queue another
+// Icf_match_task to do that.
+
+void
+Icf_match_task::locks(Task_locker* tl)
+{
+  if (this->fixed_contents_)
+    tl->add(this, this->final_blocker_);
+}
+
+void
+Icf_match_task::run(Workqueue* workqueue)
+{
+  this->icf_->match_step(this, workqueue, this->symtab_,
+			 this->fixed_contents_, this->final_blocker_);
+}
+
 } // End of namespace gold.
@@ -28,6 +28,7 @@
 #include "elfcpp.h"
 #include "symtab.h"
 #include "object.h"
+#include "workqueue.h"
 
 namespace gold
 {
@@ -35,6 +36,7 @@ namespace gold
 class Object;
 class Input_objects;
 class Symbol_table;
+class Task_token;
 
 class Icf
 {
@@ -81,7 +83,10 @@ class Icf
   : id_section_(), section_id_(), kept_section_id_(),
     fptr_section_id_(),
     icf_ready_(false),
-    reloc_info_list_()
+    reloc_info_list_(),
+    candidate_objects_(), object_first_section_(), num_tracked_relocs_(),
+    section_addraligns_(), is_secn_or_group_unique_(),
+    is_contents_ready_(), section_contents_(), section_cksums_()
   { }
 
   // Returns the kept folded identical section corresponding to
@@ -90,10 +95,29 @@ class Icf
   get_folded_section(Relobj* dup_obj, unsigned int dup_shndx);
 
   // Forms groups of identical sections where the first member
-  // of each group is the kept section during folding.
+  // of each group is the kept section during folding.  TASK is the
+  // running task.  The work is done by tasks queued on WORKQUEUE; the
+  // last of them unblocks NEXT_BLOCKER when the groups are ready.
   void
   find_identical_sections(const Input_objects* input_objects,
-                          Symbol_table* symtab);
+                          Symbol_table* symtab, const Task* task,
+                          Workqueue* workqueue, Task_token* next_blocker);
+
+  // Compute the checksums of the candidate sections from the
+  // OBJECT_INDEX'th object with candidate sections.  If
+  // FIXED_CONTENTS is false, this is the checksum of the raw section
+  // contents; otherwise it is the checksum of the parts of the
+  // section contents and relocs which do not change from iteration
+  // to iteration.  This is called by Icf_checksum_task.
+  void
+  checksum_object_sections(unsigned int object_index, Symbol_table* symtab,
+                           bool fixed_contents);
+
+  // Do the serial work after the checksums have been computed.  This
+  // is called by Icf_match_task.
+  void
+  match_step(const Task* task, Workqueue* workqueue, Symbol_table* symtab,
+             bool fixed_contents, Task_token* final_blocker);
 
   // This is set when ICF has been run and the groups of
   // identical sections have been formed.
@@ -167,6 +191,17 @@ class Icf
   add_ehframe_links(Relobj* object, unsigned int ehframe_shndx,
 		    Reloc_info& ehframe_relocs);
 
+  // Queue an Icf_checksum_task for each object with work to do,
+  // followed by an Icf_match_task.
+  void
+  queue_checksum_tasks(Workqueue* workqueue, Symbol_table* symtab,
+                       bool fixed_contents, Task_token* final_blocker);
+
+  // Prepare the relocs of the sections which may still be folded for
+  // computing their contents in parallel.
+  void
+  prepare_section_relocs(const Task* task, Symbol_table* symtab);
+
   // Maps integers to sections.
   std::vector<Section_id> id_section_;
   // Does the reverse.
@@ -186,6 +221,108 @@ class Icf
   // Regions of other sections that should be considered part of
   // each section for ICF purposes.
   Extra_identity_list extra_identity_list_;
+
+  // The following are only used while find_identical_sections is
+  // running.  The candidate sections of each object are numbered
+  // consecutively, so that each object can be handled by a separate
+  // task.
+
+  // The objects with candidate sections.
+  std::vector<Relobj*> candidate_objects_;
+  // The number of the first candidate section of each object in
+  // candidate_objects_, followed by the total number of sections.
+  std::vector<unsigned int> object_first_section_;
+  // The number of relocs of each section to candidate sections.
+  std::vector<unsigned int> num_tracked_relocs_;
+  // The alignment of each section.
+  std::vector<uint64_t> section_addraligns_;
+  // Whether each section, or the group of identical sections it is
+  // in, is already known to be unique.
+  std::vector<bool> is_secn_or_group_unique_;
+  // Whether the fixed contents of a section were computed serially,
+  // because doing so reads from another object.
+  std::vector<bool> is_contents_ready_;
+  // The contents and relocs of each section which do not change from
+  // iteration to iteration.
+  std::vector<std::string> section_contents_;
+  // The checksum of each section's raw contents, or of its entry in
+  // section_contents_ once that has been computed.
+  std::vector<uint32_t> section_cksums_;
+};
+
+// This task computes checksums of the candidate sections of one
+// object for identical code folding.
+
+class Icf_checksum_task : public Task
+{
+ public:
+  Icf_checksum_task(Icf* icf, Symbol_table* symtab, unsigned int object_index,
+                    Relobj* object, bool fixed_contents,
+                    Task_token* next_blocker)
+    : icf_(icf), symtab_(symtab), object_index_(object_index),
+      object_(object), fixed_contents_(fixed_contents),
+      next_blocker_(next_blocker)
+  { }
+
+  // The standard Task methods.
+
+  Task_token*
+  is_runnable();
+
+  void
+  locks(Task_locker*);
+
+  void
+  run(Workqueue*);
+
+  std::string
+  get_name() const;
+
+ private:
+  Icf* icf_;
+  Symbol_table* symtab_;
+  unsigned int object_index_;
+  Relobj* object_;
+  bool fixed_contents_;
+  Task_token* next_blocker_;
+};
+
+// This task runs when all the Icf_checksum_tasks for a step have
+// completed.  It either starts the next step, or forms the groups of
+// identical sections and unblocks FINAL_BLOCKER.
+
+class Icf_match_task : public Task
+{
+ public:
+  Icf_match_task(Icf* icf, Symbol_table* symtab, bool fixed_contents,
+                 Task_token* this_blocker, Task_token* final_blocker)
+    : icf_(icf), symtab_(symtab), fixed_contents_(fixed_contents),
+      this_blocker_(this_blocker), final_blocker_(final_blocker)
+  { }
+
+  ~Icf_match_task();
+
+  // The standard Task methods.
+
+  Task_token*
+  is_runnable();
+
+  void
+  locks(Task_locker*);
+
+  void
+  run(Workqueue*);
+
+  std::string
+  get_name() const
+  { return "Icf_match_task"; }
+
+ private:
+  Icf* icf_;
+  Symbol_table* symtab_;
+  bool fixed_contents_;
+  Task_token* this_blocker_;
+  Task_token* final_blocker_;
 };
 
 // This function returns true if this section corresponds to a function that
@@ -239,18 +239,22 @@ Free_list::print_stats()
 	  program_name, Free_list::num_allocate_visits);
 }
 
-// A Hash_task computes the MD5 checksum of an array of char.
+// A Hash_task computes a checksum of an array of char, using either
+// md5_buffer or fast_hash_buffer.
 
 class Hash_task : public Task
 {
  public:
+  typedef void* (*Hash_function)(const char*, size_t, void*);
+
   Hash_task(Output_file* of,
 	    size_t offset,
 	    size_t size,
 	    unsigned char* dst,
-	    Task_token* final_blocker)
+	    Task_token* final_blocker,
+	    Hash_function hash_function)
     : of_(of), offset_(offset), size_(size), dst_(dst),
-      final_blocker_(final_blocker)
+      final_blocker_(final_blocker), hash_function_(hash_function)
   { }
 
   void
@@ -258,7 +262,8 @@ class Hash_task : public Task
   {
     const unsigned char* iv =
 	this->of_->get_input_view(this->offset_, this->size_);
-    md5_buffer(reinterpret_cast<const char*>(iv), this->size_, this->dst_);
+    this->hash_function_(reinterpret_cast<const char*>(iv), this->size_,
+			 this->dst_);
     this->of_->free_input_view(this->offset_, this->size_, iv);
   }
 
@@ -281,6 +286,7 @@ class Hash_task : public Task
   const size_t size_;
   unsigned char* const dst_;
   Task_token* const final_blocker_;
+  const Hash_function hash_function_;
 };
 
 // Layout::Relaxation_debug_check methods.
@@ -443,6 +449,7 @@ Layout::Layout(int number_of_input_files, Script_options* script_options)
     dynamic_section_(NULL),
     dynamic_symbol_(NULL),
     dynamic_data_(NULL),
+    relr_dyn_(NULL),
     eh_frame_section_(NULL),
     eh_frame_data_(NULL),
     added_eh_frame_data_(false),
@@ -451,6 +458,7 @@ Layout::Layout(int number_of_input_files, Script_options* script_options)
     build_id_note_(NULL),
     debug_abbrev_(NULL),
     debug_info_(NULL),
+    compressed_sections_(),
     group_signatures_(),
     output_file_size_(-1),
     have_added_input_section_(false),
@@ -473,7 +481,7 @@ Layout::Layout(int number_of_input_files, Script_options* script_options)
     section_order_map_(),
     section_segment_map_(),
     input_section_position_(),
-    input_section_glob_(),
+    input_section_glob_(FNM_NOESCAPE),
     incremental_base_(NULL),
     free_list_(),
     gnu_properties_()
@@ -1647,9 +1655,13 @@ Layout::add_to_gdb_index(bool is_type_unit,
       os->set_after_input_sections();
     }
 
-  this->gdb_index_data_->scan_debug_info(is_type_unit, object, symbols,
-					 symbols_size, shndx, reloc_shndx,
-					 reloc_type);
+  if (Gdb_index::should_defer_scan())
+    this->gdb_index_data_->add_deferred_scan(is_type_unit, object, shndx,
+					     reloc_shndx, reloc_type);
+  else
+    this->gdb_index_data_->scan_debug_info(is_type_unit, object, symbols,
+					   symbols_size, shndx, reloc_shndx,
+					   reloc_type);
 }
 
 // Add POSD to an output section using NAME, TYPE, and FLAGS.  Return
@@ -1696,8 +1708,13 @@ Layout::make_output_section(const char* name, elfcpp::Elf_Word type,
   if ((flags & elfcpp::SHF_ALLOC) == 0
       && strcmp(parameters->options().compress_debug_sections(), "none") != 0
       && is_compressible_debug_section(name))
-    os = new Output_compressed_section(&parameters->options(), name, type,
-				       flags);
+    {
+      Output_compressed_section* ocs =
+	new Output_compressed_section(&parameters->options(), name, type,
+				      flags);
+      this->compressed_sections_.push_back(ocs);
+      os = ocs;
+    }
   else if ((flags & elfcpp::SHF_ALLOC) == 0
 	   && parameters->options().strip_debug_non_line()
 	   && strcmp(".debug_abbrev", name) == 0)
@@ -2641,6 +2658,19 @@ Layout::restore_segments(const Segment_states* segment_states)
     }
 }
 
+// Return whether laying out the sections again may change their
+// lists of input sections, so that their states must be saved before
+// the first layout.  That happens when the target relaxes, or when a
+// linker script places the input sections.  Otherwise, the sections
+// are only laid out again because a SHT_RELR section has grown.
+
+static inline bool
+sections_change_in_relayout(const Layout* layout)
+{
+  return (parameters->target().may_relax()
+	  || layout->script_options()->saw_sections_clause());
+}
+
 // Clean up after relaxation so that sections can be laid out again.
 
 void
@@ -2652,11 +2682,13 @@ Layout::clean_up_after_relaxation()
   this->restore_segments(this->segment_states_);
 
   // Reset section addresses and file offsets
+  const bool saved_states = sections_change_in_relayout(this);
   for (Section_list::iterator p = this->section_list_.begin();
        p != this->section_list_.end();
        ++p)
     {
-      (*p)->restore_states();
+      if (saved_states)
+	(*p)->restore_states();
 
       // If an input section changes size because of relaxation,
       // we need to adjust the section offsets of all input sections.
@@ -2702,20 +2734,26 @@ Layout::reset_relax_output()
 void
 Layout::prepare_for_relaxation()
 {
-  // Create an relaxation debug check if in debugging mode.
-  if (is_debugging_enabled(DEBUG_RELAXATION))
+  // Create an relaxation debug check if in debugging mode.  Growing
+  // a SHT_RELR section moves the sections, so the dummy relaxation
+  // can not be checked then.
+  if (is_debugging_enabled(DEBUG_RELAXATION)
+      && (this->relr_dyn_ == NULL || this->relr_dyn_->empty()))
     this->relaxation_debug_check_ = new Relaxation_debug_check();
 
   // Save segment states.
   this->segment_states_ = new Segment_states();
   this->save_segments(this->segment_states_);
 
-  for(Section_list::const_iterator p = this->section_list_.begin();
-      p != this->section_list_.end();
-      ++p)
-    (*p)->save_states();
+  if (sections_change_in_relayout(this))
+    {
+      for(Section_list::const_iterator p = this->section_list_.begin();
+	  p != this->section_list_.end();
+	  ++p)
+	(*p)->save_states();
+    }
 
-  if (is_debugging_enabled(DEBUG_RELAXATION))
+  if (this->relaxation_debug_check_ != NULL)
     this->relaxation_debug_check_->check_output_data_for_reset_values(
 	this->section_list_, this->special_output_list_,
 	this->relax_output_list_);
@@ -2870,7 +2908,7 @@ Layout::relaxation_loop_body(
     off = this->set_relocatable_section_offsets(file_header, pshndx);
 
    // Verify that the dummy relaxation does not change anything.
-  if (is_debugging_enabled(DEBUG_RELAXATION))
+  if (this->relaxation_debug_check_ != NULL)
     {
       if (pass == 0)
 	this->relaxation_debug_check_->read_sections(this->section_list_);
@@ -2885,7 +2923,8 @@ Layout::relaxation_loop_body(
 // Search the list of patterns and find the position of the given section
 // name in the output section.  If the section name matches a glob
 // pattern and a non-glob name, then the non-glob position takes
-// precedence.  Return 0 if no match is found.
+// precedence.  If it matches several glob patterns, the earliest
+// position is used.  Return 0 if no match is found.
 
 unsigned int
 Layout::find_section_order_index(const std::string& section_name)
@@ -2895,19 +2934,10 @@ Layout::find_section_order_index(const std::string& section_name)
   if (map_it != this->input_section_position_.end())
     return map_it->second;
 
-  // Absolute match failed.  Linear search the glob patterns.
-  std::vector<std::string>::iterator it;
-  for (it = this->input_section_glob_.begin();
-       it != this->input_section_glob_.end();
-       ++it)
-    {
-       if (fnmatch((*it).c_str(), section_name.c_str(), FNM_NOESCAPE) == 0)
-	 {
-	   map_it = this->input_section_position_.find(*it);
-	   gold_assert(map_it != this->input_section_position_.end());
-	   return map_it->second;
-	 }
-    }
+  // Absolute match failed.  Find the first matching glob pattern.
+  unsigned int position;
+  if (this->input_section_glob_.find_first(section_name.c_str(), &position))
+    return position;
   return 0;
 }
 
@@ -2942,13 +2972,17 @@ Layout::read_layout_from_file()
 	  std::getline(in, line);
 	  continue;
 	}
-      this->input_section_position_[line] = position;
-      // Store all glob patterns in a vector.
+      // If a line appears more than once, its first position is used.
+      this->input_section_position_.insert(std::make_pair(line, position));
+      // Collect all glob patterns.  A section which matches several
+      // of them goes at the lowest position.
       if (is_wildcard_string(line.c_str()))
-	this->input_section_glob_.push_back(line);
+	this->input_section_glob_.add(line, position);
       position++;
       std::getline(in, line);
     }
+
+  this->input_section_glob_.finalize();
 }
 
 // Finalize the layout.  When this is called, we have created all the
@@ -3070,8 +3104,13 @@ Layout::finalize(const Input_objects* input_objects, Symbol_table* symtab,
   unsigned int shndx;
   int pass = 0;
 
+  // The size of a SHT_RELR section depends upon the addresses of the
+  // words it relocates, so the sections are laid out again until it
+  // stops growing, just as for relaxation.
+  bool relayout_relr = (this->relr_dyn_ != NULL && !this->relr_dyn_->empty());
+
   // Take a snapshot of the section layout as needed.
-  if (target->may_relax())
+  if (target->may_relax() || relayout_relr)
     this->prepare_for_relaxation();
 
   // Run the relaxation loop to lay out sections.
@@ -3082,8 +3121,9 @@ Layout::finalize(const Input_objects* input_objects, Symbol_table* symtab,
 				       &shndx);
       pass++;
     }
-  while (target->may_relax()
-	 && target->relax(pass, input_objects, symtab, this, task));
+  while ((target->may_relax()
+	  && target->relax(pass, input_objects, symtab, this, task))
+	 || (relayout_relr && this->relr_dyn_->update_size()));
 
   // If there is a load segment that contains the file and program headers,
   // provide a symbol __ehdr_start pointing there.
@@ -3429,7 +3469,7 @@ Layout::create_build_id()
   // set DESC to the note descriptor contents.
   size_t descsz;
   std::string desc;
-  if (strcmp(style, "md5") == 0)
+  if (strcmp(style, "md5") == 0 || strcmp(style, "fast") == 0)
     descsz = 128 / 8;
   else if ((strcmp(style, "sha1") == 0) || (strcmp(style, "tree") == 0))
     descsz = 160 / 8;
@@ -4650,6 +4690,21 @@ Layout::create_dynamic_symtab(const Input_objects* input_objects,
   unsigned int local_symcount = index;
   unsigned int forced_local_count = 0;
 
+  // A dynamic linker which does not support DT_RELR would ignore the
+  // packed relocs.  If the C library marks its support with the
+  // GLIBC_ABI_DT_RELR version, require that version.
+  if (this->relr_dyn_ != NULL && !this->relr_dyn_->empty())
+    {
+      Symbol* sym = symtab->lookup("GLIBC_ABI_DT_RELR");
+      if (sym != NULL
+	  && sym->is_from_dynobj()
+	  && sym->is_absolute()
+	  && (!sym->object()->as_needed() || sym->object()->is_needed()))
+	pversions->record_need(&this->dynpool_,
+			       static_cast<Dynobj*>(sym->object()),
+			       "GLIBC_ABI_DT_RELR");
+    }
+
   index = symtab->set_dynsym_indexes(index, &forced_local_count,
 				     pdynamic_symbols, &this->dynpool_,
 				     pversions);
@@ -4767,14 +4822,27 @@ Layout::create_dynamic_symtab(const Input_objects* input_objects,
 
   // Create the hash tables.  The Gnu-style hash table must be
   // built first, because it changes the order of the symbols
-  // in the dynamic symbol table.
-
-  if (strcmp(parameters->options().hash_style(), "gnu") == 0
-      || strcmp(parameters->options().hash_style(), "both") == 0)
+  // in the dynamic symbol table.  That order is needed to finish
+  // laying out the file, so the hash codes are computed here rather
+  // than in separate tasks; Layout::finalize runs within one task,
+  // and cannot wait for others.
+
+  const char* hash_style = parameters->options().hash_style();
+  bool want_gnu_hash = (strcmp(hash_style, "gnu") == 0
+			|| strcmp(hash_style, "both") == 0);
+  bool want_sysv_hash = (strcmp(hash_style, "sysv") == 0
+			 || strcmp(hash_style, "both") == 0);
+  std::vector<uint32_t> gnu_hashvals;
+  std::vector<uint32_t> elf_hashvals;
+  Dynobj::compute_hash_values(*pdynamic_symbols,
+			      want_sysv_hash ? &elf_hashvals : NULL,
+			      want_gnu_hash ? &gnu_hashvals : NULL);
+
+  if (want_gnu_hash)
     {
       unsigned char* phash;
       unsigned int hashlen;
-      Dynobj::create_gnu_hash_table(*pdynamic_symbols,
+      Dynobj::create_gnu_hash_table(*pdynamic_symbols, gnu_hashvals,
 				    local_symcount + forced_local_count,
 				    &phash, &hashlen);
 
@@ -4807,12 +4875,11 @@ Layout::create_dynamic_symtab(const Input_objects* input_objects,
 	}
     }
 
-  if (strcmp(parameters->options().hash_style(), "sysv") == 0
-      || strcmp(parameters->options().hash_style(), "both") == 0)
+  if (want_sysv_hash)
     {
       unsigned char* phash;
       unsigned int hashlen;
-      Dynobj::create_elf_hash_table(*pdynamic_symbols,
+      Dynobj::create_elf_hash_table(*pdynamic_symbols, elf_hashvals,
 				    local_symcount + forced_local_count,
 				    &phash, &hashlen);
 
@@ -5142,6 +5209,15 @@ Layout::add_target_dynamic_tags(bool use_rel, const Output_data* plt_got,
 	}
     }
 
+  if (this->relr_dyn_ != NULL && !this->relr_dyn_->empty())
+    {
+      Output_section* os = this->relr_dyn_->output_section();
+      odyn->add_section_address(elfcpp::DT_RELR, os);
+      odyn->add_section_size(elfcpp::DT_RELRSZ, os);
+      odyn->add_constant(elfcpp::DT_RELRENT,
+			 parameters->target().get_size() / 8);
+    }
+
   if (add_debug && !parameters->options().shared())
     {
       // The value of the DT_DEBUG tag is filled in by the dynamic
@@ -5874,9 +5950,9 @@ Layout::write_sections_after_input_sections(Output_file* of)
   this->section_headers_->write(of);
 }
 
-// If a tree-style build ID was requested, the parallel part of that computation
-// is already done, and the final hash-of-hashes is computed here.  For other
-// types of build IDs, all the work is done here.
+// If a tree-style or fast build ID was requested, the parallel part of that
+// computation is already done, and the final hash-of-hashes is computed here.
+// For other types of build IDs, all the work is done here.
 
 void
 Layout::write_build_id(Output_file* of, unsigned char* array_of_hashes,
@@ -5900,6 +5976,9 @@ Layout::write_build_id(Output_file* of, unsigned char* array_of_hashes,
 	sha1_buffer(reinterpret_cast<const char*>(iv), output_file_size, ov);
       else if (strcmp(style, "md5") == 0)
 	md5_buffer(reinterpret_cast<const char*>(iv), output_file_size, ov);
+      else if (strcmp(style, "fast") == 0)
+	fast_hash_buffer(reinterpret_cast<const char*>(iv), output_file_size,
+			 ov);
       else
 	gold_unreachable();
 
@@ -5908,9 +5987,14 @@ Layout::write_build_id(Output_file* of, unsigned char* array_of_hashes,
   else
     {
       // Non-overlapping substrings of the output file have been hashed.
-      // Compute SHA-1 hash of the hashes.
-      sha1_buffer(reinterpret_cast<const char*>(array_of_hashes),
-		  size_of_hashes, ov);
+      // Compute the hash of the hashes: SHA-1 for the tree style, and
+      // the same fast hash for the fast style.
+      if (strcmp(parameters->options().build_id(), "fast") == 0)
+	fast_hash_buffer(reinterpret_cast<const char*>(array_of_hashes),
+			 size_of_hashes, ov);
+      else
+	sha1_buffer(reinterpret_cast<const char*>(array_of_hashes),
+		    size_of_hashes, ov);
       delete[] array_of_hashes;
     }
 
@@ -6072,14 +6156,16 @@ Write_symbols_task::locks(Task_locker* tl)
   tl->add(this, this->final_blocker_);
 }
 
-// Run the task--write out the symbols.
+// Run the task--write out the symbols.  This may queue more tasks
+// which hold FINAL_BLOCKER.
 
 void
-Write_symbols_task::run(Workqueue*)
+Write_symbols_task::run(Workqueue* workqueue)
 {
   this->symtab_->write_globals(this->sympool_, this->dynpool_,
 			       this->layout_->symtab_xindex(),
-			       this->layout_->dynsym_xindex(), this->of_);
+			       this->layout_->dynsym_xindex(), this->of_,
+			       workqueue, this->final_blocker_);
 }
 
 // Write_after_input_sections_task methods.
@@ -6113,6 +6199,8 @@ Write_after_input_sections_task::run(Workqueue*)
 // Build IDs can be computed as a "flat" sha1 or md5 of a string of bytes,
 // or as a "tree" where each chunk of the string is hashed and then those
 // hashes are put into a (much smaller) string which is hashed with sha1.
+// The "fast" style is like "tree", but uses fast_hash_buffer for both
+// levels, and always splits the file into chunks.
 // We compute a checksum over the entire file because that is simplest.
 
 void
@@ -6126,28 +6214,35 @@ Build_id_task_runner::run(Workqueue* workqueue, const Task*)
   unsigned char* array_of_hashes = NULL;
   size_t size_of_hashes = 0;
 
-  if (strcmp(this->options_->build_id(), "tree") == 0
+  const bool is_fast = strcmp(this->options_->build_id(), "fast") == 0;
+  if ((is_fast
+       || (strcmp(this->options_->build_id(), "tree") == 0
+	   && (filesize
+	       >= this->options_->build_id_min_file_size_for_treehash())))
       && this->options_->build_id_chunk_size_for_treehash() > 0
-      && filesize > 0
-      && (filesize >= this->options_->build_id_min_file_size_for_treehash()))
+      && filesize > 0)
     {
-      static const size_t MD5_OUTPUT_SIZE_IN_BYTES = 16;
+      // MD5 and the fast hash both produce 16 bytes.
+      static const size_t HASH_OUTPUT_SIZE_IN_BYTES = 16;
       const size_t chunk_size =
 	  this->options_->build_id_chunk_size_for_treehash();
       const size_t num_hashes = ((filesize - 1) / chunk_size) + 1;
+      Hash_task::Hash_function hash_function =
+	is_fast ? fast_hash_buffer : md5_buffer;
       post_hash_tasks_blocker->add_blockers(num_hashes);
-      size_of_hashes = num_hashes * MD5_OUTPUT_SIZE_IN_BYTES;
+      size_of_hashes = num_hashes * HASH_OUTPUT_SIZE_IN_BYTES;
       array_of_hashes = new unsigned char[size_of_hashes];
       unsigned char *dst = array_of_hashes;
       for (size_t i = 0, src_offset = 0; i < num_hashes;
-	   i++, dst += MD5_OUTPUT_SIZE_IN_BYTES, src_offset += chunk_size)
+	   i++, dst += HASH_OUTPUT_SIZE_IN_BYTES, src_offset += chunk_size)
 	{
 	  size_t size = std::min(chunk_size, filesize - src_offset);
 	  workqueue->queue(new Hash_task(of,
 					 src_offset,
 					 size,
 					 dst,
-					 post_hash_tasks_blocker));
+					 post_hash_tasks_blocker,
+					 hash_function));
 	}
     }
 
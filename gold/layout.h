@@ -35,6 +35,7 @@
 #include "object.h"
 #include "dynobj.h"
 #include "stringpool.h"
+#include "wildcard.h"
 
 namespace gold
 {
@@ -53,8 +54,10 @@ class Output_file_header;
 class Output_segment;
 class Output_data;
 class Output_data_reloc_generic;
+class Output_data_relr_generic;
 class Output_data_dynamic;
 class Output_symtab_xindex;
+class Output_compressed_section;
 class Output_reduced_debug_abbrev_section;
 class Output_reduced_debug_info_section;
 class Eh_frame;
@@ -696,6 +699,12 @@ class Layout
 		   unsigned int reloc_shndx,
 		   unsigned int reloc_type);
 
+  // Return the data for the .gdb_index section, or NULL if there is
+  // none.
+  Gdb_index*
+  gdb_index() const
+  { return this->gdb_index_data_; }
+
   // Handle a GNU stack note.  This is called once per input object
   // file.  SEEN_GNU_STACK is true if the object file has a
   // .note.GNU-stack section.  GNU_STACK_FLAGS is the section flags
@@ -851,6 +860,11 @@ class Layout
   any_postprocessing_sections() const
   { return this->any_postprocessing_sections_; }
 
+  // Return the output sections whose contents are compressed.
+  const std::vector<Output_compressed_section*>*
+  compressed_sections() const
+  { return &this->compressed_sections_; }
+
   // Return the size of the output file.
   off_t
   output_file_size() const
@@ -891,6 +905,14 @@ class Layout
   dynamic_data() const
   { return this->dynamic_data_; }
 
+  // Record the SHT_RELR section for -z pack-relative-relocs.
+  void
+  set_relr_dyn(Output_data_relr_generic* relr_dyn)
+  {
+    gold_assert(this->relr_dyn_ == NULL);
+    this->relr_dyn_ = relr_dyn;
+  }
+
   // Write out the output sections.
   void
   write_output_sections(Output_file* of) const;
@@ -1441,6 +1463,8 @@ class Layout
   Symbol* dynamic_symbol_;
   // The dynamic data which goes into dynamic_section_.
   Output_data_dynamic* dynamic_data_;
+  // The SHT_RELR section for packed relative relocs, if there is one.
+  Output_data_relr_generic* relr_dyn_;
   // The exception frame output section if there is one.
   Output_section* eh_frame_section_;
   // The exception frame data for eh_frame_section_.
@@ -1457,6 +1481,8 @@ class Layout
   Output_reduced_debug_abbrev_section* debug_abbrev_;
   // The output section containing the dwarf debug info tree
   Output_reduced_debug_info_section* debug_info_;
+  // The output sections whose contents are compressed.
+  std::vector<Output_compressed_section*> compressed_sections_;
   // A list of group sections and their signatures.
   Group_signatures group_signatures_;
   // The size of the output file.
@@ -1511,8 +1537,9 @@ class Layout
   Section_segment_map section_segment_map_;
   // Hash a pattern to its position in the section ordering file.
   Unordered_map<std::string, unsigned int> input_section_position_;
-  // Vector of glob only patterns in the section_ordering file.
-  std::vector<std::string> input_section_glob_;
+  // The glob patterns in the section_ordering file, each with its
+  // position.
+  Wildcard_matcher input_section_glob_;
   // For incremental links, the base file to be modified.
   Incremental_binary* incremental_base_;
   // For incremental links, a list of free space within the file.
@@ -251,6 +251,8 @@ main(int argc, char** argv)
   // Run the main task processing loop.
   workqueue.process(0);
 
+  workqueue.write_trace();
+
   if (command_line.options().print_output_format())
     print_output_format();
 
@@ -431,6 +431,19 @@ Output_merge_data::do_print_merge_stats(const char* section_name)
 
 // Class Output_merge_string.
 
+// Whether to defer reading the strings of input sections until
+// Merge_input_sections_tasks can read them in parallel.  We don't
+// bother when not using threads, and an incremental update reads
+// input sections as they are added.
+
+template<typename Char_type>
+bool
+Output_merge_string<Char_type>::should_defer_scan()
+{
+  return (parameters->options().threads()
+	  && !parameters->incremental());
+}
+
 // Add an input section to a merged string section.
 
 template<typename Char_type>
@@ -438,6 +451,37 @@ bool
 Output_merge_string<Char_type>::do_add_input_section(Relobj* object,
 						     unsigned int shndx)
 {
+  if (should_defer_scan())
+    {
+      // We only need the size to decide whether we can merge the
+      // section, and that is in the section header.
+      section_size_type sec_len;
+      if (!object->section_is_compressed(shndx, &sec_len))
+	sec_len = convert_to_section_size_type(object->section_size(shndx));
+      if (sec_len % sizeof(Char_type) != 0)
+	{
+	  object->error(_("mergeable string section length not multiple of "
+			  "character size"));
+	  return false;
+	}
+
+      if (this->deferred_pool_ == NULL)
+	this->deferred_pool_ = new Sharded_stringpool_template<Char_type>();
+
+      Merged_strings_list* merged_strings_list =
+	  new Merged_strings_list(object, shndx);
+      merged_strings_list->is_deferred = true;
+      this->merged_strings_lists_.push_back(merged_strings_list);
+      this->deferred_lists_[Section_id(object, shndx)] = merged_strings_list;
+      object->add_deferred_merge_section(this, shndx);
+
+      // For script processing, we keep the input sections.
+      if (this->keeps_input_sections())
+	record_input_section(object, shndx);
+
+      return true;
+    }
+
   section_size_type sec_len;
   bool is_new;
   uint64_t addralign = this->addralign();
@@ -446,10 +490,6 @@ Output_merge_string<Char_type>::do_add_input_section(Relobj* object,
 								     &is_new,
 								     &addralign);
 
-  const Char_type* p = reinterpret_cast<const Char_type*>(pdata);
-  const Char_type* pend = p + sec_len / sizeof(Char_type);
-  const Char_type* pend0 = pend;
-
   if (sec_len % sizeof(Char_type) != 0)
     {
       object->error(_("mergeable string section length not multiple of "
@@ -459,6 +499,74 @@ Output_merge_string<Char_type>::do_add_input_section(Relobj* object,
       return false;
     }
 
+  Merged_strings_list* merged_strings_list =
+      new Merged_strings_list(object, shndx);
+  this->merged_strings_lists_.push_back(merged_strings_list);
+
+  this->input_count_ += this->add_strings(object, shndx, pdata, sec_len,
+					  addralign, merged_strings_list);
+  this->input_size_ += merged_strings_list->merged_strings.back().offset;
+
+  // For script processing, we keep the input sections.
+  if (this->keeps_input_sections())
+    record_input_section(object, shndx);
+
+  if (is_new)
+    delete[] pdata;
+
+  return true;
+}
+
+// Read the strings of an input section added by do_add_input_section
+// when should_defer_scan was true.  This runs in a
+// Merge_input_sections_task, with OBJECT locked.
+
+template<typename Char_type>
+void
+Output_merge_string<Char_type>::do_scan_input_section(Relobj* object,
+						      unsigned int shndx)
+{
+  typename Deferred_lists::const_iterator p =
+    this->deferred_lists_.find(Section_id(object, shndx));
+  gold_assert(p != this->deferred_lists_.end());
+  Merged_strings_list* merged_strings_list = p->second;
+
+  section_size_type sec_len;
+  bool is_new;
+  uint64_t addralign = this->addralign();
+  const unsigned char* pdata = object->decompressed_section_contents(shndx,
+								     &sec_len,
+								     &is_new,
+								     &addralign);
+  gold_assert(sec_len % sizeof(Char_type) == 0);
+
+  merged_strings_list->deferred_count =
+    this->add_strings(object, shndx, pdata, sec_len, addralign,
+		      merged_strings_list);
+  merged_strings_list->deferred_size =
+    merged_strings_list->merged_strings.back().offset;
+
+  if (is_new)
+    delete[] pdata;
+}
+
+// Split the section contents PDATA of length SEC_LEN into strings and
+// add them to MERGED_STRINGS_LIST.
+
+template<typename Char_type>
+size_t
+Output_merge_string<Char_type>::add_strings(
+    Relobj* object,
+    unsigned int shndx,
+    const unsigned char* pdata,
+    section_size_type sec_len,
+    uint64_t addralign,
+    Merged_strings_list* merged_strings_list)
+{
+  const Char_type* p = reinterpret_cast<const Char_type*>(pdata);
+  const Char_type* pend = p + sec_len / sizeof(Char_type);
+  const Char_type* pend0 = pend;
+
   if (pend[-1] != 0)
     {
       gold_warning(_("%s: last entry in mergeable string section '%s' "
@@ -470,10 +578,8 @@ Output_merge_string<Char_type>::do_add_input_section(Relobj* object,
 	--pend0;
     }
 
-  Merged_strings_list* merged_strings_list =
-      new Merged_strings_list(object, shndx);
-  this->merged_strings_lists_.push_back(merged_strings_list);
   Merged_strings& merged_strings = merged_strings_list->merged_strings;
+  const bool is_deferred = merged_strings_list->is_deferred;
 
   // Count the number of non-null strings in the section and size the list.
   size_t count = 0;
@@ -488,6 +594,8 @@ Output_merge_string<Char_type>::do_add_input_section(Relobj* object,
   if (pend0 < pend)
     ++count;
   merged_strings.reserve(count + 1);
+  if (is_deferred)
+    merged_strings_list->deferred_strings.reserve(count + 1);
 
   // The index I is in bytes, not characters.
   section_size_type i = 0;
@@ -510,7 +618,11 @@ Output_merge_string<Char_type>::do_add_input_section(Relobj* object,
 	  has_misaligned_strings = true;
 
       Stringpool::Key key;
-      this->stringpool_.add_with_length(p, len, true, &key);
+      if (!is_deferred)
+	this->stringpool_.add_with_length(p, len, true, &key);
+      else
+	merged_strings_list->deferred_strings.push_back(
+	    this->deferred_pool_->add_with_length(p, len, true, &key));
 
       merged_strings.push_back(Merged_string(i, key));
       p += len + 1;
@@ -521,23 +633,76 @@ Output_merge_string<Char_type>::do_add_input_section(Relobj* object,
   // compute the length of the last string.
   merged_strings.push_back(Merged_string(i, 0));
 
-  this->input_count_ += count;
-  this->input_size_ += i;
-
   if (has_misaligned_strings)
     gold_warning(_("%s: section %s contains incorrectly aligned strings;"
 		   " the alignment of those strings won't be preserved"),
 		 object->name().c_str(),
 		 object->section_name(shndx).c_str());
 
-  // For script processing, we keep the input sections.
-  if (this->keeps_input_sections())
-    record_input_section(object, shndx);
+  return count;
+}
 
-  if (is_new)
-    delete[] pdata;
+// Move the strings read by the Merge_input_sections_tasks into
+// stringpool_.  The tasks ran in no particular order, so the keys in
+// deferred_pool_ are not stable.  Walking the lists in the order the
+// input sections were added, and adding each string to stringpool_
+// the first time we see it, gives the same keys and offsets as adding
+// the strings in do_add_input_section.  Only the first occurrence of
+// each string is hashed again; the rest are found by key.  This pass
+// stays serial: the keys in stringpool_ must be handed out in input
+// order, and Stringpool is not safe to add to from several threads.
 
-  return true;
+template<typename Char_type>
+void
+Output_merge_string<Char_type>::add_deferred_strings()
+{
+  if (this->deferred_pool_ == NULL)
+    return;
+
+  typedef Sharded_stringpool_template<Char_type> Deferred_pool;
+
+  // Map from each key in deferred_pool_ to a key in stringpool_.
+  std::vector<Stringpool::Key> new_keys[Deferred_pool::shard_count];
+  for (unsigned int i = 0; i < Deferred_pool::shard_count; ++i)
+    new_keys[i].resize(this->deferred_pool_->shard_string_count(i), 0);
+
+  for (typename Merged_strings_lists::const_iterator l =
+	 this->merged_strings_lists_.begin();
+       l != this->merged_strings_lists_.end();
+       ++l)
+    {
+      if (!(*l)->is_deferred)
+	continue;
+
+      Merged_strings& merged_strings = (*l)->merged_strings;
+      gold_assert(!merged_strings.empty()
+		  && ((*l)->deferred_strings.size() + 1
+		      == merged_strings.size()));
+      for (size_t i = 0; i + 1 < merged_strings.size(); ++i)
+	{
+	  Stringpool::Key key = merged_strings[i].stringpool_key;
+	  std::vector<Stringpool::Key>& shard_keys =
+	    new_keys[Deferred_pool::key_shard(key)];
+	  Stringpool::Key* pnew_key =
+	    &shard_keys[Deferred_pool::key_index(key)];
+	  if (*pnew_key == 0)
+	    {
+	      size_t len = ((merged_strings[i + 1].offset
+			     - merged_strings[i].offset)
+			    / sizeof(Char_type)) - 1;
+	      this->stringpool_.add_with_length((*l)->deferred_strings[i], len,
+						false, pnew_key);
+	    }
+	  merged_strings[i].stringpool_key = *pnew_key;
+	}
+
+      this->input_count_ += (*l)->deferred_count;
+      this->input_size_ += (*l)->deferred_size;
+      std::vector<const Char_type*>().swap((*l)->deferred_strings);
+      (*l)->is_deferred = false;
+    }
+
+  this->deferred_lists_.clear();
 }
 
 // Finalize the mappings from the input sections to the output
@@ -547,6 +712,7 @@ template<typename Char_type>
 section_size_type
 Output_merge_string<Char_type>::finalize_merged_data()
 {
+  this->add_deferred_strings();
   this->stringpool_.set_string_offsets();
 
   for (typename Merged_strings_lists::const_iterator l =
@@ -659,6 +825,43 @@ Output_merge_string<Char_type>::do_print_merge_stats(const char* section_name)
   this->stringpool_.print_stats(buf);
 }
 
+// Class Merge_input_sections_task.
+
+// We need to wait for the object to be unlocked.
+
+Task_token*
+Merge_input_sections_task::is_runnable()
+{
+  if (this->object_->is_locked())
+    return this->object_->token();
+  return NULL;
+}
+
+// Lock the object while we read from it, and unblock BLOCKER when
+// done.
+
+void
+Merge_input_sections_task::locks(Task_locker* tl)
+{
+  Task_token* token = this->object_->token();
+  if (token != NULL)
+    tl->add(this, token);
+  tl->add(this, this->blocker_);
+}
+
+void
+Merge_input_sections_task::run(Workqueue*)
+{
+  this->object_->scan_deferred_merge_sections();
+  this->object_->release();
+}
+
+std::string
+Merge_input_sections_task::get_name() const
+{
+  return "Merge_input_sections_task " + this->object_->name();
+}
+
 // Instantiate the templates we need.
 
 template
@@ -29,6 +29,7 @@
 
 #include "stringpool.h"
 #include "output.h"
+#include "workqueue.h"
 
 namespace gold
 {
@@ -217,6 +218,14 @@ class Output_merge_base : public Output_section_data
     return this->first_shndx_;
   }
  
+  // Read the contents of input section SHNDX of OBJECT, which was
+  // added earlier but whose contents were not yet read.  This is
+  // called by a Merge_input_sections_task, and may run in parallel
+  // with calls for other objects.
+  void
+  scan_input_section(Relobj* object, unsigned int shndx)
+  { this->do_scan_input_section(object, shndx); }
+
   // Set of merged input sections.
   typedef Unordered_set<Section_id, Section_id_hash> Input_sections;
 
@@ -248,6 +257,12 @@ class Output_merge_base : public Output_section_data
   do_is_string()
   { return false; }
 
+  // This must be overridden by a child class which defers reading
+  // its input sections.
+  virtual void
+  do_scan_input_section(Relobj*, unsigned int)
+  { gold_unreachable(); }
+
   // This may be overridden by the child class.
   virtual void
   do_set_keeps_input_sections()
@@ -402,16 +417,24 @@ class Output_merge_string : public Output_merge_base
  public:
   Output_merge_string(uint64_t addralign)
     : Output_merge_base(sizeof(Char_type), addralign), stringpool_(addralign),
-      merged_strings_lists_(), input_count_(0), input_size_(0)
+      merged_strings_lists_(), deferred_lists_(), deferred_pool_(NULL),
+      input_count_(0), input_size_(0)
   {
     this->stringpool_.set_no_zero_null();
   }
 
+  ~Output_merge_string()
+  { delete this->deferred_pool_; }
+
  protected:
   // Add an input section.
   bool
   do_add_input_section(Relobj* object, unsigned int shndx);
 
+  // Read the strings of an input section whose scan was deferred.
+  void
+  do_scan_input_section(Relobj* object, unsigned int shndx);
+
   // Do all the final processing after the input sections are read in.
   // Returns the final data size.
   section_size_type
@@ -446,7 +469,11 @@ class Output_merge_string : public Output_merge_base
   // Clears all the data in the stringpool, to save on memory.
   void
   clear_stringpool()
-  { this->stringpool_.clear(); }
+  {
+    this->stringpool_.clear();
+    delete this->deferred_pool_;
+    this->deferred_pool_ = NULL;
+  }
 
   // Whether this is a merge string section.
   virtual bool
@@ -490,25 +517,98 @@ class Output_merge_string : public Output_merge_base
     unsigned int shndx;
     // The list of merged strings.
     Merged_strings merged_strings;
+    // If the strings were read by a Merge_input_sections_task, the
+    // keys in MERGED_STRINGS are keys in deferred_pool_, and this
+    // holds the canonical string for each entry.  This is cleared
+    // when the keys are converted to stringpool_ keys.
+    std::vector<const Char_type*> deferred_strings;
+    // For a deferred list, the number of strings and the size of the
+    // input section, which are added to the totals when the list is
+    // converted.
+    size_t deferred_count;
+    size_t deferred_size;
+    // Whether this list's scan was deferred.
+    bool is_deferred;
 
     Merged_strings_list(Relobj* objecta, unsigned int shndxa)
-      : object(objecta), shndx(shndxa), merged_strings()
+      : object(objecta), shndx(shndxa), merged_strings(), deferred_strings(),
+	deferred_count(0), deferred_size(0), is_deferred(false)
     { }
   };
 
   typedef std::vector<Merged_strings_list*> Merged_strings_lists;
 
+  typedef Unordered_map<Section_id, Merged_strings_list*, Section_id_hash>
+    Deferred_lists;
+
+  // Whether to defer reading input sections to
+  // Merge_input_sections_tasks.
+  static bool
+  should_defer_scan();
+
+  // Split the contents of an input section into strings and add them
+  // to LIST, using stringpool_ or, for a deferred list,
+  // deferred_pool_.  Returns the number of non-empty strings.
+  size_t
+  add_strings(Relobj* object, unsigned int shndx, const unsigned char* pdata,
+	      section_size_type sec_len, uint64_t addralign,
+	      Merged_strings_list* list);
+
+  // Add the strings of the deferred lists to stringpool_ in input
+  // order, so that the result is the same as if they had been added
+  // by do_add_input_section.
+  void
+  add_deferred_strings();
+
   // As we see the strings, we add them to a Stringpool.
   Stringpool_template<Char_type> stringpool_;
   // Map from a location in an input object to an entry in the
   // Stringpool.
   Merged_strings_lists merged_strings_lists_;
+  // The lists whose scans were deferred, by input section.  This is
+  // only changed by do_add_input_section, so the tasks may read it.
+  Deferred_lists deferred_lists_;
+  // The pool which the Merge_input_sections_tasks add strings to.
+  // Strings added to stringpool_ from a deferred list point into this
+  // pool, so it lives as long as stringpool_.
+  Sharded_stringpool_template<Char_type>* deferred_pool_;
   // The number of entries seen in input files.
   size_t input_count_;
   // The total size of input sections.
   size_t input_size_;
 };
 
+// This task reads the strings of the merged input sections of one
+// object whose scans were deferred by Output_merge_string.  These
+// tasks run in parallel after all input sections have been laid
+// out, and before the output sections are finalized.
+
+class Merge_input_sections_task : public Task
+{
+ public:
+  Merge_input_sections_task(Relobj* object, Task_token* blocker)
+    : object_(object), blocker_(blocker)
+  { }
+
+  // The standard Task methods.
+
+  Task_token*
+  is_runnable();
+
+  void
+  locks(Task_locker*);
+
+  void
+  run(Workqueue*);
+
+  std::string
+  get_name() const;
+
+ private:
+  Relobj* object_;
+  Task_token* blocker_;
+};
+
 } // End namespace gold.
 
 #endif // !defined(GOLD_MERGE_H)
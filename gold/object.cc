@@ -42,6 +42,7 @@
 #include "compressed_output.h"
 #include "incremental.h"
 #include "merge.h"
+#include "cache.h"
 
 namespace gold
 {
@@ -67,6 +68,8 @@ Read_symbols_data::~Read_symbols_data()
     delete this->verdef;
   if (this->verneed != NULL)
     delete this->verneed;
+  if (this->interned_names != NULL)
+    delete this->interned_names;
 }
 
 // Class Xindex.
@@ -414,6 +417,19 @@ Relobj::get_or_create_merge_map()
   return this->object_merge_map_;
 }
 
+// Read the contents of the merged sections whose scans were deferred.
+// This is called by Merge_input_sections_task with the object locked.
+
+void
+Relobj::scan_deferred_merge_sections()
+{
+  for (size_t i = 0; i < this->deferred_merge_sections_.size(); ++i)
+    this->deferred_merge_sections_[i].first->scan_input_section(
+	this, this->deferred_merge_sections_[i].second);
+  std::vector<std::pair<Output_merge_base*, unsigned int> >().swap(
+      this->deferred_merge_sections_);
+}
+
 // Class Sized_relobj.
 
 // Iterate over local symbols, calling a visitor class V for each GOT offset
@@ -2148,6 +2164,7 @@ Sized_relobj_file<size, big_endian>::do_add_symbols(Symbol_table* symtab,
 			  sd->symbols->data() + sd->external_symbols_offset,
 			  symcount, this->local_symbol_count_,
 			  sym_names, sd->symbol_names_size,
+			  sd->interned_names,
 			  &this->symbols_,
 			  &this->defined_count_);
 
@@ -2155,6 +2172,56 @@ Sized_relobj_file<size, big_endian>::do_add_symbols(Symbol_table* symtab,
   sd->symbols = NULL;
   delete sd->symbol_names;
   sd->symbol_names = NULL;
+  if (sd->interned_names != NULL)
+    {
+      delete sd->interned_names;
+      sd->interned_names = NULL;
+    }
+}
+
+// Enter the names of the global symbols into the name pool of SYMTAB.
+// This is called from the Read_symbols task, before do_add_symbols.
+
+template<int size, bool big_endian>
+void
+Sized_relobj_file<size, big_endian>::do_intern_symbol_names(
+    Symbol_table* symtab,
+    Read_symbols_data* sd)
+{
+  if (sd->symbols == NULL || sd->interned_names != NULL)
+    return;
+
+  const int sym_size = This::sym_size;
+  size_t symcount = ((sd->symbols_size - sd->external_symbols_offset)
+		     / sym_size);
+  if (symcount * sym_size != sd->symbols_size - sd->external_symbols_offset)
+    return;
+
+  const unsigned char* syms =
+    sd->symbols->data() + sd->external_symbols_offset;
+  const char* sym_names =
+    reinterpret_cast<const char*>(sd->symbol_names->data());
+  sd->interned_names = new Interned_symbol_names();
+
+  if (!Object_cache::enabled())
+    {
+      symtab->intern_symbol_names<size, big_endian>(
+	  syms, symcount, sym_names, sd->symbol_names_size, true, NULL, NULL,
+	  sd->interned_names);
+      return;
+    }
+
+  // Look for the digests of these names in the object cache, and
+  // save them there if they are not found.
+  Object_cache cache(syms, symcount * sym_size, sym_names,
+		     sd->symbol_names_size, !parameters->incremental_update());
+  const Symbol_name_digest* digests = cache.find(symcount);
+  Symbol_name_digests new_digests;
+  symtab->intern_symbol_names<size, big_endian>(
+      syms, symcount, sym_names, sd->symbol_names_size, true, digests,
+      &new_digests, sd->interned_names);
+  if (digests == NULL)
+    cache.save(new_digests);
 }
 
 // Find out if this object, that is a member of a lib group, should be included
@@ -48,8 +48,10 @@ class Output_symtab_xindex;
 class Pluginobj;
 class Dynobj;
 class Object_merge_map;
+class Output_merge_base;
 class Relocatable_relocs;
 struct Symbols_data;
+struct Interned_symbol_name;
 
 template<typename Stringpool_char>
 class Stringpool_template;
@@ -60,7 +62,8 @@ struct Read_symbols_data
 {
   Read_symbols_data()
     : section_headers(NULL), section_names(NULL), symbols(NULL),
-      symbol_names(NULL), versym(NULL), verdef(NULL), verneed(NULL)
+      symbol_names(NULL), versym(NULL), verdef(NULL), verneed(NULL),
+      interned_names(NULL)
   { }
 
   ~Read_symbols_data();
@@ -96,6 +99,11 @@ struct Read_symbols_data
   File_view* verneed;
   section_size_type verneed_size;
   unsigned int verneed_info;
+
+  // The global symbol names, already entered into the symbol table's
+  // name pool by Object::intern_symbol_names.  NULL if that was not
+  // done for this object.
+  std::vector<Interned_symbol_name>* interned_names;
 };
 
 // Information used to print error messages.
@@ -695,6 +703,13 @@ class Object
   layout(Symbol_table* symtab, Layout* layout, Read_symbols_data* sd)
   { this->do_layout(symtab, layout, sd); }
 
+  // Enter the names of the global symbols read by read_symbols into
+  // the symbol table's name pool.  This may run in parallel with
+  // other objects, and saves work in add_symbols, which can not.
+  void
+  intern_symbol_names(Symbol_table* symtab, Read_symbols_data* sd)
+  { this->do_intern_symbol_names(symtab, sd); }
+
   // Add symbol information to the global symbol table.
   void
   add_symbols(Symbol_table* symtab, Read_symbols_data* sd, Layout *layout)
@@ -932,6 +947,12 @@ class Object
   virtual void
   do_layout(Symbol_table*, Layout*, Read_symbols_data*) = 0;
 
+  // Enter the global symbol names into the name pool--optionally
+  // implemented by child class.
+  virtual void
+  do_intern_symbol_names(Symbol_table*, Read_symbols_data*)
+  { }
+
   // Add symbol information to the global symbol table--implemented by
   // child class.
   virtual void
@@ -1145,6 +1166,7 @@ class Relobj : public Object
       output_sections_(),
       map_to_relocatable_relocs_(NULL),
       object_merge_map_(NULL),
+      deferred_merge_sections_(),
       relocs_must_follow_section_writes_(false),
       sd_(NULL),
       reloc_counts_(NULL),
@@ -1342,6 +1364,23 @@ class Relobj : public Object
   Object_merge_map*
   get_or_create_merge_map();
 
+  // Record that input section SHNDX was added to the merged section
+  // POMB without reading its contents.  The contents are read later
+  // by a Merge_input_sections_task.
+  void
+  add_deferred_merge_section(Output_merge_base* pomb, unsigned int shndx)
+  { this->deferred_merge_sections_.push_back(std::make_pair(pomb, shndx)); }
+
+  // Return whether any merged sections are waiting to be read.
+  bool
+  has_deferred_merge_sections() const
+  { return !this->deferred_merge_sections_.empty(); }
+
+  // Read the contents of the merged sections recorded by
+  // add_deferred_merge_section.
+  void
+  scan_deferred_merge_sections();
+
   template<int size>
   void
   initialize_input_to_output_map(unsigned int shndx,
@@ -1587,6 +1626,9 @@ class Relobj : public Object
   // Mappings for merge sections.  This is managed by the code in the
   // Merge_map class.
   Object_merge_map* object_merge_map_;
+  // Merged input sections whose contents have not yet been read.
+  std::vector<std::pair<Output_merge_base*, unsigned int> >
+    deferred_merge_sections_;
   // Whether we need to wait for output sections to be written before
   // we can apply relocations.
   bool relocs_must_follow_section_writes_;
@@ -2429,6 +2471,10 @@ class Sized_relobj_file : public Sized_relobj<size, big_endian>
   void
   do_layout_deferred_sections(Layout*);
 
+  // Enter the global symbol names into the name pool.
+  void
+  do_intern_symbol_names(Symbol_table*, Read_symbols_data*);
+
   // Add the symbols to the symbol table.
   void
   do_add_symbols(Symbol_table*, Read_symbols_data*, Layout*);
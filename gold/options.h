@@ -698,6 +698,10 @@ class General_options
 	      N_("(aarch64 only) Do not apply link-time values "
 		 "for dynamic relocations"));
 
+  DEFINE_string(archive_index_cache, options::TWO_DASHES, '\0', NULL,
+		N_("Cache archive symbol tables in DIRECTORY"),
+		N_("DIRECTORY"));
+
   DEFINE_bool(as_needed, options::TWO_DASHES, '\0', false,
 	      N_("Use DT_NEEDED only for shared libraries that are used"),
 	      N_("Use DT_NEEDED for all shared libraries"));
@@ -724,7 +728,8 @@ class General_options
 
   DEFINE_uint64(build_id_chunk_size_for_treehash,
 		options::TWO_DASHES, '\0', 2 << 20,
-		N_("Chunk size for '--build-id=tree'"), N_("SIZE"));
+		N_("Chunk size for '--build-id=tree' and '--build-id=fast'"),
+		N_("SIZE"));
 
   DEFINE_uint64(build_id_min_file_size_for_treehash, options::TWO_DASHES,
 		'\0', 40 << 20,
@@ -770,8 +775,8 @@ class General_options
 
   DEFINE_enum(compress_debug_sections, options::TWO_DASHES, '\0', "none",
 	      N_("Compress .debug_* sections in the output file"),
-	      ("[none,zlib,zlib-gnu,zlib-gabi]"), false,
-	      {"none", "zlib", "zlib-gnu", "zlib-gabi"});
+	      ("[none,zlib,zlib-gnu,zlib-gabi,zstd]"), false,
+	      {"none", "zlib", "zlib-gnu", "zlib-gabi", "zstd"});
 
   DEFINE_bool(copy_dt_needed_entries, options::TWO_DASHES, '\0', false,
 	      N_("Not supported"),
@@ -1084,6 +1089,10 @@ class General_options
 
   // o
 
+  DEFINE_string(object_cache, options::TWO_DASHES, '\0', NULL,
+		N_("Cache digests of object file symbols in DIRECTORY"),
+		N_("DIRECTORY"));
+
   DEFINE_string(output, options::TWO_DASHES, 'o', "a.out",
 		N_("Set output file name"), N_("FILE"));
 
@@ -1294,6 +1303,11 @@ class General_options
   DEFINE_bool(trace, options::TWO_DASHES, 't', false,
 	      N_("Print the name of each input file"), NULL);
 
+  DEFINE_string(trace_file, options::TWO_DASHES, '\0', NULL,
+		N_("Write a trace of the tasks run to FILE in Chrome trace "
+		   "format"),
+		N_("FILE"));
+
   DEFINE_bool(target1_abs, options::TWO_DASHES, '\0', false,
 	      N_("(ARM only) Force R_ARM_TARGET1 type to R_ARM_ABS32"),
 	      NULL);
@@ -1517,6 +1531,9 @@ class General_options
   DEFINE_bool(origin, options::DASH_Z, '\0', false,
 	      N_("Mark DSO to indicate that needs immediate $ORIGIN "
 		 "processing at runtime"), NULL);
+  DEFINE_bool(pack_relative_relocs, options::DASH_Z, '\0', false,
+	      N_("Pack relative relocations into a DT_RELR section"),
+	      N_("Do not pack relative relocations (default)"));
   DEFINE_bool(relro, options::DASH_Z, '\0', DEFAULT_LD_Z_RELRO,
 	      N_("Where possible mark variables read-only after relocation"),
 	      N_("Don't mark variables read-only after relocation"));
@@ -1810,6 +1827,12 @@ class General_options
   power10_stubs_enum() const
   { return this->power10_stubs_enum_; }
 
+  // Turn on threads.  This is for dwp, which uses the workqueue but
+  // does not parse a linker command line.
+  void
+  enable_threads()
+  { this->set_threads(true); }
+
  private:
   // Don't copy this structure.
   General_options(const General_options&);
@@ -1290,6 +1290,186 @@ Output_data_reloc_base<sh_type, dynamic, size, big_endian>::do_write(
   this->do_write_generic<Writer>(of);
 }
 
+// Class Output_data_relr.
+
+// Add a reloc for a word in OD.  The word must hold the final value
+// less the load bias, which is not so for a STT_GNU_IFUNC symbol.
+
+template<int size, bool big_endian>
+bool
+Output_data_relr<size, big_endian>::add(const Symbol* gsym, Output_data* od,
+					Address address)
+{
+  if ((gsym != NULL && gsym->type() == elfcpp::STT_GNU_IFUNC)
+      || address % word_size != 0
+      || od->addralign() < word_size)
+    return false;
+  this->relocs_.push_back(Relr(od, NULL, 0, address));
+  return true;
+}
+
+// Add a reloc for a word in an input section.  The offset of the
+// input section in a merged section is not known yet, so the word can
+// not be relocated here.
+
+template<int size, bool big_endian>
+bool
+Output_data_relr<size, big_endian>::add(
+    const Symbol* gsym,
+    Sized_relobj<size, big_endian>* relobj,
+    unsigned int shndx,
+    Address address)
+{
+  if ((gsym != NULL && gsym->type() == elfcpp::STT_GNU_IFUNC)
+      || address % word_size != 0
+      || relobj->section_addralign(shndx) < word_size
+      || relobj->get_output_section_offset(shndx) == invalid_address)
+    return false;
+  this->relocs_.push_back(Relr(NULL, relobj, shndx, address));
+  return true;
+}
+
+// Return the address of a word to relocate.  This follows
+// Output_reloc::get_address.
+
+template<int size, bool big_endian>
+typename Output_data_relr<size, big_endian>::Address
+Output_data_relr<size, big_endian>::get_address(const Relr& r) const
+{
+  if (r.relobj == NULL)
+    return r.od->address() + r.address;
+
+  Output_section* os = r.relobj->output_section(r.shndx);
+  gold_assert(os != NULL);
+  Address off = r.relobj->get_output_section_offset(r.shndx);
+  if (off != invalid_address)
+    return os->address() + off + r.address;
+  Sized_relobj_file<size, big_endian>* relobj = r.relobj->sized_relobj();
+  gold_assert(relobj != NULL);
+  Address address = os->output_address(relobj, r.shndx, r.address);
+  gold_assert(address != invalid_address);
+  return address;
+}
+
+// Encode the relocs.  Each address entry relocates the word at that
+// address.  It is followed by bitmap entries, whose low bit is set,
+// each of which relocates the words selected by its other bits among
+// the SIZE - 1 words after those covered by the previous entry.
+
+template<int size, bool big_endian>
+void
+Output_data_relr<size, big_endian>::encode(
+    std::vector<Address>* entries) const
+{
+  std::vector<Address> addresses;
+  addresses.reserve(this->relocs_.size());
+  for (typename std::vector<Relr>::const_iterator p = this->relocs_.begin();
+       p != this->relocs_.end();
+       ++p)
+    {
+      Address address = this->get_address(*p);
+      gold_assert(address % word_size == 0);
+      addresses.push_back(address);
+    }
+  std::sort(addresses.begin(), addresses.end());
+  addresses.erase(std::unique(addresses.begin(), addresses.end()),
+		  addresses.end());
+
+  const unsigned int nbits = size - 1;
+  entries->clear();
+  size_t i = 0;
+  while (i < addresses.size())
+    {
+      entries->push_back(addresses[i]);
+      Address base = addresses[i] + word_size;
+      ++i;
+      while (true)
+	{
+	  Address bitmap = 0;
+	  for (; i < addresses.size(); ++i)
+	    {
+	      Address delta = (addresses[i] - base) / word_size;
+	      if (delta >= nbits)
+		break;
+	      bitmap |= static_cast<Address>(1) << delta;
+	    }
+	  if (bitmap == 0)
+	    break;
+	  entries->push_back((bitmap << 1) | 1);
+	  base += nbits * word_size;
+	}
+    }
+}
+
+// Grow the section if the encoding no longer fits.
+
+template<int size, bool big_endian>
+bool
+Output_data_relr<size, big_endian>::do_update_size()
+{
+  std::vector<Address> entries;
+  this->encode(&entries);
+  off_t new_size = entries.size() * word_size;
+  if (new_size <= this->current_size_)
+    return false;
+  gold_debug(DEBUG_RELAXATION, "growing .relr.dyn from %ld to %ld bytes",
+	     static_cast<long>(this->current_size_),
+	     static_cast<long>(new_size));
+  this->current_size_ = new_size;
+  return true;
+}
+
+// Set the final data size.  Until the addresses are known, assume
+// that all the relocs fit in one entry.
+
+template<int size, bool big_endian>
+void
+Output_data_relr<size, big_endian>::set_final_data_size()
+{
+  if (this->current_size_ == 0 && !this->relocs_.empty())
+    this->current_size_ = word_size;
+  this->set_data_size(this->current_size_);
+}
+
+// Set the entry size.
+
+template<int size, bool big_endian>
+void
+Output_data_relr<size, big_endian>::do_adjust_output_section(
+    Output_section* os)
+{
+  os->set_entsize(word_size);
+}
+
+// Write out the section.  Any space left over is filled with empty
+// bitmap entries, which relocate nothing.
+
+template<int size, bool big_endian>
+void
+Output_data_relr<size, big_endian>::do_write(Output_file* of)
+{
+  std::vector<Address> entries;
+  this->encode(&entries);
+
+  const off_t off = this->offset();
+  const off_t oview_size = this->data_size();
+  gold_assert(static_cast<off_t>(entries.size() * word_size) <= oview_size);
+  unsigned char* const oview = of->get_output_view(off, oview_size);
+
+  unsigned char* pov = oview;
+  for (typename std::vector<Address>::const_iterator p = entries.begin();
+       p != entries.end();
+       ++p)
+    {
+      elfcpp::Swap<size, big_endian>::writeval(pov, *p);
+      pov += word_size;
+    }
+  for (; pov < oview + oview_size; pov += word_size)
+    elfcpp::Swap<size, big_endian>::writeval(pov, 1);
+
+  of->write_output_view(off, oview_size, oview);
+}
+
 // Class Output_relocatable_relocs.
 
 template<int sh_type, int size, bool big_endian>
@@ -5499,6 +5679,26 @@ template
 class Output_data_reloc<elfcpp::SHT_RELA, true, 64, true>;
 #endif
 
+#ifdef HAVE_TARGET_32_LITTLE
+template
+class Output_data_relr<32, false>;
+#endif
+
+#ifdef HAVE_TARGET_32_BIG
+template
+class Output_data_relr<32, true>;
+#endif
+
+#ifdef HAVE_TARGET_64_LITTLE
+template
+class Output_data_relr<64, false>;
+#endif
+
+#ifdef HAVE_TARGET_64_BIG
+template
+class Output_data_relr<64, true>;
+#endif
+
 #ifdef HAVE_TARGET_32_LITTLE
 template
 class Output_relocatable_relocs<elfcpp::SHT_REL, 32, false>;
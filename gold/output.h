@@ -1500,6 +1500,128 @@ class Output_reloc<elfcpp::SHT_RELA, dynamic, size, big_endian>
   Addend addend_;
 };
 
+// Output_data_relr_generic is a non-template base class for
+// Output_data_relr.  This gives the generic code a way to hold a
+// pointer to a packed relative reloc section.
+
+class Output_data_relr_generic : public Output_section_data
+{
+ public:
+  Output_data_relr_generic(int size)
+    : Output_section_data(Output_data::default_alignment_for_size(size))
+  { }
+
+  // Return whether there are no relocs in this section.
+  bool
+  empty() const
+  { return this->do_empty(); }
+
+  // Encode the relocs using the addresses which have just been
+  // assigned.  If the encoding does not fit in the current size of
+  // the section, grow the section and return true; the sections must
+  // then be laid out again.
+  bool
+  update_size()
+  { return this->do_update_size(); }
+
+ protected:
+  virtual bool
+  do_empty() const = 0;
+
+  virtual bool
+  do_update_size() = 0;
+};
+
+// Output_data_relr is a SHT_RELR section, which holds the RELATIVE
+// dynamic relocs for -z pack-relative-relocs.  The dynamic linker
+// adds the load bias to each relocated word, so the addend must
+// already be in the word, and the word must be aligned.  The section
+// holds the sorted addresses as a list of address entries, each
+// followed by bitmap entries for the words which follow it.  The
+// encoding depends upon the final addresses, so its size is only
+// known after the sections have been laid out; the Layout lays them
+// out again until the size stops growing.
+
+template<int size, bool big_endian>
+class Output_data_relr : public Output_data_relr_generic
+{
+ public:
+  typedef typename elfcpp::Elf_types<size>::Elf_Addr Address;
+
+  Output_data_relr()
+    : Output_data_relr_generic(size), relocs_(), current_size_(0)
+  { }
+
+  // Add a reloc for the word at offset ADDRESS within OD.  GSYM is
+  // the global symbol whose value the word holds, or NULL for a local
+  // symbol.  Return false if the word can not be relocated by this
+  // section.
+  bool
+  add(const Symbol* gsym, Output_data* od, Address address);
+
+  // Add a reloc for the word at offset ADDRESS within section SHNDX
+  // of RELOBJ.
+  bool
+  add(const Symbol* gsym, Sized_relobj<size, big_endian>* relobj,
+      unsigned int shndx, Address address);
+
+ protected:
+  bool
+  do_empty() const
+  { return this->relocs_.empty(); }
+
+  bool
+  do_update_size();
+
+  void
+  set_final_data_size();
+
+  void
+  do_write(Output_file*);
+
+  // Set the entry size.
+  void
+  do_adjust_output_section(Output_section* os);
+
+  // Write to a map file.
+  void
+  do_print_to_mapfile(Mapfile* mapfile) const
+  { mapfile->print_output_data(this, _("** packed relative relocs")); }
+
+ private:
+  static const unsigned int word_size = size / 8;
+  static const Address invalid_address = static_cast<Address>(0) - 1;
+
+  // A word to relocate, either at offset ADDRESS within OD, or at
+  // offset ADDRESS within section SHNDX of RELOBJ.
+  struct Relr
+  {
+    Relr(Output_data* o, Sized_relobj<size, big_endian>* r,
+	 unsigned int s, Address a)
+      : od(o), relobj(r), shndx(s), address(a)
+    { }
+
+    Output_data* od;
+    Sized_relobj<size, big_endian>* relobj;
+    unsigned int shndx;
+    Address address;
+  };
+
+  // Return the address of the word to relocate.
+  Address
+  get_address(const Relr&) const;
+
+  // Set *ENTRIES to the encoded section contents.
+  void
+  encode(std::vector<Address>* entries) const;
+
+  // The words to relocate.
+  std::vector<Relr> relocs_;
+  // The size of the section.  This only grows, so that relaying out
+  // the sections can not go on forever.
+  off_t current_size_;
+};
+
 // Output_data_reloc_generic is a non-template base class for
 // Output_data_reloc_base.  This gives the generic code a way to hold
 // a pointer to a reloc section.
@@ -1604,9 +1726,21 @@ class Output_data_reloc_base : public Output_data_reloc_generic
 
   // Construct the section.
   Output_data_reloc_base(bool sort_relocs)
-    : Output_data_reloc_generic(size, sort_relocs)
+    : Output_data_reloc_generic(size, sort_relocs), relr_(NULL),
+      relr_type_(0)
   { }
 
+  // Put the RELATIVE relocs of type RELATIVE_TYPE into RELR when
+  // possible, rather than into this section.
+  void
+  set_relr(Output_data_relr<size, big_endian>* relr,
+	   unsigned int relative_type)
+  {
+    gold_assert(dynamic);
+    this->relr_ = relr;
+    this->relr_type_ = relative_type;
+  }
+
  protected:
   // Write out the data.
   void
@@ -1675,6 +1809,37 @@ class Output_data_reloc_base : public Output_data_reloc_generic
       relobj->add_dyn_reloc(this->relocs_.size() - 1);
   }
 
+  // Try to add a RELATIVE reloc of type TYPE for the data at offset
+  // ADDRESS within OD to the SHT_RELR section.  GSYM is the global
+  // symbol, or NULL for a local symbol.  Return false if the reloc
+  // must go into this section instead.
+  bool
+  add_relr(const Symbol* gsym, Output_data* od, unsigned int type,
+	   Address address)
+  {
+    if (this->relr_ == NULL
+	|| type != this->relr_type_
+	|| !this->relr_->add(gsym, od, address))
+      return false;
+    od->add_dynamic_reloc();
+    return true;
+  }
+
+  // Likewise, for the data at offset ADDRESS within section SHNDX of
+  // RELOBJ.  OD is the associated output section.
+  bool
+  add_relr(const Symbol* gsym, Output_data* od, unsigned int type,
+	   Sized_relobj<size, big_endian>* relobj, unsigned int shndx,
+	   Address address)
+  {
+    if (this->relr_ == NULL
+	|| type != this->relr_type_
+	|| !this->relr_->add(gsym, relobj, shndx, address))
+      return false;
+    od->add_dynamic_reloc();
+    return true;
+  }
+
  private:
   typedef std::vector<Output_reloc_type> Relocs;
 
@@ -1688,6 +1853,10 @@ class Output_data_reloc_base : public Output_data_reloc_generic
 
   // The relocations in this section.
   Relocs relocs_;
+  // The SHT_RELR section for RELATIVE relocs, or NULL.
+  Output_data_relr<size, big_endian>* relr_;
+  // The type of the RELATIVE relocs which may go into relr_.
+  unsigned int relr_type_;
 };
 
 // The class which callers actually create.
@@ -1761,6 +1930,8 @@ class Output_data_reloc<elfcpp::SHT_REL, dynamic, size, big_endian>
   add_global_relative(Symbol* gsym, unsigned int type, Output_data* od,
 		      Address address)
   {
+    if (this->add_relr(gsym, od, type, address))
+      return;
     this->add(od, Output_reloc_type(gsym, type, od, address, true, true,
 				    false));
   }
@@ -1770,6 +1941,8 @@ class Output_data_reloc<elfcpp::SHT_REL, dynamic, size, big_endian>
 		      Sized_relobj<size, big_endian>* relobj,
 		      unsigned int shndx, Address address)
   {
+    if (this->add_relr(gsym, od, type, relobj, shndx, address))
+      return;
     this->add(od, Output_reloc_type(gsym, type, relobj, shndx, address,
 				    true, true, false));
   }
@@ -1848,6 +2021,8 @@ class Output_data_reloc<elfcpp::SHT_REL, dynamic, size, big_endian>
 		     unsigned int local_sym_index, unsigned int type,
 		     Output_data* od, Address address)
   {
+    if (this->add_relr(NULL, od, type, address))
+      return;
     this->add(od, Output_reloc_type(relobj, local_sym_index, type, od,
 				    address, true, true, false, false));
   }
@@ -1857,6 +2032,8 @@ class Output_data_reloc<elfcpp::SHT_REL, dynamic, size, big_endian>
 		     unsigned int local_sym_index, unsigned int type,
 		     Output_data* od, unsigned int shndx, Address address)
   {
+    if (this->add_relr(NULL, od, type, relobj, shndx, address))
+      return;
     this->add(od, Output_reloc_type(relobj, local_sym_index, type, shndx,
 				    address, true, true, false, false));
   }
@@ -1867,6 +2044,9 @@ class Output_data_reloc<elfcpp::SHT_REL, dynamic, size, big_endian>
 		     Output_data* od, unsigned int shndx, Address address,
 		     bool use_plt_offset)
   {
+    if (!use_plt_offset
+	&& this->add_relr(NULL, od, type, relobj, shndx, address))
+      return;
     this->add(od, Output_reloc_type(relobj, local_sym_index, type, shndx,
 				    address, true, true, false,
 				    use_plt_offset));
@@ -2080,6 +2260,8 @@ class Output_data_reloc<elfcpp::SHT_RELA, dynamic, size, big_endian>
   add_global_relative(Symbol* gsym, unsigned int type, Output_data* od,
 		      Address address, Addend addend, bool use_plt_offset)
   {
+    if (!use_plt_offset && this->add_relr(gsym, od, type, address))
+      return;
     this->add(od, Output_reloc_type(gsym, type, od, address, addend, true,
 				    true, use_plt_offset));
   }
@@ -2090,6 +2272,9 @@ class Output_data_reloc<elfcpp::SHT_RELA, dynamic, size, big_endian>
 		      unsigned int shndx, Address address, Addend addend,
 		      bool use_plt_offset)
   {
+    if (!use_plt_offset
+	&& this->add_relr(gsym, od, type, relobj, shndx, address))
+      return;
     this->add(od, Output_reloc_type(gsym, type, relobj, shndx, address,
 				    addend, true, true, use_plt_offset));
   }
@@ -2172,6 +2357,8 @@ class Output_data_reloc<elfcpp::SHT_RELA, dynamic, size, big_endian>
 		     Output_data* od, Address address, Addend addend,
 		     bool use_plt_offset)
   {
+    if (!use_plt_offset && this->add_relr(NULL, od, type, address))
+      return;
     this->add(od, Output_reloc_type(relobj, local_sym_index, type, od, address,
 				    addend, true, true, false,
 				    use_plt_offset));
@@ -2183,6 +2370,9 @@ class Output_data_reloc<elfcpp::SHT_RELA, dynamic, size, big_endian>
 		     Output_data* od, unsigned int shndx, Address address,
 		     Addend addend, bool use_plt_offset)
   {
+    if (!use_plt_offset
+	&& this->add_relr(NULL, od, type, relobj, shndx, address))
+      return;
     this->add(od, Output_reloc_type(relobj, local_sym_index, type, shndx,
 				    address, addend, true, true, false,
 				    use_plt_offset));
@@ -2902,13 +3092,17 @@ class Output_symtab_xindex : public Output_section_data
  public:
   Output_symtab_xindex(size_t symcount)
     : Output_section_data(symcount * 4, 4, true),
-      entries_()
+      entries_(), lock_()
   { }
 
-  // Add an entry: symbol number SYMNDX has section SHNDX.
+  // Add an entry: symbol number SYMNDX has section SHNDX.  This may
+  // be called by several tasks at once.
   void
   add(unsigned int symndx, unsigned int shndx)
-  { this->entries_.push_back(std::make_pair(symndx, shndx)); }
+  {
+    Hold_lock hl(this->lock_);
+    this->entries_.push_back(std::make_pair(symndx, shndx));
+  }
 
  protected:
   void
@@ -2931,6 +3125,8 @@ class Output_symtab_xindex : public Output_section_data
 
   // The entries we need.
   Xindex_entries entries_;
+  // Protects entries_.
+  Lock lock_;
 };
 
 // A relaxed input section.
@@ -3613,6 +3809,11 @@ class Output_section : public Output_data
   void
   create_postprocessing_buffer();
 
+  // Return whether the postprocessing buffer has been created.
+  bool
+  has_postprocessing_buffer() const
+  { return this->postprocessing_buffer_ != NULL; }
+
   // If a section requires postprocessing, this is the size of the
   // buffer to which relocations should be applied.
   off_t
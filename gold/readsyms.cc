@@ -400,6 +400,11 @@ Read_symbols::do_read_symbols(Workqueue* workqueue)
       Read_symbols_data* sd = new Read_symbols_data;
       elf_obj->read_symbols(sd);
 
+      // Enter the symbol names into the symbol table's name pool
+      // now, while we run in parallel with the other Read_symbols
+      // tasks, so that the serial Add_symbols task has less to do.
+      elf_obj->intern_symbol_names(this->symtab_, sd);
+
       // Opening the file locked it, so now we need to unlock it.  We
       // need to unlock it before queuing the Add_symbols task,
       // because the workqueue doesn't know about our lock on the
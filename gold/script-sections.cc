@@ -37,6 +37,7 @@
 #include "script-c.h"
 #include "script.h"
 #include "script-sections.h"
+#include "wildcard.h"
 
 // Support for the SECTIONS clause in linker scripts.
 
@@ -635,6 +636,12 @@ class Sections_element
 		      Script_sections::Section_type*, bool*, bool)
   { return NULL; }
 
+  // Add any input section specifications to MATCHER.  The only real
+  // implementation is in Output_section_definition.
+  virtual void
+  add_to_input_section_matcher(Input_section_matcher*)
+  { }
+
   // Initialize OSP with an output section.
   virtual void
   orphan_section_init(Orphan_section_placement*,
@@ -853,6 +860,13 @@ class Output_section_element
   match_name(const char*, const char*, bool *) const
   { return false; }
 
+  // Add this element to MATCHER, if it is an input section
+  // specification in the output section OSD.
+  virtual void
+  add_to_input_section_matcher(Input_section_matcher*,
+			       Output_section_definition*)
+  { }
+
   // Set section addresses.  This includes applying assignments if the
   // expression is an absolute value.
   virtual void
@@ -1272,6 +1286,77 @@ class Output_section_element_fill : public Output_section_element
   Expression* val_;
 };
 
+class Output_section_element_input;
+
+// The input section specifications of a SECTIONS clause, compiled so
+// that we can quickly find the first one which matches an input
+// section.  Each specification is a rule, numbered in the order in
+// which it appears in the script.  The section name patterns of all
+// the rules go into a single Wildcard_matcher, so looking up a
+// section name does not run fnmatch on every pattern in the script.
+
+class Input_section_matcher
+{
+ public:
+  Input_section_matcher()
+    : rules_(), section_patterns_(0), match_all_rules_()
+  { }
+
+  // Add a rule for the input section specification INPUT in the
+  // output section OSD.  Return the rule number.
+  unsigned int
+  add_rule(const Output_section_element_input* input,
+	   Output_section_definition* osd)
+  {
+    this->rules_.push_back(Rule(input, osd));
+    return this->rules_.size() - 1;
+  }
+
+  // Add a section name pattern for RULE.
+  void
+  add_section_pattern(unsigned int rule, const std::string& pattern)
+  { this->section_patterns_.add(pattern, rule); }
+
+  // Record that RULE matches all section names.
+  void
+  add_match_all_rule(unsigned int rule)
+  { this->match_all_rules_.push_back(rule); }
+
+  // Build the lookup tables, after all rules have been added.
+  void
+  finalize()
+  { this->section_patterns_.finalize(); }
+
+  // Return the output section of the first rule which matches
+  // FILE_NAME and SECTION_NAME, and set *KEEP.  Return NULL if no
+  // rule matches.
+  Output_section_definition*
+  find(const char* file_name, const char* section_name, bool* keep) const;
+
+ private:
+  struct Rule
+  {
+    Rule(const Output_section_element_input* i,
+	 Output_section_definition* o)
+      : input(i), osd(o)
+    { }
+
+    const Output_section_element_input* input;
+    Output_section_definition* osd;
+  };
+
+  // Return whether rule R matches FILE_NAME, and set *KEEP if so.
+  bool
+  match_rule(unsigned int r, const char* file_name, bool* keep) const;
+
+  // The rules, in script order.
+  std::vector<Rule> rules_;
+  // The section name patterns, tagged with their rule numbers.
+  Wildcard_matcher section_patterns_;
+  // The rules with no section name patterns, in increasing order.
+  std::vector<unsigned int> match_all_rules_;
+};
+
 // An input section specification in an output section
 
 class Output_section_element_input : public Output_section_element
@@ -1293,6 +1378,20 @@ class Output_section_element_input : public Output_section_element
   bool
   match_name(const char* file_name, const char* section_name, bool* keep) const;
 
+  // See if we match a file name.
+  bool
+  match_file_name(const char* file_name) const;
+
+  // Whether to keep matching sections when garbage collecting.
+  bool
+  keep() const
+  { return this->keep_; }
+
+  // Add our section name patterns to MATCHER.
+  void
+  add_to_input_section_matcher(Input_section_matcher* matcher,
+			       Output_section_definition* osd);
+
   // Set the section address.
   void
   set_section_addresses(Symbol_table* symtab, Layout* layout, Output_section*,
@@ -1336,10 +1435,6 @@ class Output_section_element_input : public Output_section_element
 	    : strcmp(string, pattern) == 0);
   }
 
-  // See if we match a file name.
-  bool
-  match_file_name(const char* file_name) const;
-
   // The file name pattern.  If this is the empty string, we match all
   // files.
   std::string filename_pattern_;
@@ -1474,6 +1569,81 @@ Output_section_element_input::match_name(const char* file_name,
   return false;
 }
 
+// Add our section name patterns to MATCHER, as a single rule.
+
+void
+Output_section_element_input::add_to_input_section_matcher(
+    Input_section_matcher* matcher,
+    Output_section_definition* osd)
+{
+  unsigned int rule = matcher->add_rule(this, osd);
+  if (this->input_section_patterns_.empty())
+    matcher->add_match_all_rule(rule);
+  else
+    {
+      for (Input_section_patterns::const_iterator p =
+	     this->input_section_patterns_.begin();
+	   p != this->input_section_patterns_.end();
+	   ++p)
+	matcher->add_section_pattern(rule, p->pattern);
+    }
+}
+
+// Class Input_section_matcher.
+
+// Return whether rule R matches FILE_NAME.
+
+bool
+Input_section_matcher::match_rule(unsigned int r, const char* file_name,
+				  bool* keep) const
+{
+  const Output_section_element_input* input = this->rules_[r].input;
+  if (!input->match_file_name(file_name))
+    return false;
+  *keep = input->keep();
+  return true;
+}
+
+// Find the first rule which matches.  The rules whose section name
+// patterns match SECTION_NAME, and the rules which match any section
+// name, are both in increasing order, so we walk them together.  Only
+// those rules need to check FILE_NAME.
+
+Output_section_definition*
+Input_section_matcher::find(const char* file_name, const char* section_name,
+			    bool* keep) const
+{
+  std::vector<unsigned int> rules;
+  this->section_patterns_.find_all(section_name, &rules);
+
+  std::vector<unsigned int>::const_iterator p = rules.begin();
+  std::vector<unsigned int>::const_iterator pall =
+    this->match_all_rules_.begin();
+  while (p != rules.end() || pall != this->match_all_rules_.end())
+    {
+      unsigned int r;
+      if (pall == this->match_all_rules_.end()
+	  || (p != rules.end() && *p < *pall))
+	{
+	  r = *p;
+	  // A rule may have several patterns which match.
+	  do
+	    ++p;
+	  while (p != rules.end() && *p == r);
+	}
+      else
+	{
+	  r = *pall;
+	  ++pall;
+	}
+
+      if (this->match_rule(r, file_name, keep))
+	return this->rules_[r].osd;
+    }
+
+  return NULL;
+}
+
 // Information we use to sort the input sections.
 
 class Input_section_info
@@ -2005,6 +2175,21 @@ class Output_section_definition : public Sections_element
 		      Output_section***, Script_sections::Section_type*,
 		      bool*, bool);
 
+  // Return the output section name to use for an input section which
+  // matched one of our input section specifications.
+  const char*
+  matched_output_section_name(Output_section*** slot,
+			      Script_sections::Section_type* psection_type)
+  {
+    *slot = &this->output_section_;
+    *psection_type = this->section_type();
+    return this->name_.c_str();
+  }
+
+  // Add our input section specifications to MATCHER.
+  void
+  add_to_input_section_matcher(Input_section_matcher* matcher);
+
   // Initialize OSP with an output section.
   void
   orphan_section_init(Orphan_section_placement* osp,
@@ -2312,9 +2497,7 @@ Output_section_definition::output_section_name(
 	{
 	  // We found a match for NAME, which means that it should go
 	  // into this output section.
-	  *slot = &this->output_section_;
-	  *psection_type = this->section_type();
-	  return this->name_.c_str();
+	  return this->matched_output_section_name(slot, psection_type);
 	}
     }
 
@@ -2322,6 +2505,18 @@ Output_section_definition::output_section_name(
   return NULL;
 }
 
+// Add our input section specifications to MATCHER.
+
+void
+Output_section_definition::add_to_input_section_matcher(
+    Input_section_matcher* matcher)
+{
+  for (Output_section_elements::const_iterator p = this->elements_.begin();
+       p != this->elements_.end();
+       ++p)
+    (*p)->add_to_input_section_matcher(matcher, this);
+}
+
 // Return true if memory from START to START + LENGTH is contained
 // within a memory region.
 
@@ -3347,7 +3542,8 @@ Script_sections::Script_sections()
     saw_data_segment_align_(false),
     saw_relro_end_(false),
     saw_segment_start_expression_(false),
-    segments_created_(false)
+    segments_created_(false),
+    input_section_matcher_(NULL)
 {
 }
 
@@ -3370,6 +3566,16 @@ Script_sections::finish_sections()
 {
   gold_assert(this->in_sections_clause_ && this->output_section_ == NULL);
   this->in_sections_clause_ = false;
+
+  // Compile the input section specifications.  There may be more than
+  // one SECTIONS clause, so start over each time.
+  delete this->input_section_matcher_;
+  this->input_section_matcher_ = new Input_section_matcher();
+  for (Sections_elements::const_iterator p = this->sections_elements_->begin();
+       p != this->sections_elements_->end();
+       ++p)
+    (*p)->add_to_input_section_matcher(this->input_section_matcher_);
+  this->input_section_matcher_->finalize();
 }
 
 // Add a symbol to be defined.
@@ -3572,27 +3778,44 @@ Script_sections::output_section_name(
     bool* keep,
     bool is_input_section)
 {
-  for (Sections_elements::const_iterator p = this->sections_elements_->begin();
-       p != this->sections_elements_->end();
-       ++p)
+  const char* ret = NULL;
+  if (is_input_section && this->input_section_matcher_ != NULL)
     {
-      const char* ret = (*p)->output_section_name(file_name, section_name,
-						  output_section_slot,
-						  psection_type, keep,
-						  is_input_section);
+      // When matching an input section, only the input section
+      // specifications matter, so we can use the compiled form.
+      Output_section_definition* osd =
+	this->input_section_matcher_->find(file_name, section_name, keep);
+      if (osd != NULL)
+	ret = osd->matched_output_section_name(output_section_slot,
+					       psection_type);
+    }
+  else
+    {
+      for (Sections_elements::const_iterator p =
+	     this->sections_elements_->begin();
+	   p != this->sections_elements_->end();
+	   ++p)
+	{
+	  ret = (*p)->output_section_name(file_name, section_name,
+					  output_section_slot,
+					  psection_type, keep,
+					  is_input_section);
+	  if (ret != NULL)
+	    break;
+	}
+    }
 
-      if (ret != NULL)
+  if (ret != NULL)
+    {
+      // The special name /DISCARD/ means that the input section
+      // should be discarded.
+      if (strcmp(ret, "/DISCARD/") == 0)
 	{
-	  // The special name /DISCARD/ means that the input section
-	  // should be discarded.
-	  if (strcmp(ret, "/DISCARD/") == 0)
-	    {
-	      *output_section_slot = NULL;
-	      *psection_type = Script_sections::ST_NONE;
-	      return NULL;
-	    }
-	  return ret;
+	  *output_section_slot = NULL;
+	  *psection_type = Script_sections::ST_NONE;
+	  return NULL;
 	}
+      return ret;
     }
 
   // We have an orphan section.
@@ -41,6 +41,7 @@ class Memory_region;
 class Phdrs_element;
 class Output_data;
 class Output_section_definition;
+class Input_section_matcher;
 class Output_section;
 class Output_segment;
 class Orphan_section_placement;
@@ -324,6 +325,9 @@ class Script_sections
   bool saw_segment_start_expression_;
   // Whether we have created all necessary segments.
   bool segments_created_;
+  // The input section specifications in the SECTIONS clause, compiled
+  // for matching.  NULL if no SECTIONS clause has been finished.
+  Input_section_matcher* input_section_matcher_;
 };
 
 // Attributes for memory regions.
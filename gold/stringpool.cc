@@ -28,6 +28,7 @@
 
 #include "output.h"
 #include "parameters.h"
+#include "gold-threads.h"
 #include "stringpool.h"
 
 namespace gold
@@ -39,8 +40,11 @@ Stringpool_template<Stringpool_char>::Stringpool_template(uint64_t addralign)
     zero_null_(true), optimize_(false), offset_(sizeof(Stringpool_char)),
     addralign_(addralign)
 {
+  // Suffix merging is cheap enough to do by default.  We don't do it
+  // for an incremental link, which expects strings to keep the
+  // offsets they are given as they are added.
   if (parameters->options_valid()
-      && parameters->options().optimize() >= 2
+      && !parameters->incremental()
       && addralign <= sizeof(Stringpool_char))
     this->optimize_ = true;
 }
@@ -241,6 +245,20 @@ Stringpool_template<Stringpool_char>::add_with_length(const Stringpool_char* s,
 						      size_t length,
 						      bool copy,
 						      Key* pkey)
+{
+  return this->add_with_hash(s, length, string_hash(s, length), copy, pkey);
+}
+
+// Add string S of length LENGTH with the precomputed hash code
+// HASH_CODE.
+
+template<typename Stringpool_char>
+const Stringpool_char*
+Stringpool_template<Stringpool_char>::add_with_hash(const Stringpool_char* s,
+						    size_t length,
+						    size_t hash_code,
+						    bool copy,
+						    Key* pkey)
 {
   typedef std::pair<typename String_set_type::iterator, bool> Insert_type;
 
@@ -252,7 +270,7 @@ Stringpool_template<Stringpool_char>::add_with_length(const Stringpool_char* s,
       // When we don't need to copy the string, we can call insert
       // directly.
 
-      std::pair<Hashkey, Hashval> element(Hashkey(s, length), k);
+      std::pair<Hashkey, Hashval> element(Hashkey(s, length, hash_code), k);
 
       Insert_type ins = this->string_set_.insert(element);
 
@@ -279,7 +297,7 @@ Stringpool_template<Stringpool_char>::add_with_length(const Stringpool_char* s,
   // canonicalize it by copying it into the canonical list. The hash
   // code will only be computed once.
 
-  Hashkey hk(s, length);
+  Hashkey hk(s, length, hash_code);
   typename String_set_type::const_iterator p = this->string_set_.find(hk);
   if (p != this->string_set_.end())
     {
@@ -320,6 +338,24 @@ Stringpool_template<Stringpool_char>::find(const Stringpool_char* s,
   return p->first.string;
 }
 
+template<typename Stringpool_char>
+const Stringpool_char*
+Stringpool_template<Stringpool_char>::find_with_hash(const Stringpool_char* s,
+						     size_t length,
+						     size_t hash_code,
+						     Key* pkey) const
+{
+  Hashkey hk(s, length, hash_code);
+  typename String_set_type::const_iterator p = this->string_set_.find(hk);
+  if (p == this->string_set_.end())
+    return NULL;
+
+  if (pkey != NULL)
+    *pkey = p->second;
+
+  return p->first.string;
+}
+
 // Comparison routine used when sorting into an ELF strtab.  We want
 // to sort this so that when one string is a suffix of another, we
 // always see the shorter string immediately after the longer string.
@@ -333,25 +369,109 @@ Stringpool_template<Stringpool_char>::find(const Stringpool_char* s,
 
 template<typename Stringpool_char>
 bool
-Stringpool_template<Stringpool_char>::Stringpool_sort_comparison::operator()(
-  const Stringpool_sort_info& sort_info1,
-  const Stringpool_sort_info& sort_info2) const
-{
-  const Hashkey& h1(sort_info1->first);
-  const Hashkey& h2(sort_info2->first);
-  const Stringpool_char* s1 = h1.string;
-  const Stringpool_char* s2 = h2.string;
-  const size_t len1 = h1.length;
-  const size_t len2 = h2.length;
-  const size_t minlen = len1 < len2 ? len1 : len2;
-  const Stringpool_char* p1 = s1 + len1 - 1;
-  const Stringpool_char* p2 = s2 + len2 - 1;
-  for (size_t i = minlen; i > 0; --i, --p1, --p2)
+Stringpool_template<Stringpool_char>::reversed_less(
+    const Stringpool_sort_info& info1,
+    const Stringpool_sort_info& info2,
+    size_t depth)
+{
+  const size_t minlen = std::min(info1.length, info2.length);
+  const Stringpool_char* p1 = info1.string + info1.length - 1 - depth;
+  const Stringpool_char* p2 = info2.string + info2.length - 1 - depth;
+  for (size_t i = depth; i < minlen; ++i, --p1, --p2)
     {
       if (*p1 != *p2)
 	return *p1 > *p2;
     }
-  return len1 > len2;
+  return info1.length > info2.length;
+}
+
+// Sort the strings using a multikey quicksort on the reversed
+// strings.  Each partitioning step looks at a single character of
+// each string, and strings which share a suffix move on to the next
+// character together, so we never compare a common suffix twice.
+// This is much cheaper than a comparison sort when many strings share
+// long suffixes, as mangled names do.  Since the strings are unique,
+// the result is the same as a sort with reversed_less.
+
+template<typename Stringpool_char>
+void
+Stringpool_template<Stringpool_char>::sort_reversed(Stringpool_sort_vector* v)
+{
+  // Ranges this small are finished with an insertion sort.
+  const size_t small_range = 12;
+
+  struct Range
+  {
+    size_t lo;
+    size_t hi;
+    size_t depth;
+  };
+
+  std::vector<Range> stack;
+  Range initial = { 0, v->size(), 0 };
+  stack.push_back(initial);
+  while (!stack.empty())
+    {
+      Range r = stack.back();
+      stack.pop_back();
+
+      if (r.hi - r.lo <= small_range)
+	{
+	  for (size_t i = r.lo + 1; i < r.hi; ++i)
+	    {
+	      Stringpool_sort_info t = (*v)[i];
+	      size_t j = i;
+	      for (; j > r.lo && reversed_less(t, (*v)[j - 1], r.depth); --j)
+		(*v)[j] = (*v)[j - 1];
+	      (*v)[j] = t;
+	    }
+	  continue;
+	}
+
+      // Use the median of three characters as the pivot.
+      int64_t a = reversed_char((*v)[r.lo], r.depth);
+      int64_t b = reversed_char((*v)[r.lo + (r.hi - r.lo) / 2], r.depth);
+      int64_t c = reversed_char((*v)[r.hi - 1], r.depth);
+      int64_t pivot;
+      if (a < b)
+	pivot = b < c ? b : (a < c ? c : a);
+      else
+	pivot = a < c ? a : (b < c ? c : b);
+
+      // Partition into characters greater than the pivot, equal to
+      // it, and less than it, in that order.
+      size_t lt = r.lo;
+      size_t i = r.lo;
+      size_t gt = r.hi;
+      while (i < gt)
+	{
+	  int64_t ch = reversed_char((*v)[i], r.depth);
+	  if (ch > pivot)
+	    std::swap((*v)[lt++], (*v)[i++]);
+	  else if (ch < pivot)
+	    std::swap((*v)[i], (*v)[--gt]);
+	  else
+	    ++i;
+	}
+
+      if (lt - r.lo > 1)
+	{
+	  Range greater = { r.lo, lt, r.depth };
+	  stack.push_back(greater);
+	}
+      if (r.hi - gt > 1)
+	{
+	  Range less = { gt, r.hi, r.depth };
+	  stack.push_back(less);
+	}
+      // Strings which have ended are all the same string, and there
+      // is only one of each.
+      if (gt - lt > 1 && pivot != end_of_string)
+	{
+	  Range equal = { lt, gt, r.depth + 1 };
+	  stack.push_back(equal);
+	}
+    }
 }
 
 // Return whether s1 is a suffix of s2.
@@ -386,11 +506,8 @@ Stringpool_template<Stringpool_char>::set_string_offsets()
   // Offset 0 may be reserved for the empty string.
   section_offset_type offset = this->zero_null_ ? charsize : 0;
 
-  // Sorting to find suffixes can take over 25% of the total CPU time
-  // used by the linker.  Since it's merely an optimization to reduce
-  // the strtab size, and gives a relatively small benefit (it's
-  // typically rare for a symbol to be a suffix of another), we only
-  // take the time to sort when the user asks for heavy optimization.
+  // When optimizing, sort the strings so that we can share the tail
+  // of a string with any string that is a suffix of it.
   if (!this->optimize_)
     {
       // If we are not optimizing, the offsets are already assigned.
@@ -400,41 +517,44 @@ Stringpool_template<Stringpool_char>::set_string_offsets()
     {
       size_t count = this->string_set_.size();
 
-      std::vector<Stringpool_sort_info> v;
+      Stringpool_sort_vector v;
       v.reserve(count);
 
       for (typename String_set_type::iterator p = this->string_set_.begin();
            p != this->string_set_.end();
            ++p)
-        v.push_back(Stringpool_sort_info(p));
+	{
+	  Stringpool_sort_info info;
+	  info.string = p->first.string;
+	  info.length = p->first.length;
+	  info.key = p->second;
+	  v.push_back(info);
+	}
 
-      std::sort(v.begin(), v.end(), Stringpool_sort_comparison());
+      sort_reversed(&v);
 
       section_offset_type last_offset = -1;
-      for (typename std::vector<Stringpool_sort_info>::iterator last = v.end(),
+      for (typename Stringpool_sort_vector::iterator last = v.end(),
              curr = v.begin();
            curr != v.end();
            last = curr++)
         {
 	  section_offset_type this_offset;
-          if (this->zero_null_ && (*curr)->first.string[0] == 0)
+          if (this->zero_null_ && curr->string[0] == 0)
             this_offset = 0;
           else if (last != v.end()
-                   && ((((*curr)->first.length - (*last)->first.length)
+                   && (((curr->length - last->length)
 			% this->addralign_) == 0)
-                   && is_suffix((*curr)->first.string,
-				(*curr)->first.length,
-                                (*last)->first.string,
-				(*last)->first.length))
+                   && is_suffix(curr->string, curr->length,
+                                last->string, last->length))
             this_offset = (last_offset
-			   + (((*last)->first.length - (*curr)->first.length)
-			      * charsize));
+			   + ((last->length - curr->length) * charsize));
           else
             {
               this_offset = align_address(offset, this->addralign_);
-              offset = this_offset + ((*curr)->first.length + 1) * charsize;
+              offset = this_offset + (curr->length + 1) * charsize;
             }
-	  this->key_to_offset_[(*curr)->second - 1] = this_offset;
+	  this->key_to_offset_[curr->key - 1] = this_offset;
 	  last_offset = this_offset;
         }
     }
@@ -521,6 +641,131 @@ Stringpool_template<Stringpool_char>::print_stats(const char* name) const
 	  program_name, name, this->strings_.size());
 }
 
+// Class Sharded_stringpool.
+
+template<typename Stringpool_char>
+Sharded_stringpool_template<Stringpool_char>::Sharded_stringpool_template()
+{
+  for (unsigned int i = 0; i < shard_count; ++i)
+    this->shards_[i].lock = new Lock();
+}
+
+template<typename Stringpool_char>
+Sharded_stringpool_template<Stringpool_char>::~Sharded_stringpool_template()
+{
+  for (unsigned int i = 0; i < shard_count; ++i)
+    delete this->shards_[i].lock;
+}
+
+// Spread the reservation evenly over the shards.
+
+template<typename Stringpool_char>
+void
+Sharded_stringpool_template<Stringpool_char>::reserve(unsigned int n)
+{
+  unsigned int per_shard = (n + shard_count - 1) / shard_count;
+  for (unsigned int i = 0; i < shard_count; ++i)
+    {
+      Hold_lock hl(*this->shards_[i].lock);
+      this->shards_[i].pool.reserve(per_shard);
+    }
+}
+
+// Add a string.  The hash code is computed before taking the lock of
+// the shard that owns it.
+
+template<typename Stringpool_char>
+const Stringpool_char*
+Sharded_stringpool_template<Stringpool_char>::add_with_length(
+    const Stringpool_char* s,
+    size_t length,
+    bool copy,
+    Key* pkey,
+    size_t* phash)
+{
+  size_t hash_code =
+    Stringpool_template<Stringpool_char>::hash_string(s, length);
+  if (phash != NULL)
+    *phash = hash_code;
+  return this->add_with_hash(s, length, hash_code, copy, pkey);
+}
+
+// Add a string whose hash code is already known.
+
+template<typename Stringpool_char>
+const Stringpool_char*
+Sharded_stringpool_template<Stringpool_char>::add_with_hash(
+    const Stringpool_char* s,
+    size_t length,
+    size_t hash_code,
+    bool copy,
+    Key* pkey)
+{
+  unsigned int shard = shard_index(hash_code);
+  Shard* ps = &this->shards_[shard];
+
+  Key shard_key;
+  const Stringpool_char* ret;
+  {
+    Hold_lock hl(*ps->lock);
+    ret = ps->pool.add_with_hash(s, length, hash_code, copy, &shard_key);
+  }
+
+  if (pkey != NULL)
+    *pkey = make_key(shard_key, shard);
+  return ret;
+}
+
+// Find a string.
+
+template<typename Stringpool_char>
+const Stringpool_char*
+Sharded_stringpool_template<Stringpool_char>::find(const Stringpool_char* s,
+						   Key* pkey,
+						   size_t* phash) const
+{
+  size_t length = string_length(s);
+  size_t hash_code =
+    Stringpool_template<Stringpool_char>::hash_string(s, length);
+  unsigned int shard = shard_index(hash_code);
+  const Shard* ps = &this->shards_[shard];
+
+  Key shard_key;
+  const Stringpool_char* ret;
+  {
+    Hold_lock hl(*ps->lock);
+    ret = ps->pool.find_with_hash(s, length, hash_code, &shard_key);
+  }
+  if (ret == NULL)
+    return NULL;
+
+  if (pkey != NULL)
+    *pkey = make_key(shard_key, shard);
+  if (phash != NULL)
+    *phash = hash_code;
+  return ret;
+}
+
+// Print statistics, summed over all the shards.
+
+template<typename Stringpool_char>
+void
+Sharded_stringpool_template<Stringpool_char>::print_stats(const char* name)
+  const
+{
+  size_t entries = 0;
+  size_t largest = 0;
+  for (unsigned int i = 0; i < shard_count; ++i)
+    {
+      size_t count = this->shards_[i].pool.string_count();
+      entries += count;
+      if (count > largest)
+	largest = count;
+    }
+  fprintf(stderr, _("%s: %s entries: %zu; shards: %u; largest shard: %zu\n"),
+	  program_name, name, entries, shard_count, largest);
+}
+
 // Instantiate the templates we need.
 
 template
@@ -532,4 +777,13 @@ class Stringpool_template<uint16_t>;
 template
 class Stringpool_template<uint32_t>;
 
+template
+class Sharded_stringpool_template<char>;
+
+template
+class Sharded_stringpool_template<uint16_t>;
+
+template
+class Sharded_stringpool_template<uint32_t>;
+
 } // End namespace gold.
@@ -31,6 +31,7 @@ namespace gold
 {
 
 class Output_file;
+class Lock;
 
 // Return the length of a string in units of Char_type.
 
@@ -206,12 +207,18 @@ class Stringpool_template
     this->offset_ = 0;
   }
 
-  // Indicate that this string pool should be optimized, even if not
-  // running with -O2.
+  // Indicate that this string pool should be optimized, even for an
+  // incremental link.
   void
   set_optimize()
   { this->optimize_ = true; }
 
+  // Indicate that this string pool should not be optimized, because
+  // the caller uses the offsets of strings as they are added.
+  void
+  set_no_optimize()
+  { this->optimize_ = false; }
+
   // Add the string S to the pool.  This returns a canonical permanent
   // pointer to the string in the pool.  If COPY is true, the string
   // is copied into permanent storage.  If PKEY is not NULL, this sets
@@ -229,12 +236,34 @@ class Stringpool_template
   const Stringpool_char*
   add_with_length(const Stringpool_char* s, size_t len, bool copy, Key* pkey);
 
+  // Add string S of length LEN characters to the pool, where
+  // HASH_CODE is the value returned by hash_string for S.
+  const Stringpool_char*
+  add_with_hash(const Stringpool_char* s, size_t len, size_t hash_code,
+		bool copy, Key* pkey);
+
   // If the string S is present in the pool, return the canonical
   // string pointer.  Otherwise, return NULL.  If PKEY is not NULL,
   // set *PKEY to the key.
   const Stringpool_char*
   find(const Stringpool_char* s, Key* pkey) const;
 
+  // Like find, for string S of length LEN characters with hash code
+  // HASH_CODE.
+  const Stringpool_char*
+  find_with_hash(const Stringpool_char* s, size_t len, size_t hash_code,
+		 Key* pkey) const;
+
+  // Return the hash code used for string S of LENGTH characters.
+  static size_t
+  hash_string(const Stringpool_char* s, size_t length)
+  { return string_hash(s, length); }
+
+  // Return the number of strings in the pool.
+  size_t
+  string_count() const
+  { return this->string_set_.size(); }
+
   // Turn the stringpool into a string table: determine the offsets of
   // all the strings.  After this is called, no more strings may be
   // added to the stringpool.
@@ -353,6 +382,10 @@ class Stringpool_template
     Hashkey(const Stringpool_char* s, size_t len)
       : string(s), length(len), hash_code(string_hash(s, len))
     { }
+
+    Hashkey(const Stringpool_char* s, size_t len, size_t hash)
+      : string(s), length(len), hash_code(hash)
+    { }
   };
 
   // Hash function.  This is trivial, since we have already computed
@@ -378,16 +411,42 @@ class Stringpool_template
   typedef Unordered_map<Hashkey, Hashval, Stringpool_hash,
 			Stringpool_eq> String_set_type;
 
-  // Comparison routine used when sorting into a string table.
-
-  typedef typename String_set_type::iterator Stringpool_sort_info;
+  // An entry in the array we sort when building a string table.  We
+  // copy the string and its length out of the hash table so that
+  // sorting does not chase the hash table nodes.
 
-  struct Stringpool_sort_comparison
+  struct Stringpool_sort_info
   {
-    bool
-    operator()(const Stringpool_sort_info&, const Stringpool_sort_info&) const;
+    const Stringpool_char* string;
+    size_t length;
+    Key key;
   };
 
+  typedef std::vector<Stringpool_sort_info> Stringpool_sort_vector;
+
+  // A value less than any character.
+  static const int64_t end_of_string = -(static_cast<int64_t>(1) << 32) - 1;
+
+  // Return the character DEPTH characters from the end of the string
+  // of INFO, or end_of_string if the string is shorter than that.
+  static int64_t
+  reversed_char(const Stringpool_sort_info& info, size_t depth)
+  {
+    if (depth >= info.length)
+      return end_of_string;
+    return info.string[info.length - 1 - depth];
+  }
+
+  // Return whether INFO1 sorts before INFO2, given that their last
+  // DEPTH characters are the same.
+  static bool
+  reversed_less(const Stringpool_sort_info& info1,
+		const Stringpool_sort_info& info2, size_t depth);
+
+  // Sort the strings into string table order.
+  static void
+  sort_reversed(Stringpool_sort_vector*);
+
   // Keys map to offsets via a Chunked_vector.  We only use the
   // offsets if we turn this into an string table section.
   typedef Chunked_vector<section_offset_type> Key_to_offset;
@@ -416,6 +475,116 @@ class Stringpool_template
 // The most common type of Stringpool.
 typedef Stringpool_template<char> Stringpool;
 
+// A Sharded_stringpool is a pool of unique strings which may be added
+// to by several threads at once.  The strings are divided by hash
+// code among a fixed number of Stringpools, each with its own lock,
+// so threads adding different strings rarely wait for each other.
+
+// As with a Stringpool, every string in the pool is unique and has a
+// nonzero key.  However, the key assigned to a string depends on the
+// order in which the threads happen to add strings, so keys may only
+// be compared for equality.  Code that needs a value that is stable
+// across runs of the linker should use the hash code, which depends
+// only on the contents of the string.  A Sharded_stringpool can not
+// be turned into a string table.
+
+template<typename Stringpool_char>
+class Sharded_stringpool_template
+{
+ public:
+  typedef typename Stringpool_template<Stringpool_char>::Key Key;
+
+  // The number of low bits of a key which hold the shard index.
+  static const int shard_bits = 6;
+  // The number of shards.
+  static const unsigned int shard_count = 1U << shard_bits;
+
+  Sharded_stringpool_template();
+
+  ~Sharded_stringpool_template();
+
+  // Hint that about N strings will be added.
+  void
+  reserve(unsigned int n);
+
+  // Add the string S to the pool, returning the canonical string.  If
+  // COPY is true, the string is copied into permanent storage.  If
+  // PKEY is not NULL, set *PKEY to the key.  If PHASH is not NULL,
+  // set *PHASH to the hash code.
+  const Stringpool_char*
+  add(const Stringpool_char* s, bool copy, Key* pkey, size_t* phash = NULL)
+  { return this->add_with_length(s, string_length(s), copy, pkey, phash); }
+
+  // Add string S of length LEN characters to the pool.  If COPY is
+  // true, S need not be null terminated.
+  const Stringpool_char*
+  add_with_length(const Stringpool_char* s, size_t len, bool copy, Key* pkey,
+		  size_t* phash = NULL);
+
+  // Add string S of length LEN characters to the pool, where
+  // HASH_CODE is the value returned by
+  // Stringpool_template::hash_string for S.
+  const Stringpool_char*
+  add_with_hash(const Stringpool_char* s, size_t len, size_t hash_code,
+		bool copy, Key* pkey);
+
+  // If the string S is present in the pool, return the canonical
+  // string pointer and set *PKEY and *PHASH if they are not NULL.
+  // Otherwise, return NULL.
+  const Stringpool_char*
+  find(const Stringpool_char* s, Key* pkey, size_t* phash = NULL) const;
+
+  // The keys of the strings in each shard are dense.  Return the
+  // shard of key K.
+  static unsigned int
+  key_shard(Key k)
+  { return k & (shard_count - 1); }
+
+  // Return the index of key K within its shard, starting from 0.
+  static size_t
+  key_index(Key k)
+  { return (k >> shard_bits) - 1; }
+
+  // Return the number of strings in shard SHARD.
+  size_t
+  shard_string_count(unsigned int shard) const
+  { return this->shards_[shard].pool.string_count(); }
+
+  // Dump statistical information to stderr.
+  void
+  print_stats(const char*) const;
+
+ private:
+  Sharded_stringpool_template(const Sharded_stringpool_template&);
+  Sharded_stringpool_template& operator=(const Sharded_stringpool_template&);
+
+  // Return the shard which holds strings with hash code HASH_CODE.
+  static unsigned int
+  shard_index(size_t hash_code)
+  { return (hash_code ^ (hash_code >> 17)) & (shard_count - 1); }
+
+  // Convert a key in shard SHARD to a key in this pool.
+  static Key
+  make_key(Key shard_key, unsigned int shard)
+  { return (shard_key << shard_bits) | shard; }
+
+  // One shard of the pool.
+  struct Shard
+  {
+    Shard()
+      : pool(), lock(NULL)
+    { }
+
+    Stringpool_template<Stringpool_char> pool;
+    Lock* lock;
+  };
+
+  Shard shards_[shard_count];
+};
+
+// The most common type of Sharded_stringpool.
+typedef Sharded_stringpool_template<char> Sharded_stringpool;
+
 } // End namespace gold.
 
 #endif // !defined(GOLD_STRINGPOOL_H)
@@ -585,7 +585,7 @@ inline bool
 Symbol_table::Symbol_table_eq::operator()(const Symbol_table_key& k1,
 					  const Symbol_table_key& k2) const
 {
-  return k1.first == k2.first && k1.second == k2.second;
+  return k1.name_key == k2.name_key && k1.version_key == k2.version_key;
 }
 
 bool
@@ -702,7 +702,8 @@ Symbol*
 Symbol_table::lookup(const char* name, const char* version) const
 {
   Stringpool::Key name_key;
-  name = this->namepool_.find(name, &name_key);
+  size_t name_hash;
+  name = this->namepool_.find(name, &name_key, &name_hash);
   if (name == NULL)
     return NULL;
 
@@ -714,7 +715,7 @@ Symbol_table::lookup(const char* name, const char* version) const
 	return NULL;
     }
 
-  Symbol_table_key key(name_key, version_key);
+  Symbol_table_key key(name_key, name_hash, version_key);
   Symbol_table::Symbol_table_type::const_iterator p = this->table_.find(key);
   if (p == this->table_.end())
     return NULL;
@@ -767,12 +768,13 @@ Symbol_table::force_local(Symbol* sym)
   this->forced_locals_.push_back(sym);
 }
 
-// Adjust NAME for wrapping, and update *NAME_KEY if necessary.  This
-// is only called for undefined symbols, when at least one --wrap
-// option was used.
+// Adjust NAME for wrapping, and update *NAME_KEY and *NAME_HASH if
+// necessary.  This is only called for undefined symbols, when at
+// least one --wrap option was used.
 
 const char*
-Symbol_table::wrap_symbol(const char* name, Stringpool::Key* name_key)
+Symbol_table::wrap_symbol(const char* name, Stringpool::Key* name_key,
+			  size_t* name_hash)
 {
   // For some targets, we need to ignore a specific character when
   // wrapping, and add it back later.
@@ -795,7 +797,7 @@ Symbol_table::wrap_symbol(const char* name, Stringpool::Key* name_key)
       // This will give us both the old and new name in NAMEPOOL_, but
       // that is OK.  Only the versions we need will wind up in the
       // real string table in the output file.
-      return this->namepool_.add(s.c_str(), true, name_key);
+      return this->namepool_.add(s.c_str(), true, name_key, name_hash);
     }
 
   const char* const real_prefix = "__real_";
@@ -808,7 +810,7 @@ Symbol_table::wrap_symbol(const char* name, Stringpool::Key* name_key)
       if (prefix != '\0')
 	s += prefix;
       s += name + real_prefix_length;
-      return this->namepool_.add(s.c_str(), true, name_key);
+      return this->namepool_.add(s.c_str(), true, name_key, name_hash);
     }
 
   return name;
@@ -933,6 +935,7 @@ Sized_symbol<size>*
 Symbol_table::add_from_object(Object* object,
 			      const char* name,
 			      Stringpool::Key name_key,
+			      size_t name_hash,
 			      const char* version,
 			      Stringpool::Key version_key,
 			      bool is_default_version,
@@ -955,7 +958,7 @@ Symbol_table::add_from_object(Object* object,
   if (orig_st_shndx == elfcpp::SHN_UNDEF
       && parameters->options().any_wrap())
     {
-      const char* wrap_name = this->wrap_symbol(name, &name_key);
+      const char* wrap_name = this->wrap_symbol(name, &name_key, &name_hash);
       if (wrap_name != name)
 	{
 	  // If we see a reference to malloc with version GLIBC_2.0,
@@ -971,7 +974,8 @@ Symbol_table::add_from_object(Object* object,
 
   Symbol* const snull = NULL;
   std::pair<typename Symbol_table_type::iterator, bool> ins =
-    this->table_.insert(std::make_pair(std::make_pair(name_key, version_key),
+    this->table_.insert(std::make_pair(Symbol_table_key(name_key, name_hash,
+							version_key),
 				       snull));
 
   std::pair<typename Symbol_table_type::iterator, bool> insdefault =
@@ -979,8 +983,9 @@ Symbol_table::add_from_object(Object* object,
   if (is_default_version)
     {
       const Stringpool::Key vnull_key = 0;
-      insdefault = this->table_.insert(std::make_pair(std::make_pair(name_key,
-								     vnull_key),
+      insdefault = this->table_.insert(std::make_pair(Symbol_table_key(name_key,
+								       name_hash,
+								       vnull_key),
 						      snull));
     }
 
@@ -1034,7 +1039,8 @@ Symbol_table::add_from_object(Object* object,
 	      // (See PR gold/18703.)
 	      ret->set_is_not_default();
 	      const Stringpool::Key vnull_key = 0;
-	      this->table_.erase(std::make_pair(name_key, vnull_key));
+	      this->table_.erase(Symbol_table_key(name_key, name_hash,
+						  vnull_key));
 	    }
 	}
     }
@@ -1107,8 +1113,9 @@ Symbol_table::add_from_object(Object* object,
 		    {
 		      this->table_.erase(insdefault.first);
 		      // Inserting INSDEFAULT invalidated INS.
-		      this->table_.erase(std::make_pair(name_key,
-							version_key));
+		      this->table_.erase(Symbol_table_key(name_key,
+							  name_hash,
+							  version_key));
 		    }
 		  return NULL;
 		}
@@ -1182,12 +1189,14 @@ Symbol_table::add_from_relobj(
     size_t symndx_offset,
     const char* sym_names,
     size_t sym_name_size,
+    const Interned_symbol_names* interned,
     typename Sized_relobj_file<size, big_endian>::Symbols* sympointers,
     size_t* defined)
 {
   *defined = 0;
 
   gold_assert(size == parameters->target().get_size());
+  gold_assert(interned == NULL || interned->size() == count);
 
   const int sym_size = elfcpp::Elf_sizes<size>::sym_size;
 
@@ -1240,10 +1249,11 @@ Symbol_table::add_from_relobj(
 	  is_defined_in_discarded_section = true;
 	}
 
-      // In an object file, an '@' in the name separates the symbol
-      // name from the version name.  If there are two '@' characters,
-      // this is the default version.
-      const char* ver = strchr(name, '@');
+      const Interned_symbol_name* in = NULL;
+      if (interned != NULL && (*interned)[i].name != NULL)
+	in = &(*interned)[i];
+
+      const char* ver;
       Stringpool::Key ver_key = 0;
       int namelen = 0;
       // IS_DEFAULT_VERSION: is the version default?
@@ -1251,32 +1261,48 @@ Symbol_table::add_from_relobj(
       bool is_default_version = false;
       bool is_forced_local = false;
 
-      // FIXME: For incremental links, we don't store version information,
-      // so we need to ignore version symbols for now.
-      if (parameters->incremental_update() && ver != NULL)
+      if (in != NULL)
 	{
-	  namelen = ver - name;
-	  ver = NULL;
+	  // The name was split and interned when the symbols were
+	  // read.
+	  ver = in->version;
+	  ver_key = in->version_key;
+	  is_default_version = in->is_default_version;
 	}
+      else
+	{
+	  // In an object file, an '@' in the name separates the
+	  // symbol name from the version name.  If there are two '@'
+	  // characters, this is the default version.
+	  ver = strchr(name, '@');
 
-      if (ver != NULL)
-        {
-          // The symbol name is of the form foo@VERSION or foo@@VERSION
-          namelen = ver - name;
-          ++ver;
-	  if (*ver == '@')
+	  // FIXME: For incremental links, we don't store version
+	  // information, so we need to ignore version symbols for now.
+	  if (parameters->incremental_update())
+	    ver = NULL;
+
+	  if (ver != NULL)
 	    {
-	      is_default_version = true;
+	      // The symbol name is of the form foo@VERSION or
+	      // foo@@VERSION
+	      namelen = ver - name;
 	      ++ver;
+	      if (*ver == '@')
+		{
+		  is_default_version = true;
+		  ++ver;
+		}
+	      ver = this->namepool_.add(ver, true, &ver_key);
 	    }
-	  ver = this->namepool_.add(ver, true, &ver_key);
-        }
+	  else
+	    namelen = strlen(name);
+	}
+
       // We don't want to assign a version to an undefined symbol,
       // even if it is listed in the version script.  FIXME: What
       // about a common symbol?
-      else
+      if (ver == NULL)
 	{
-	  namelen = strlen(name);
 	  if (!this->version_script_.empty()
 	      && st_shndx != elfcpp::SHN_UNDEF)
 	    {
@@ -1348,13 +1374,21 @@ Symbol_table::add_from_relobj(
         }
 
       Stringpool::Key name_key;
-      name = this->namepool_.add_with_length(name, namelen, true,
-					     &name_key);
+      size_t name_hash;
+      if (in != NULL)
+	{
+	  name = in->name;
+	  name_key = in->name_key;
+	  name_hash = in->name_hash;
+	}
+      else
+	name = this->namepool_.add_with_length(name, namelen, true,
+					       &name_key, &name_hash);
 
       Sized_symbol<size>* res;
-      res = this->add_from_object(relobj, name, name_key, ver, ver_key,
-				  is_default_version, *psym, st_shndx,
-				  is_ordinary, orig_st_shndx);
+      res = this->add_from_object(relobj, name, name_key, name_hash,
+				  ver, ver_key, is_default_version, *psym,
+				  st_shndx, is_ordinary, orig_st_shndx);
 
       if (res == NULL)
 	continue;
@@ -1381,6 +1415,123 @@ Symbol_table::add_from_relobj(
     }
 }
 
+// Enter the names of global symbols into the name pool.  This runs in
+// the Read_symbols task of each object, in parallel with other
+// objects, so it must only touch the symbol table through NAMEPOOL_,
+// which does its own locking.  Any symbol we can not handle here is
+// left with a NULL name, and add_from_relobj or add_from_dynobj will
+// handle it in the usual way.
+
+template<int size, bool big_endian>
+void
+Symbol_table::intern_symbol_names(const unsigned char* syms, size_t count,
+				  const char* sym_names,
+				  size_t sym_name_size,
+				  bool split_versions,
+				  const Symbol_name_digest* digests,
+				  Symbol_name_digests* new_digests,
+				  Interned_symbol_names* interned)
+{
+  const int sym_size = elfcpp::Elf_sizes<size>::sym_size;
+
+  // For incremental links, we don't store version information; see
+  // add_from_relobj.
+  if (parameters->incremental_update())
+    split_versions = false;
+
+  if (digests != NULL)
+    new_digests = NULL;
+  if (new_digests != NULL)
+    new_digests->resize(count);
+
+  interned->resize(count);
+  const unsigned char* p = syms;
+  for (size_t i = 0; i < count; ++i, p += sym_size)
+    {
+      Interned_symbol_name* in = &(*interned)[i];
+      in->name = NULL;
+      in->version = NULL;
+      in->version_key = 0;
+      in->is_default_version = false;
+
+      Symbol_name_digest* nd = NULL;
+      if (new_digests != NULL)
+	{
+	  nd = &(*new_digests)[i];
+	  nd->name_hash = 0;
+	  nd->name_length = -1U;
+	  nd->version_offset = 0;
+	}
+
+      elfcpp::Sym<size, big_endian> sym(p);
+
+      // Local symbols in a dynamic object are never added.
+      if (sym.get_st_bind() == elfcpp::STB_LOCAL)
+	continue;
+
+      unsigned int st_name = sym.get_st_name();
+      if (st_name >= sym_name_size)
+	continue;
+
+      const char* name = sym_names + st_name;
+      size_t namelen;
+      const char* ver;
+      size_t name_hash;
+
+      // Use the digest from the object cache if it fits the name.  A
+      // digest which does not fit means a damaged cache file, and is
+      // ignored.
+      const Symbol_name_digest* d = digests != NULL ? &digests[i] : NULL;
+      const size_t max_length = sym_name_size - st_name - 1;
+      if (d != NULL
+	  && d->name_length <= max_length
+	  && d->version_offset <= max_length
+	  && (d->version_offset == 0
+	      ? name[d->name_length] == '\0'
+	      : (name[d->name_length] == '@'
+		 && (d->version_offset == d->name_length + 1
+		     || d->version_offset == d->name_length + 2))))
+	{
+	  namelen = d->name_length;
+	  ver = d->version_offset == 0 ? NULL : name + d->version_offset;
+	  if (ver != NULL && d->version_offset == d->name_length + 2)
+	    in->is_default_version = true;
+	  name_hash = d->name_hash;
+	}
+      else
+	{
+	  ver = split_versions ? strchr(name, '@') : NULL;
+	  if (ver == NULL)
+	    namelen = strlen(name);
+	  else
+	    {
+	      namelen = ver - name;
+	      ++ver;
+	      if (*ver == '@')
+		{
+		  in->is_default_version = true;
+		  ++ver;
+		}
+	    }
+	  name_hash = Stringpool::hash_string(name, namelen);
+	}
+
+      if (ver != NULL)
+	in->version = this->namepool_.add(ver, true, &in->version_key);
+
+      in->name = this->namepool_.add_with_hash(name, namelen, name_hash, true,
+					       &in->name_key);
+      in->name_hash = name_hash;
+
+      if (nd != NULL)
+	{
+	  nd->name_hash = name_hash;
+	  nd->name_length = namelen;
+	  nd->version_offset = ver == NULL ? 0 : ver - name;
+	}
+    }
+}
+
 // Add a symbol from a plugin-claimed file.
 
 template<int size, bool big_endian>
@@ -1432,10 +1583,11 @@ Symbol_table::add_from_pluginobj(
     }
 
   Stringpool::Key name_key;
-  name = this->namepool_.add(name, true, &name_key);
+  size_t name_hash;
+  name = this->namepool_.add(name, true, &name_key, &name_hash);
 
   Sized_symbol<size>* res;
-  res = this->add_from_object(obj, name, name_key, ver, ver_key,
+  res = this->add_from_object(obj, name, name_key, name_hash, ver, ver_key,
 		              is_default_version, *sym, st_shndx,
 			      is_ordinary, st_shndx);
 
@@ -1461,12 +1613,14 @@ Symbol_table::add_from_dynobj(
     const unsigned char* versym,
     size_t versym_size,
     const std::vector<const char*>* version_map,
+    const Interned_symbol_names* interned,
     typename Sized_relobj_file<size, big_endian>::Symbols* sympointers,
     size_t* defined)
 {
   *defined = 0;
 
   gold_assert(size == parameters->target().get_size());
+  gold_assert(interned == NULL || interned->size() == count);
 
   if (dynobj->just_symbols())
     {
@@ -1543,6 +1697,10 @@ Symbol_table::add_from_dynobj(
 
       const char* name = sym_names + st_name;
 
+      const Interned_symbol_name* in = NULL;
+      if (interned != NULL && (*interned)[i].name != NULL)
+	in = &(*interned)[i];
+
       bool is_ordinary;
       unsigned int st_shndx = dynobj->adjust_sym_shndx(i, psym->get_st_shndx(),
 						       &is_ordinary);
@@ -1555,10 +1713,11 @@ Symbol_table::add_from_dynobj(
       if (versym == NULL)
 	{
 	  Stringpool::Key name_key;
-	  name = this->namepool_.add(name, true, &name_key);
-	  res = this->add_from_object(dynobj, name, name_key, NULL, 0,
-				      false, *psym, st_shndx, is_ordinary,
-				      st_shndx);
+	  size_t name_hash;
+	  name = this->dynobj_symbol_name(name, in, &name_key, &name_hash);
+	  res = this->add_from_object(dynobj, name, name_key, name_hash,
+				      NULL, 0, false, *psym, st_shndx,
+				      is_ordinary, st_shndx);
 	}
       else
 	{
@@ -1585,15 +1744,16 @@ Symbol_table::add_from_dynobj(
 
 	  // At this point we are definitely going to add this symbol.
 	  Stringpool::Key name_key;
-	  name = this->namepool_.add(name, true, &name_key);
+	  size_t name_hash;
+	  name = this->dynobj_symbol_name(name, in, &name_key, &name_hash);
 
 	  if (v == static_cast<unsigned int>(elfcpp::VER_NDX_LOCAL)
 	      || v == static_cast<unsigned int>(elfcpp::VER_NDX_GLOBAL))
 	    {
 	      // This symbol does not have a version.
-	      res = this->add_from_object(dynobj, name, name_key, NULL, 0,
-					  false, *psym, st_shndx, is_ordinary,
-					  st_shndx);
+	      res = this->add_from_object(dynobj, name, name_key, name_hash,
+					  NULL, 0, false, *psym, st_shndx,
+					  is_ordinary, st_shndx);
 	    }
 	  else
 	    {
@@ -1623,17 +1783,17 @@ Symbol_table::add_from_dynobj(
 	      if (st_shndx == elfcpp::SHN_ABS
 		  && !is_ordinary
 		  && name_key == version_key)
-		res = this->add_from_object(dynobj, name, name_key, NULL, 0,
-					    false, *psym, st_shndx, is_ordinary,
-					    st_shndx);
+		res = this->add_from_object(dynobj, name, name_key, name_hash,
+					    NULL, 0, false, *psym, st_shndx,
+					    is_ordinary, st_shndx);
 	      else
 		{
 		  const bool is_default_version =
 		    !hidden && st_shndx != elfcpp::SHN_UNDEF;
-		  res = this->add_from_object(dynobj, name, name_key, version,
-					      version_key, is_default_version,
-					      *psym, st_shndx,
-					      is_ordinary, st_shndx);
+		  res = this->add_from_object(dynobj, name, name_key,
+					      name_hash, version, version_key,
+					      is_default_version, *psym,
+					      st_shndx, is_ordinary, st_shndx);
 		}
 	    }
 	}
@@ -1681,10 +1841,11 @@ Symbol_table::add_from_incrobj(
   bool is_default_version = false;
 
   Stringpool::Key name_key;
-  name = this->namepool_.add(name, true, &name_key);
+  size_t name_hash;
+  name = this->namepool_.add(name, true, &name_key, &name_hash);
 
   Sized_symbol<size>* res;
-  res = this->add_from_object(obj, name, name_key, ver, ver_key,
+  res = this->add_from_object(obj, name, name_key, name_hash, ver, ver_key,
 		              is_default_version, *sym, st_shndx,
 			      is_ordinary, st_shndx);
 
@@ -1852,7 +2013,8 @@ Symbol_table::define_special_symbol(const char** pname, const char** pversion,
     {
       // Canonicalize NAME and VERSION.
       Stringpool::Key name_key;
-      *pname = this->namepool_.add(*pname, true, &name_key);
+      size_t name_hash;
+      *pname = this->namepool_.add(*pname, true, &name_key, &name_hash);
 
       Stringpool::Key version_key = 0;
       if (*pversion != NULL)
@@ -1860,8 +2022,9 @@ Symbol_table::define_special_symbol(const char** pname, const char** pversion,
 
       Symbol* const snull = NULL;
       std::pair<typename Symbol_table_type::iterator, bool> ins =
-	this->table_.insert(std::make_pair(std::make_pair(name_key,
-							  version_key),
+	this->table_.insert(std::make_pair(Symbol_table_key(name_key,
+							    name_hash,
+							    version_key),
 					   snull));
 
       std::pair<typename Symbol_table_type::iterator, bool> insdefault =
@@ -1870,8 +2033,9 @@ Symbol_table::define_special_symbol(const char** pname, const char** pversion,
 	{
 	  const Stringpool::Key vnull = 0;
 	  insdefault =
-	    this->table_.insert(std::make_pair(std::make_pair(name_key,
-							      vnull),
+	    this->table_.insert(std::make_pair(Symbol_table_key(name_key,
+								name_hash,
+								vnull),
 					       snull));
 	}
 
@@ -3022,32 +3186,38 @@ Symbol_table::write_globals(const Stringpool* sympool,
 			    const Stringpool* dynpool,
 			    Output_symtab_xindex* symtab_xindex,
 			    Output_symtab_xindex* dynsym_xindex,
-			    Output_file* of) const
+			    Output_file* of,
+			    Workqueue* workqueue,
+			    Task_token* final_blocker) const
 {
   switch (parameters->size_and_endianness())
     {
 #ifdef HAVE_TARGET_32_LITTLE
     case Parameters::TARGET_32_LITTLE:
       this->sized_write_globals<32, false>(sympool, dynpool, symtab_xindex,
-					   dynsym_xindex, of);
+					   dynsym_xindex, of, workqueue,
+					   final_blocker);
       break;
 #endif
 #ifdef HAVE_TARGET_32_BIG
     case Parameters::TARGET_32_BIG:
       this->sized_write_globals<32, true>(sympool, dynpool, symtab_xindex,
-					  dynsym_xindex, of);
+					  dynsym_xindex, of, workqueue,
+					  final_blocker);
       break;
 #endif
 #ifdef HAVE_TARGET_64_LITTLE
     case Parameters::TARGET_64_LITTLE:
       this->sized_write_globals<64, false>(sympool, dynpool, symtab_xindex,
-					   dynsym_xindex, of);
+					   dynsym_xindex, of, workqueue,
+					   final_blocker);
       break;
 #endif
 #ifdef HAVE_TARGET_64_BIG
     case Parameters::TARGET_64_BIG:
       this->sized_write_globals<64, true>(sympool, dynpool, symtab_xindex,
-					  dynsym_xindex, of);
+					  dynsym_xindex, of, workqueue,
+					  final_blocker);
       break;
 #endif
     default:
@@ -3055,7 +3225,112 @@ Symbol_table::write_globals(const Stringpool* sympool,
     }
 }
 
-// Write out the global symbols.
+// Write out the global symbols in SYMS.
+
+void
+Symbol_table::write_global_symbols(const std::vector<Symbol*>& syms,
+				   const Stringpool* sympool,
+				   const Stringpool* dynpool,
+				   Output_symtab_xindex* symtab_xindex,
+				   Output_symtab_xindex* dynsym_xindex,
+				   Output_file* of) const
+{
+  switch (parameters->size_and_endianness())
+    {
+#ifdef HAVE_TARGET_32_LITTLE
+    case Parameters::TARGET_32_LITTLE:
+      this->sized_write_global_symbols<32, false>(syms, sympool, dynpool,
+						  symtab_xindex,
+						  dynsym_xindex, of);
+      break;
+#endif
+#ifdef HAVE_TARGET_32_BIG
+    case Parameters::TARGET_32_BIG:
+      this->sized_write_global_symbols<32, true>(syms, sympool, dynpool,
+						 symtab_xindex,
+						 dynsym_xindex, of);
+      break;
+#endif
+#ifdef HAVE_TARGET_64_LITTLE
+    case Parameters::TARGET_64_LITTLE:
+      this->sized_write_global_symbols<64, false>(syms, sympool, dynpool,
+						  symtab_xindex,
+						  dynsym_xindex, of);
+      break;
+#endif
+#ifdef HAVE_TARGET_64_BIG
+    case Parameters::TARGET_64_BIG:
+      this->sized_write_global_symbols<64, true>(syms, sympool, dynpool,
+						 symtab_xindex,
+						 dynsym_xindex, of);
+      break;
+#endif
+    default:
+      gold_unreachable();
+    }
+}
+
+// A Write_global_symbols_task writes out some of the global symbols.
+
+class Write_global_symbols_task : public Task
+{
+ public:
+  // The symbols in *SYMS are moved to the new task.
+  Write_global_symbols_task(const Symbol_table* symtab,
+			    std::vector<Symbol*>* syms,
+			    const Stringpool* sympool,
+			    const Stringpool* dynpool,
+			    Output_symtab_xindex* symtab_xindex,
+			    Output_symtab_xindex* dynsym_xindex,
+			    Output_file* of,
+			    Task_token* final_blocker)
+    : symtab_(symtab), syms_(), sympool_(sympool), dynpool_(dynpool),
+      symtab_xindex_(symtab_xindex), dynsym_xindex_(dynsym_xindex), of_(of),
+      final_blocker_(final_blocker)
+  { this->syms_.swap(*syms); }
+
+  void
+  run(Workqueue*)
+  {
+    this->symtab_->write_global_symbols(this->syms_, this->sympool_,
+					this->dynpool_, this->symtab_xindex_,
+					this->dynsym_xindex_, this->of_);
+  }
+
+  Task_token*
+  is_runnable()
+  { return NULL; }
+
+  // Unblock FINAL_BLOCKER_ when done.
+  void
+  locks(Task_locker* tl)
+  { tl->add(this, this->final_blocker_); }
+
+  std::string
+  get_name() const
+  { return "Write_global_symbols_task"; }
+
+ private:
+  const Symbol_table* symtab_;
+  std::vector<Symbol*> syms_;
+  const Stringpool* sympool_;
+  const Stringpool* dynpool_;
+  Output_symtab_xindex* symtab_xindex_;
+  Output_symtab_xindex* dynsym_xindex_;
+  Output_file* of_;
+  Task_token* final_blocker_;
+};
+
+// The number of symbols written by each Write_global_symbols_task.
+
+static const size_t write_globals_chunk_size = 16384;
+
+// Write out the global symbols.  First collect the symbols which go
+// in the output file.  That is also when we warn about unresolved
+// symbols in shared libraries, so that the warnings come out in the
+// same order however the symbols are written.  Since each symbol has
+// its own place in the output symbol tables, the symbols can then be
+// split into pieces which are written by separate tasks.
 
 template<int size, bool big_endian>
 void
@@ -3063,9 +3338,52 @@ Symbol_table::sized_write_globals(const Stringpool* sympool,
 				  const Stringpool* dynpool,
 				  Output_symtab_xindex* symtab_xindex,
 				  Output_symtab_xindex* dynsym_xindex,
-				  Output_file* of) const
+				  Output_file* of,
+				  Workqueue* workqueue,
+				  Task_token* final_blocker) const
 {
-  const Target& target = parameters->target();
+  const bool have_dynamic = (this->dynamic_offset_ != 0
+			     && this->dynamic_count_ != 0);
+  std::vector<Symbol*> syms;
+  syms.reserve(this->table_.size());
+  for (Symbol_table_type::const_iterator p = this->table_.begin();
+       p != this->table_.end();
+       ++p)
+    {
+      Symbol* sym = p->second;
+
+      // Possibly warn about unresolved symbols in shared libraries.
+      this->warn_about_undefined_dynobj_symbol(sym);
+
+      if (sym->symtab_index() != -1U
+	  || (have_dynamic && sym->dynsym_index() != -1U))
+	syms.push_back(sym);
+    }
+
+  if (workqueue != NULL
+      && parameters->options().threads()
+      && syms.size() > write_globals_chunk_size)
+    {
+      for (size_t i = 0; i < syms.size(); i += write_globals_chunk_size)
+	{
+	  size_t end = std::min(syms.size(), i + write_globals_chunk_size);
+	  std::vector<Symbol*> chunk(syms.begin() + i, syms.begin() + end);
+	  // Our caller holds FINAL_BLOCKER until we return, so it is
+	  // safe to add to it here.
+	  workqueue->add_blocker(final_blocker);
+	  workqueue->queue_soon(new Write_global_symbols_task(this, &chunk,
+							      sympool,
+							      dynpool,
+							      symtab_xindex,
+							      dynsym_xindex,
+							      of,
+							      final_blocker));
+	}
+    }
+  else
+    this->sized_write_global_symbols<size, big_endian>(syms, sympool, dynpool,
+						       symtab_xindex,
+						       dynsym_xindex, of);
 
   const int sym_size = elfcpp::Elf_sizes<size>::sym_size;
 
@@ -3088,14 +3406,98 @@ Symbol_table::sized_write_globals(const Stringpool* sympool,
   else
     dynamic_view = of->get_output_view(this->dynamic_offset_, dynamic_size);
 
-  for (Symbol_table_type::const_iterator p = this->table_.begin();
-       p != this->table_.end();
+  // Write the target-specific symbols.
+  for (std::vector<Symbol*>::const_iterator p = this->target_symbols_.begin();
+       p != this->target_symbols_.end();
        ++p)
     {
-      Sized_symbol<size>* sym = static_cast<Sized_symbol<size>*>(p->second);
+      Sized_symbol<size>* sym = static_cast<Sized_symbol<size>*>(*p);
 
-      // Possibly warn about unresolved symbols in shared libraries.
-      this->warn_about_undefined_dynobj_symbol(sym);
+      unsigned int sym_index = sym->symtab_index();
+      unsigned int dynsym_index;
+      if (dynamic_view == NULL)
+	dynsym_index = -1U;
+      else
+	dynsym_index = sym->dynsym_index();
+
+      unsigned int shndx;
+      switch (sym->source())
+	{
+	case Symbol::IS_CONSTANT:
+	  shndx = elfcpp::SHN_ABS;
+	  break;
+	case Symbol::IS_UNDEFINED:
+	  shndx = elfcpp::SHN_UNDEF;
+	  break;
+	default:
+	  gold_unreachable();
+	}
+
+      if (sym_index != -1U)
+	{
+	  sym_index -= first_global_index;
+	  gold_assert(sym_index < output_count);
+	  unsigned char* ps = psyms + (sym_index * sym_size);
+	  this->sized_write_symbol<size, big_endian>(sym, sym->value(), shndx,
+						     sym->binding(), sympool,
+						     ps);
+	}
+
+      if (dynsym_index != -1U)
+	{
+	  dynsym_index -= first_dynamic_global_index;
+	  gold_assert(dynsym_index < dynamic_count);
+	  unsigned char* pd = dynamic_view + (dynsym_index * sym_size);
+	  this->sized_write_symbol<size, big_endian>(sym, sym->value(), shndx,
+						     sym->binding(), dynpool,
+						     pd);
+	}
+    }
+
+  of->write_output_view(this->offset_, oview_size, psyms);
+  if (dynamic_view != NULL)
+    of->write_output_view(this->dynamic_offset_, dynamic_size, dynamic_view);
+}
+
+// Write out the global symbols in SYMS.
+
+template<int size, bool big_endian>
+void
+Symbol_table::sized_write_global_symbols(const std::vector<Symbol*>& syms,
+					 const Stringpool* sympool,
+					 const Stringpool* dynpool,
+					 Output_symtab_xindex* symtab_xindex,
+					 Output_symtab_xindex* dynsym_xindex,
+					 Output_file* of) const
+{
+  const Target& target = parameters->target();
+
+  const int sym_size = elfcpp::Elf_sizes<size>::sym_size;
+
+  const unsigned int output_count = this->output_count_;
+  const section_size_type oview_size = output_count * sym_size;
+  const unsigned int first_global_index = this->first_global_index_;
+  unsigned char* psyms;
+  if (this->offset_ == 0 || output_count == 0)
+    psyms = NULL;
+  else
+    psyms = of->get_output_view(this->offset_, oview_size);
+
+  const unsigned int dynamic_count = this->dynamic_count_;
+  const section_size_type dynamic_size = dynamic_count * sym_size;
+  const unsigned int first_dynamic_global_index =
+    this->first_dynamic_global_index_;
+  unsigned char* dynamic_view;
+  if (this->dynamic_offset_ == 0 || dynamic_count == 0)
+    dynamic_view = NULL;
+  else
+    dynamic_view = of->get_output_view(this->dynamic_offset_, dynamic_size);
+
+  for (std::vector<Symbol*>::const_iterator p = syms.begin();
+       p != syms.end();
+       ++p)
+    {
+      Sized_symbol<size>* sym = static_cast<Sized_symbol<size>*>(*p);
 
       unsigned int sym_index = sym->symtab_index();
       unsigned int dynsym_index;
@@ -3269,54 +3671,6 @@ Symbol_table::sized_write_globals(const Stringpool* sympool,
 	}
     }
 
-  // Write the target-specific symbols.
-  for (std::vector<Symbol*>::const_iterator p = this->target_symbols_.begin();
-       p != this->target_symbols_.end();
-       ++p)
-    {
-      Sized_symbol<size>* sym = static_cast<Sized_symbol<size>*>(*p);
-
-      unsigned int sym_index = sym->symtab_index();
-      unsigned int dynsym_index;
-      if (dynamic_view == NULL)
-	dynsym_index = -1U;
-      else
-	dynsym_index = sym->dynsym_index();
-
-      unsigned int shndx;
-      switch (sym->source())
-	{
-	case Symbol::IS_CONSTANT:
-	  shndx = elfcpp::SHN_ABS;
-	  break;
-	case Symbol::IS_UNDEFINED:
-	  shndx = elfcpp::SHN_UNDEF;
-	  break;
-	default:
-	  gold_unreachable();
-	}
-
-      if (sym_index != -1U)
-	{
-	  sym_index -= first_global_index;
-	  gold_assert(sym_index < output_count);
-	  unsigned char* ps = psyms + (sym_index * sym_size);
-	  this->sized_write_symbol<size, big_endian>(sym, sym->value(), shndx,
-						     sym->binding(), sympool,
-						     ps);
-	}
-
-      if (dynsym_index != -1U)
-	{
-	  dynsym_index -= first_dynamic_global_index;
-	  gold_assert(dynsym_index < dynamic_count);
-	  unsigned char* pd = dynamic_view + (dynsym_index * sym_size);
-	  this->sized_write_symbol<size, big_endian>(sym, sym->value(), shndx,
-						     sym->binding(), dynpool,
-						     pd);
-	}
-    }
-
   of->write_output_view(this->offset_, oview_size, psyms);
   if (dynamic_view != NULL)
     of->write_output_view(this->dynamic_offset_, dynamic_size, dynamic_view);
@@ -3736,8 +4090,21 @@ Symbol_table::add_from_relobj<32, false>(
     size_t symndx_offset,
     const char* sym_names,
     size_t sym_name_size,
+    const Interned_symbol_names* interned,
     Sized_relobj_file<32, false>::Symbols* sympointers,
     size_t* defined);
+
+template
+void
+Symbol_table::intern_symbol_names<32, false>(
+    const unsigned char* syms,
+    size_t count,
+    const char* sym_names,
+    size_t sym_name_size,
+    bool split_versions,
+    const Symbol_name_digest* digests,
+    Symbol_name_digests* new_digests,
+    Interned_symbol_names* interned);
 #endif
 
 #ifdef HAVE_TARGET_32_BIG
@@ -3750,8 +4117,21 @@ Symbol_table::add_from_relobj<32, true>(
     size_t symndx_offset,
     const char* sym_names,
     size_t sym_name_size,
+    const Interned_symbol_names* interned,
     Sized_relobj_file<32, true>::Symbols* sympointers,
     size_t* defined);
+
+template
+void
+Symbol_table::intern_symbol_names<32, true>(
+    const unsigned char* syms,
+    size_t count,
+    const char* sym_names,
+    size_t sym_name_size,
+    bool split_versions,
+    const Symbol_name_digest* digests,
+    Symbol_name_digests* new_digests,
+    Interned_symbol_names* interned);
 #endif
 
 #ifdef HAVE_TARGET_64_LITTLE
@@ -3764,8 +4144,21 @@ Symbol_table::add_from_relobj<64, false>(
     size_t symndx_offset,
     const char* sym_names,
     size_t sym_name_size,
+    const Interned_symbol_names* interned,
     Sized_relobj_file<64, false>::Symbols* sympointers,
     size_t* defined);
+
+template
+void
+Symbol_table::intern_symbol_names<64, false>(
+    const unsigned char* syms,
+    size_t count,
+    const char* sym_names,
+    size_t sym_name_size,
+    bool split_versions,
+    const Symbol_name_digest* digests,
+    Symbol_name_digests* new_digests,
+    Interned_symbol_names* interned);
 #endif
 
 #ifdef HAVE_TARGET_64_BIG
@@ -3778,8 +4171,21 @@ Symbol_table::add_from_relobj<64, true>(
     size_t symndx_offset,
     const char* sym_names,
     size_t sym_name_size,
+    const Interned_symbol_names* interned,
     Sized_relobj_file<64, true>::Symbols* sympointers,
     size_t* defined);
+
+template
+void
+Symbol_table::intern_symbol_names<64, true>(
+    const unsigned char* syms,
+    size_t count,
+    const char* sym_names,
+    size_t sym_name_size,
+    bool split_versions,
+    const Symbol_name_digest* digests,
+    Symbol_name_digests* new_digests,
+    Interned_symbol_names* interned);
 #endif
 
 #ifdef HAVE_TARGET_32_LITTLE
@@ -3834,6 +4240,7 @@ Symbol_table::add_from_dynobj<32, false>(
     const unsigned char* versym,
     size_t versym_size,
     const std::vector<const char*>* version_map,
+    const Interned_symbol_names* interned,
     Sized_relobj_file<32, false>::Symbols* sympointers,
     size_t* defined);
 #endif
@@ -3850,6 +4257,7 @@ Symbol_table::add_from_dynobj<32, true>(
     const unsigned char* versym,
     size_t versym_size,
     const std::vector<const char*>* version_map,
+    const Interned_symbol_names* interned,
     Sized_relobj_file<32, true>::Symbols* sympointers,
     size_t* defined);
 #endif
@@ -3866,6 +4274,7 @@ Symbol_table::add_from_dynobj<64, false>(
     const unsigned char* versym,
     size_t versym_size,
     const std::vector<const char*>* version_map,
+    const Interned_symbol_names* interned,
     Sized_relobj_file<64, false>::Symbols* sympointers,
     size_t* defined);
 #endif
@@ -3882,6 +4291,7 @@ Symbol_table::add_from_dynobj<64, true>(
     const unsigned char* versym,
     size_t versym_size,
     const std::vector<const char*>* version_map,
+    const Interned_symbol_names* interned,
     Sized_relobj_file<64, true>::Symbols* sympointers,
     size_t* defined);
 #endif
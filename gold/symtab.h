@@ -58,6 +58,8 @@ class Output_section;
 class Output_segment;
 class Output_file;
 class Output_symtab_xindex;
+class Workqueue;
+class Task_token;
 class Garbage_collection;
 class Icf;
 
@@ -1389,6 +1391,52 @@ class Warnings
   Warning_table warnings_;
 };
 
+// The name of a global symbol from an input object, entered into the
+// symbol table's name pool ahead of time by
+// Symbol_table::intern_symbol_names.  This is done by the
+// Read_symbols tasks, which run in parallel, so that the Add_symbols
+// tasks, which run one at a time, need not hash and copy the names.
+
+struct Interned_symbol_name
+{
+  // The canonical symbol name, without any version.  NULL if the
+  // symbol was not interned, in which case it is handled as though
+  // no names had been interned.
+  const char* name;
+  // The key and hash code of NAME.
+  Stringpool::Key name_key;
+  size_t name_hash;
+  // The canonical version from a NAME@VERSION or NAME@@VERSION
+  // symbol, or NULL.
+  const char* version;
+  // The key of VERSION, or 0.
+  Stringpool::Key version_key;
+  // True for NAME@@VERSION.
+  bool is_default_version;
+};
+
+typedef std::vector<Interned_symbol_name> Interned_symbol_names;
+
+// How Symbol_table::intern_symbol_names split and hashed the name of
+// a global symbol.  This depends only on the name, so it is saved in
+// the object cache and reused for an object which has been seen
+// before.  This is stored in cache files as is, so it must not have
+// any padding.
+
+struct Symbol_name_digest
+{
+  // The hash code of the name without any version.
+  uint64_t name_hash;
+  // The length of the name without any version, or -1U if the symbol
+  // was not interned.
+  uint32_t name_length;
+  // The offset of the version from the start of the name, or 0 if
+  // there is no version.
+  uint32_t version_offset;
+};
+
+typedef std::vector<Symbol_name_digest> Symbol_name_digests;
+
 // The main linker symbol table.
 
 class Symbol_table
@@ -1468,15 +1516,36 @@ class Symbol_table
   // their names, SYM_NAME_SIZE is the size of SYM_NAMES.  This sets
   // SYMPOINTERS to point to the symbols in the symbol table.  It sets
   // *DEFINED to the number of defined symbols.
+  // INTERNED is the result of intern_symbol_names for these
+  // symbols, or NULL.
   template<int size, bool big_endian>
   void
   add_from_relobj(Sized_relobj_file<size, big_endian>* relobj,
 		  const unsigned char* syms, size_t count,
 		  size_t symndx_offset, const char* sym_names,
 		  size_t sym_name_size,
+		  const Interned_symbol_names* interned,
 		  typename Sized_relobj_file<size, big_endian>::Symbols*,
 		  size_t* defined);
 
+  // Enter the names of the COUNT global symbols SYMS into the name
+  // pool, and store the results in INTERNED.  SYM_NAMES and
+  // SYM_NAME_SIZE are as for add_from_relobj.  If SPLIT_VERSIONS is
+  // true, a name of the form NAME@VERSION is split as for a
+  // relocatable object.  If DIGESTS is not NULL, it holds COUNT
+  // digests of the names from the object cache, which are used
+  // instead of scanning the names.  Otherwise, if NEW_DIGESTS is not
+  // NULL, the digests are stored there.  This does not change the
+  // symbol table, and may be called by several threads at once.
+  template<int size, bool big_endian>
+  void
+  intern_symbol_names(const unsigned char* syms, size_t count,
+		      const char* sym_names, size_t sym_name_size,
+		      bool split_versions,
+		      const Symbol_name_digest* digests,
+		      Symbol_name_digests* new_digests,
+		      Interned_symbol_names* interned);
+
   // Add one external symbol from the plugin object OBJ to the symbol table.
   // Returns a pointer to the resolved symbol in the symbol table.
   template<int size, bool big_endian>
@@ -1489,6 +1558,7 @@ class Symbol_table
   // symbol table.  SYMS is the symbols.  SYM_NAMES is their names.
   // SYM_NAME_SIZE is the size of SYM_NAMES.  The other parameters are
   // symbol version data.
+  // INTERNED is as for add_from_relobj.
   template<int size, bool big_endian>
   void
   add_from_dynobj(Sized_dynobj<size, big_endian>* dynobj,
@@ -1496,6 +1566,7 @@ class Symbol_table
 		  const char* sym_names, size_t sym_name_size,
 		  const unsigned char* versym, size_t versym_size,
 		  const std::vector<const char*>*,
+		  const Interned_symbol_names* interned,
 		  typename Sized_relobj_file<size, big_endian>::Symbols*,
 		  size_t* defined);
 
@@ -1682,11 +1753,22 @@ class Symbol_table
   output_count() const
   { return this->output_count_; }
 
-  // Write out the global symbols.
+  // Write out the global symbols.  With --threads, large symbol
+  // tables are written by a set of tasks queued on WORKQUEUE, each of
+  // which holds FINAL_BLOCKER.
   void
   write_globals(const Stringpool*, const Stringpool*,
 		Output_symtab_xindex*, Output_symtab_xindex*,
-		Output_file*) const;
+		Output_file*, Workqueue* workqueue,
+		Task_token* final_blocker) const;
+
+  // Write out the global symbols in SYMS.  This is called by the
+  // tasks queued by write_globals.
+  void
+  write_global_symbols(const std::vector<Symbol*>& syms,
+		       const Stringpool*, const Stringpool*,
+		       Output_symtab_xindex*, Output_symtab_xindex*,
+		       Output_file*) const;
 
   // Write out a section symbol.  Return the updated offset.
   void
@@ -1734,15 +1816,31 @@ class Symbol_table
 
   // The type of the symbol hash table.
 
-  typedef std::pair<Stringpool::Key, Stringpool::Key> Symbol_table_key;
+  // The key is the name pool keys of the name and version.  The keys
+  // of a Sharded_stringpool depend on thread scheduling, so the key
+  // also holds the hash code of the name, which does not.  Hashing
+  // on that keeps the iteration order of the table, and therefore
+  // the order of the output symbol table, the same from run to run
+  // and for any number of threads.  Older versions of gold hashed on
+  // the keys, so they wrote the same global symbols in another order.
+  struct Symbol_table_key
+  {
+    Symbol_table_key(Stringpool::Key nk, size_t nh, Stringpool::Key vk)
+      : name_key(nk), version_key(vk), name_hash(nh)
+    { }
 
-  // The hash function.  The key values are Stringpool keys.
+    Stringpool::Key name_key;
+    Stringpool::Key version_key;
+    size_t name_hash;
+  };
+
+  // The hash function.
   struct Symbol_table_hash
   {
     inline size_t
     operator()(const Symbol_table_key& key) const
     {
-      return key.first ^ key.second;
+      return key.name_hash;
     }
   };
 
@@ -1767,6 +1865,7 @@ class Symbol_table
   template<int size, bool big_endian>
   Sized_symbol<size>*
   add_from_object(Object*, const char* name, Stringpool::Key name_key,
+		  size_t name_hash,
 		  const char* version, Stringpool::Key version_key,
 		  bool def, const elfcpp::Sym<size, big_endian>& sym,
 		  unsigned int st_shndx, bool is_ordinary,
@@ -1797,9 +1896,23 @@ class Symbol_table
   void
   force_local(Symbol*);
 
-  // Adjust NAME and *NAME_KEY for wrapping.
+  // Return the canonical version of NAME, a symbol name from a
+  // dynamic object, and set *NAME_KEY and *NAME_HASH.  IN is the
+  // result of intern_symbol_names for the symbol, or NULL.
   const char*
-  wrap_symbol(const char* name, Stringpool::Key* name_key);
+  dynobj_symbol_name(const char* name, const Interned_symbol_name* in,
+		     Stringpool::Key* name_key, size_t* name_hash)
+  {
+    if (in == NULL)
+      return this->namepool_.add(name, true, name_key, name_hash);
+    *name_key = in->name_key;
+    *name_hash = in->name_hash;
+    return in->name;
+  }
+
+  // Adjust NAME, *NAME_KEY and *NAME_HASH for wrapping.
+  const char*
+  wrap_symbol(const char* name, Stringpool::Key* name_key, size_t* name_hash);
 
   // Whether we should override a symbol, based on flags in
   // resolve.cc.
@@ -1941,7 +2054,16 @@ class Symbol_table
   void
   sized_write_globals(const Stringpool*, const Stringpool*,
 		      Output_symtab_xindex*, Output_symtab_xindex*,
-		      Output_file*) const;
+		      Output_file*, Workqueue*, Task_token*) const;
+
+  // Write the global symbols in a vector, specialized for size and
+  // endianness.
+  template<int size, bool big_endian>
+  void
+  sized_write_global_symbols(const std::vector<Symbol*>&,
+			     const Stringpool*, const Stringpool*,
+			     Output_symtab_xindex*, Output_symtab_xindex*,
+			     Output_file*) const;
 
   // Write out a symbol to P.
   template<int size, bool big_endian>
@@ -1992,7 +2114,7 @@ class Symbol_table
   Symbol_table_type table_;
   // A pool of symbol names.  This is used for all global symbols.
   // Entries in the hash table point into this pool.
-  Stringpool namepool_;
+  Sharded_stringpool namepool_;
   // Forwarding symbols.
   Unordered_map<const Symbol*, Symbol*> forwarders_;
   // Weak aliases.  A symbol in this list points to the next alias.
@@ -113,7 +113,8 @@ class Target
   has_code_fill() const
   { return this->pti_->has_code_fill; }
 
-  // Return the default name of the dynamic linker.
+  // Return the default name of the dynamic linker, or NULL if the
+  // target only supports static linking.
   const char*
   dynamic_linker() const
   { return this->pti_->dynamic_linker; }
@@ -545,7 +546,8 @@ class Target
     bool can_icf_inline_merge_sections;
     // Prefix character to strip when checking for wrapping.
     char wrap_char;
-    // The default dynamic linker name.
+    // The default dynamic linker name, or NULL if the target only
+    // supports static linking.
     const char* dynamic_linker;
     // The default text segment address.
     uint64_t default_text_segment_address;
@@ -575,7 +577,8 @@ class Target
     // Name of the main entry point to the program.
     const char* entry_symbol_name;
     // Size (in bits) of SHT_HASH entry. Always equal to 32, except for
-    // 64-bit S/390.
+    // 64-bit S/390, and 0 for a target which only supports static
+    // linking.
     const int hash_entry_size;
     // Processor-specific section type for ".eh_frame" (unwind) sections.
     // SHT_PROGBITS if there is no special section type.
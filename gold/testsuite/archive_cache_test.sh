@@ -0,0 +1,98 @@
+#!/bin/sh
+
+# archive_cache_test.sh -- test --archive-index-cache
+
+# Copyright (C) 2022 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# The Makefile links two_file_test_main.o against an archive five
+# times with --archive-index-cache and --verbose, in this order:
+#  1. with an empty cache directory, which must write a cache file;
+#  2. again, which must use that cache file;
+#  3. after changing the archive's mtime, which must not use the old
+#     cache file, and must write a second one;
+#  4. after overwriting the cache files with the one written by link 1,
+#     whose key no longer matches, which must ignore them as stale;
+#  5. again, which must use the cache file rewritten by link 4.
+# Each archive_cache_test_N.stdout holds the cache messages of link N
+# followed by the list of cache files.  All links must produce the same
+# output as a link without the cache.
+
+check()
+{
+    if ! grep -q "$2" "$1"
+    then
+	echo "Did not find expected output in $1:"
+	echo "   $2"
+	echo ""
+	echo "Actual output below:"
+	cat "$1"
+	exit 1
+    fi
+}
+
+check_missing()
+{
+    if grep -q "$2" "$1"
+    then
+	echo "Found unexpected output in $1:"
+	echo "   $2"
+	echo ""
+	echo "Actual output below:"
+	cat "$1"
+	exit 1
+    fi
+}
+
+check_count()
+{
+    n=`grep -c '^[0-9a-f]*\.armap$' "$1"`
+    if test "$n" -ne "$2"
+    then
+	echo "Expected $2 cache files, found $n in $1:"
+	cat "$1"
+	exit 1
+    fi
+}
+
+check_missing archive_cache_test_1.stdout "using archive index cache"
+check_count archive_cache_test_1.stdout 1
+
+check archive_cache_test_2.stdout "using archive index cache"
+check_count archive_cache_test_2.stdout 1
+
+check_missing archive_cache_test_3.stdout "using archive index cache"
+check_count archive_cache_test_3.stdout 2
+
+check archive_cache_test_4.stdout "ignoring stale archive index cache"
+check_missing archive_cache_test_4.stdout "using archive index cache"
+check_count archive_cache_test_4.stdout 2
+
+check archive_cache_test_5.stdout "using archive index cache"
+check_count archive_cache_test_5.stdout 2
+
+for i in 1 2 3 4 5; do
+    if ! cmp -s archive_cache_test_0.o archive_cache_test_$i.o
+    then
+	echo "archive_cache_test_$i.o differs from the link without a cache"
+	exit 1
+    fi
+done
+
+exit 0
@@ -0,0 +1,71 @@
+#!/bin/sh
+
+# build_id_fast_test.sh -- test --build-id=fast
+
+# Copyright (C) 2022 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# --build-id=fast hashes the chunks of the output file in parallel.
+# build_id_fast_test_1 and build_id_fast_test_2 are the same link done
+# with --no-threads and with --threads; build_id_fast_test_3 repeats
+# the first.  They must all get the same 128-bit build ID.
+# build_id_fast_test_4 uses a different chunk size, and
+# build_id_fast_test_5 defines one more symbol, so their build IDs must
+# differ from the others.
+
+build_id()
+{
+    id=`sed -n -e 's/^ *Build ID: *\([0-9a-f]*\)$/\1/p' $1`
+    if test `echo "$id" | wc -c` -ne 33
+    then
+	echo "Did not find a 128-bit build ID in $1:" 1>&2
+	cat $1 1>&2
+	exit 1
+    fi
+    echo $id
+}
+
+id1=`build_id build_id_fast_test_1.stdout` || exit 1
+id2=`build_id build_id_fast_test_2.stdout` || exit 1
+id3=`build_id build_id_fast_test_3.stdout` || exit 1
+id4=`build_id build_id_fast_test_4.stdout` || exit 1
+id5=`build_id build_id_fast_test_5.stdout` || exit 1
+
+if test "$id1" != "$id2"
+then
+    echo "Build ID differs between --no-threads ($id1) and --threads ($id2)"
+    exit 1
+fi
+if test "$id1" != "$id3"
+then
+    echo "Build ID differs between two identical links ($id1, $id3)"
+    exit 1
+fi
+if test "$id1" = "$id4"
+then
+    echo "Build ID does not depend on the chunk size ($id1)"
+    exit 1
+fi
+if test "$id1" = "$id5"
+then
+    echo "Build ID does not depend on the file contents ($id1)"
+    exit 1
+fi
+
+exit 0
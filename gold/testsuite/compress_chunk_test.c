@@ -0,0 +1,32 @@
+// compress_chunk_test.c -- test compressing debug sections in chunks
+
+// Copyright (C) 2022 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+// This file puts a debug section of a bit over 2 MiB into an object,
+// so that gold splits it into several chunks when it compresses it.
+// It uses a generated .h file for the section contents.  The values
+// vary so that each chunk depends on the dictionary of the one before.
+
+__asm__(".pushsection .debug_gold_chunks,\"\",@progbits\n"
+#include "compress_chunk_test_data.h"
+	".popsection\n");
+
+int
+compress_chunk_test_var = 1;
@@ -0,0 +1,58 @@
+#!/bin/sh
+
+# compress_chunk_test.sh -- test chunked debug section compression
+
+# Copyright (C) 2022 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# compress_chunk_test.o has a .debug_gold_chunks section larger than
+# the 1 MiB compression chunk.  The Makefile compresses it with
+# ld -r, with zlib and (if gold was built with it) zstd, and then
+# decompresses the result with another ld -r.  Check that:
+#  - the compressed section is marked SHF_COMPRESSED;
+#  - readelf can inflate the joined zlib chunks;
+#  - both compressions round trip to the original contents;
+#  - the compressed contents do not depend on the thread count.
+
+check_same()
+{
+    if ! cmp -s "$1" "$2"; then
+	echo "$1 and $2 differ:"
+	diff "$1" "$2" | head -20
+	exit 1
+    fi
+}
+
+if ! grep -q "debug_gold_chunks.* C " compress_chunk_test_zlib.stdout; then
+    echo "Section .debug_gold_chunks is not compressed:"
+    cat compress_chunk_test_zlib.stdout
+    exit 1
+fi
+
+check_same compress_chunk_test_none.x compress_chunk_test_zlib.x
+check_same compress_chunk_test_none.x compress_chunk_test_zlib_none.x
+check_same compress_chunk_test_zlib.raw compress_chunk_test_zlib_threads.raw
+
+if grep -q "zstd not supported" compress_chunk_test_zstd_none.x; then
+    exit 0
+fi
+
+check_same compress_chunk_test_none.x compress_chunk_test_zstd_none.x
+
+exit 0
@@ -0,0 +1,39 @@
+#!/bin/sh
+
+# dwp_threads_test.sh -- test dwp --threads
+
+# Copyright (C) 2022 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+
+# The Makefile runs dwp on the dwp_test_* .dwo files, and on the .dwp
+# files made from them, once without --threads and once with
+# --threads.  dwp must write the same file both ways.
+
+check_same()
+{
+    if ! cmp -s "$1" "$2"
+    then
+	echo "dwp --threads wrote $2, which differs from $1"
+	exit 1
+    fi
+}
+
+check_same dwp_threads_test_1.dwp dwp_threads_test_2.dwp
+check_same dwp_threads_test_3.dwp dwp_threads_test_4.dwp
+
+exit 0
@@ -0,0 +1,168 @@
+// eh_frame_hdr_sort_test.c -- test the .eh_frame_hdr search table
+
+// Copyright (C) 2022 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+// This file is compiled three times with -ffunction-sections, with
+// PART set to 1, 2 and 3, and the objects are linked out of order with
+// a --section-ordering-file which shuffles the functions.  So the
+// FDEs in .eh_frame are not in the order of the code.  The program
+// finds .eh_frame_hdr through PT_GNU_EH_FRAME and checks that its
+// search table is sorted by address and has an entry for each of the
+// functions.
+
+// For dl_iterate_phdr.
+#define _GNU_SOURCE 1
+
+#include <link.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define DECLARE(f)				\
+  int f##_0(int); int f##_1(int); int f##_2(int); int f##_3(int);	\
+  int f##_4(int); int f##_5(int); int f##_6(int); int f##_7(int);
+
+DECLARE(f1)
+DECLARE(f2)
+DECLARE(f3)
+
+#define DEFINE_1(f, n)				\
+  int f##_##n(int i) { return i * (n + 2) + 1; }
+
+#define DEFINE(f)							\
+  DEFINE_1(f, 0) DEFINE_1(f, 1) DEFINE_1(f, 2) DEFINE_1(f, 3)	\
+  DEFINE_1(f, 4) DEFINE_1(f, 5) DEFINE_1(f, 6) DEFINE_1(f, 7)
+
+#if PART == 1
+DEFINE(f1)
+#elif PART == 2
+DEFINE(f2)
+#else
+DEFINE(f3)
+#endif
+
+#if PART == 1
+
+#define ADDRESSES(f)					\
+  (void*) f##_0, (void*) f##_1, (void*) f##_2, (void*) f##_3,	\
+  (void*) f##_4, (void*) f##_5, (void*) f##_6, (void*) f##_7
+
+static void* const functions[] =
+{
+  ADDRESSES(f1), ADDRESSES(f2), ADDRESSES(f3)
+};
+
+#define FUNCTION_COUNT (sizeof(functions) / sizeof(functions[0]))
+
+// Find .eh_frame_hdr in the executable, which is always the first
+// object passed to the callback.
+
+static int
+find_eh_frame_hdr(struct dl_phdr_info* info, size_t size, void* data)
+{
+  int i;
+
+  (void) size;
+  for (i = 0; i < info->dlpi_phnum; ++i)
+    if (info->dlpi_phdr[i].p_type == PT_GNU_EH_FRAME)
+      *(const unsigned char**) data =
+	(const unsigned char*) (info->dlpi_addr + info->dlpi_phdr[i].p_vaddr);
+  return 1;
+}
+
+int
+main(void)
+{
+  const unsigned char* hdr = NULL;
+  const unsigned char* table;
+  uint32_t fde_count;
+  uint32_t i;
+  size_t j;
+  int32_t prev;
+
+  if (f1_0(0) + f2_0(0) + f3_0(0) != 3)
+    return 1;
+
+  // The test is only useful if the code is not in source order.
+  for (j = 1; j < FUNCTION_COUNT; ++j)
+    if ((const char*) functions[j] < (const char*) functions[j - 1])
+      break;
+  if (j == FUNCTION_COUNT)
+    {
+      fprintf(stderr, "functions were not reordered\n");
+      return 1;
+    }
+
+  dl_iterate_phdr(find_eh_frame_hdr, &hdr);
+  if (hdr == NULL)
+    {
+      fprintf(stderr, "no PT_GNU_EH_FRAME segment\n");
+      return 1;
+    }
+
+  // Version 1, a 4-byte eh_frame_ptr, a 4-byte count, and a table of
+  // 4-byte pairs relative to the start of .eh_frame_hdr.
+  if (hdr[0] != 1 || hdr[2] != 0x03 || hdr[3] != 0x3b)
+    {
+      fprintf(stderr, "unexpected .eh_frame_hdr encoding %d %d %d %d\n",
+	      hdr[0], hdr[1], hdr[2], hdr[3]);
+      return 1;
+    }
+  memcpy(&fde_count, hdr + 8, 4);
+  table = hdr + 12;
+
+  prev = 0;
+  for (i = 0; i < fde_count; ++i)
+    {
+      int32_t loc;
+
+      memcpy(&loc, table + i * 8, 4);
+      if (i > 0 && loc < prev)
+	{
+	  fprintf(stderr, "entry %u at %d is below entry %u at %d\n",
+		  i, loc, i - 1, prev);
+	  return 1;
+	}
+      prev = loc;
+    }
+
+  for (j = 0; j < FUNCTION_COUNT; ++j)
+    {
+      int32_t want = (const unsigned char*) functions[j] - hdr;
+      int found = 0;
+
+      for (i = 0; i < fde_count && !found; ++i)
+	{
+	  int32_t loc;
+
+	  memcpy(&loc, table + i * 8, 4);
+	  found = loc == want;
+	}
+      if (!found)
+	{
+	  fprintf(stderr, "no entry for function %u\n", (unsigned int) j);
+	  return 1;
+	}
+    }
+
+  return 0;
+}
+
+#endif // PART == 1
@@ -0,0 +1,54 @@
+#!/bin/sh
+
+# eh_frame_hdr_sort_test.sh -- test the .eh_frame_hdr search table
+
+# Copyright (C) 2022 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# eh_frame_hdr_sort_test is linked from three objects given out of
+# order, with a --section-ordering-file which shuffles their functions,
+# so the FDEs are not in address order.  Check that the output has an
+# .eh_frame_hdr, then run the program, which checks that the search
+# table in it is sorted.
+
+check()
+{
+    if ! grep -q "$2" "$1"
+    then
+	echo "Did not find expected output in $1:"
+	echo "   $2"
+	echo ""
+	echo "Actual output below:"
+	cat "$1"
+	exit 1
+    fi
+}
+
+check eh_frame_hdr_sort_test.stdout "\.eh_frame_hdr"
+check eh_frame_hdr_sort_test.stdout "GNU_EH_FRAME"
+
+./eh_frame_hdr_sort_test
+status=$?
+if test $status -ne 0
+then
+    echo "eh_frame_hdr_sort_test failed with exit status $status"
+    exit 1
+fi
+
+exit 0
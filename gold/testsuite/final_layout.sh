@@ -23,7 +23,11 @@
 # MA 02110-1301, USA.
 
 # The goal of this program is to verify if --section-ordering-file works as
-# intended.  File final_layout.cc is in this test.
+# intended.  File final_layout.cc is in this test.  final_layout_2 is
+# linked with an ordering file in which several globs match the same
+# section, one glob is listed twice, and some globs only have a literal
+# suffix.  A section goes where the first glob which matches it is
+# listed.
 
 set -e
 
@@ -59,3 +63,8 @@ check final_layout.stdout "_Z3barv" "_Z3bazv"
 check final_layout.stdout "_Z3bazv" "_Z3foov"
 check final_layout.stdout "global_varb" "global_vara"
 check final_layout.stdout "global_vara" "global_varc"
+
+check final_layout_2.stdout "_Z3bazv" "_Z3barv"
+check final_layout_2.stdout "_Z3barv" "_Z3foov"
+check final_layout_2.stdout "global_varc" "global_vara"
+check final_layout_2.stdout "global_vara" "global_varb"
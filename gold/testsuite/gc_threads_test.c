@@ -0,0 +1,35 @@
+// gc_threads_test.c -- test --gc-sections with --threads
+
+// Copyright (C) 2022 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+// This program is compiled with -fdata-sections.  The generated
+// gc_threads_test_define.h defines gc_threads_test_0, which points to
+// 2000 arrays, and every one of those points to 8 more.  The arrays
+// whose number is a multiple of 5 are left out of gc_threads_test_0,
+// so they and the arrays they point to are garbage.  The graph is wide
+// enough that the marking work is split between several tasks.
+
+#include "gc_threads_test_define.h"
+
+int
+main(void)
+{
+  return gc_threads_test_0[0] == 0;
+}
@@ -0,0 +1,71 @@
+#!/bin/sh
+
+# gc_threads_test.sh -- test --gc-sections with --threads
+
+# Copyright (C) 2022 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# The goal of this program is to verify that marking the sections to
+# keep for --gc-sections in several tasks keeps the same sections as
+# marking them in one thread.  gc_threads_test_1 is linked with
+# --no-threads and gc_threads_test_2 with --threads.
+
+check()
+{
+    if ! grep -q "$2" "$1"
+    then
+	echo "Did not find expected symbol '$2' in $1"
+	exit 1
+    fi
+}
+
+check_missing()
+{
+    if grep -q "$2" "$1"
+    then
+	echo "Garbage collection should have collected '$2' in $1"
+	exit 1
+    fi
+}
+
+for f in gc_threads_test_1.stdout gc_threads_test_2.stdout
+do
+    check $f " gc_threads_test_1$"
+    check $f " gc_threads_test_2001$"
+    check $f " gc_threads_test_17992$"
+    check_missing $f " gc_threads_test_5$"
+    check_missing $f " gc_threads_test_2033$"
+    check_missing $f " gc_threads_test_17993$"
+done
+
+if ! cmp -s gc_threads_test_1.stdout gc_threads_test_2.stdout
+then
+    echo "--threads and --no-threads kept different sections"
+    diff -u gc_threads_test_1.stdout gc_threads_test_2.stdout | head -20
+    exit 1
+fi
+
+if ! cmp -s gc_threads_test_1.gc gc_threads_test_2.gc
+then
+    echo "--threads and --no-threads collected different sections"
+    diff -u gc_threads_test_1.gc gc_threads_test_2.gc | head -20
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,55 @@
+#!/bin/sh
+
+# gdb_index_test_threads.sh -- test --gdb-index with --threads
+
+# Copyright (C) 2022 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# With --threads, each object's debug info is scanned for --gdb-index
+# in its own task, and the per-object indexes are merged afterwards.
+# Check that the .gdb_index section is byte for byte the same as the
+# one built by the serial scan.
+
+check()
+{
+    if ! grep -q "$2" "$1"
+    then
+	echo "Did not find expected output:"
+	echo "   $2"
+	echo ""
+	echo "Actual error output below:"
+	cat "$1"
+	exit 1
+    fi
+}
+
+check gdb_index_test_threads_1.stdout "^Version [4-7]"
+check gdb_index_test_threads_1.stdout "^\[ *[0-9]*\] main:"
+check gdb_index_test_threads_1.stdout "^\[ *[0-9]*\] t1:"
+
+for f in stdout x; do
+    if ! cmp -s gdb_index_test_threads_1.$f gdb_index_test_threads_2.$f
+    then
+	echo ".gdb_index differs between --no-threads and --threads:"
+	diff gdb_index_test_threads_1.$f gdb_index_test_threads_2.$f | head -20
+	exit 1
+    fi
+done
+
+exit 0
@@ -0,0 +1,15 @@
+	.globl	i960_abs_0x1234
+	.set	i960_abs_0x1234, 0x1234
+	.globl	i960_abs_0x1000000
+	.set	i960_abs_0x1000000, 0x1000000
+
+	.text
+	.word	0, 0, 0, 0
+	.globl	i960_func
+i960_func:
+	ret
+
+	.data
+	.globl	i960_data
+i960_data:
+	.word	0
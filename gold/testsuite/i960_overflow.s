@@ -0,0 +1,4 @@
+	.text
+
+test_R_960_IP24_overflow:
+	call	i960_abs_0x1000000
@@ -0,0 +1,4 @@
+	.data
+
+test_R_960_12:
+	.word	i960_data
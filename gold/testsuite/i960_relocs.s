@@ -0,0 +1,21 @@
+	.text
+
+test_R_960_32:
+	lda	i960_abs_0x1234,r4
+	lda	i960_abs_0x1234+0x4,r4
+	ld	i960_data,r5
+
+test_R_960_IP24:
+	call	i960_func
+	b	i960_func
+	bal	i960_func+0x4
+
+test_R_960_OPTCALL:
+	callj	i960_func
+	callj	i960_func
+
+	.data
+test_R_960_32_data:
+	.word	i960_abs_0x1234
+	.word	i960_func+0x4
+	.word	i960_data
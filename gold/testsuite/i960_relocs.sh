@@ -0,0 +1,96 @@
+#!/bin/sh
+
+# i960_relocs.sh -- test i960 relocations
+
+# Copyright (C) 2022 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+
+check()
+{
+    file=$1
+    lbl=$2
+    line=$3
+    pattern=$4
+
+    found=`grep "<$lbl>:" $file`
+    if test -z "$found"; then
+        echo "Label $lbl not found."
+        exit 1
+    fi
+
+    match_pattern=`grep "<$lbl>:" -A$line $file | tail -n 1 | grep -e "$pattern"`
+    if test -z "$match_pattern"; then
+        echo "Expected pattern did not found in line $line after label $lbl:"
+        echo "    $pattern"
+        echo ""
+        echo "Extract:"
+        grep "<$lbl>:" -A$line $file
+        echo ""
+        echo "Actual output below:"
+        cat "$file"
+        exit 1
+    fi
+}
+
+check_error()
+{
+    if ! grep -q "$2" "$1"
+    then
+	echo "Did not find expected error in $1:"
+	echo "   $2"
+	echo ""
+	echo "Actual error output below:"
+	cat "$1"
+	exit 1
+    fi
+}
+
+# The MEMB format lda and ld have a 32-bit displacement in the second
+# word of the instruction.
+check "i960_relocs.stdout" "test_R_960_32" 1 "\<lda[[:space:]]\+1234 <i960_abs_0x1234>,r4$"
+check "i960_relocs.stdout" "test_R_960_32" 3 "\<R_960_32[[:space:]]\+i960_abs_0x1234$"
+check "i960_relocs.stdout" "test_R_960_32" 4 "\<lda[[:space:]]\+1238 <i960_abs_0x1234+0x4>,r4$"
+check "i960_relocs.stdout" "test_R_960_32" 7 "\<ld[[:space:]]\+[0-9a-f]\+ <i960_data>,r5$"
+check "i960_relocs.stdout" "test_R_960_32" 9 "\<R_960_32[[:space:]]\+i960_data$"
+
+# The CTRL format displacement is relative to the instruction.  gas
+# stores an addend relative to the start of the section instead, so
+# each instruction after the first one checks that gold allows for it.
+check "i960_relocs.stdout" "test_R_960_IP24" 1 "\<call[[:space:]]\+[0-9a-f]\+ <i960_func>$"
+check "i960_relocs.stdout" "test_R_960_IP24" 2 "\<R_960_IP24[[:space:]]\+i960_func$"
+check "i960_relocs.stdout" "test_R_960_IP24" 3 "\<b[[:space:]]\+[0-9a-f]\+ <i960_func>$"
+check "i960_relocs.stdout" "test_R_960_IP24" 5 "\<bal[[:space:]]\+[0-9a-f]\+ <i960_func+0x4>$"
+
+# An optimizable callj is always a plain call.
+check "i960_relocs.stdout" "test_R_960_OPTCALL" 1 "\<call[[:space:]]\+[0-9a-f]\+ <i960_func>$"
+check "i960_relocs.stdout" "test_R_960_OPTCALL" 2 "\<R_960_OPTCALL[[:space:]]\+i960_func$"
+check "i960_relocs.stdout" "test_R_960_OPTCALL" 3 "\<call[[:space:]]\+[0-9a-f]\+ <i960_func>$"
+
+func=`sed -n -e 's/^\([0-9a-f]*\) <i960_func>:$/\1/p' i960_relocs.stdout`
+data=`sed -n -e 's/^\([0-9a-f]*\) <i960_data>:$/\1/p' i960_relocs.stdout`
+func_4=`printf '%08x' $((0x$func + 4))`
+data_0=`printf '%08x' $((0x$data))`
+check "i960_relocs.stdout" "test_R_960_32_data" 1 "\.word[[:space:]]\+0x00001234$"
+check "i960_relocs.stdout" "test_R_960_32_data" 3 "\.word[[:space:]]\+0x$func_4$"
+check "i960_relocs.stdout" "test_R_960_32_data" 5 "\.word[[:space:]]\+0x$data_0$"
+
+check_error i960_overflow.err "relocation overflow: reference to 'i960_abs_0x1000000'"
+check_error i960_reloc_12.err "unsupported reloc R_960_12"
+check_error i960_shared.err "dynamic linking is not supported for this target"
+
+exit 0
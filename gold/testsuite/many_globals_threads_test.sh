@@ -0,0 +1,73 @@
+#!/bin/sh
+
+# many_globals_threads_test.sh -- test writing many global symbols
+# with --threads
+
+# Copyright (C) 2022 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# many_sections_test.o defines 70000 global variables, each in its own
+# section.  It is linked with -rdynamic and with -r, each time once
+# with --no-threads and once with --threads, so that the global symbols
+# are written in several pieces.  With -r the symbols in sections past
+# SHN_LORESERVE need entries in .symtab_shndx.  The links with and
+# without --threads must give the same symbols.
+
+check()
+{
+    if ! grep -q "$2" "$1"
+    then
+	echo "Did not find expected symbol '$2' in $1"
+	exit 1
+    fi
+}
+
+check_same()
+{
+    if ! cmp -s "$1" "$2"
+    then
+	echo "--threads and --no-threads wrote different symbols"
+	diff -u "$1" "$2" | head -20
+	exit 1
+    fi
+}
+
+for f in many_globals_threads_test_1.stdout many_globals_threads_test_2.stdout
+do
+    check $f "Symbol table '\.dynsym'"
+    check $f "Symbol table '\.symtab'"
+    check $f " var_1$"
+    check $f " var_70000$"
+done
+
+# The compiler emits the sections in reverse order, so var_1 is in one
+# of the last sections of the -r output, whose index only fits in
+# .symtab_shndx.
+for f in many_globals_threads_test_3.stdout many_globals_threads_test_4.stdout
+do
+    check $f " var_70000$"
+    check $f " 7[0-9][0-9][0-9][0-9] var_1$"
+done
+
+check_same many_globals_threads_test_1.stdout \
+	   many_globals_threads_test_2.stdout
+check_same many_globals_threads_test_3.stdout \
+	   many_globals_threads_test_4.stdout
+
+exit 0
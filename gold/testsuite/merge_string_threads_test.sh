@@ -0,0 +1,55 @@
+#!/bin/sh
+
+# merge_string_threads_test.sh -- test merged strings with --threads
+
+# Copyright (C) 2022 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+
+# With --threads, the strings of the input sections of a merged string
+# section are read in parallel by Merge_input_sections_tasks, and added
+# to the output section afterwards.  merge_string_threads_test_1 is
+# linked with --no-threads and merge_string_threads_test_2 with
+# --threads.  Their .rodata and .debug_str must be the same.
+
+check()
+{
+    if ! grep -q "$2" "$1"
+    then
+	echo "Did not find expected section in $1:"
+	echo "   $2"
+	echo ""
+	echo "Actual output below:"
+	cat "$1"
+	exit 1
+    fi
+}
+
+for f in merge_string_threads_test_1.stdout merge_string_threads_test_2.stdout
+do
+    check $f "Hex dump of section '.rodata'"
+    check $f "Hex dump of section '.debug_str'"
+done
+
+if ! cmp -s merge_string_threads_test_1.stdout merge_string_threads_test_2.stdout
+then
+    echo "Merged string sections differ with --threads"
+    diff -u merge_string_threads_test_1.stdout merge_string_threads_test_2.stdout | head -40
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,77 @@
+#!/bin/sh
+
+# object_cache_test.sh -- test --object-cache
+
+# Copyright (C) 2022 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# The Makefile links two objects three times with --object-cache and
+# --verbose, in this order:
+#  1. object_cache_test_main_1.o, which calls object_cache_test_foo1,
+#     with object_cache_test_work.o, a copy of object_cache_test_1.o
+#     which defines it, and an empty cache directory;
+#  2. object_cache_test_main_2.o, which calls object_cache_test_foo2,
+#     after object_cache_test_work.o is overwritten by
+#     object_cache_test_2.o, which defines it, and its old mtime is
+#     restored.  The two objects have the same size, so only their
+#     contents tell them apart;
+#  3. the same link again.
+# Link 2 fails with an undefined reference if the cache entry written
+# for the old object is used for the new one.  Each
+# object_cache_test_N.stdout holds the cache messages of link N.
+
+check()
+{
+    if ! grep -q "$2" "$1"
+    then
+	echo "Did not find expected output in $1:"
+	echo "   $2"
+	echo ""
+	echo "Actual output below:"
+	cat "$1"
+	exit 1
+    fi
+}
+
+check_missing()
+{
+    if grep -q "$2" "$1"
+    then
+	echo "Found unexpected output in $1:"
+	echo "   $2"
+	echo ""
+	echo "Actual output below:"
+	cat "$1"
+	exit 1
+    fi
+}
+
+size_1=`wc -c < object_cache_test_1.o`
+size_2=`wc -c < object_cache_test_2.o`
+if test "$size_1" -ne "$size_2"
+then
+    echo "object_cache_test_1.o and object_cache_test_2.o differ in size"
+    exit 1
+fi
+
+check_missing object_cache_test_1.stdout "using object cache file"
+check_missing object_cache_test_2.stdout "using object cache file"
+check object_cache_test_3.stdout "using object cache file"
+
+exit 0
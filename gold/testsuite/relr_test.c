@@ -0,0 +1,78 @@
+// relr_test.c -- test -z pack-relative-relocs
+
+// Copyright (C) 2022 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+// This program is linked as a PIE with -z pack-relative-relocs.  Its
+// pointers need RELATIVE relocs, which gold packs into .relr.dyn:
+//  - a run of 100 pointers, longer than one bitmap entry covers;
+//  - pointers spaced further apart than one bitmap entry covers;
+//  - one pointer at an odd address, which can not be packed and must
+//    stay in .rela.dyn.
+// Check at run time that the dynamic linker relocated all of them.
+
+#define RUN 100
+#define SPARSE 8
+
+int target[RUN];
+
+int* run[RUN] =
+{
+#define P10(n) &target[n], &target[n + 1], &target[n + 2], &target[n + 3], \
+  &target[n + 4], &target[n + 5], &target[n + 6], &target[n + 7], \
+  &target[n + 8], &target[n + 9]
+  P10(0), P10(10), P10(20), P10(30), P10(40),
+  P10(50), P10(60), P10(70), P10(80), P10(90)
+};
+
+struct sparse
+{
+  int* p;
+  char pad[1000];
+};
+
+struct sparse sparse[SPARSE] =
+{
+  { &target[1] }, { &target[2] }, { &target[3] }, { &target[4] },
+  { &target[5] }, { &target[6] }, { &target[7] }, { &target[8] }
+};
+
+struct __attribute__((packed)) unaligned
+{
+  char c;
+  int* p;
+};
+
+struct unaligned unaligned = { 1, &target[42] };
+
+int
+main(void)
+{
+  int i;
+
+  for (i = 0; i < RUN; ++i)
+    if (run[i] != &target[i])
+      return 1;
+  for (i = 0; i < SPARSE; ++i)
+    if (sparse[i].p != &target[i + 1])
+      return 2;
+  if (unaligned.p != &target[42])
+    return 3;
+  return 0;
+}
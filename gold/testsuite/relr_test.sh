@@ -0,0 +1,78 @@
+#!/bin/sh
+
+# relr_test.sh -- test -z pack-relative-relocs
+
+# Copyright (C) 2022 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# relr_test is a PIE linked with -z pack-relative-relocs.  Check that
+# it has a SHT_RELR .relr.dyn section and the DT_RELR, DT_RELRSZ and
+# DT_RELRENT tags, and that only the unaligned RELATIVE reloc is left
+# in .rela.dyn.  If the C library defines GLIBC_ABI_DT_RELR, check
+# that relr_test needs it, and that it runs.
+
+check()
+{
+    if ! grep -q "$2" "$1"
+    then
+	echo "Did not find expected output in $1:"
+	echo "   $2"
+	echo ""
+	echo "Actual output below:"
+	cat "$1"
+	exit 1
+    fi
+}
+
+STDOUT=relr_test.stdout
+
+check $STDOUT "\.relr\.dyn *RELR "
+check $STDOUT "(RELR) "
+check $STDOUT "(RELRSZ) "
+check $STDOUT "(RELRENT) *8 (bytes)"
+check $STDOUT "Relocation section '\.relr\.dyn'"
+
+# The 100 pointers in the run and the 8 sparse ones at least.
+offsets=`sed -n -e 's/^ *\([0-9]*\) offsets$/\1/p' $STDOUT`
+if test -z "$offsets" || test "$offsets" -lt 108
+then
+    echo "Expected at least 108 RELR offsets, found '$offsets'"
+    exit 1
+fi
+
+relative=`grep -c "R_X86_64_RELATIVE" $STDOUT`
+if test "$relative" -ne 1
+then
+    echo "Expected 1 R_X86_64_RELATIVE reloc in .rela.dyn, found $relative"
+    exit 1
+fi
+
+if grep -q "Name: GLIBC_ABI_DT_RELR" relr_test_libc.stdout
+then
+    check $STDOUT "Name: GLIBC_ABI_DT_RELR"
+    ./relr_test
+    status=$?
+    if test $status -ne 0
+    then
+	echo "relr_test failed with exit status $status"
+	exit 1
+    fi
+fi
+
+exit 0
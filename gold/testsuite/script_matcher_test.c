@@ -0,0 +1,55 @@
+// script_matcher_test.c -- test matching input sections in a linker script
+
+// Copyright (C) 2022 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+// This file is compiled twice, with FILE set to 1 and 2.  Each function
+// and variable goes in its own named section, and script_matcher_test.t
+// places the sections by name and by file.
+
+#define SECTION(name) __attribute__((section(name), used))
+
+#define CAT2(a, b) a ## b
+#define CAT(a, b) CAT2(a, b)
+#define VAR(name) CAT(name, FILE)
+#define FUNC(name, section) \
+  void VAR(name)(void); \
+  SECTION(section) void VAR(name)(void) { }
+
+FUNC(hot_a_, ".text.hot.a")
+FUNC(hot_b_, ".text.hot.b")
+FUNC(cold_, ".text.cold.a")
+FUNC(other_, ".text.other")
+SECTION(".rodata.keep1") const int VAR(keep_) = 1;
+SECTION(".rodata.misc") const int VAR(ro_) = 1;
+SECTION(".data.special") int VAR(special_) = 1;
+SECTION(".data.misc") int VAR(misc_) = 1;
+SECTION(".discard.me") int VAR(discard_) = 1;
+SECTION(".foo1") int VAR(foo1_) = 1;
+SECTION(".foo2") int VAR(foo2_) = 1;
+SECTION(".bar") int VAR(bar_) = 1;
+
+#if FILE == 1
+void _start(void);
+
+void
+_start(void)
+{
+}
+#endif
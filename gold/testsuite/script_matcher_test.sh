@@ -0,0 +1,83 @@
+#!/bin/sh
+
+# script_matcher_test.sh -- test matching input sections in a script
+
+# Copyright (C) 2022 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# The input section specifications of script_matcher_test.t are
+# compiled into a single matcher.  Check that each input section is
+# still placed by the first specification which matches it, as when
+# gold tried the specifications one at a time.  The placements are
+# read from the link map, as "output-section input-section file".
+
+MAP=script_matcher_test.map
+SECTIONS=script_matcher_test.sections
+
+awk '
+/^Discarded input sections/ { out = "/DISCARD/"; next }
+/^[./]/ { out = $1; next }
+/^ [.]/ {
+  name = $1
+  if (NF == 1) { getline; file = $3 } else { file = $4 }
+  print out, name, file
+}' $MAP > $SECTIONS
+
+check()
+{
+    if ! grep -q -x -F "$1" $SECTIONS
+    then
+	echo "Did not find expected placement:"
+	echo "   $1"
+	echo ""
+	echo "Actual placements:"
+	cat $SECTIONS
+	exit 1
+    fi
+}
+
+f1=script_matcher_test_1.o
+f2=script_matcher_test_2.o
+
+check ".hot .text.hot.a $f1"
+check ".hot .text.hot.b $f1"
+check ".hot .text.hot.a $f2"
+check ".hot .text.hot.b $f2"
+check ".cold .text.cold.a $f2"
+check ".text .text.cold.a $f1"
+check ".text .text.other $f1"
+check ".text .text.other $f2"
+check ".rodata .rodata.keep1 $f1"
+check ".rodata .rodata.keep1 $f2"
+check ".rodata .rodata.misc $f1"
+check ".rodata .rodata.misc $f2"
+check ".special .data.special $f1"
+check ".data .data.special $f2"
+check ".data .data.misc $f1"
+check ".data .data.misc $f2"
+check "/DISCARD/ .discard.me $f1"
+check "/DISCARD/ .discard.me $f2"
+check ".rest2 .foo1 $f2"
+check ".rest2 .foo2 $f2"
+check ".rest2 .bar $f2"
+check ".foo .foo1 $f1"
+check ".foo .foo2 $f1"
+check ".bar .bar $f1"
+
+exit 0
@@ -0,0 +1,41 @@
+/* script_matcher_test.t -- linker script for script_matcher_test.
+
+   Copyright (C) 2022 Free Software Foundation, Inc.
+
+   This file is part of gold.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+   MA 02110-1301, USA.
+
+   The rules overlap, so each input section must go to the first
+   specification which matches it.  The .rest2 rule takes every
+   section of script_matcher_test_2.o that an earlier rule has not
+   taken, before the later rules see it.  */
+
+SECTIONS
+{
+  . = 0x10000;
+  .hot : { *(.text.hot.*) }
+  .cold : { *_2.o(.text.cold.*) }
+  .text : { *(.text .text.*) }
+  .rodata : { KEEP(*(.rodata.keep*)) *(.rodata .rodata.*) }
+  .special : { *(EXCLUDE_FILE(*_2.o) .data.special) }
+  .data : { *(.data .data.*) }
+  /DISCARD/ : { *(.discard.*) }
+  .eh_frame : { *(.eh_frame) }
+  .rest2 : { script_matcher_test_2.o(*) }
+  .foo : { *(.foo[12]) }
+  .bar : { *(.bar) }
+}
@@ -0,0 +1,53 @@
+// string_tail_merge_test.c -- test string tables without -O2
+
+// Copyright (C) 2022 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+// Each symbol name here is a suffix of another, so that the linker
+// can share the tail of the longer name in the string tables.
+
+int string_tail_merge_test_name(void);
+int tail_merge_test_name(void);
+int test_name(void);
+int main(void);
+
+int
+string_tail_merge_test_name(void)
+{
+  return 1;
+}
+
+int
+tail_merge_test_name(void)
+{
+  return 2;
+}
+
+int
+test_name(void)
+{
+  return 3;
+}
+
+int
+main(void)
+{
+  return (string_tail_merge_test_name() + tail_merge_test_name()
+	  + test_name() == 6 ? 0 : 1);
+}
@@ -0,0 +1,70 @@
+#!/bin/sh
+
+# string_tail_merge_test.sh -- test string tables without -O2
+
+# Copyright (C) 2022 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+
+# The linker shares the tails of strings in its string tables by
+# default, as it used to do only with -O2.  string_tail_merge_test_1 is
+# linked without -O2 and string_tail_merge_test_2 with -O2, from the
+# same input.  The Makefile dumps .strtab, .dynstr, .shstrtab and
+# .debug_str of each, which must be the same, and in which the shorter
+# symbol names must not appear as strings of their own.
+
+check_missing()
+{
+    if grep -q "$2" "$1"
+    then
+	echo "Found unexpected string in $1:"
+	echo "   $2"
+	echo ""
+	echo "Actual output below:"
+	cat "$1"
+	exit 1
+    fi
+}
+
+check()
+{
+    if ! grep -q "$2" "$1"
+    then
+	echo "Did not find expected string in $1:"
+	echo "   $2"
+	echo ""
+	echo "Actual output below:"
+	cat "$1"
+	exit 1
+    fi
+}
+
+for f in string_tail_merge_test_1.stdout string_tail_merge_test_2.stdout
+do
+    check $f "]  string_tail_merge_test_name$"
+    check_missing $f "]  tail_merge_test_name$"
+    check_missing $f "]  test_name$"
+done
+
+if ! cmp -s string_tail_merge_test_1.stdout string_tail_merge_test_2.stdout
+then
+    echo "The string tables differ with and without -O2"
+    diff -u string_tail_merge_test_1.stdout string_tail_merge_test_2.stdout | head -40
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,42 @@
+// symtab_order_test.c -- test that the symbol table order is stable
+
+// Copyright (C) 2022 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+// This file is compiled twice, with different values of PREFIX, and
+// both objects are linked with and without threads.  The generated
+// .h file defines a few thousand global symbols, so that the names
+// of each object are interned by several threads at once.
+
+#define CAT(a, b) CAT_1 (a, b)
+#define CAT_1(a, b) a ## b
+
+#define DEFINE_SYM(n) \
+  int CAT (CAT (PREFIX, var_), n) = n; \
+  void CAT (CAT (PREFIX, func_), n) (void) { }
+
+#include "symtab_order_test_define.h"
+
+#ifdef MAIN
+int
+main (void)
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,47 @@
+#!/bin/sh
+
+# symtab_order_test.sh -- test that the symbol table order is stable
+
+# Copyright (C) 2022 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# The global symbol names are interned in parallel when reading the
+# input files, so the name pool keys depend on thread scheduling.  The
+# order of the output symbol tables must not.  Check that the same
+# link done without threads and with several threads gives the same
+# .symtab and .dynsym.
+
+check_present()
+{
+    if ! grep -q "$2" "$1"; then
+	echo "Did not find expected symbol $2 in $1"
+	exit 1
+    fi
+}
+
+check_present symtab_order_test_1.stdout "order_a_var_1$"
+check_present symtab_order_test_1.stdout "order_b_func_5000$"
+
+if ! cmp -s symtab_order_test_1.stdout symtab_order_test_2.stdout; then
+    echo "Symbol tables differ between --no-threads and --threads:"
+    diff symtab_order_test_1.stdout symtab_order_test_2.stdout | head -20
+    exit 1
+fi
+
+exit 0
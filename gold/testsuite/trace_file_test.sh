@@ -0,0 +1,79 @@
+#!/bin/sh
+
+# trace_file_test.sh -- test --trace-file
+
+# Copyright (C) 2022 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# trace_file_test was linked with --threads and --trace-file.  One of
+# its input files has a double quote and a backslash in its name, which
+# show up in the task names.  Check that the trace is valid JSON in the
+# trace event format, and that the names are escaped.
+
+TRACE=trace_file_test.json
+
+check()
+{
+    if ! grep -q -F "$1" $TRACE
+    then
+	echo "Did not find expected output in $TRACE:"
+	echo "   $1"
+	exit 1
+    fi
+}
+
+if ! head -n 1 $TRACE | grep -q '^{"displayTimeUnit":"ms","traceEvents":\[$'
+then
+    echo "$TRACE does not start a traceEvents array"
+    exit 1
+fi
+if test "`tail -n 1 $TRACE`" != "]}"
+then
+    echo "$TRACE does not end the traceEvents array"
+    exit 1
+fi
+
+# Every line between the first and the last is one event object, and
+# all but the last are followed by a comma.
+bad=`sed -e '1d' -e '$d' $TRACE | sed -e '$s/$/,/' \
+     | grep -v '^{"name":".*"ph":"[MX]".*},$'`
+if test -n "$bad"
+then
+    echo "Badly formed events in $TRACE:"
+    echo "$bad" | head -5
+    exit 1
+fi
+
+check '"name":"thread_name","ph":"M"'
+check '"name":"Read_symbols trace_file_test_\"1b\\.o","cat":"task","ph":"X"'
+check '"name":"Task_function Close_task_runner","cat":"task","ph":"X"'
+check '"lock_waits":'
+check '"released_by":"'
+
+# Use a real JSON parser too, if there is one.
+if command -v python3 > /dev/null 2>&1
+then
+    if ! python3 -c 'import json, sys; json.load(open(sys.argv[1]))' $TRACE
+    then
+	echo "$TRACE is not valid JSON"
+	exit 1
+    fi
+fi
+
+exit 0
@@ -0,0 +1,278 @@
+// wildcard.cc -- match a name against a set of wildcards
+
+// Copyright (C) 2022 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+#include "gold.h"
+
+#include <cstring>
+#include <fnmatch.h>
+#include <algorithm>
+
+#include "wildcard.h"
+
+namespace gold
+{
+
+// Class Wildcard_matcher::Pattern.
+
+Wildcard_matcher::Pattern::Pattern(const std::string& p, unsigned int i)
+  : pattern(p), index(i), prefix_length(0), suffix_length(0),
+    is_literal(false)
+{
+  // As elsewhere in gold, a pattern without wildcard characters is
+  // compared as a plain string, even if it has a backslash.
+  const char* s = p.c_str();
+  if (!is_wildcard_string(s))
+    {
+      this->prefix_length = p.length();
+      this->is_literal = true;
+      return;
+    }
+
+  // A backslash may quote the next character, so the literal prefix
+  // stops there too, even if FNM_NOESCAPE is used.  That only makes
+  // the prefix shorter than it could be.
+  const char* const special = "?*[\\";
+  this->prefix_length = strcspn(s, special);
+
+  // If the pattern ends with a '*' followed by plain characters, a
+  // matching name must end with those characters.  Don't try this if
+  // there is a bracket expression or a backslash, since the '*' might
+  // not be a wildcard.
+  const char* star = strrchr(s, '*');
+  if (star != NULL
+      && strpbrk(s, "[\\") == NULL
+      && strchr(star + 1, '?') == NULL)
+    this->suffix_length = strlen(star + 1);
+}
+
+// Class Wildcard_matcher.
+
+Wildcard_matcher::Wildcard_matcher(int fnmatch_flags)
+  : fnmatch_flags_(fnmatch_flags), patterns_(), buckets_(),
+    has_prefix_length_(), finalized_(false)
+{
+}
+
+// Add a pattern.
+
+void
+Wildcard_matcher::add(const std::string& pattern, unsigned int index)
+{
+  gold_assert(!this->finalized_);
+  this->patterns_.push_back(Pattern(pattern, index));
+}
+
+// Search buckets by hash.
+
+struct Wildcard_bucket_compare
+{
+  template<typename Bucket_entry>
+  bool
+  operator()(const Bucket_entry& b, uint64_t h) const
+  { return b.first < h; }
+};
+
+// Build the buckets.
+
+void
+Wildcard_matcher::finalize()
+{
+  gold_assert(!this->finalized_);
+  this->finalized_ = true;
+
+  // Sort the patterns by prefix hash, then by index, then by the
+  // order in which they were added.
+  typedef std::pair<unsigned int, unsigned int> Index_and_pattern;
+  std::vector<std::pair<uint64_t, Index_and_pattern> > hashes;
+  hashes.reserve(this->patterns_.size());
+  size_t max_prefix_length = 0;
+  for (size_t i = 0; i < this->patterns_.size(); ++i)
+    {
+      const Pattern& p(this->patterns_[i]);
+      uint64_t h = hash_init;
+      for (size_t j = 0; j < p.prefix_length; ++j)
+	h = hash_char(h, p.pattern[j]);
+      hashes.push_back(std::make_pair(h, std::make_pair(p.index, i)));
+      max_prefix_length = std::max(max_prefix_length, p.prefix_length);
+    }
+  std::sort(hashes.begin(), hashes.end());
+
+  this->has_prefix_length_.resize(max_prefix_length + 1);
+  for (size_t i = 0; i < hashes.size(); ++i)
+    {
+      if (this->buckets_.empty()
+	  || this->buckets_.back().first != hashes[i].first)
+	this->buckets_.push_back(std::make_pair(hashes[i].first, Bucket()));
+      unsigned int pattern = hashes[i].second.second;
+      this->buckets_.back().second.push_back(pattern);
+      this->has_prefix_length_[this->patterns_[pattern].prefix_length] = true;
+    }
+}
+
+// Return whether NAME matches P.
+
+bool
+Wildcard_matcher::match_pattern(const Pattern& p, const char* name,
+				size_t len) const
+{
+  if (p.is_literal)
+    return len == p.prefix_length;
+  if (p.suffix_length > 0
+      && (len < p.prefix_length + p.suffix_length
+	  || memcmp(name + len - p.suffix_length,
+		    p.pattern.data() + p.pattern.length() - p.suffix_length,
+		    p.suffix_length) != 0))
+    return false;
+  return fnmatch(p.pattern.c_str(), name, this->fnmatch_flags_) == 0;
+}
+
+// Walk the patterns which match NAME.  VISITOR->want(INDEX) is called
+// before trying a pattern; if it returns false, no later pattern in
+// the same bucket is tried.  VISITOR->found(INDEX) is called when a
+// pattern matches; if it returns false, no later pattern in the same
+// bucket is tried.
+
+template<typename Visitor>
+void
+Wildcard_matcher::visit_matches(const char* name, Visitor* visitor) const
+{
+  if (this->patterns_.empty())
+    return;
+  gold_assert(this->finalized_);
+
+  size_t len = strlen(name);
+  size_t max = std::min(len, this->has_prefix_length_.size() - 1);
+  uint64_t h = hash_init;
+  for (size_t k = 0; k <= max; ++k)
+    {
+      if (k > 0)
+	h = hash_char(h, name[k - 1]);
+      if (!this->has_prefix_length_[k])
+	continue;
+
+      std::vector<std::pair<uint64_t, Bucket> >::const_iterator pb =
+	std::lower_bound(this->buckets_.begin(), this->buckets_.end(), h,
+			 Wildcard_bucket_compare());
+      if (pb == this->buckets_.end() || pb->first != h)
+	continue;
+
+      for (Bucket::const_iterator p = pb->second.begin();
+	   p != pb->second.end();
+	   ++p)
+	{
+	  const Pattern& pat(this->patterns_[*p]);
+	  if (!visitor->want(pat.index))
+	    break;
+	  // A different prefix may have the same hash.
+	  if (pat.prefix_length != k
+	      || memcmp(pat.pattern.data(), name, k) != 0)
+	    continue;
+	  if (this->match_pattern(pat, name, len)
+	      && !visitor->found(pat.index))
+	    break;
+	}
+    }
+}
+
+// Visitor for find_first.
+
+class Wildcard_find_first
+{
+ public:
+  Wildcard_find_first()
+    : found_(false), index_(0)
+  { }
+
+  bool
+  want(unsigned int index) const
+  { return !this->found_ || index < this->index_; }
+
+  bool
+  found(unsigned int index)
+  {
+    this->found_ = true;
+    this->index_ = index;
+    return false;
+  }
+
+  bool
+  is_found() const
+  { return this->found_; }
+
+  unsigned int
+  index() const
+  { return this->index_; }
+
+ private:
+  bool found_;
+  unsigned int index_;
+};
+
+// Find the lowest index of a matching pattern.
+
+bool
+Wildcard_matcher::find_first(const char* name, unsigned int* pindex) const
+{
+  Wildcard_find_first visitor;
+  this->visit_matches(name, &visitor);
+  if (!visitor.is_found())
+    return false;
+  *pindex = visitor.index();
+  return true;
+}
+
+// Visitor for find_all.
+
+class Wildcard_find_all
+{
+ public:
+  Wildcard_find_all(std::vector<unsigned int>* pindexes)
+    : pindexes_(pindexes)
+  { }
+
+  bool
+  want(unsigned int) const
+  { return true; }
+
+  bool
+  found(unsigned int index)
+  {
+    this->pindexes_->push_back(index);
+    return true;
+  }
+
+ private:
+  std::vector<unsigned int>* pindexes_;
+};
+
+// Find the indexes of all matching patterns.
+
+void
+Wildcard_matcher::find_all(const char* name,
+			   std::vector<unsigned int>* pindexes) const
+{
+  size_t start = pindexes->size();
+  Wildcard_find_all visitor(pindexes);
+  this->visit_matches(name, &visitor);
+  std::sort(pindexes->begin() + start, pindexes->end());
+}
+
+} // End namespace gold.
@@ -0,0 +1,134 @@
+// wildcard.h -- match a name against a set of wildcards   -*- C++ -*-
+
+// Copyright (C) 2022 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+#ifndef GOLD_WILDCARD_H
+#define GOLD_WILDCARD_H
+
+#include <string>
+#include <vector>
+
+namespace gold
+{
+
+// A Wildcard_matcher holds a set of fnmatch patterns, each tagged with
+// an index, and finds the lowest index of a pattern which matches a
+// given name.  Checking every pattern with fnmatch is linear in the
+// number of patterns, which is too slow when there are many thousands
+// of them.  Instead, the patterns are bucketed by their literal prefix,
+// the part before the first wildcard character.  A lookup walks the
+// name once, hashing each of its prefixes, and only runs fnmatch on the
+// patterns whose literal prefix is a prefix of the name.  Patterns
+// without wildcards are matched by a string compare.
+
+class Wildcard_matcher
+{
+ public:
+  // FNMATCH_FLAGS are passed to fnmatch when matching.
+  Wildcard_matcher(int fnmatch_flags);
+
+  // Add PATTERN, with index INDEX.  This may not be called after
+  // finalize.
+  void
+  add(const std::string& pattern, unsigned int index);
+
+  // Build the lookup tables.  This must be called after all patterns
+  // have been added and before any call to find.
+  void
+  finalize();
+
+  // Return whether there are no patterns.
+  bool
+  empty() const
+  { return this->patterns_.empty(); }
+
+  // Find the lowest index of a pattern which matches NAME, and set
+  // *PINDEX to it.  Return false if no pattern matches.  This may be
+  // called from several threads at once.
+  bool
+  find_first(const char* name, unsigned int* pindex) const;
+
+  // Add the index of every pattern which matches NAME to *PINDEXES,
+  // in increasing order.
+  void
+  find_all(const char* name, std::vector<unsigned int>* pindexes) const;
+
+ private:
+  Wildcard_matcher(const Wildcard_matcher&);
+  Wildcard_matcher& operator=(const Wildcard_matcher&);
+
+  // A pattern.
+  struct Pattern
+  {
+    Pattern(const std::string& p, unsigned int i);
+
+    // The pattern itself.
+    std::string pattern;
+    // The index the pattern was added with.
+    unsigned int index;
+    // The length of the literal prefix of the pattern.
+    size_t prefix_length;
+    // The length of a literal suffix which every matching name must
+    // end with; 0 if unknown.
+    size_t suffix_length;
+    // Whether the pattern has no wildcard characters.
+    bool is_literal;
+  };
+
+  // A bucket of patterns which share a literal prefix hash.  The
+  // patterns are listed in order of increasing index.
+  typedef std::vector<unsigned int> Bucket;
+
+  // Hash one more character into H.
+  static uint64_t
+  hash_char(uint64_t h, unsigned char c)
+  { return (h ^ c) * 1099511628211ULL; }
+
+  // The initial hash value.
+  static const uint64_t hash_init = 14695981039346656037ULL;
+
+  // Return whether NAME, of length LEN, matches pattern P.  The
+  // caller has already checked that the literal prefix matches.
+  bool
+  match_pattern(const Pattern& p, const char* name, size_t len) const;
+
+  // Walk the buckets which may hold patterns matching NAME, passing
+  // the indexes of the patterns which match to VISITOR.
+  template<typename Visitor>
+  void
+  visit_matches(const char* name, Visitor* visitor) const;
+
+  // Flags to pass to fnmatch.
+  int fnmatch_flags_;
+  // The patterns, in the order they were added.
+  std::vector<Pattern> patterns_;
+  // Map from the hash of a literal prefix to the patterns with that
+  // prefix.  Sorted by hash for lookup.
+  std::vector<std::pair<uint64_t, Bucket> > buckets_;
+  // For each length, whether there are any literal prefixes of that
+  // length.
+  std::vector<bool> has_prefix_length_;
+  // Whether finalize has been called.
+  bool finalized_;
+};
+
+} // End namespace gold.
+
+#endif // !defined(GOLD_WILDCARD_H)
@@ -69,6 +69,37 @@ class Workqueue_threader
   Workqueue* workqueue_;
 };
 
+// A Workqueue run queue.  The lock controls access to the lists.
+
+class Workqueue_run_queue
+{
+ public:
+  Workqueue_run_queue()
+    : lock_(), first_tasks_(), tasks_()
+  { }
+
+  // Return the list of tasks to execute soon, or the list of tasks to
+  // execute after those.
+  Task_list*
+  tasks(bool soon)
+  { return soon ? &this->first_tasks_ : &this->tasks_; }
+
+  // The lock for this run queue.
+  Lock&
+  lock()
+  { return this->lock_; }
+
+ private:
+  Workqueue_run_queue(const Workqueue_run_queue&);
+  Workqueue_run_queue& operator=(const Workqueue_run_queue&);
+
+  Lock lock_;
+  // List of tasks to execute soon.
+  Task_list first_tasks_;
+  // List of tasks to execute after the ones in first_tasks_.
+  Task_list tasks_;
+};
+
 // The threaded instantiation of Workqueue_threader.
 
 class Workqueue_threader_threadpool : public Workqueue_threader
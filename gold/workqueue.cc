@@ -22,6 +22,13 @@
 
 #include "gold.h"
 
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <sys/time.h>
+
 #include "debug.h"
 #include "options.h"
 #include "timer.h"
@@ -114,17 +121,190 @@ class Workqueue_threader_single : public Workqueue_threader
   { return false; }
 };
 
+// Class Workqueue_trace.  This records when each Task runs, and how
+// long it waited for Task_tokens, and writes the result in the JSON
+// trace event format read by Chrome's about:tracing and by Perfetto.
+
+class Workqueue_trace
+{
+ public:
+  Workqueue_trace(const char* filename)
+    : filename_(filename), base_(now()), events_(), max_thread_(0)
+  { }
+
+  // Return the current time in microseconds.
+  static int64_t
+  now()
+  {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return static_cast<int64_t>(tv.tv_sec) * 1000000 + tv.tv_usec;
+  }
+
+  // Record that T ran in thread THREAD_NUMBER from START to END.
+  // This is called with the workqueue lock held.
+  void
+  add_event(Task* t, int thread_number, int64_t start, int64_t end);
+
+  // Write out the trace file.
+  void
+  write();
+
+ private:
+  // A Task which ran.
+  struct Event
+  {
+    std::string name;
+    int thread_number;
+    int64_t queued;
+    int64_t start;
+    int64_t end;
+    int64_t wait_time;
+    int wait_count;
+    std::string released_by;
+  };
+
+  // Write S to F as a JSON string.
+  static void
+  write_string(FILE* f, const std::string& s);
+
+  // The name of the trace file.
+  const char* filename_;
+  // The time at which tracing started.  Times in the trace file are
+  // relative to this.
+  int64_t base_;
+  // The Tasks which have run.
+  std::vector<Event> events_;
+  // The largest thread number seen.
+  int max_thread_;
+};
+
+// Record a Task which ran.
+
+void
+Workqueue_trace::add_event(Task* t, int thread_number, int64_t start,
+			   int64_t end)
+{
+  Task_trace_info* info = t->trace_info();
+  this->events_.push_back(Event());
+  Event& e(this->events_.back());
+  e.name = t->name();
+  e.thread_number = thread_number;
+  e.queued = info->queued != 0 ? info->queued : start;
+  e.start = start;
+  e.end = end;
+  e.wait_time = info->wait_time;
+  e.wait_count = info->wait_count;
+  e.released_by = info->released_by;
+  this->max_thread_ = std::max(this->max_thread_, thread_number);
+}
+
+// Write a string with JSON quoting.
+
+void
+Workqueue_trace::write_string(FILE* f, const std::string& s)
+{
+  putc('"', f);
+  for (std::string::const_iterator p = s.begin(); p != s.end(); ++p)
+    {
+      unsigned char c = *p;
+      if (c == '"' || c == '\\')
+	fprintf(f, "\\%c", c);
+      else if (c < 0x20)
+	fprintf(f, "\\u%04x", c);
+      else
+	putc(c, f);
+    }
+  putc('"', f);
+}
+
+// Write out the trace.  Each Task is a complete event on the thread
+// which ran it.  The arguments show how long the Task waited after it
+// was queued, how much of that was spent waiting for Task_tokens, and
+// which Task released the last Task_token it waited for.
+
+void
+Workqueue_trace::write()
+{
+  FILE* f = fopen(this->filename_, "w");
+  if (f == NULL)
+    {
+      gold_error(_("cannot open trace file %s: %s"), this->filename_,
+		 strerror(errno));
+      return;
+    }
+
+  fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  for (int i = 0; i <= this->max_thread_; ++i)
+    fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+	    "\"tid\":%d,\"args\":{\"name\":\"thread %d\"}},\n", i, i);
+
+  for (std::vector<Event>::const_iterator p = this->events_.begin();
+       p != this->events_.end();
+       ++p)
+    {
+      fprintf(f, "{\"name\":");
+      write_string(f, p->name);
+      fprintf(f, ",\"cat\":\"task\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+	      "\"ts\":%lld,\"dur\":%lld,\"args\":{\"queued_us\":%lld,"
+	      "\"lock_waits\":%d,\"lock_wait_us\":%lld",
+	      p->thread_number,
+	      static_cast<long long>(p->start - this->base_),
+	      static_cast<long long>(p->end - p->start),
+	      static_cast<long long>(p->start - p->queued),
+	      p->wait_count,
+	      static_cast<long long>(p->wait_time));
+      if (!p->released_by.empty())
+	{
+	  fprintf(f, ",\"released_by\":");
+	  write_string(f, p->released_by);
+	}
+      fprintf(f, "}}%s\n", p + 1 != this->events_.end() ? "," : "");
+    }
+  fprintf(f, "]}\n");
+
+  if (fclose(f) != 0)
+    gold_error(_("%s: close: %s"), this->filename_, strerror(errno));
+}
+
+// Atomically add DELTA to *P.  Without the sync builtins, the
+// Workqueue lock is always held when the run queue counters are
+// changed; see Workqueue::pop_task.
+
+static inline void
+atomic_add(volatile int* p, int delta)
+{
+#ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_4
+  __sync_fetch_and_add(p, delta);
+#else
+  *p += delta;
+#endif
+}
+
+// The largest number of run queues we use.  Threads beyond this share
+// run queues.
+
+const int max_thread_run_queues = 64;
+
 // Workqueue methods.
 
 Workqueue::Workqueue(const General_options& options)
   : lock_(),
-    first_tasks_(),
-    tasks_(),
+    run_queues_(NULL),
+    max_run_queues_(1),
+    run_queue_count_(1),
+    next_run_queue_(0),
+    queued_(0),
+    queued_soon_(0),
     running_(0),
     waiting_(0),
     condvar_(this->lock_),
-    threader_(NULL)
+    threader_(NULL),
+    trace_(NULL)
 {
+  if (options.trace_file() != NULL)
+    this->trace_ = new Workqueue_trace(options.trace_file());
+
   bool threads = options.threads();
 #ifndef ENABLE_THREADS
   threads = false;
@@ -135,24 +315,59 @@ Workqueue::Workqueue(const General_options& options)
     {
 #ifdef ENABLE_THREADS
       this->threader_ = new Workqueue_threader_threadpool(this);
+      this->max_run_queues_ = max_thread_run_queues;
 #else
       gold_unreachable();
 #endif
     }
+  this->run_queues_ = new Workqueue_run_queue[this->max_run_queues_];
 }
 
 Workqueue::~Workqueue()
 {
+  delete this->trace_;
 }
 
-// Add a task to the end of a specific queue, or put it on the list
-// waiting for a Token.
+// Record that T is waiting for a Task_token.  The workqueue lock must
+// be held.
+
+inline void
+Workqueue::trace_wait(Task* t)
+{
+  if (this->trace_ != NULL)
+    {
+      Task_trace_info* info = t->trace_info();
+      info->wait_start = Workqueue_trace::now();
+      ++info->wait_count;
+    }
+}
+
+// Record that RELEASER released a Task_token that T was waiting for.
+// The workqueue lock must be held.
+
+inline void
+Workqueue::trace_release(Task* t, Task* releaser)
+{
+  if (this->trace_ != NULL)
+    {
+      Task_trace_info* info = t->trace_info();
+      info->wait_time += Workqueue_trace::now() - info->wait_start;
+      info->released_by = releaser->name();
+    }
+}
+
+// Add a task to a run queue, or put it on the list waiting for a
+// Token.  Tasks queued this way are spread across the run queues in
+// turn.
 
 void
-Workqueue::add_to_queue(Task_list* queue, Task* t, bool front)
+Workqueue::add_to_queue(Task* t, bool soon, bool front)
 {
   Hold_lock hl(this->lock_);
 
+  if (this->trace_ != NULL)
+    t->trace_info()->queued = Workqueue_trace::now();
+
   Task_token* token = t->is_runnable();
   if (token != NULL)
     {
@@ -161,15 +376,13 @@ Workqueue::add_to_queue(Task_list* queue, Task* t, bool front)
       else
 	token->add_waiting(t);
       ++this->waiting_;
+      this->trace_wait(t);
     }
   else
     {
-      if (front)
-	queue->push_front(t);
-      else
-	queue->push_back(t);
-      // Tell any waiting thread that there is work to do.
-      this->condvar_.signal();
+      int i = this->next_run_queue_;
+      this->next_run_queue_ = (i + 1) % this->run_queue_count_;
+      this->push_runnable(&this->run_queues_[i], t, soon, front);
     }
 }
 
@@ -178,7 +391,7 @@ Workqueue::add_to_queue(Task_list* queue, Task* t, bool front)
 void
 Workqueue::queue(Task* t)
 {
-  this->add_to_queue(&this->tasks_, t, false);
+  this->add_to_queue(t, false, false);
 }
 
 // Queue a task which should run soon.
@@ -187,7 +400,7 @@ void
 Workqueue::queue_soon(Task* t)
 {
   t->set_should_run_soon();
-  this->add_to_queue(&this->first_tasks_, t, false);
+  this->add_to_queue(t, true, false);
 }
 
 // Queue a task which should run next.
@@ -196,7 +409,7 @@ void
 Workqueue::queue_next(Task* t)
 {
   t->set_should_run_soon();
-  this->add_to_queue(&this->first_tasks_, t, true);
+  this->add_to_queue(t, true, true);
 }
 
 // Return whether to cancel the current thread.
@@ -207,55 +420,142 @@ Workqueue::should_cancel_thread(int thread_number)
   return this->threader_->should_cancel_thread(thread_number);
 }
 
-// Find a runnable task in TASKS.  Return NULL if none could be found.
-// If we find a Task waiting for a Token, add it to the list for that
-// Token.  The workqueue lock must be held when this is called.
+// Add T, which was runnable, to run queue RQ, and tell any waiting
+// thread that there is work to do.  The workqueue lock must be held
+// when this is called.
+
+void
+Workqueue::push_runnable(Workqueue_run_queue* rq, Task* t, bool soon,
+			 bool front)
+{
+  {
+    Hold_lock hl(rq->lock());
+    if (front)
+      rq->tasks(soon)->push_front(t);
+    else
+      rq->tasks(soon)->push_back(t);
+    atomic_add(&this->queued_, 1);
+    if (soon)
+      atomic_add(&this->queued_soon_, 1);
+  }
+  this->condvar_.signal();
+}
+
+// Remove the first task from run queue RQ, counting it as running.
+// Return NULL if the queue is empty.  This only needs the lock of the
+// run queue.
 
 Task*
-Workqueue::find_runnable_in_list(Task_list* tasks)
+Workqueue::pop_runnable(Workqueue_run_queue* rq, bool soon)
 {
-  Task* t;
-  while ((t = tasks->pop_front()) != NULL)
+  Hold_lock hl(rq->lock());
+  Task* t = rq->tasks(soon)->pop_front();
+  if (t != NULL)
     {
-      Task_token* token = t->is_runnable();
+      // Count the task as running before it leaves the queue, so
+      // that no thread can see both counts as zero and decide that
+      // the workqueue is finished.
+      atomic_add(&this->running_, 1);
+      atomic_add(&this->queued_, -1);
+      if (soon)
+	atomic_add(&this->queued_soon_, -1);
+    }
+  return t;
+}
+
+// Remove a task from the run queues.  Tasks which should run soon
+// come first.  A thread looks at its own run queue first, and
+// otherwise steals from the others.  Return NULL if the run queues
+// are empty.  Without the sync builtins this must be called with the
+// workqueue lock held.
+
+Task*
+Workqueue::pop_task(int thread_number)
+{
+  if (this->queued_ == 0)
+    return NULL;
 
-      if (token == NULL)
+  int count = this->run_queue_count_;
+  int self = thread_number % count;
+  Task* t;
+  if (this->queued_soon_ > 0)
+    {
+      for (int i = 0; i < count; ++i)
+	{
+	  t = this->pop_runnable(&this->run_queues_[(self + i) % count],
+				 true);
+	  if (t != NULL)
+	    return t;
+	}
+    }
+  for (int i = 0; i < count; ++i)
+    {
+      t = this->pop_runnable(&this->run_queues_[(self + i) % count], false);
+      if (t != NULL)
 	return t;
+    }
+  return NULL;
+}
 
+// T was taken from a run queue.  If it is still runnable, get its
+// locks and return true.  Otherwise add it to the list for the Token
+// it is waiting for and return false.  The workqueue lock must be
+// held when this is called.
+
+bool
+Workqueue::claim_task(Task* t, Task_locker* tl)
+{
+  Task_token* token = t->is_runnable();
+  if (token != NULL)
+    {
       token->add_waiting(t);
       ++this->waiting_;
+      this->trace_wait(t);
+      atomic_add(&this->running_, -1);
+      return false;
     }
 
-  // We couldn't find any runnable task.
-  return NULL;
+  // Get the locks for the task.  This must be called while we are
+  // still holding the Workqueue lock.
+  t->locks(tl);
+  return true;
 }
 
-// Find a runnable task.  Return NULL if none could be found.  The
-// workqueue lock must be held when this is called.
+// Find a runnable a task, get its locks, and return it.  Wait until
+// we find one.  Return NULL if we should exit.  The workqueue lock
+// must not be held when this is called.
 
 Task*
-Workqueue::find_runnable()
+Workqueue::find_runnable_or_wait(int thread_number, Task_locker* tl)
 {
-  Task* t = this->find_runnable_in_list(&this->first_tasks_);
-  if (t == NULL)
-    t = this->find_runnable_in_list(&this->tasks_);
-  return t;
-}
+  while (true)
+    {
+      Task* t;
 
-// Find a runnable a task, and wait until we find one.  Return NULL if
-// we should exit.  The workqueue lock must be held when this is
-// called.
+#ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_4
+      t = this->pop_task(thread_number);
+      if (t != NULL)
+	{
+	  Hold_lock hl(this->lock_);
+	  if (this->claim_task(t, tl))
+	    return t;
+	  continue;
+	}
+#endif
 
-Task*
-Workqueue::find_runnable_or_wait(int thread_number)
-{
-  Task* t = this->find_runnable();
+      Hold_lock hl(this->lock_);
 
-  while (t == NULL)
-    {
-      if (this->running_ == 0
-	  && this->first_tasks_.empty()
-	  && this->tasks_.empty())
+      // Look again now that we hold the lock, since tasks are only
+      // queued with the lock held.
+      t = this->pop_task(thread_number);
+      if (t != NULL)
+	{
+	  if (this->claim_task(t, tl))
+	    return t;
+	  continue;
+	}
+
+      if (this->running_ == 0 && this->queued_ == 0)
 	{
 	  // Kick all the threads to make them exit.
 	  this->condvar_.broadcast();
@@ -272,11 +572,7 @@ Workqueue::find_runnable_or_wait(int thread_number)
       this->condvar_.wait();
 
       gold_debug(DEBUG_TASK, "%3d awake", thread_number);
-
-      t = this->find_runnable();
     }
-
-  return t;
 }
 
 // Find and run tasks.  If we can't find a runnable task, wait for one
@@ -288,24 +584,11 @@ Workqueue::find_runnable_or_wait(int thread_number)
 bool
 Workqueue::find_and_run_task(int thread_number)
 {
-  Task* t;
   Task_locker tl;
 
-  {
-    Hold_lock hl(this->lock_);
-
-    // Find a runnable task.
-    t = this->find_runnable_or_wait(thread_number);
-
-    if (t == NULL)
-      return false;
-
-    // Get the locks for the task.  This must be called while we are
-    // still holding the Workqueue lock.
-    t->locks(&tl);
-
-    ++this->running_;
-  }
+  Task* t = this->find_runnable_or_wait(thread_number, &tl);
+  if (t == NULL)
+    return false;
 
   while (t != NULL)
     {
@@ -316,8 +599,21 @@ Workqueue::find_and_run_task(int thread_number)
       if (is_debugging_enabled(DEBUG_TASK))
         timer.start();
 
+      int64_t trace_start = 0;
+      if (this->trace_ != NULL)
+	{
+	  // Get the name now, since running the task may free data
+	  // which the name is built from.
+	  t->name();
+	  trace_start = Workqueue_trace::now();
+	}
+
       t->run(this);
 
+      int64_t trace_end = 0;
+      if (this->trace_ != NULL)
+	trace_end = Workqueue_trace::now();
+
       if (is_debugging_enabled(DEBUG_TASK))
         {
           Timer::TimeStats elapsed = timer.get_elapsed_time();
@@ -335,24 +631,24 @@ Workqueue::find_and_run_task(int thread_number)
       {
 	Hold_lock hl(this->lock_);
 
-	--this->running_;
+	if (this->trace_ != NULL)
+	  this->trace_->add_event(t, thread_number, trace_start, trace_end);
 
 	// Release the locks for the task.  This must be done with the
 	// workqueue lock held.  Get the next Task to run if any.
-	next = this->release_locks(t, &tl);
-
-	if (next == NULL)
-	  next = this->find_runnable();
+	next = this->release_locks(t, &tl, thread_number);
 
 	// If we have another Task to run, get the Locks.  This must
 	// be called while we are still holding the Workqueue lock.
+	// Otherwise we look at the run queues again, starting with
+	// our own, which holds any other tasks we just made runnable.
 	if (next != NULL)
 	  {
 	    tl.clear();
 	    next->locks(&tl);
-
-	    ++this->running_;
 	  }
+	else
+	  atomic_add(&this->running_, -1);
       }
 
       // We are done with this task.
@@ -370,8 +666,8 @@ Workqueue::find_and_run_task(int thread_number)
 // 1) If T is not runnable, queue it on the appropriate token.
 
 // 2) Otherwise, T is runnable.  If *PRET is not NULL, then we have
-// already decided which Task to run next.  Add T to the list of
-// runnable tasks, and signal another thread.
+// already decided which Task to run next.  Add T to the run queue of
+// THREAD_NUMBER, and signal another thread.
 
 // 3) Otherwise, *PRET is NULL.  If IS_BLOCKER is false, then T was
 // waiting on a write lock.  We can grab that lock now, so we run T
@@ -394,7 +690,8 @@ Workqueue::find_and_run_task(int thread_number)
 // Return true if we set *PRET to T, false otherwise.
 
 bool
-Workqueue::return_or_queue(Task* t, bool is_blocker, Task** pret)
+Workqueue::return_or_queue(Task* t, bool is_blocker, Task** pret,
+			   int thread_number)
 {
   Task_token* token = t->is_runnable();
 
@@ -402,6 +699,7 @@ Workqueue::return_or_queue(Task* t, bool is_blocker, Task** pret)
     {
       token->add_waiting(t);
       ++this->waiting_;
+      this->trace_wait(t);
       return false;
     }
 
@@ -414,7 +712,7 @@ Workqueue::return_or_queue(Task* t, bool is_blocker, Task** pret)
     should_return = true;
   else if (t->should_run_soon())
     should_return = true;
-  else if (!this->first_tasks_.empty() || !this->tasks_.empty())
+  else if (this->queued_ > 0)
     should_queue = true;
   else
     should_return = true;
@@ -427,11 +725,9 @@ Workqueue::return_or_queue(Task* t, bool is_blocker, Task** pret)
     }
   else if (should_queue)
     {
-      if (t->should_run_soon())
-	this->first_tasks_.push_back(t);
-      else
-	this->tasks_.push_back(t);
-      this->condvar_.signal();
+      int i = thread_number % this->run_queue_count_;
+      this->push_runnable(&this->run_queues_[i], t, t->should_run_soon(),
+			  false);
       return false;
     }
 
@@ -440,11 +736,11 @@ Workqueue::return_or_queue(Task* t, bool is_blocker, Task** pret)
 
 // Release the locks associated with a Task.  Return the first
 // runnable Task that we find.  If we find more runnable tasks, add
-// them to the run queue and signal any other threads.  This must be
-// called with the Workqueue lock held.
+// them to the run queue of THREAD_NUMBER and signal any other
+// threads.  This must be called with the Workqueue lock held.
 
 Task*
-Workqueue::release_locks(Task* t, Task_locker* tl)
+Workqueue::release_locks(Task* t, Task_locker* tl, int thread_number)
 {
   Task* ret = NULL;
   for (Task_locker::iterator p = tl->begin(); p != tl->end(); ++p)
@@ -456,11 +752,12 @@ Workqueue::release_locks(Task* t, Task_locker* tl)
 	    {
 	      // The token has been unblocked.  Every waiting Task may
 	      // now be runnable.
-	      Task* t;
-	      while ((t = token->remove_first_waiting()) != NULL)
+	      Task* w;
+	      while ((w = token->remove_first_waiting()) != NULL)
 		{
 		  --this->waiting_;
-		  this->return_or_queue(t, true, &ret);
+		  this->trace_release(w, t);
+		  this->return_or_queue(w, true, &ret, thread_number);
 		}
 	    }
 	}
@@ -473,11 +770,12 @@ Workqueue::release_locks(Task* t, Task_locker* tl)
 	  // move all the Tasks to the runnable queue, to avoid a
 	  // potential deadlock if the locking status changes before
 	  // we run the next thread.
-	  Task* t;
-	  while ((t = token->remove_first_waiting()) != NULL)
+	  Task* w;
+	  while ((w = token->remove_first_waiting()) != NULL)
 	    {
 	      --this->waiting_;
-	      if (this->return_or_queue(t, false, &ret))
+	      this->trace_release(w, t);
+	      if (this->return_or_queue(w, false, &ret, thread_number))
 		break;
 	    }
 	}
@@ -504,6 +802,12 @@ Workqueue::set_thread_count(int threads)
 {
   Hold_lock hl(this->lock_);
 
+  // Give each thread its own run queue, up to the number allocated.
+  // Run queues are never removed, since they may still hold tasks.
+  int count = std::min(std::max(threads, 1), this->max_run_queues_);
+  if (count > this->run_queue_count_)
+    this->run_queue_count_ = count;
+
   this->threader_->set_thread_count(threads);
   // Wake up all the threads, since something has changed.
   this->condvar_.broadcast();
@@ -518,4 +822,13 @@ Workqueue::add_blocker(Task_token* token)
   token->add_blocker();
 }
 
+// Write out the trace, if we are tracing.
+
+void
+Workqueue::write_trace()
+{
+  if (this->trace_ != NULL)
+    this->trace_->write();
+}
+
 } // End namespace gold.
@@ -38,6 +38,28 @@ namespace gold
 class General_options;
 class Workqueue;
 
+// Information recorded about a Task when --trace-file is used.  Times
+// are in microseconds.
+
+struct Task_trace_info
+{
+  Task_trace_info()
+    : queued(0), wait_start(0), wait_time(0), wait_count(0), released_by()
+  { }
+
+  // When the Task was queued.
+  int64_t queued;
+  // When the Task last started waiting for a Task_token.
+  int64_t wait_start;
+  // The total time the Task has spent waiting for Task_tokens.
+  int64_t wait_time;
+  // The number of times the Task has waited for a Task_token.
+  int wait_count;
+  // The name of the Task which last released a Task_token that this
+  // Task was waiting for.
+  std::string released_by;
+};
+
 // The superclass for tasks to be placed on the workqueue.  Each
 // specific task class will inherit from this one.
 
@@ -45,10 +67,10 @@ class Task
 {
  public:
   Task()
-    : list_next_(NULL), name_(), should_run_soon_(false)
+    : list_next_(NULL), name_(), should_run_soon_(false), trace_info_(NULL)
   { }
   virtual ~Task()
-  { }
+  { delete this->trace_info_; }
 
   // Check whether the Task can be run now.  This method is only
   // called with the workqueue lock held.  If the Task can run, this
@@ -106,6 +128,17 @@ class Task
     return this->name_;
   }
 
+  // Return the trace information for the Task, creating it if
+  // necessary.  This is only used when tracing, and is only called
+  // with the workqueue lock held.
+  Task_trace_info*
+  trace_info()
+  {
+    if (this->trace_info_ == NULL)
+      this->trace_info_ = new Task_trace_info();
+    return this->trace_info_;
+  }
+
  protected:
   // Get the name of the task.  This must be implemented by the child
   // class.
@@ -127,6 +160,8 @@ class Task
   // Whether this Task should be executed soon.  This is used for
   // Tasks which can be run after some data is read.
   bool should_run_soon_;
+  // Information for --trace-file.  NULL if not tracing.
+  Task_trace_info* trace_info_;
 };
 
 // An interface for Task_function.  This is a convenience class to run
@@ -194,6 +229,8 @@ class Task_function : public Task
 // The workqueue itself.
 
 class Workqueue_threader;
+class Workqueue_run_queue;
+class Workqueue_trace;
 
 class Workqueue
 {
@@ -233,26 +270,41 @@ class Workqueue
   void
   add_blocker(Task_token*);
 
+  // If --trace-file was used, write out the trace of the tasks which
+  // have been run.
+  void
+  write_trace();
+
  private:
   // This class can not be copied.
   Workqueue(const Workqueue&);
   Workqueue& operator=(const Workqueue&);
 
-  // Add a task to a queue.
+  // Add a task to a run queue.
   void
-  add_to_queue(Task_list* queue, Task* t, bool front);
+  add_to_queue(Task* t, bool soon, bool front);
 
-  // Find a runnable task, or wait for one.
+  // Push a runnable task onto a run queue.
+  void
+  push_runnable(Workqueue_run_queue*, Task* t, bool soon, bool front);
+
+  // Remove a task from a run queue.
   Task*
-  find_runnable_or_wait(int thread_number);
+  pop_runnable(Workqueue_run_queue*, bool soon);
 
-  // Find a runnable task.
+  // Remove a task from the run queues, preferring the one belonging
+  // to a thread.
   Task*
-  find_runnable();
+  pop_task(int thread_number);
+
+  // Take the locks for a task taken from a run queue, if it is
+  // runnable.
+  bool
+  claim_task(Task*, Task_locker*);
 
-  // Find a runnable task in a list.
+  // Find a runnable task, or wait for one.
   Task*
-  find_runnable_in_list(Task_list*);
+  find_runnable_or_wait(int thread_number, Task_locker*);
 
   // Find an run a task.
   bool
@@ -260,25 +312,49 @@ class Workqueue
 
   // Release the locks for a Task.  Return the next Task to run.
   Task*
-  release_locks(Task*, Task_locker*);
+  release_locks(Task*, Task_locker*, int thread_number);
 
   // Store T into *PRET, or queue it as appropriate.
   bool
-  return_or_queue(Task* t, bool is_blocker, Task** pret);
+  return_or_queue(Task* t, bool is_blocker, Task** pret, int thread_number);
 
   // Return whether to cancel this thread.
   bool
   should_cancel_thread(int thread_number);
 
-  // Master Workqueue lock.  This controls access to the following
-  // member variables.
+  // Record that T is waiting for a Task_token, if tracing.
+  void
+  trace_wait(Task* t);
+
+  // Record that RELEASER has released a Task_token that T was waiting
+  // for, if tracing.
+  void
+  trace_release(Task* t, Task* releaser);
+
+  // Master Workqueue lock.  This controls access to the Task_tokens
+  // and to the following member variables, except where noted.
   Lock lock_;
-  // List of tasks to execute soon.
-  Task_list first_tasks_;
-  // List of tasks to execute after the ones in first_tasks_.
-  Task_list tasks_;
-  // Number of tasks currently running.
-  int running_;
+  // The run queues of tasks which were runnable when they were
+  // queued.  Each thread has a run queue which it prefers to take
+  // tasks from, and takes tasks from the others when its own is
+  // empty.  Tasks are only added with lock_ held, but may be removed
+  // holding just the lock of the run queue.
+  Workqueue_run_queue* run_queues_;
+  // The number of run queues allocated.
+  int max_run_queues_;
+  // The number of run queues in use.  This only grows.
+  volatile int run_queue_count_;
+  // The run queue to use for the next task queued by queue().
+  int next_run_queue_;
+  // Number of tasks on the run queues.  This is updated atomically.
+  volatile int queued_;
+  // Number of tasks on the run queues which should run soon.  This
+  // is updated atomically.
+  volatile int queued_soon_;
+  // Number of tasks currently running, including tasks taken from a
+  // run queue whose locks have not yet been taken.  This is updated
+  // atomically.
+  volatile int running_;
   // Number of tasks waiting for a lock to release.
   int waiting_;
   // Condition variable associated with lock_.  This is signalled when
@@ -288,6 +364,10 @@ class Workqueue
   // The threading implementation.  This is set at construction time
   // and not changed thereafter.
   Workqueue_threader* threader_;
+  // The trace of the tasks run, for --trace-file.  This is NULL if
+  // we are not tracing.  This is set at construction time and not
+  // changed thereafter; the events are recorded with lock_ held.
+  Workqueue_trace* trace_;
 };
 
 } // End namespace gold.
@@ -1557,6 +1557,21 @@ Target_x86_64<size>::rela_dyn_section(Layout* layout)
       layout->add_output_section_data(".rela.dyn", elfcpp::SHT_RELA,
 				      elfcpp::SHF_ALLOC, this->rela_dyn_,
 				      ORDER_DYNAMIC_RELOCS, false);
+
+      // With -z pack-relative-relocs, RELATIVE relocs go into a
+      // SHT_RELR section when they can.
+      if (parameters->options().pack_relative_relocs()
+	  && parameters->options().output_is_position_independent()
+	  && !parameters->incremental())
+	{
+	  Output_data_relr<size, false>* relr =
+	    new Output_data_relr<size, false>();
+	  layout->add_output_section_data(".relr.dyn", elfcpp::SHT_RELR,
+					  elfcpp::SHF_ALLOC, relr,
+					  ORDER_DYNAMIC_RELOCS, false);
+	  this->rela_dyn_->set_relr(relr, elfcpp::R_X86_64_RELATIVE);
+	  layout->set_relr_dyn(relr);
+	}
     }
   return this->rela_dyn_;
 }
@@ -32,6 +32,7 @@ START_RELOC_NUMBERS (elf_i960_reloc_type)
      RELOC_NUMBER (R_960_OPTCALL,   5)
      RELOC_NUMBER (R_960_OPTCALLX,  6)
      RELOC_NUMBER (R_960_OPTCALLXA, 7)
+     RELOC_NUMBER (R_960_ALIGN,	    8)
 END_RELOC_NUMBERS (R_960_max)
 
 #endif /* _ELF_I960_H */
@@ -0,0 +1,12 @@
+# With --relax, a callx whose target is within reach of a 24-bit call
+# is shortened to one, and one whose target is not is left alone.
+
+	.text
+	.globl	_start
+_start:
+	callx	near
+	callx	in_range
+	callx	out_of_range
+	ret
+near:
+	ret
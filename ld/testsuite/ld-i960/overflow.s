@@ -0,0 +1,8 @@
+# 24-bit branch displacements which cannot reach their target.
+
+	.text
+	.globl	_start
+_start:
+	call	far			# R_960_IP24
+	callj	far			# R_960_OPTCALL
+	ret
@@ -0,0 +1,13 @@
+# A branch to a local label is an R_960_IP24 against the section
+# symbol, whose in-place field is relative to the start of the input
+# section.  ld -r places this .text after another one, and the branch
+# must still reach its target.
+
+	.text
+	.word	0, 0, 0, 0
+	.globl	_start
+_start:
+	call	1f
+	ret
+1:
+	ret
@@ -0,0 +1,11 @@
+	.text
+	.word	0, 0, 0, 0
+	.globl	ext_func
+ext_func:
+	ret
+
+	.data
+	.word	0
+	.globl	ext_data
+ext_data:
+	.word	0
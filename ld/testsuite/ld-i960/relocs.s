@@ -0,0 +1,28 @@
+# One reference of each kind that gas emits for i960, assembled with
+# --link-relax and linked without --relax.
+
+	.text
+	.globl	_start
+_start:
+	.reloc	., R_960_NONE, ext_func
+	.word	0			# R_960_NONE: left alone
+	call	ext_func		# R_960_IP24
+	b	ext_func
+	bal	ext_func + 4
+	callj	ext_func		# R_960_OPTCALL
+	callx	ext_func		# R_960_OPTCALLX
+	ld	ext_data, g0		# R_960_32
+	lda	str, g1			# R_960_32 against a merged string
+	.word	end - _start		# R_960_32 and R_960_SUB
+	.align	4			# R_960_ALIGN: ignored
+end:
+	ret
+
+	.data
+	.word	ext_data		# R_960_32
+	.word	ext_func + 8
+
+	.section .rodata.str1.1, "aMS", %progbits, 1
+	.asciz	"abc"
+str:
+	.asciz	"bc"
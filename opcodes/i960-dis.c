@@ -30,20 +30,35 @@ static const char *const reg_names[] = {
 /* 32 */	"pc",  "ac",  "ip",  "tc",  "fp0", "fp1", "fp2", "fp3"
 };
 
+/* Text of one disassembled instruction.  Everything before the
+   (single) address operand is collected in PART[0] and everything after
+   it in PART[1], so that an instruction costs at most two fprintf_func
+   calls around one print_address_func call.  */
 
-//static FILE *stream;		/* Output goes here */
-//static struct disassemble_info *info;
-static void print_addr (bfd_vma, disassemble_info*);
-static void ctrl (bfd_vma, uint32_t, uint32_t, disassemble_info*);
-static void cobr (bfd_vma, uint32_t, uint32_t, disassemble_info*);
-static void reg (uint32_t, disassemble_info*);
-static int mem (bfd_vma, uint32_t, uint32_t, int, disassemble_info*);
-static void ea (bfd_vma, int, const char *, const char *, int, unsigned int, disassemble_info*);
-static void dstop (int, int, int, disassemble_info*);
-static void regop (int, int, int, int, disassemble_info*);
-static void invalid (int, disassemble_info*);
+struct insn_text
+{
+  char part[2][128];
+  size_t len[2];
+  int cur;			/* Part currently being written.  */
+  bfd_vma addr;			/* Address operand, if CUR is 1.  */
+};
+
+static void text_puts (struct insn_text *, const char *);
+static void text_printf (struct insn_text *, const char *, ...)
+  ATTRIBUTE_PRINTF_2;
+static void print_addr (bfd_vma, struct insn_text *);
+static void ctrl (bfd_vma, uint32_t, struct insn_text *);
+static void cobr (bfd_vma, uint32_t, struct insn_text *);
+static void reg (uint32_t, struct insn_text *);
+static int mem_len (uint32_t);
+static void mem (bfd_vma, uint32_t, uint32_t, struct insn_text *);
+static void ea (bfd_vma, int, const char *, const char *, int, unsigned int,
+		struct insn_text *);
+static void dstop (int, int, int, struct insn_text *);
+static void regop (int, int, int, int, struct insn_text *);
+static void invalid (int, struct insn_text *);
 static int pinsn (bfd_vma, uint32_t, uint32_t, disassemble_info*);
-static void put_abs (uint32_t, uint32_t, disassemble_info*);
+static void put_abs (uint32_t, uint32_t, int, struct insn_text *);
 static int get_opcode_high4bits(uint32_t);
 
 int
@@ -104,105 +119,436 @@ print_insn_i960 (bfd_vma memaddr, disassemble_info *info)
  *****************************************************************************/
 
 struct tabent {
-  char *name;
+  const char *name;
   short numops;
 };
 
-struct sparse_tabent {
-  int opcode;
-  char *name;
-  short numops;
+/* The decode tables below are indexed directly by opcode, so every
+   lookup is a single array access.  Unlisted entries are zero, i.e.
+   invalid instructions.  */
+
+/* CTRL format, opcodes 0x00 - 0x1f.  */
+
+static const struct tabent ctrl_tab[] = {
+  { NULL,		0, },	/* 0x00 */
+  { NULL,		0, },	/* 0x01 */
+  { NULL,		0, },	/* 0x02 */
+  { NULL,		0, },	/* 0x03 */
+  { NULL,		0, },	/* 0x04 */
+  { NULL,		0, },	/* 0x05 */
+  { NULL,		0, },	/* 0x06 */
+  { NULL,		0, },	/* 0x07 */
+  { "b",		1, },	/* 0x08 */
+  { "call",		1, },	/* 0x09 */
+  { "ret",		0, },	/* 0x0a */
+  { "bal",		1, },	/* 0x0b */
+  { NULL,		0, },	/* 0x0c */
+  { NULL,		0, },	/* 0x0d */
+  { NULL,		0, },	/* 0x0e */
+  { NULL,		0, },	/* 0x0f */
+  { "bno",		1, },	/* 0x10 */
+  { "bg",		1, },	/* 0x11 */
+  { "be",		1, },	/* 0x12 */
+  { "bge",		1, },	/* 0x13 */
+  { "bl",		1, },	/* 0x14 */
+  { "bne",		1, },	/* 0x15 */
+  { "ble",		1, },	/* 0x16 */
+  { "bo",		1, },	/* 0x17 */
+  { "faultno",		0, },	/* 0x18 */
+  { "faultg",		0, },	/* 0x19 */
+  { "faulte",		0, },	/* 0x1a */
+  { "faultge",		0, },	/* 0x1b */
+  { "faultl",		0, },	/* 0x1c */
+  { "faultne",		0, },	/* 0x1d */
+  { "faultle",		0, },	/* 0x1e */
+  { "faulto",		0, },	/* 0x1f */
+};
+
+/* COBR format, opcodes 0x20 - 0x3f.  */
+
+static const struct tabent cobr_tab[] = {
+  { "testno",	1, },	/* 0x20 */
+  { "testg",	1, },	/* 0x21 */
+  { "teste",	1, },	/* 0x22 */
+  { "testge",	1, },	/* 0x23 */
+  { "testl",	1, },	/* 0x24 */
+  { "testne",	1, },	/* 0x25 */
+  { "testle",	1, },	/* 0x26 */
+  { "testo",	1, },	/* 0x27 */
+  { NULL,	0, },	/* 0x28 */
+  { NULL,	0, },	/* 0x29 */
+  { NULL,	0, },	/* 0x2a */
+  { NULL,	0, },	/* 0x2b */
+  { NULL,	0, },	/* 0x2c */
+  { NULL,	0, },	/* 0x2d */
+  { NULL,	0, },	/* 0x2e */
+  { NULL,	0, },	/* 0x2f */
+  { "bbc",	3, },	/* 0x30 */
+  { "cmpobg",	3, },	/* 0x31 */
+  { "cmpobe",	3, },	/* 0x32 */
+  { "cmpobge",3, },	/* 0x33 */
+  { "cmpobl",	3, },	/* 0x34 */
+  { "cmpobne",3, },	/* 0x35 */
+  { "cmpoble",3, },	/* 0x36 */
+  { "bbs",	3, },	/* 0x37 */
+  { "cmpibno",3, },	/* 0x38 */
+  { "cmpibg",	3, },	/* 0x39 */
+  { "cmpibe",	3, },	/* 0x3a */
+  { "cmpibge",3, },	/* 0x3b */
+  { "cmpibl",	3, },	/* 0x3c */
+  { "cmpibne",3, },	/* 0x3d */
+  { "cmpible",3, },	/* 0x3e */
+  { "cmpibo",	3, },	/* 0x3f */
+};
+
+/* MEM format.  Opcodes of 0x8X, 9X, aX, bX, and cX must be in the table.
+
+   NOTE: In this table, the meaning of 'numops' is:
+      1: single operand
+      2: 2 operands, load instruction
+     -2: 2 operands, store instruction.  */
+
+#define MEM_MIN	0x80
+#define MEM_MAX	0xcf
+
+static const struct tabent mem_tab[MEM_MAX - MEM_MIN + 1] = {
+  [0x80 - MEM_MIN] = { "ldob",		2 },
+  [0x82 - MEM_MIN] = { "stob",		-2 },
+  [0x84 - MEM_MIN] = { "bx",		1 },
+  [0x85 - MEM_MIN] = { "balx",		2 },
+  [0x86 - MEM_MIN] = { "callx",		1 },
+  [0x88 - MEM_MIN] = { "ldos",		2 },
+  [0x8a - MEM_MIN] = { "stos",		-2 },
+  [0x8c - MEM_MIN] = { "lda",		2 },
+  [0x90 - MEM_MIN] = { "ld",		2 },
+  [0x92 - MEM_MIN] = { "st",		-2 },
+  [0x98 - MEM_MIN] = { "ldl",		2 },
+  [0x9a - MEM_MIN] = { "stl",		-2 },
+  [0xa0 - MEM_MIN] = { "ldt",		2 },
+  [0xa2 - MEM_MIN] = { "stt",		-2 },
+  [0xac - MEM_MIN] = { "dcinva",	1 },
+  [0xb0 - MEM_MIN] = { "ldq",		2 },
+  [0xb2 - MEM_MIN] = { "stq",		-2 },
+  [0xc0 - MEM_MIN] = { "ldib",		2 },
+  [0xc2 - MEM_MIN] = { "stib",		-2 },
+  [0xc8 - MEM_MIN] = { "ldis",		2 },
+  [0xca - MEM_MIN] = { "stis",		-2 },
+};
+
+/* REG format, indexed by the 12-bit opcode less REG_MIN.
+
+   NOTE: In this table, the meaning of 'numops' is:
+	 1: single operand, which is NOT a destination.
+	-1: single operand, which IS a destination.
+	 2: 2 operands, the 2nd of which is NOT a destination.
+	-2: 2 operands, the 2nd of which IS a destination.
+	 3: 3 operands
+
+	If an opcode mnemonic begins with "F", it is a floating-point
+	opcode (the "F" is not printed).  */
+
+#define REG_MIN	0x580
+#define REG_MAX 0x7f4
+
+static const struct tabent reg_tab[REG_MAX - REG_MIN + 1] = {
+  [0x580 - REG_MIN] = { "notbit",	3 },
+  [0x581 - REG_MIN] = { "and",		3 },
+  [0x582 - REG_MIN] = { "andnot",	3 },
+  [0x583 - REG_MIN] = { "setbit",	3 },
+  [0x584 - REG_MIN] = { "notand",	3 },
+  [0x586 - REG_MIN] = { "xor",		3 },
+  [0x587 - REG_MIN] = { "or",		3 },
+  [0x588 - REG_MIN] = { "nor",		3 },
+  [0x589 - REG_MIN] = { "xnor",		3 },
+  [0x58a - REG_MIN] = { "not",		-2 },
+  [0x58b - REG_MIN] = { "ornot",	3 },
+  [0x58c - REG_MIN] = { "clrbit",	3 },
+  [0x58d - REG_MIN] = { "notor",	3 },
+  [0x58e - REG_MIN] = { "nand",		3 },
+  [0x58f - REG_MIN] = { "alterbit",	3 },
+  [0x590 - REG_MIN] = { "addo",		3 },
+  [0x591 - REG_MIN] = { "addi",		3 },
+  [0x592 - REG_MIN] = { "subo",		3 },
+  [0x593 - REG_MIN] = { "subi",		3 },
+  [0x594 - REG_MIN] = { "cmpob",	2 },
+  [0x595 - REG_MIN] = { "cmpib",	2 },
+  [0x596 - REG_MIN] = { "cmpos",	2 },
+  [0x597 - REG_MIN] = { "cmpis",	2 },
+  [0x598 - REG_MIN] = { "shro",		3 },
+  [0x59a - REG_MIN] = { "shrdi",	3 },
+  [0x59b - REG_MIN] = { "shri",		3 },
+  [0x59c - REG_MIN] = { "shlo",		3 },
+  [0x59d - REG_MIN] = { "rotate",	3 },
+  [0x59e - REG_MIN] = { "shli",		3 },
+  [0x5a0 - REG_MIN] = { "cmpo",		2 },
+  [0x5a1 - REG_MIN] = { "cmpi",		2 },
+  [0x5a2 - REG_MIN] = { "concmpo",	2 },
+  [0x5a3 - REG_MIN] = { "concmpi",	2 },
+  [0x5a4 - REG_MIN] = { "cmpinco",	3 },
+  [0x5a5 - REG_MIN] = { "cmpinci",	3 },
+  [0x5a6 - REG_MIN] = { "cmpdeco",	3 },
+  [0x5a7 - REG_MIN] = { "cmpdeci",	3 },
+  [0x5ac - REG_MIN] = { "scanbyte",	2 },
+  [0x5ad - REG_MIN] = { "bswap",	-2 },
+  [0x5ae - REG_MIN] = { "chkbit",	2 },
+  [0x5b0 - REG_MIN] = { "addc",		3 },
+  [0x5b2 - REG_MIN] = { "subc",		3 },
+  [0x5b4 - REG_MIN] = { "intdis",	0 },
+  [0x5b5 - REG_MIN] = { "inten",	0 },
+  [0x5cc - REG_MIN] = { "mov",		-2 },
+  [0x5d8 - REG_MIN] = { "eshro",	3 },
+  [0x5dc - REG_MIN] = { "movl",		-2 },
+  [0x5ec - REG_MIN] = { "movt",		-2 },
+  [0x5fc - REG_MIN] = { "movq",		-2 },
+  [0x600 - REG_MIN] = { "synmov",	2 },
+  [0x601 - REG_MIN] = { "synmovl",	2 },
+  [0x602 - REG_MIN] = { "synmovq",	2 },
+  [0x603 - REG_MIN] = { "cmpstr",	3 },
+  [0x604 - REG_MIN] = { "movqstr",	3 },
+  [0x605 - REG_MIN] = { "movstr",	3 },
+  [0x610 - REG_MIN] = { "atmod",	3 },
+  [0x612 - REG_MIN] = { "atadd",	3 },
+  [0x613 - REG_MIN] = { "inspacc",	-2 },
+  [0x614 - REG_MIN] = { "ldphy",	-2 },
+  [0x615 - REG_MIN] = { "synld",	-2 },
+  [0x617 - REG_MIN] = { "fill",		3 },
+  [0x630 - REG_MIN] = { "sdma",		3 },
+  [0x631 - REG_MIN] = { "udma",		0 },
+  [0x640 - REG_MIN] = { "spanbit",	-2 },
+  [0x641 - REG_MIN] = { "scanbit",	-2 },
+  [0x642 - REG_MIN] = { "daddc",	3 },
+  [0x643 - REG_MIN] = { "dsubc",	3 },
+  [0x644 - REG_MIN] = { "dmovt",	-2 },
+  [0x645 - REG_MIN] = { "modac",	3 },
+  [0x646 - REG_MIN] = { "condrec",	-2 },
+  [0x650 - REG_MIN] = { "modify",	3 },
+  [0x651 - REG_MIN] = { "extract",	3 },
+  [0x654 - REG_MIN] = { "modtc",	3 },
+  [0x655 - REG_MIN] = { "modpc",	3 },
+  [0x656 - REG_MIN] = { "receive",	-2 },
+  [0x658 - REG_MIN] = { "intctl",	-2 },
+  [0x659 - REG_MIN] = { "sysctl",	3 },
+  [0x65b - REG_MIN] = { "icctl",	3 },
+  [0x65c - REG_MIN] = { "dcctl",	3 },
+  [0x65d - REG_MIN] = { "halt",		0 },
+  [0x660 - REG_MIN] = { "calls",	1 },
+  [0x662 - REG_MIN] = { "send",		3 },
+  [0x663 - REG_MIN] = { "sendserv",	1 },
+  [0x664 - REG_MIN] = { "resumprcs",	1 },
+  [0x665 - REG_MIN] = { "schedprcs",	1 },
+  [0x666 - REG_MIN] = { "saveprcs",	0 },
+  [0x668 - REG_MIN] = { "condwait",	1 },
+  [0x669 - REG_MIN] = { "wait",		1 },
+  [0x66a - REG_MIN] = { "signal",	1 },
+  [0x66b - REG_MIN] = { "mark",		0 },
+  [0x66c - REG_MIN] = { "fmark",	0 },
+  [0x66d - REG_MIN] = { "flushreg",	0 },
+  [0x66f - REG_MIN] = { "syncf",	0 },
+  [0x670 - REG_MIN] = { "emul",		3 },
+  [0x671 - REG_MIN] = { "ediv",		3 },
+  [0x673 - REG_MIN] = { "ldtime",	-1 },
+  [0x674 - REG_MIN] = { "Fcvtir",	-2 },
+  [0x675 - REG_MIN] = { "Fcvtilr",	-2 },
+  [0x676 - REG_MIN] = { "Fscalerl",	3 },
+  [0x677 - REG_MIN] = { "Fscaler",	3 },
+  [0x680 - REG_MIN] = { "Fatanr",	3 },
+  [0x681 - REG_MIN] = { "Flogepr",	3 },
+  [0x682 - REG_MIN] = { "Flogr",	3 },
+  [0x683 - REG_MIN] = { "Fremr",	3 },
+  [0x684 - REG_MIN] = { "Fcmpor",	2 },
+  [0x685 - REG_MIN] = { "Fcmpr",	2 },
+  [0x688 - REG_MIN] = { "Fsqrtr",	-2 },
+  [0x689 - REG_MIN] = { "Fexpr",	-2 },
+  [0x68a - REG_MIN] = { "Flogbnr",	-2 },
+  [0x68b - REG_MIN] = { "Froundr",	-2 },
+  [0x68c - REG_MIN] = { "Fsinr",	-2 },
+  [0x68d - REG_MIN] = { "Fcosr",	-2 },
+  [0x68e - REG_MIN] = { "Ftanr",	-2 },
+  [0x68f - REG_MIN] = { "Fclassr",	1 },
+  [0x690 - REG_MIN] = { "Fatanrl",	3 },
+  [0x691 - REG_MIN] = { "Flogeprl",	3 },
+  [0x692 - REG_MIN] = { "Flogrl",	3 },
+  [0x693 - REG_MIN] = { "Fremrl",	3 },
+  [0x694 - REG_MIN] = { "Fcmporl",	2 },
+  [0x695 - REG_MIN] = { "Fcmprl",	2 },
+  [0x698 - REG_MIN] = { "Fsqrtrl",	-2 },
+  [0x699 - REG_MIN] = { "Fexprl",	-2 },
+  [0x69a - REG_MIN] = { "Flogbnrl",	-2 },
+  [0x69b - REG_MIN] = { "Froundrl",	-2 },
+  [0x69c - REG_MIN] = { "Fsinrl",	-2 },
+  [0x69d - REG_MIN] = { "Fcosrl",	-2 },
+  [0x69e - REG_MIN] = { "Ftanrl",	-2 },
+  [0x69f - REG_MIN] = { "Fclassrl",	1 },
+  [0x6c0 - REG_MIN] = { "Fcvtri",	-2 },
+  [0x6c1 - REG_MIN] = { "Fcvtril",	-2 },
+  [0x6c2 - REG_MIN] = { "Fcvtzri",	-2 },
+  [0x6c3 - REG_MIN] = { "Fcvtzril",	-2 },
+  [0x6c9 - REG_MIN] = { "Fmovr",	-2 },
+  [0x6d9 - REG_MIN] = { "Fmovrl",	-2 },
+  /* the manuals are flat out WRONG! They state 0x6e9 as the opcode not 0x6e1 */
+  [0x6e1 - REG_MIN] = { "Fmovre",	-2 },
+  [0x6e2 - REG_MIN] = { "Fcpysre",	3 },
+  [0x6e3 - REG_MIN] = { "Fcpyrsre",	3 },
+  [0x701 - REG_MIN] = { "mulo",		3 },
+  [0x708 - REG_MIN] = { "remo",		3 },
+  [0x70b - REG_MIN] = { "divo",		3 },
+  [0x741 - REG_MIN] = { "muli",		3 },
+  [0x748 - REG_MIN] = { "remi",		3 },
+  [0x749 - REG_MIN] = { "modi",		3 },
+  [0x74b - REG_MIN] = { "divi",		3 },
+  [0x780 - REG_MIN] = { "addono",	3 },
+  [0x781 - REG_MIN] = { "addino",	3 },
+  [0x782 - REG_MIN] = { "subono",	3 },
+  [0x783 - REG_MIN] = { "subino",	3 },
+  [0x784 - REG_MIN] = { "selno",	3 },
+  [0x78b - REG_MIN] = { "Fdivr",	3 },
+  [0x78c - REG_MIN] = { "Fmulr",	3 },
+  [0x78d - REG_MIN] = { "Fsubr",	3 },
+  [0x78f - REG_MIN] = { "Faddr",	3 },
+  [0x790 - REG_MIN] = { "addog",	3 },
+  [0x791 - REG_MIN] = { "addig",	3 },
+  [0x792 - REG_MIN] = { "subog",	3 },
+  [0x793 - REG_MIN] = { "subig",	3 },
+  [0x794 - REG_MIN] = { "selg",		3 },
+  [0x79b - REG_MIN] = { "Fdivrl",	3 },
+  [0x79c - REG_MIN] = { "Fmulrl",	3 },
+  [0x79d - REG_MIN] = { "Fsubrl",	3 },
+  [0x79f - REG_MIN] = { "Faddrl",	3 },
+  [0x7a0 - REG_MIN] = { "addoe",	3 },
+  [0x7a1 - REG_MIN] = { "addie",	3 },
+  [0x7a2 - REG_MIN] = { "suboe",	3 },
+  [0x7a3 - REG_MIN] = { "subie",	3 },
+  [0x7a4 - REG_MIN] = { "sele",		3 },
+  [0x7b0 - REG_MIN] = { "addoge",	3 },
+  [0x7b1 - REG_MIN] = { "addige",	3 },
+  [0x7b2 - REG_MIN] = { "suboge",	3 },
+  [0x7b3 - REG_MIN] = { "subige",	3 },
+  [0x7b4 - REG_MIN] = { "selge",	3 },
+  [0x7c0 - REG_MIN] = { "addol",	3 },
+  [0x7c1 - REG_MIN] = { "addil",	3 },
+  [0x7c2 - REG_MIN] = { "subol",	3 },
+  [0x7c3 - REG_MIN] = { "subil",	3 },
+  [0x7c4 - REG_MIN] = { "sell",		3 },
+  [0x7d0 - REG_MIN] = { "addone",	3 },
+  [0x7d1 - REG_MIN] = { "addine",	3 },
+  [0x7d2 - REG_MIN] = { "subone",	3 },
+  [0x7d3 - REG_MIN] = { "subine",	3 },
+  [0x7d4 - REG_MIN] = { "selne",	3 },
+  [0x7e0 - REG_MIN] = { "addole",	3 },
+  [0x7e1 - REG_MIN] = { "addile",	3 },
+  [0x7e2 - REG_MIN] = { "subole",	3 },
+  [0x7e3 - REG_MIN] = { "subile",	3 },
+  [0x7e4 - REG_MIN] = { "selle",	3 },
+  [0x7f0 - REG_MIN] = { "addoo",	3 },
+  [0x7f1 - REG_MIN] = { "addio",	3 },
+  [0x7f2 - REG_MIN] = { "suboo",	3 },
+  [0x7f3 - REG_MIN] = { "subio",	3 },
+  [0x7f4 - REG_MIN] = { "selo",		3 },
 };
 
+/* Append the string S to the current part of T.  */
+
+static void
+text_puts (struct insn_text *t, const char *s)
+{
+  size_t room = sizeof (t->part[0]) - 1 - t->len[t->cur];
+  size_t n = strlen (s);
+
+  if (n > room)
+    n = room;
+  memcpy (t->part[t->cur] + t->len[t->cur], s, n);
+  t->len[t->cur] += n;
+  t->part[t->cur][t->len[t->cur]] = '\0';
+}
+
+/* Append formatted text to the current part of T.  */
+
+static void
+text_printf (struct insn_text *t, const char *fmt, ...)
+{
+  va_list ap;
+  size_t room;
+  int n;
+
+  room = sizeof (t->part[0]) - t->len[t->cur];
+  va_start (ap, fmt);
+  n = vsnprintf (t->part[t->cur] + t->len[t->cur], room, fmt, ap);
+  va_end (ap);
+  if (n > 0)
+    t->len[t->cur] += (size_t) n < room ? (size_t) n : room - 1;
+}
+
 static int
 pinsn (bfd_vma memaddr, uint32_t word1, uint32_t word2, disassemble_info* info)
 {
+  struct insn_text t;
   int instr_len;
 
+  t.part[0][0] = t.part[1][0] = '\0';
+  t.len[0] = t.len[1] = 0;
+  t.cur = 0;
+  t.addr = 0;
+
   instr_len = 4;
-  put_abs (word1, word2, info);
 
   /* Divide instruction set into classes based on high 4 bits of opcode.  */
     switch (get_opcode_high4bits(word1)) {
         case 0x0:
         case 0x1:
-            ctrl (memaddr, word1, word2, info);
+            put_abs (word1, word2, instr_len, &t);
+            ctrl (memaddr, word1, &t);
             break;
         case 0x2:
         case 0x3:
-            cobr (memaddr, word1, word2, info);
+            put_abs (word1, word2, instr_len, &t);
+            cobr (memaddr, word1, &t);
             break;
         case 0x5:
         case 0x6:
         case 0x7:
-            reg (word1, info);
+            put_abs (word1, word2, instr_len, &t);
+            reg (word1, &t);
             break;
         case 0x8:
         case 0x9:
         case 0xa:
         case 0xb:
         case 0xc:
-            instr_len = mem (memaddr, word1, word2, 0, info);
+            instr_len = mem_len (word1);
+            put_abs (word1, word2, instr_len, &t);
+            mem (memaddr, word1, word2, &t);
             break;
         default:
             /* Invalid instruction, print as data word.  */
-            invalid (word1, info);
+            put_abs (word1, word2, instr_len, &t);
+            invalid (word1, &t);
             break;
     }
-    return instr_len;
+
+  (*info->fprintf_func) (info->stream, "%s", t.part[0]);
+  if (t.cur != 0)
+    {
+      (*info->print_address_func) (t.addr, info);
+      if (t.len[1] != 0)
+	(*info->fprintf_func) (info->stream, "%s", t.part[1]);
+    }
+  return instr_len;
 }
 
 /* CTRL format.. */
 
 static void
-ctrl (bfd_vma memaddr, uint32_t word1, uint32_t word2 ATTRIBUTE_UNUSED, disassemble_info* info)
+ctrl (bfd_vma memaddr, uint32_t word1, struct insn_text *t)
 {
-  static const struct tabent ctrl_tab[] = {
-    { NULL,		0, },	/* 0x00 */
-    { NULL,		0, },	/* 0x01 */
-    { NULL,		0, },	/* 0x02 */
-    { NULL,		0, },	/* 0x03 */
-    { NULL,		0, },	/* 0x04 */
-    { NULL,		0, },	/* 0x05 */
-    { NULL,		0, },	/* 0x06 */
-    { NULL,		0, },	/* 0x07 */
-    { "b",		1, },	/* 0x08 */
-    { "call",		1, },	/* 0x09 */
-    { "ret",		0, },	/* 0x0a */
-    { "bal",		1, },	/* 0x0b */
-    { NULL,		0, },	/* 0x0c */
-    { NULL,		0, },	/* 0x0d */
-    { NULL,		0, },	/* 0x0e */
-    { NULL,		0, },	/* 0x0f */
-    { "bno",		1, },	/* 0x10 */
-    { "bg",		1, },	/* 0x11 */
-    { "be",		1, },	/* 0x12 */
-    { "bge",		1, },	/* 0x13 */
-    { "bl",		1, },	/* 0x14 */
-    { "bne",		1, },	/* 0x15 */
-    { "ble",		1, },	/* 0x16 */
-    { "bo",		1, },	/* 0x17 */
-    { "faultno",	0, },	/* 0x18 */
-    { "faultg",		0, },	/* 0x19 */
-    { "faulte",		0, },	/* 0x1a */
-    { "faultge",	0, },	/* 0x1b */
-    { "faultl",		0, },	/* 0x1c */
-    { "faultne",	0, },	/* 0x1d */
-    { "faultle",	0, },	/* 0x1e */
-    { "faulto",		0, },	/* 0x1f */
-  };
-
   int i = (word1 >> 24) & 0xff;
   if ((ctrl_tab[i].name == NULL) || ((word1 & 1) != 0))
     {
-      invalid (word1, info);
+      invalid (word1, t);
       return;
     }
 
-  (*info->fprintf_func) (info->stream, "%s", ctrl_tab[i].name);
-  if (word1 & 2)
-    /* Predicts branch not taken.  */
-    (*info->fprintf_func) (info->stream, ".f");
+  /* A set bit 1 predicts branch not taken.  */
+  text_printf (t, "%s%s", ctrl_tab[i].name, (word1 & 2) ? ".f" : "");
 
   if (ctrl_tab[i].numops == 1)
     {
@@ -215,87 +561,47 @@ ctrl (bfd_vma memaddr, uint32_t word1, uint32_t word2 ATTRIBUTE_UNUSED, disassem
 	  word1 |= (-1 & ~0xffffff);	/* Sign extend.  */
 	}
 
-      (*info->fprintf_func) (info->stream, "\t");
-      print_addr (word1 + memaddr, info);
+      text_puts (t, "\t");
+      print_addr (word1 + memaddr, t);
     }
 }
 
 /* COBR format.  */
 
 static void
-cobr (bfd_vma memaddr, uint32_t word1, uint32_t word2 ATTRIBUTE_UNUSED, disassemble_info* info)
+cobr (bfd_vma memaddr, uint32_t word1, struct insn_text *t)
 {
   int src1;
   int src2;
   int i;
 
-  static const struct tabent cobr_tab[] = {
-    { "testno",	1, },	/* 0x20 */
-    { "testg",	1, },	/* 0x21 */
-    { "teste",	1, },	/* 0x22 */
-    { "testge",	1, },	/* 0x23 */
-    { "testl",	1, },	/* 0x24 */
-    { "testne",	1, },	/* 0x25 */
-    { "testle",	1, },	/* 0x26 */
-    { "testo",	1, },	/* 0x27 */
-    { NULL,	0, },	/* 0x28 */
-    { NULL,	0, },	/* 0x29 */
-    { NULL,	0, },	/* 0x2a */
-    { NULL,	0, },	/* 0x2b */
-    { NULL,	0, },	/* 0x2c */
-    { NULL,	0, },	/* 0x2d */
-    { NULL,	0, },	/* 0x2e */
-    { NULL,	0, },	/* 0x2f */
-    { "bbc",	3, },	/* 0x30 */
-    { "cmpobg",	3, },	/* 0x31 */
-    { "cmpobe",	3, },	/* 0x32 */
-    { "cmpobge",3, },	/* 0x33 */
-    { "cmpobl",	3, },	/* 0x34 */
-    { "cmpobne",3, },	/* 0x35 */
-    { "cmpoble",3, },	/* 0x36 */
-    { "bbs",	3, },	/* 0x37 */
-    { "cmpibno",3, },	/* 0x38 */
-    { "cmpibg",	3, },	/* 0x39 */
-    { "cmpibe",	3, },	/* 0x3a */
-    { "cmpibge",3, },	/* 0x3b */
-    { "cmpibl",	3, },	/* 0x3c */
-    { "cmpibne",3, },	/* 0x3d */
-    { "cmpible",3, },	/* 0x3e */
-    { "cmpibo",	3, },	/* 0x3f */
-  };
-
   i = ((word1 >> 24) & 0xff) - 0x20;
   if (cobr_tab[i].name == NULL)
     {
-      invalid (word1, info);
+      invalid (word1, t);
       return;
     }
 
-  (*info->fprintf_func) (info->stream, "%s", cobr_tab[i].name);
-
-  /* Predicts branch not taken.  */
-  if (word1 & 2)
-    (*info->fprintf_func) (info->stream, ".f");
-
-  (*info->fprintf_func) (info->stream, "\t");
-
   src1 = (word1 >> 19) & 0x1f;
   src2 = (word1 >> 14) & 0x1f;
 
+  /* A set bit 1 predicts branch not taken.  */
+  text_printf (t, "%s%s\t", cobr_tab[i].name, (word1 & 2) ? ".f" : "");
+
   if (word1 & 0x02000)
     /* M1 is 1 */
-    (*info->fprintf_func) (info->stream, "%d", src1);
+    text_printf (t, "%d", src1);
   else
-    (*info->fprintf_func) (info->stream, "%s", reg_names[src1]);
+    text_puts (t, reg_names[src1]);
 
   if (cobr_tab[i].numops > 1)
     {
       if (word1 & 1)
 	/* S2 is 1.  */
-	(*info->fprintf_func) (info->stream, ",sf%d,", src2);
+	text_printf (t, ",sf%d,", src2);
       else
 	/* S1 is 0.  */
-	(*info->fprintf_func) (info->stream, ",%s,", reg_names[src2]);
+	text_printf (t, ",%s,", reg_names[src2]);
 
       /* Extract displacement and convert to address.  */
       word1 &= 0x00001ffc;
@@ -303,94 +609,49 @@ cobr (bfd_vma memaddr, uint32_t word1, uint32_t word2 ATTRIBUTE_UNUSED, disassem
 	/* Negative displacement.  */
 	word1 |= (-1 & ~0x1fff);	/* Sign extend.  */
 
-      print_addr (memaddr + word1, info);
+      print_addr (memaddr + word1, t);
     }
 }
 
 /* MEM format.  */
-/* Returns instruction length: 4 or 8.  */
+
+/* Return the length of the MEM format instruction WORD1: 4 or 8.  */
 
 static int
-mem (bfd_vma memaddr, uint32_t word1, uint32_t word2, int noprint, disassemble_info* info)
+mem_len (uint32_t word1)
+{
+  int i = ((word1 >> 24) & 0xff) - MEM_MIN;
+  int mode = (word1 >> 10) & 0xf;
+
+  if ((mem_tab[i].name != NULL)		/* Valid instruction */
+      && ((mode == 5) || (mode >= 12)))
+    /* With 32-bit displacement.  */
+    return 8;
+  return 4;
+}
+
+static void
+mem (bfd_vma memaddr, uint32_t word1, uint32_t word2, struct insn_text *t)
 {
-  int i, j;
-  int len;
+  int i;
   int mode;
   int offset;
   const char *reg1, *reg2, *reg3;
 
-  /* This lookup table is too sparse to make it worth typing in, but not
-     so large as to make a sparse array necessary.  We create the table
-     at runtime.  */
-
-  /* NOTE: In this table, the meaning of 'numops' is:
-      1: single operand
-      2: 2 operands, load instruction
-     -2: 2 operands, store instruction.  */
-  static struct tabent *mem_tab;
-  /* Opcodes of 0x8X, 9X, aX, bX, and cX must be in the table.  */
-#define MEM_MIN	0x80
-#define MEM_MAX	0xcf
-#define MEM_SIZ	( * sizeof(struct tabent))
-
-  static const struct sparse_tabent mem_init[] = {
-    { 0x80,	"ldob",	 2 },
-    { 0x82,	"stob",	-2 },
-    { 0x84,	"bx",	 1 },
-    { 0x85,	"balx",	 2 },
-    { 0x86,	"callx", 1 },
-    { 0x88,	"ldos",	 2 },
-    { 0x8a,	"stos",	-2 },
-    { 0x8c,	"lda",	 2 },
-    { 0x90,	"ld",	 2 },
-    { 0x92,	"st",	-2 },
-    { 0x98,	"ldl",	 2 },
-    { 0x9a,	"stl",	-2 },
-    { 0xa0,	"ldt",	 2 },
-    { 0xa2,	"stt",	-2 },
-    { 0xac,	"dcinva", 1 },
-    { 0xb0,	"ldq",	 2 },
-    { 0xb2,	"stq",	-2 },
-    { 0xc0,	"ldib",	 2 },
-    { 0xc2,	"stib",	-2 },
-    { 0xc8,	"ldis",	 2 },
-    { 0xca,	"stis",	-2 },
-    { 0,	NULL,	0 }
-  };
-  static struct tabent mem_tab_buf[MEM_MAX - MEM_MIN + 1];
-
-  if (mem_tab == NULL)
-    {
-      mem_tab = mem_tab_buf;
-
-      for (i = 0; mem_init[i].opcode != 0; i++)
-	{
-	  j = mem_init[i].opcode - MEM_MIN;
-	  mem_tab[j].name = mem_init[i].name;
-	  mem_tab[j].numops = mem_init[i].numops;
-	}
-    }
-
   i = ((word1 >> 24) & 0xff) - MEM_MIN;
   mode = (word1 >> 10) & 0xf;
 
-  if ((mem_tab[i].name != NULL)		/* Valid instruction */
-      && ((mode == 5) || (mode >= 12)))
-    /* With 32-bit displacement.  */
-    len = 8;
-  else
-    len = 4;
-
-  if (noprint)
-    return len;
-
-  if ((mem_tab[i].name == NULL) || (mode == 6))
+  /* MEMB format (mode & 4) also reserves scales above 16 and
+     bits 5-6.  */
+  if ((mem_tab[i].name == NULL) || (mode == 6)
+      || ((mode & 4)
+	  && ((((word1 >> 7) & 0x07) > 4) || (((word1 >> 5) & 0x03) != 0))))
     {
-      invalid (word1, info);
-      return len;
+      invalid (word1, t);
+      return;
     }
 
-  (*info->fprintf_func) (info->stream, "%s\t", mem_tab[i].name);
+  text_printf (t, "%s\t", mem_tab[i].name);
 
   reg1 = reg_names[ (word1 >> 19) & 0x1f ];	/* MEMB only */
   reg2 = reg_names[ (word1 >> 14) & 0x1f ];
@@ -402,17 +663,15 @@ mem (bfd_vma memaddr, uint32_t word1, uint32_t word2, int noprint, disassemble_i
     case 2: /* LOAD INSTRUCTION */
       if (mode & 4)
 	{			/* MEMB FORMAT */
-	  ea (memaddr, mode, reg2, reg3, word1, word2, info);
-	  (*info->fprintf_func) (info->stream, ",%s", reg1);
+	  ea (memaddr, mode, reg2, reg3, word1, word2, t);
+	  text_printf (t, ",%s", reg1);
 	}
       else
 	{				/* MEMA FORMAT */
-	  (*info->fprintf_func) (info->stream, "0x%x", (unsigned) offset);
-
 	  if (mode & 8)
-	    (*info->fprintf_func) (info->stream, "(%s)", reg2);
-
-	  (*info->fprintf_func)(info->stream, ",%s", reg1);
+	    text_printf (t, "0x%x(%s),%s", (unsigned) offset, reg2, reg1);
+	  else
+	    text_printf (t, "0x%x,%s", (unsigned) offset, reg1);
 	}
       break;
 
@@ -420,16 +679,16 @@ mem (bfd_vma memaddr, uint32_t word1, uint32_t word2, int noprint, disassemble_i
       if (mode & 4)
 	{
 	  /* MEMB FORMAT */
-	  (*info->fprintf_func) (info->stream, "%s,", reg1);
-	  ea (memaddr, mode, reg2, reg3, word1, word2, info);
+	  text_printf (t, "%s,", reg1);
+	  ea (memaddr, mode, reg2, reg3, word1, word2, t);
 	}
       else
 	{
 	  /* MEMA FORMAT */
-	  (*info->fprintf_func) (info->stream, "%s,0x%x", reg1, (unsigned) offset);
-
 	  if (mode & 8)
-	    (*info->fprintf_func) (info->stream, "(%s)", reg2);
+	    text_printf (t, "%s,0x%x(%s)", reg1, (unsigned) offset, reg2);
+	  else
+	    text_printf (t, "%s,0x%x", reg1, (unsigned) offset);
 	}
       break;
 
@@ -437,268 +696,39 @@ mem (bfd_vma memaddr, uint32_t word1, uint32_t word2, int noprint, disassemble_i
       if (mode & 4)
 	{
 	  /* MEMB FORMAT */
-	  ea (memaddr, mode, reg2, reg3, word1, word2, info);
+	  ea (memaddr, mode, reg2, reg3, word1, word2, t);
 	}
       else
 	{
 	  /* MEMA FORMAT */
-	  (*info->fprintf_func) (info->stream, "0x%x", (unsigned) offset);
 	  if (mode & 8)
-	    (*info->fprintf_func) (info->stream, "(%s)", reg2);
+	    text_printf (t, "0x%x(%s)", (unsigned) offset, reg2);
+	  else
+	    text_printf (t, "0x%x", (unsigned) offset);
 	}
       break;
     }
-
-  return len;
 }
 
 /* REG format.  */
 
 static void
-reg (uint32_t word1, disassemble_info* info)
+reg (uint32_t word1, struct insn_text *t)
 {
-  int i, j;
+  int i;
   int opcode;
   int fp;
   int m1, m2, m3;
   int s1, s2;
   int src, src2, dst;
-  char *mnemp;
-
-  /* This lookup table is too sparse to make it worth typing in, but not
-     so large as to make a sparse array necessary.  We create the table
-     at runtime.  */
-
-  /* NOTE: In this table, the meaning of 'numops' is:
-	 1: single operand, which is NOT a destination.
-	-1: single operand, which IS a destination.
-	 2: 2 operands, the 2nd of which is NOT a destination.
-	-2: 2 operands, the 2nd of which IS a destination.
-	 3: 3 operands
-
-	If an opcode mnemonic begins with "F", it is a floating-point
-	opcode (the "F" is not printed).  */
-
-  static struct tabent *reg_tab;
-  static const struct sparse_tabent reg_init[] =
-  {
-#define REG_MIN	0x580
-    { 0x580,	"notbit",	3 },
-    { 0x581,	"and",		3 },
-    { 0x582,	"andnot",	3 },
-    { 0x583,	"setbit",	3 },
-    { 0x584,	"notand",	3 },
-    { 0x586,	"xor",		3 },
-    { 0x587,	"or",		3 },
-    { 0x588,	"nor",		3 },
-    { 0x589,	"xnor",		3 },
-    { 0x58a,	"not",		-2 },
-    { 0x58b,	"ornot",	3 },
-    { 0x58c,	"clrbit",	3 },
-    { 0x58d,	"notor",	3 },
-    { 0x58e,	"nand",		3 },
-    { 0x58f,	"alterbit",	3 },
-    { 0x590,	"addo",		3 },
-    { 0x591,	"addi",		3 },
-    { 0x592,	"subo",		3 },
-    { 0x593,	"subi",		3 },
-    { 0x594,	"cmpob",	2 },
-    { 0x595,	"cmpib",	2 },
-    { 0x596,	"cmpos",	2 },
-    { 0x597,	"cmpis",	2 },
-    { 0x598,	"shro",		3 },
-    { 0x59a,	"shrdi",	3 },
-    { 0x59b,	"shri",		3 },
-    { 0x59c,	"shlo",		3 },
-    { 0x59d,	"rotate",	3 },
-    { 0x59e,	"shli",		3 },
-    { 0x5a0,	"cmpo",		2 },
-    { 0x5a1,	"cmpi",		2 },
-    { 0x5a2,	"concmpo",	2 },
-    { 0x5a3,	"concmpi",	2 },
-    { 0x5a4,	"cmpinco",	3 },
-    { 0x5a5,	"cmpinci",	3 },
-    { 0x5a6,	"cmpdeco",	3 },
-    { 0x5a7,	"cmpdeci",	3 },
-    { 0x5ac,	"scanbyte",	2 },
-    { 0x5ad,	"bswap",	-2 },
-    { 0x5ae,	"chkbit",	2 },
-    { 0x5b0,	"addc",		3 },
-    { 0x5b2,	"subc",		3 },
-    { 0x5b4,	"intdis",	0 },
-    { 0x5b5,	"inten",	0 },
-    { 0x5cc,	"mov",		-2 },
-    { 0x5d8,	"eshro",	3 },
-    { 0x5dc,	"movl",		-2 },
-    { 0x5ec,	"movt",		-2 },
-    { 0x5fc,	"movq",		-2 },
-    { 0x600,	"synmov",	2 },
-    { 0x601,	"synmovl",	2 },
-    { 0x602,	"synmovq",	2 },
-    { 0x603,	"cmpstr",	3 },
-    { 0x604,	"movqstr",	3 },
-    { 0x605,	"movstr",	3 },
-    { 0x610,	"atmod",	3 },
-    { 0x612,	"atadd",	3 },
-    { 0x613,	"inspacc",	-2 },
-    { 0x614,	"ldphy",	-2 },
-    { 0x615,	"synld",	-2 },
-    { 0x617,	"fill",		3 },
-    { 0x630,	"sdma",		3 },
-    { 0x631,	"udma",		0 },
-    { 0x640,	"spanbit",	-2 },
-    { 0x641,	"scanbit",	-2 },
-    { 0x642,	"daddc",	3 },
-    { 0x643,	"dsubc",	3 },
-    { 0x644,	"dmovt",	-2 },
-    { 0x645,	"modac",	3 },
-    { 0x646,	"condrec",	-2 },
-    { 0x650,	"modify",	3 },
-    { 0x651,	"extract",	3 },
-    { 0x654,	"modtc",	3 },
-    { 0x655,	"modpc",	3 },
-    { 0x656,	"receive",	-2 },
-    { 0x658,	"intctl",	-2 },
-    { 0x659,	"sysctl",	3 },
-    { 0x65b,	"icctl",	3 },
-    { 0x65c,	"dcctl",	3 },
-    { 0x65d,	"halt",		0 },
-    { 0x660,	"calls",	1 },
-    { 0x662,	"send",		3 },
-    { 0x663,	"sendserv",	1 },
-    { 0x664,	"resumprcs",	1 },
-    { 0x665,	"schedprcs",	1 },
-    { 0x666,	"saveprcs",	0 },
-    { 0x668,	"condwait",	1 },
-    { 0x669,	"wait",		1 },
-    { 0x66a,	"signal",	1 },
-    { 0x66b,	"mark",		0 },
-    { 0x66c,	"fmark",	0 },
-    { 0x66d,	"flushreg",	0 },
-    { 0x66f,	"syncf",	0 },
-    { 0x670,	"emul",		3 },
-    { 0x671,	"ediv",		3 },
-    { 0x673,	"ldtime",	-1 },
-    { 0x674,	"Fcvtir",	-2 },
-    { 0x675,	"Fcvtilr",	-2 },
-    { 0x676,	"Fscalerl",	3 },
-    { 0x677,	"Fscaler",	3 },
-    { 0x680,	"Fatanr",	3 },
-    { 0x681,	"Flogepr",	3 },
-    { 0x682,	"Flogr",	3 },
-    { 0x683,	"Fremr",	3 },
-    { 0x684,	"Fcmpor",	2 },
-    { 0x685,	"Fcmpr",	2 },
-    { 0x688,	"Fsqrtr",	-2 },
-    { 0x689,	"Fexpr",	-2 },
-    { 0x68a,	"Flogbnr",	-2 },
-    { 0x68b,	"Froundr",	-2 },
-    { 0x68c,	"Fsinr",	-2 },
-    { 0x68d,	"Fcosr",	-2 },
-    { 0x68e,	"Ftanr",	-2 },
-    { 0x68f,	"Fclassr",	1 },
-    { 0x690,	"Fatanrl",	3 },
-    { 0x691,	"Flogeprl",	3 },
-    { 0x692,	"Flogrl",	3 },
-    { 0x693,	"Fremrl",	3 },
-    { 0x694,	"Fcmporl",	2 },
-    { 0x695,	"Fcmprl",	2 },
-    { 0x698,	"Fsqrtrl",	-2 },
-    { 0x699,	"Fexprl",	-2 },
-    { 0x69a,	"Flogbnrl",	-2 },
-    { 0x69b,	"Froundrl",	-2 },
-    { 0x69c,	"Fsinrl",	-2 },
-    { 0x69d,	"Fcosrl",	-2 },
-    { 0x69e,	"Ftanrl",	-2 },
-    { 0x69f,	"Fclassrl",	1 },
-    { 0x6c0,	"Fcvtri",	-2 },
-    { 0x6c1,	"Fcvtril",	-2 },
-    { 0x6c2,	"Fcvtzri",	-2 },
-    { 0x6c3,	"Fcvtzril",	-2 },
-    { 0x6c9,	"Fmovr",	-2 },
-    { 0x6d9,	"Fmovrl",	-2 },
-    /* the manuals are flat out WRONG! They state 0x6e9 as the opcode not 0x6e1 */
-    { 0x6e1,	"Fmovre",	-2 }, 
-    { 0x6e2,	"Fcpysre",	3 },
-    { 0x6e3,	"Fcpyrsre",	3 },
-    { 0x701,	"mulo",		3 },
-    { 0x708,	"remo",		3 },
-    { 0x70b,	"divo",		3 },
-    { 0x741,	"muli",		3 },
-    { 0x748,	"remi",		3 },
-    { 0x749,	"modi",		3 },
-    { 0x74b,	"divi",		3 },
-    { 0x780,	"addono",	3 },
-    { 0x781,	"addino",	3 },
-    { 0x782,	"subono",	3 },
-    { 0x783,	"subino",	3 },
-    { 0x784,	"selno",	3 },
-    { 0x78b,	"Fdivr",	3 },
-    { 0x78c,	"Fmulr",	3 },
-    { 0x78d,	"Fsubr",	3 },
-    { 0x78f,	"Faddr",	3 },
-    { 0x790,	"addog",	3 },
-    { 0x791,	"addig",        3 },
-    { 0x792,	"subog",	3 },
-    { 0x793,	"subig",	3 },
-    { 0x794,	"selg",		3 },
-    { 0x79b,	"Fdivrl",	3 },
-    { 0x79c,	"Fmulrl",	3 },
-    { 0x79d,	"Fsubrl",	3 },
-    { 0x79f,	"Faddrl",	3 },
-    { 0x7a0,	"addoe",	3 },
-    { 0x7a1,	"addie",        3 },
-    { 0x7a2,	"suboe",	3 },
-    { 0x7a3,	"subie",	3 },
-    { 0x7a4,	"sele",		3 },
-    { 0x7b0,	"addoge",	3 },
-    { 0x7b1,	"addige",	3 },
-    { 0x7b2,	"suboge",	3 },
-    { 0x7b3,	"subige",	3 },
-    { 0x7b4,	"selge",	3 },
-    { 0x7c0,	"addol",	3 },
-    { 0x7c1,	"addil",	3 },
-    { 0x7c2,	"subol",	3 },
-    { 0x7c3,	"subil",	3 },
-    { 0x7c4,	"sell",		3 },
-    { 0x7d0,	"addone",	3 },
-    { 0x7d1,	"addine",	3 },
-    { 0x7d2,	"subone",	3 },
-    { 0x7d3,	"subine",	3 },
-    { 0x7d4,	"selne",	3 },
-    { 0x7e0,	"addole",	3 },
-    { 0x7e1,	"addile",	3 },
-    { 0x7e2,	"subole",	3 },
-    { 0x7e3,	"subile",	3 },
-    { 0x7e4,	"selle",	3 },
-    { 0x7f0,	"addoo",	3 },
-    { 0x7f1,	"addio",	3 },
-    { 0x7f2,	"suboo",	3 },
-    { 0x7f3,	"subio",	3 },
-    { 0x7f4,	"selo",		3 },
-#define REG_MAX 0x7f4
-    { 0,	NULL,		0 }
-  };
-  static struct tabent reg_tab_buf[REG_MAX - REG_MIN + 1];
-
-  if (reg_tab == NULL)
-    {
-      reg_tab = reg_tab_buf;
-
-      for (i = 0; reg_init[i].opcode != 0; i++)
-	{
-	  j = reg_init[i].opcode - REG_MIN;
-	  reg_tab[j].name = reg_init[i].name;
-	  reg_tab[j].numops = reg_init[i].numops;
-	}
-    }
+  const char *mnemp;
 
   opcode = ((word1 >> 20) & 0xff0) | ((word1 >> 7) & 0xf);
   i = opcode - REG_MIN;
 
   if ((opcode<REG_MIN) || (opcode>REG_MAX) || (reg_tab[i].name==NULL))
     {
-      invalid (word1, info);
+      invalid (word1, t);
       return;
     }
 
@@ -713,7 +743,7 @@ reg (uint32_t word1, disassemble_info* info)
       fp = 0;
     }
 
-  (*info->fprintf_func) (info->stream, "%s", mnemp);
+  text_puts (t, mnemp);
 
   s1   = (word1 >> 5)  & 1;
   s2   = (word1 >> 6)  & 1;
@@ -726,32 +756,32 @@ reg (uint32_t word1, disassemble_info* info)
 
   if  (reg_tab[i].numops != 0)
     {
-      (*info->fprintf_func) (info->stream, "\t");
+      text_puts (t, "\t");
 
     switch (reg_tab[i].numops)
       {
       case 1:
-	regop (m1, s1, src, fp, info);
+	regop (m1, s1, src, fp, t);
 	break;
       case -1:
-	dstop (m3, dst, fp, info);
+	dstop (m3, dst, fp, t);
 	break;
       case 2:
-	regop (m1, s1, src, fp, info);
-	(*info->fprintf_func) (info->stream, ",");
-	regop (m2, s2, src2, fp, info);
+	regop (m1, s1, src, fp, t);
+	text_puts (t, ",");
+	regop (m2, s2, src2, fp, t);
 	break;
       case -2:
-	regop (m1, s1, src, fp, info);
-	(*info->fprintf_func) (info->stream, ",");
-	dstop (m3, dst, fp, info);
+	regop (m1, s1, src, fp, t);
+	text_puts (t, ",");
+	dstop (m3, dst, fp, t);
 	break;
       case 3:
-	regop (m1, s1, src, fp, info);
-	(*info->fprintf_func) (info->stream, ",");
-	regop (m2, s2, src2, fp, info);
-	(*info->fprintf_func) (info->stream, ",");
-	dstop (m3, dst, fp, info);
+	regop (m1, s1, src, fp, t);
+	text_puts (t, ",");
+	regop (m2, s2, src2, fp, t);
+	text_puts (t, ",");
+	dstop (m3, dst, fp, t);
 	break;
       }
     }
@@ -761,57 +791,51 @@ reg (uint32_t word1, disassemble_info* info)
 
 static void
 ea (bfd_vma memaddr, int mode, const char *reg2, const char *reg3, int word1,
-    unsigned int word2, disassemble_info* info)
+    unsigned int word2, struct insn_text *t)
 {
   int scale;
   static const int scale_tab[] = { 1, 2, 4, 8, 16 };
 
-  scale = (word1 >> 7) & 0x07;
-
-  if ((scale > 4) || (((word1 >> 5) & 0x03) != 0))
-    {
-      invalid (word1, info);
-      return;
-    }
-  scale = scale_tab[scale];
+  /* mem has rejected reserved scales.  */
+  scale = scale_tab[(word1 >> 7) & 0x07];
 
   switch (mode)
     {
     case 4:						/* (reg) */
-      (*info->fprintf_func)( info->stream, "(%s)", reg2 );
+      text_printf (t, "(%s)", reg2);
       break;
     case 5:						/* displ+8(ip) */
-      print_addr (word2 + 8 + memaddr, info);
+      print_addr (word2 + 8 + memaddr, t);
       break;
     case 7:						/* (reg)[index*scale] */
       if (scale == 1)
-	(*info->fprintf_func) (info->stream, "(%s)[%s]", reg2, reg3);
+	text_printf (t, "(%s)[%s]", reg2, reg3);
       else
-	(*info->fprintf_func) (info->stream, "(%s)[%s*%d]", reg2, reg3, scale);
+	text_printf (t, "(%s)[%s*%d]", reg2, reg3, scale);
       break;
     case 12:					/* displacement */
-      print_addr ((bfd_vma) word2, info);
+      print_addr ((bfd_vma) word2, t);
       break;
     case 13:					/* displ(reg) */
-      print_addr ((bfd_vma) word2, info);
-      (*info->fprintf_func) (info->stream, "(%s)", reg2);
+      print_addr ((bfd_vma) word2, t);
+      text_printf (t, "(%s)", reg2);
       break;
     case 14:					/* displ[index*scale] */
-      print_addr ((bfd_vma) word2, info);
+      print_addr ((bfd_vma) word2, t);
       if (scale == 1)
-	(*info->fprintf_func) (info->stream, "[%s]", reg3);
+	text_printf (t, "[%s]", reg3);
       else
-	(*info->fprintf_func) (info->stream, "[%s*%d]", reg3, scale);
+	text_printf (t, "[%s*%d]", reg3, scale);
       break;
     case 15:				/* displ(reg)[index*scale] */
-      print_addr ((bfd_vma) word2, info);
+      print_addr ((bfd_vma) word2, t);
       if (scale == 1)
-	(*info->fprintf_func) (info->stream, "(%s)[%s]", reg2, reg3);
+	text_printf (t, "(%s)[%s]", reg2, reg3);
       else
-	(*info->fprintf_func) (info->stream, "(%s)[%s*%d]", reg2, reg3, scale);
+	text_printf (t, "(%s)[%s*%d]", reg2, reg3, scale);
       break;
     default:
-      invalid (word1, info);
+      invalid (word1, t);
       return;
     }
 }
@@ -820,7 +844,7 @@ ea (bfd_vma memaddr, int mode, const char *reg2, const char *reg3, int word1,
 /* Register Instruction Operand.  */
 
 static void
-regop (int mode, int spec, int fp_reg, int fp, disassemble_info* info)
+regop (int mode, int spec, int fp_reg, int fp, struct insn_text *t)
 {
   if (fp)
     {
@@ -830,26 +854,26 @@ regop (int mode, int spec, int fp_reg, int fp, disassemble_info* info)
 	  /* FP operand.  */
 	  switch (fp_reg)
 	    {
-	    case 0:  (*info->fprintf_func) (info->stream, "fp0");
+	    case 0:  text_puts (t, "fp0");
 	      break;
-	    case 1:  (*info->fprintf_func) (info->stream, "fp1");
+	    case 1:  text_puts (t, "fp1");
 	      break;
-	    case 2:  (*info->fprintf_func) (info->stream, "fp2");
+	    case 2:  text_puts (t, "fp2");
 	      break;
-	    case 3:  (*info->fprintf_func) (info->stream, "fp3");
+	    case 3:  text_puts (t, "fp3");
 	      break;
-	    case 16: (*info->fprintf_func) (info->stream, "0f0.0");
+	    case 16: text_puts (t, "0f0.0");
 	      break;
-	    case 22: (*info->fprintf_func) (info->stream, "0f1.0");
+	    case 22: text_puts (t, "0f1.0");
 	      break;
-	    default: (*info->fprintf_func) (info->stream, "?");
+	    default: text_puts (t, "?");
 	      break;
 	    }
 	}
       else
 	{
 	  /* Non-FP register.  */
-	  (*info->fprintf_func) (info->stream, "%s", reg_names[fp_reg]);
+	  text_puts (t, reg_names[fp_reg]);
 	}
     }
   else
@@ -858,15 +882,15 @@ regop (int mode, int spec, int fp_reg, int fp, disassemble_info* info)
       if (mode == 1)
 	{
 	  /* Literal.  */
-	  (*info->fprintf_func) (info->stream, "%d", fp_reg);
+	  text_printf (t, "%d", fp_reg);
 	}
       else
 	{
 	  /* Register.  */
 	  if (spec == 0)
-	    (*info->fprintf_func) (info->stream, "%s", reg_names[fp_reg]);
+	    text_puts (t, reg_names[fp_reg]);
 	  else
-	    (*info->fprintf_func) (info->stream, "sf%d", fp_reg);
+	    text_printf (t, "sf%d", fp_reg);
 	}
     }
 }
@@ -874,53 +898,41 @@ regop (int mode, int spec, int fp_reg, int fp, disassemble_info* info)
 /* Register Instruction Destination Operand.  */
 
 static void
-dstop (int mode, int dest_reg, int fp, disassemble_info* info)
+dstop (int mode, int dest_reg, int fp, struct insn_text *t)
 {
   /* 'dst' operand can't be a literal. On non-FP instructions,  register
      mode is assumed and "m3" acts as if were "s3";  on FP-instructions,
      sf registers are not allowed so m3 acts normally.  */
   if (fp)
-    regop (mode, 0, dest_reg, fp, info);
+    regop (mode, 0, dest_reg, fp, t);
   else
-    regop (0, mode, dest_reg, fp, info);
+    regop (0, mode, dest_reg, fp, t);
 }
 
 static void
-invalid (int word1, disassemble_info* info)
+invalid (int word1, struct insn_text *t)
 {
-  (*info->fprintf_func) (info->stream, ".word\t0x%08x", (unsigned) word1);
+  text_printf (t, ".word\t0x%08x", (unsigned) word1);
 }
 
+/* Record the address operand A; it is printed through
+   print_address_func once the instruction text is complete.  */
+
 static void
-print_addr (bfd_vma a, disassemble_info* info)
+print_addr (bfd_vma a, struct insn_text *t)
 {
-  (*info->print_address_func) (a, info);
+  t->addr = a;
+  t->cur = 1;
 }
 
 static void
 put_abs (uint32_t word1,
 	 uint32_t word2,
-     disassemble_info* info)
+	 int len,
+	 struct insn_text *t)
 {
-  int len;
-
-  switch (get_opcode_high4bits(word1))
-    {
-    case 0x8:
-    case 0x9:
-    case 0xa:
-    case 0xb:
-    case 0xc:
-      /* MEM format instruction.  */
-      len = mem (0, word1, word2, 1, info);
-      break;
-    default:
-      len = 4;
-      break;
-    }
-
   if (len == 8)
-    (*info->fprintf_func) (info->stream, "%08x %08x\t", word1, word2);
+    text_printf (t, "%08x %08x\t", word1, word2);
   else
-    (*info->fprintf_func) (info->stream, "%08x         \t", word1);
+    text_printf (t, "%08x         \t", word1);
 }